@@ -9,12 +9,89 @@ TEMPLATE = app
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
-    sqlworker.cpp
+    sqlworker.cpp \
+    databasetask.cpp \
+    maintenancetask.cpp \
+    integritychecktask.cpp \
+    compacttask.cpp \
+    tablefilter.cpp \
+    filterheaderview.cpp \
+    searchindextask.cpp \
+    tablefindscanner.cpp \
+    columnstatisticstask.cpp \
+    columnstatisticspanel.cpp \
+    pivotquerytask.cpp \
+    pivottablemodel.cpp \
+    pivotdialog.cpp \
+    sqlitefunctions.cpp \
+    globalsearchtask.cpp \
+    globalsearchdialog.cpp \
+    csvwriter.cpp \
+    csvexporttask.cpp \
+    pdftablewriter.cpp \
+    parquetwriter.cpp \
+    arrowipcwriter.cpp \
+    jsonlineswriter.cpp \
+    jsonlinesreader.cpp \
+    compressingdevice.cpp \
+    zipstreamwriter.cpp \
+    xlsxwriter.cpp \
+    pdfexporttask.cpp \
+    parquetexporttask.cpp \
+    arrowexporttask.cpp \
+    jsonlinesexporttask.cpp \
+    xlsxexporttask.cpp \
+    exportjobspanel.cpp
 
 # Header files
 HEADERS += \
     mainwindow.h \
-    sqlworker.h
+    sqlworker.h \
+    databasetask.h \
+    maintenancetask.h \
+    integritychecktask.h \
+    compacttask.h \
+    tablefilter.h \
+    filterheaderview.h \
+    searchindextask.h \
+    tablefindscanner.h \
+    columnstatisticstask.h \
+    columnstatisticspanel.h \
+    pivotquerytask.h \
+    pivottablemodel.h \
+    pivotdialog.h \
+    sqlitefunctions.h \
+    globalsearchtask.h \
+    globalsearchdialog.h \
+    csvwriter.h \
+    csvexporttask.h \
+    pdftablewriter.h \
+    parquetwriter.h \
+    arrowipcwriter.h \
+    jsonlineswriter.h \
+    jsonlinesreader.h \
+    compressingdevice.h \
+    zipstreamwriter.h \
+    xlsxwriter.h \
+    pdfexporttask.h \
+    parquetexporttask.h \
+    arrowexporttask.h \
+    jsonlinesexporttask.h \
+    xlsxexporttask.h \
+    exportjobspanel.h
+
+# Native SQLite API used on QSQLITE connection handles
+# Qt's SQLite driver must be built against the same library (-system-sqlite)
+LIBS += -lsqlite3
+
+# zlib for gzip compressed export pages and files and the xlsx zip container
+LIBS += -lz
+
+# Zstandard for zstd compressed export files, when installed
+packagesExist(libzstd) {
+    DEFINES += HAVE_ZSTD
+    LIBS += -lzstd
+}
 
 # Additional clean files
 QMAKE_CLEAN += $(TARGET)
@@ -0,0 +1,102 @@
+#include "arrowexporttask.h"
+#include "arrowipcwriter.h"
+#include "compressingdevice.h"
+#include "sqlworker.h"
+#include <sqlite3.h>
+
+// Define Arrow export constants
+const int ArrowExportTask::PROGRESS_INTERVAL_ROWS = 100000;
+
+/**
+ * @brief Constructor initializes ArrowExportTask with the query and the output file
+ */
+ArrowExportTask::ArrowExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                                 const QStringList &tableColumns, const QStringList &tableTypes, const QString &outputPath,
+                                 int batchRows)
+    : DatabaseTask(filePath)
+    , QueryString(queryString)         // Exported rows
+    , BindValues(bindValues)           // Placeholder values
+    , TableColumns(tableColumns)       // Declared column names
+    , TableTypes(tableTypes)           // Declared column types
+    , OutputPath(outputPath)           // Arrow file
+    , BatchRows(batchRows)             // Record batch size
+    , RowCount(0)                      // No row written
+{
+}
+
+/**
+ * @brief Get the number of rows written so far
+ */
+qint64 ArrowExportTask::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Step the query and write its rows
+ */
+bool ArrowExportTask::Run(QSqlDatabase &database, QString &message)
+{
+    // A searched view reads its row ids from the index file, which this connection must attach itself
+    if (!SQLWorker::AttachSearchIndexFile(database, FilePath)) {
+        message = "Cannot open search index file of " + FilePath;
+        return false;
+    }
+
+    sqlite3_stmt *_statement = nullptr;  // Native statement over the exported rows
+    if (!SQLWorker::PrepareNativeStatement(database, QueryString, BindValues, _statement)) {
+        message = "Cannot prepare export query";
+        return false;
+    }
+
+    // Declared types are matched by name, since they select the Arrow column types
+    const int _columnCount = sqlite3_column_count(_statement);  // Values per row
+    QStringList _names;  // Exported column names
+    QStringList _types;  // Declared types of the exported columns
+    for (int _col = 0; _col < _columnCount; ++_col) {
+        QString _name = QString::fromUtf8(sqlite3_column_name(_statement, _col));  // Result column name
+        _names.append(_name);
+        _types.append(TableTypes.value(TableColumns.indexOf(_name)));
+    }
+
+    // Readers memory-map Arrow IPC files, so the file is never compressed as a whole
+    CompressingDevice _file(OutputPath, CompressingDevice::Codec::None);  // Output file, written on the pipeline thread
+    if (!_file.open(QIODevice::WriteOnly)) {
+        message = QString("Cannot open %1: %2").arg(OutputPath, _file.errorString());
+        sqlite3_finalize(_statement);
+        return false;
+    }
+
+    ArrowIpcWriter _writer(&_file, _names, _types, BatchRows);  // Encoder buffering one record batch
+    bool _success = _writer.Begin();  // Every row so far was written
+    int _stepResult = SQLITE_DONE;    // Result of the last sqlite3_step
+    while (_success && !IsCancelled() && (_stepResult = sqlite3_step(_statement)) == SQLITE_ROW) {
+        _success = _writer.AppendRow(_statement);
+
+        if (++RowCount % PROGRESS_INTERVAL_ROWS == 0) {
+            emit ProgressChanged(-1, QString("%1 rows written to Arrow").arg(RowCount.load()));
+        }
+    }
+
+    if (IsCancelled()) {
+        message = "Export cancelled";
+    } else if (_success && _stepResult != SQLITE_DONE) {
+        message = QString("Export query failed: %1").arg(QString::fromUtf8(sqlite3_errmsg(sqlite3_db_handle(_statement))));
+    }
+    sqlite3_finalize(_statement);
+    if (message.isEmpty() && (!_success || !_writer.Finish() || !_file.Finish())) {
+        message = QString("Cannot write %1: %2").arg(OutputPath, _file.errorString());
+    }
+
+    // A file without its footer is unreadable, so partial exports are removed
+    if (!message.isEmpty()) {
+        _file.Remove();
+        return false;
+    }
+
+    message = QString("%1 rows written to %2").arg(RowCount.load()).arg(OutputPath);
+    if (_writer.GetMismatchCount() > 0) {
+        message += QString(" (%1 values did not match their declared column type and were written as null)").arg(_writer.GetMismatchCount());
+    }
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef ARROWEXPORTTASK_H
+#define ARROWEXPORTTASK_H
+
+#include <QStringList>
+#include <QVariantList>
+#include <atomic>
+#include "databasetask.h"
+
+/**
+ * @brief Background export of the rows of one query to an Arrow IPC (Feather) file
+ * Rows are stepped from a native statement on the task's own connection, so values go
+ * from SQLite's column buffers into the record batch buffers without QVariant conversion
+ */
+class ArrowExportTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for ArrowExportTask
+     * @param filePath Path to the SQL database file to read
+     * @param queryString SELECT statement returning the exported rows
+     * @param bindValues Values for the placeholders of the statement in order
+     * @param tableColumns Column names of the table in declaration order
+     * @param tableTypes Declared types of the table columns in declaration order
+     * @param outputPath Path of the Arrow file to write
+     * @param batchRows Rows per record batch
+     */
+    ArrowExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                    const QStringList &tableColumns, const QStringList &tableTypes, const QString &outputPath, int batchRows);
+
+    /**
+     * @brief Get the number of rows written so far (safe to call while running)
+     * @return Rows written
+     */
+    qint64 GetRowCount() const;
+
+protected:
+    /**
+     * @brief Step the query and write its rows
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if the complete file was written, false otherwise
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    QString QueryString;                 // SELECT statement of the exported rows
+    QVariantList BindValues;             // Placeholder values of the statement
+    QStringList TableColumns;            // Column names in declaration order
+    QStringList TableTypes;              // Declared types in declaration order
+    QString OutputPath;                  // Arrow file written by the task
+    int BatchRows;                       // Rows per record batch
+    std::atomic<qint64> RowCount;        // Rows written so far
+
+    static const int PROGRESS_INTERVAL_ROWS;  // Rows between progress reports
+};
+
+#endif // ARROWEXPORTTASK_H
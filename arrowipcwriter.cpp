@@ -0,0 +1,608 @@
+#include "arrowipcwriter.h"
+#include <QtEndian>
+#include <QDebug>
+#include <cmath>
+#include <cstring>
+#include <sqlite3.h>
+
+// Define Arrow IPC writer constants
+const int ArrowIpcWriter::DEFAULT_BATCH_ROWS = 65536;
+const int ArrowIpcWriter::BATCH_MAX_BYTES = 256 << 20;
+
+/**
+ * @brief Constructor initializes FlatBufferBuilder with an empty buffer
+ */
+FlatBufferBuilder::FlatBufferBuilder()
+    : Buffer(1024, '\0')               // Initial storage, grown on demand
+    , Head(1024)                       // Nothing written
+    , TableStart(0)                    // No table started
+    , TableFields()                    // No table fields
+{
+}
+
+/**
+ * @brief Create a string (length, bytes and a terminating zero)
+ */
+quint32 FlatBufferBuilder::CreateString(const QByteArray &utf8)
+{
+    PreAlign(utf8.size() + 1, 4);
+    Prepend("", 1);
+    Prepend(utf8.constData(), utf8.size());
+    quint32 _length = qToLittleEndian<quint32>(static_cast<quint32>(utf8.size()));  // Length prefix
+    Prepend(&_length, 4);
+    return static_cast<quint32>(GetSize());
+}
+
+/**
+ * @brief Create a vector of references to tables or strings
+ */
+quint32 FlatBufferBuilder::CreateOffsetVector(const QVector<quint32> &offsets)
+{
+    Align(4);
+    for (int _i = offsets.size() - 1; _i >= 0; --_i) {
+        quint32 _reference = qToLittleEndian<quint32>(ReferTo(offsets[_i]));  // Relative reference of the element
+        Prepend(&_reference, 4);
+    }
+    quint32 _length = qToLittleEndian<quint32>(static_cast<quint32>(offsets.size()));  // Element count
+    Prepend(&_length, 4);
+    return static_cast<quint32>(GetSize());
+}
+
+/**
+ * @brief Create a vector of structs
+ * The elements are aligned to the struct alignment and preceded by the count
+ */
+quint32 FlatBufferBuilder::CreateStructVector(const QByteArray &structs, int count, int alignment)
+{
+    PreAlign(structs.size(), 4);
+    PreAlign(structs.size(), alignment);
+    Prepend(structs.constData(), structs.size());
+    quint32 _length = qToLittleEndian<quint32>(static_cast<quint32>(count));  // Element count
+    Prepend(&_length, 4);
+    return static_cast<quint32>(GetSize());
+}
+
+/**
+ * @brief Start a table; fields are added until EndTable
+ */
+void FlatBufferBuilder::StartTable()
+{
+    TableFields.clear();
+    TableStart = GetSize();
+}
+
+/**
+ * @brief Add an 8-bit field (ubyte, bool or union type) to the current table
+ */
+void FlatBufferBuilder::AddUint8(int fieldId, quint8 value)
+{
+    AddScalar(fieldId, &value, 1);
+}
+
+/**
+ * @brief Add a 16-bit field (short or short enum) to the current table
+ */
+void FlatBufferBuilder::AddInt16(int fieldId, qint16 value)
+{
+    qint16 _value = qToLittleEndian<qint16>(value);  // Value in file byte order
+    AddScalar(fieldId, &_value, 2);
+}
+
+/**
+ * @brief Add a 32-bit field to the current table
+ */
+void FlatBufferBuilder::AddInt32(int fieldId, qint32 value)
+{
+    qint32 _value = qToLittleEndian<qint32>(value);  // Value in file byte order
+    AddScalar(fieldId, &_value, 4);
+}
+
+/**
+ * @brief Add a 64-bit field to the current table
+ */
+void FlatBufferBuilder::AddInt64(int fieldId, qint64 value)
+{
+    qint64 _value = qToLittleEndian<qint64>(value);  // Value in file byte order
+    AddScalar(fieldId, &_value, 8);
+}
+
+/**
+ * @brief Add a reference field to the current table
+ */
+void FlatBufferBuilder::AddOffset(int fieldId, quint32 offset)
+{
+    quint32 _reference = qToLittleEndian<quint32>(ReferTo(offset));  // Relative reference
+    Prepend(&_reference, 4);
+    TableFields.append(qMakePair(fieldId, GetSize()));
+}
+
+/**
+ * @brief Finish the current table and write its vtable
+ * The table starts with the signed distance to its vtable, which is written in front of it
+ */
+quint32 FlatBufferBuilder::EndTable()
+{
+    Align(4);
+    qint32 _placeholder = 0;  // Vtable distance, patched below
+    Prepend(&_placeholder, 4);
+    const int _tablePosition = GetSize();  // Reference to the table
+
+    int _maxFieldId = -1;  // Highest field id present
+    for (const QPair<int, int> &_field : TableFields) {
+        _maxFieldId = qMax(_maxFieldId, _field.first);
+    }
+
+    // vtable: its own size, the table size and the position of each field within the table (0 if absent)
+    QVector<quint16> _vtable(2 + _maxFieldId + 1, 0);  // Vtable entries in order
+    _vtable[0] = static_cast<quint16>(_vtable.size() * 2);
+    _vtable[1] = static_cast<quint16>(_tablePosition - TableStart);
+    for (const QPair<int, int> &_field : TableFields) {
+        _vtable[2 + _field.first] = static_cast<quint16>(_tablePosition - _field.second);
+    }
+    for (int _i = _vtable.size() - 1; _i >= 0; --_i) {
+        quint16 _entry = qToLittleEndian<quint16>(_vtable[_i]);  // Entry in file byte order
+        Prepend(&_entry, 2);
+    }
+
+    qint32 _distance = static_cast<qint32>(GetSize() - _tablePosition);  // Table address minus vtable address
+    qToLittleEndian<qint32>(_distance, Buffer.data() + Buffer.size() - _tablePosition);
+    return static_cast<quint32>(_tablePosition);
+}
+
+/**
+ * @brief Write the root reference and get the finished buffer
+ */
+QByteArray FlatBufferBuilder::Finish(quint32 root)
+{
+    PreAlign(4, 8);
+    quint32 _reference = qToLittleEndian<quint32>(ReferTo(root));  // Root table reference
+    Prepend(&_reference, 4);
+    return Buffer.mid(Head);
+}
+
+/**
+ * @brief Get the number of bytes written so far
+ */
+int FlatBufferBuilder::GetSize() const
+{
+    return Buffer.size() - Head;
+}
+
+/**
+ * @brief Add bytes in front of the buffer, doubling the storage when it is full
+ */
+void FlatBufferBuilder::Prepend(const void *data, int length)
+{
+    if (Head < length) {
+        const int _used = GetSize();  // Bytes to keep at the end
+        QByteArray _grown(qMax(Buffer.size() * 2, _used + length), '\0');  // Larger storage
+        std::memcpy(_grown.data() + _grown.size() - _used, Buffer.constData() + Head, static_cast<size_t>(_used));
+        Head = _grown.size() - _used;
+        Buffer = _grown;
+    }
+    Head -= length;
+    std::memcpy(Buffer.data() + Head, data, static_cast<size_t>(length));
+}
+
+/**
+ * @brief Add a scalar field value and remember its position
+ */
+void FlatBufferBuilder::AddScalar(int fieldId, const void *value, int size)
+{
+    Align(size);
+    Prepend(value, size);
+    TableFields.append(qMakePair(fieldId, GetSize()));
+}
+
+/**
+ * @brief Pad so that the buffer size is a multiple of an alignment
+ */
+void FlatBufferBuilder::Align(int alignment)
+{
+    PreAlign(0, alignment);
+}
+
+/**
+ * @brief Pad so that the buffer size is a multiple of an alignment after adding some bytes
+ */
+void FlatBufferBuilder::PreAlign(int length, int alignment)
+{
+    static const char _zeros[8] = {0};  // Padding bytes
+    int _padding = (alignment - (GetSize() + length) % alignment) % alignment;  // Bytes to insert
+    Prepend(_zeros, _padding);
+}
+
+/**
+ * @brief Get the value of a reference stored in the next 4 bytes
+ * References are unsigned distances forward from where they are stored
+ */
+quint32 FlatBufferBuilder::ReferTo(quint32 offset)
+{
+    Align(4);
+    return static_cast<quint32>(GetSize()) + 4 - offset;
+}
+
+/**
+ * @brief Constructor initializes ArrowIpcWriter with the schema of the columns
+ */
+ArrowIpcWriter::ArrowIpcWriter(QIODevice *device, const QStringList &columnNames, const QStringList &declaredTypes, int batchRows)
+    : Device(device)                   // Output device
+    , Columns(columnNames.size())      // One builder per column
+    , Batches()                        // No batch written
+    , BatchRows(qMax(1, batchRows))    // Rows per batch
+    , BufferedRows(0)                  // Empty batch
+    , BufferedBytes(0)                 // Empty batch
+    , FileOffset(0)                    // Nothing written
+    , RowCount(0)                      // No rows appended
+    , MismatchCount(0)                 // No value converted
+    , Failed(false)                    // No write failed
+{
+    for (int _col = 0; _col < columnNames.size(); ++_col) {
+        Columns[_col].Name = columnNames[_col];
+        Columns[_col].Type = MapDeclaredType(declaredTypes.value(_col));
+        if (Columns[_col].Type == TYPE_UTF8 || Columns[_col].Type == TYPE_BINARY) {
+            Columns[_col].Offsets = QByteArray(4, '\0');
+        }
+    }
+}
+
+/**
+ * @brief Write the file magic and the schema
+ */
+bool ArrowIpcWriter::Begin()
+{
+    if (!WriteBytes(QByteArray("ARROW1\0\0", 8))) {
+        return false;
+    }
+
+    FlatBufferBuilder _builder;  // Builder of the schema message
+    quint32 _schema = BuildSchema(_builder);  // Schema table
+    _builder.StartTable();
+    _builder.AddInt16(0, 4);       // MetadataVersion V5
+    _builder.AddUint8(1, 1);       // MessageHeader Schema
+    _builder.AddOffset(2, _schema);
+    _builder.AddInt64(3, 0);       // No body
+    WriteMessage(_builder.Finish(_builder.EndTable()), QVector<QByteArray>());
+    return !Failed;
+}
+
+/**
+ * @brief Append the row a statement is positioned on
+ * Values are read with the sqlite3_column functions of their storage class; text and
+ * blobs are copied once, from SQLite's buffer into the column buffer
+ */
+bool ArrowIpcWriter::AppendRow(sqlite3_stmt *statement)
+{
+    if (Failed) {
+        return false;
+    }
+
+    for (int _col = 0; _col < Columns.size(); ++_col) {
+        ColumnBuilder &_column = Columns[_col];  // Column of the value
+        const int _storage = sqlite3_column_type(statement, _col);  // SQLite storage class of the value
+        bool _valid = _storage != SQLITE_NULL;  // Value is not null
+
+        if (_column.Type == TYPE_INT64 || _column.Type == TYPE_FLOAT64) {
+            qint64 _integer = 0;  // Value of an int64 column
+            double _real = 0;     // Value of a float64 column
+            if (_storage == SQLITE_INTEGER) {
+                _integer = sqlite3_column_int64(statement, _col);
+                _real = static_cast<double>(_integer);
+            } else if (_storage == SQLITE_FLOAT) {
+                _real = sqlite3_column_double(statement, _col);
+                _integer = static_cast<qint64>(_real);
+                // Integral reals are stored as REAL when they do not fit, so only exact values convert
+                if (_column.Type == TYPE_INT64 && (std::floor(_real) != _real || _real < -9223372036854775808.0 || _real >= 9223372036854775808.0)) {
+                    _valid = false;
+                }
+            } else if (_valid) {
+                const char *_text = reinterpret_cast<const char *>(sqlite3_column_text(statement, _col));  // Text or blob bytes
+                QByteArray _bytes = QByteArray::fromRawData(_text, sqlite3_column_bytes(statement, _col)).trimmed();  // Number text
+                bool _ok = false;  // Text holds a number of the column type
+                if (_column.Type == TYPE_INT64) {
+                    _integer = _bytes.toLongLong(&_ok);
+                } else {
+                    _real = _bytes.toDouble(&_ok);
+                }
+                _valid = _ok;
+            }
+            if (_storage != SQLITE_NULL && !_valid) {
+                MismatchCount++;
+            }
+
+            // Null slots keep their place with a zero value
+            char _value[8];  // Little-endian value bytes
+            if (_column.Type == TYPE_INT64) {
+                qToLittleEndian<qint64>(_valid ? _integer : 0, _value);
+            } else {
+                quint64 _bits = 0;  // IEEE 754 bits of the value
+                if (_valid) {
+                    std::memcpy(&_bits, &_real, sizeof(_bits));
+                }
+                qToLittleEndian<quint64>(_bits, _value);
+            }
+            _column.Values.append(_value, 8);
+            BufferedBytes += 8;
+        } else {
+            if (_valid) {
+                // sqlite3_column_bytes must follow the pointer call, which may convert the value
+                const void *_data = _storage == SQLITE_BLOB ? sqlite3_column_blob(statement, _col)
+                                                           : static_cast<const void *>(sqlite3_column_text(statement, _col));  // Value bytes
+                int _length = sqlite3_column_bytes(statement, _col);  // Byte length of the value
+                _column.Values.append(static_cast<const char *>(_data), _length);
+                BufferedBytes += _length;
+            }
+            char _offset[4];  // Little-endian end offset of the value
+            qToLittleEndian<qint32>(static_cast<qint32>(_column.Values.size()), _offset);
+            _column.Offsets.append(_offset, 4);
+            BufferedBytes += 4;
+        }
+
+        AppendValidity(_column, BufferedRows, _valid);
+        if (!_valid) {
+            _column.NullCount++;
+        }
+    }
+
+    BufferedRows++;
+    RowCount++;
+    // The byte limit also keeps the int32 offsets of text columns in range
+    if (BufferedRows >= BatchRows || BufferedBytes >= BATCH_MAX_BYTES) {
+        return WriteBatch();
+    }
+    return true;
+}
+
+/**
+ * @brief Write the last record batch and the footer
+ */
+bool ArrowIpcWriter::Finish()
+{
+    if (!WriteBatch()) {
+        return false;
+    }
+
+    // End-of-stream marker, then the footer repeating the schema and locating the batches
+    if (!WriteBytes(QByteArray("\xFF\xFF\xFF\xFF\0\0\0\0", 8))) {
+        return false;
+    }
+
+    FlatBufferBuilder _builder;  // Builder of the footer
+    quint32 _schema = BuildSchema(_builder);  // Schema table
+    quint32 _dictionaries = _builder.CreateStructVector(QByteArray(), 0, 8);  // No dictionary batches
+    QByteArray _blocks;  // Block structs: offset, metadata length, padding, body length
+    for (const Block &_batch : Batches) {
+        char _block[24] = {0};  // One Block struct
+        qToLittleEndian<qint64>(_batch.Offset, _block);
+        qToLittleEndian<qint32>(_batch.MetadataLength, _block + 8);
+        qToLittleEndian<qint64>(_batch.BodyLength, _block + 16);
+        _blocks.append(_block, 24);
+    }
+    quint32 _recordBatches = _builder.CreateStructVector(_blocks, Batches.size(), 8);  // Record batch locations
+
+    _builder.StartTable();
+    _builder.AddInt16(0, 4);  // MetadataVersion V5
+    _builder.AddOffset(1, _schema);
+    _builder.AddOffset(2, _dictionaries);
+    _builder.AddOffset(3, _recordBatches);
+    QByteArray _footer = _builder.Finish(_builder.EndTable());  // Footer flatbuffer
+
+    char _length[4];  // Little-endian footer length
+    qToLittleEndian<qint32>(static_cast<qint32>(_footer.size()), _length);
+    _footer.append(_length, 4);
+    _footer.append("ARROW1");
+    return WriteBytes(_footer);
+}
+
+/**
+ * @brief Get the number of rows appended so far
+ */
+qint64 ArrowIpcWriter::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Get the number of values written as null because they did not fit their column type
+ */
+qint64 ArrowIpcWriter::GetMismatchCount() const
+{
+    return MismatchCount;
+}
+
+/**
+ * @brief Map a declared SQLite type to the Arrow type of a column
+ * Same rules as ParquetWriter, so both exports of a table have the same column types
+ */
+ArrowIpcWriter::ColumnType ArrowIpcWriter::MapDeclaredType(const QString &declaredType)
+{
+    QString _type = declaredType.toUpper();  // Declared type in upper case
+    if (_type.contains("INT") || _type.contains("BOOL")) {
+        return TYPE_INT64;
+    }
+    if (_type.isEmpty() || _type.contains("CHAR") || _type.contains("CLOB") || _type.contains("TEXT")
+        || _type.contains("DATE") || _type.contains("TIME")) {
+        return TYPE_UTF8;
+    }
+    if (_type.contains("BLOB")) {
+        return TYPE_BINARY;
+    }
+    return TYPE_FLOAT64;
+}
+
+/**
+ * @brief Mark the next row of a column as null or valid (least significant bit first)
+ */
+void ArrowIpcWriter::AppendValidity(ColumnBuilder &column, int row, bool valid)
+{
+    if (row % 8 == 0) {
+        column.Validity.append('\0');
+    }
+    if (valid) {
+        column.Validity.data()[column.Validity.size() - 1] |= static_cast<char>(1 << (row % 8));
+    }
+}
+
+/**
+ * @brief Create the Schema table in a builder
+ */
+quint32 ArrowIpcWriter::BuildSchema(FlatBufferBuilder &builder) const
+{
+    QVector<quint32> _fields;  // Field tables in column order
+    for (const ColumnBuilder &_column : Columns) {
+        quint32 _name = builder.CreateString(_column.Name.toUtf8());  // Field name
+
+        // Type union: the member table and its type code
+        quint8 _typeCode = 0;  // Type union discriminator
+        builder.StartTable();
+        switch (_column.Type) {
+        case TYPE_INT64:
+            builder.AddInt32(0, 64);  // bitWidth
+            builder.AddUint8(1, 1);   // is_signed
+            _typeCode = 2;            // Int
+            break;
+        case TYPE_FLOAT64:
+            builder.AddInt16(0, 2);   // Precision DOUBLE
+            _typeCode = 3;            // FloatingPoint
+            break;
+        case TYPE_BINARY:
+            _typeCode = 4;            // Binary
+            break;
+        case TYPE_UTF8:
+            _typeCode = 5;            // Utf8
+            break;
+        }
+        quint32 _type = builder.EndTable();  // Type table
+        quint32 _children = builder.CreateOffsetVector(QVector<quint32>());  // Readers expect the vector even when empty
+
+        builder.StartTable();
+        builder.AddOffset(0, _name);
+        builder.AddUint8(1, 1);  // nullable
+        builder.AddUint8(2, _typeCode);
+        builder.AddOffset(3, _type);
+        builder.AddOffset(5, _children);
+        _fields.append(builder.EndTable());
+    }
+    quint32 _fieldVector = builder.CreateOffsetVector(_fields);  // Fields of the schema
+
+    builder.StartTable();
+    builder.AddInt16(0, 0);  // Endianness Little
+    builder.AddOffset(1, _fieldVector);
+    return builder.EndTable();
+}
+
+/**
+ * @brief Write the buffered rows as a record batch and reset the buffers
+ * Each buffer is padded to 8 bytes in place; the padding is dropped with the batch
+ */
+bool ArrowIpcWriter::WriteBatch()
+{
+    if (Failed) {
+        return false;
+    }
+    if (BufferedRows == 0) {
+        return true;
+    }
+
+    QByteArray _nodes;    // FieldNode structs: length, null count
+    QByteArray _buffers;  // Buffer structs: body offset, length
+    QVector<QByteArray> _body;  // Padded buffers in body order
+    qint64 _bodyLength = 0;     // Bytes of the body so far
+    int _bufferCount = 0;       // Buffer structs written
+    auto _addBuffer = [&](QByteArray &buffer, qint64 length) {
+        char _buffer[16];  // One Buffer struct
+        qToLittleEndian<qint64>(_bodyLength, _buffer);
+        qToLittleEndian<qint64>(length, _buffer + 8);
+        _buffers.append(_buffer, 16);
+        _bufferCount++;
+        if (length == 0) {
+            return;
+        }
+        buffer.append((8 - buffer.size() % 8) % 8, '\0');
+        _body.append(buffer);
+        _bodyLength += buffer.size();
+    };
+
+    for (ColumnBuilder &_column : Columns) {
+        char _node[16];  // One FieldNode struct
+        qToLittleEndian<qint64>(BufferedRows, _node);
+        qToLittleEndian<qint64>(_column.NullCount, _node + 8);
+        _nodes.append(_node, 16);
+
+        // A column without nulls needs no validity bitmap
+        _addBuffer(_column.Validity, _column.NullCount > 0 ? _column.Validity.size() : 0);
+        if (_column.Type == TYPE_UTF8 || _column.Type == TYPE_BINARY) {
+            _addBuffer(_column.Offsets, _column.Offsets.size());
+        }
+        _addBuffer(_column.Values, _column.Values.size());
+    }
+
+    FlatBufferBuilder _builder;  // Builder of the record batch message
+    quint32 _nodeVector = _builder.CreateStructVector(_nodes, Columns.size(), 8);  // FieldNode per column
+    quint32 _bufferVector = _builder.CreateStructVector(_buffers, _bufferCount, 8);  // Buffer locations
+    _builder.StartTable();
+    _builder.AddInt64(0, BufferedRows);
+    _builder.AddOffset(1, _nodeVector);
+    _builder.AddOffset(2, _bufferVector);
+    quint32 _recordBatch = _builder.EndTable();  // RecordBatch table
+    _builder.StartTable();
+    _builder.AddInt16(0, 4);  // MetadataVersion V5
+    _builder.AddUint8(1, 3);  // MessageHeader RecordBatch
+    _builder.AddOffset(2, _recordBatch);
+    _builder.AddInt64(3, _bodyLength);
+    Batches.append(WriteMessage(_builder.Finish(_builder.EndTable()), _body));
+
+    _body.clear();
+    for (ColumnBuilder &_column : Columns) {
+        _column.Validity.resize(0);
+        _column.Values.resize(0);
+        if (_column.Type == TYPE_UTF8 || _column.Type == TYPE_BINARY) {
+            _column.Offsets.resize(4);
+            std::memset(_column.Offsets.data(), 0, 4);
+        }
+        _column.NullCount = 0;
+    }
+    BufferedRows = 0;
+    BufferedBytes = 0;
+    return !Failed;
+}
+
+/**
+ * @brief Write an encapsulated message: continuation marker, length, metadata and body
+ * The metadata is a multiple of 8 bytes, so the body starts 8-byte aligned
+ */
+ArrowIpcWriter::Block ArrowIpcWriter::WriteMessage(const QByteArray &metadata, const QVector<QByteArray> &body)
+{
+    Block _block;  // Location of the message
+    _block.Offset = FileOffset;
+    _block.MetadataLength = 8 + metadata.size();
+    _block.BodyLength = 0;
+
+    char _prefix[8];  // Continuation marker and metadata length
+    qToLittleEndian<quint32>(0xFFFFFFFFu, _prefix);
+    qToLittleEndian<qint32>(static_cast<qint32>(metadata.size()), _prefix + 4);
+    WriteBytes(QByteArray(_prefix, 8));
+    WriteBytes(metadata);
+    for (const QByteArray &_buffer : body) {
+        WriteBytes(_buffer);
+        _block.BodyLength += _buffer.size();
+    }
+    return _block;
+}
+
+/**
+ * @brief Append bytes to the device, tracking the file offset
+ */
+bool ArrowIpcWriter::WriteBytes(const QByteArray &bytes)
+{
+    if (Failed) {
+        return false;
+    }
+    if (Device->write(bytes) != bytes.size()) {
+        qDebug() << "Error: Failed to write Arrow output:" << Device->errorString();
+        Failed = true;
+        return false;
+    }
+    FileOffset += bytes.size();
+    return true;
+}
@@ -0,0 +1,266 @@
+#ifndef ARROWIPCWRITER_H
+#define ARROWIPCWRITER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QStringList>
+#include <QVector>
+#include <QPair>
+
+struct sqlite3_stmt;
+
+/**
+ * @brief Minimal FlatBuffers builder for Arrow IPC metadata
+ * Like the reference builder it fills the buffer from the back, so children are created
+ * before the tables and vectors that refer to them. Objects are referred to by their
+ * offset from the end of the buffer, as returned when they are created
+ */
+class FlatBufferBuilder
+{
+public:
+    /**
+     * @brief Constructor for FlatBufferBuilder
+     */
+    FlatBufferBuilder();
+
+    /**
+     * @brief Create a string
+     * @param utf8 String bytes
+     * @return Reference to the string
+     */
+    quint32 CreateString(const QByteArray &utf8);
+
+    /**
+     * @brief Create a vector of references to tables or strings
+     * @param offsets References in element order
+     * @return Reference to the vector
+     */
+    quint32 CreateOffsetVector(const QVector<quint32> &offsets);
+
+    /**
+     * @brief Create a vector of structs
+     * @param structs Struct bytes in element order
+     * @param count Number of structs
+     * @param alignment Alignment of the struct type
+     * @return Reference to the vector
+     */
+    quint32 CreateStructVector(const QByteArray &structs, int count, int alignment);
+
+    /**
+     * @brief Start a table; fields are added until EndTable
+     */
+    void StartTable();
+
+    /**
+     * @brief Add an 8-bit field (ubyte, bool or union type) to the current table
+     */
+    void AddUint8(int fieldId, quint8 value);
+
+    /**
+     * @brief Add a 16-bit field (short or short enum) to the current table
+     */
+    void AddInt16(int fieldId, qint16 value);
+
+    /**
+     * @brief Add a 32-bit field to the current table
+     */
+    void AddInt32(int fieldId, qint32 value);
+
+    /**
+     * @brief Add a 64-bit field to the current table
+     */
+    void AddInt64(int fieldId, qint64 value);
+
+    /**
+     * @brief Add a reference field to the current table
+     * @param fieldId Field id in the table schema
+     * @param offset Reference to a string, vector or table created earlier
+     */
+    void AddOffset(int fieldId, quint32 offset);
+
+    /**
+     * @brief Finish the current table and write its vtable
+     * @return Reference to the table
+     */
+    quint32 EndTable();
+
+    /**
+     * @brief Write the root reference and get the finished buffer
+     * @param root Reference to the root table
+     * @return Buffer whose size is a multiple of 8
+     */
+    QByteArray Finish(quint32 root);
+
+private:
+    /**
+     * @brief Get the number of bytes written so far
+     */
+    int GetSize() const;
+
+    /**
+     * @brief Add bytes in front of the buffer
+     */
+    void Prepend(const void *data, int length);
+
+    /**
+     * @brief Add a scalar field value and remember its position
+     */
+    void AddScalar(int fieldId, const void *value, int size);
+
+    /**
+     * @brief Pad so that the buffer size is a multiple of an alignment
+     */
+    void Align(int alignment);
+
+    /**
+     * @brief Pad so that the buffer size is a multiple of an alignment after adding some bytes
+     */
+    void PreAlign(int length, int alignment);
+
+    /**
+     * @brief Get the value of a reference stored in the next 4 bytes
+     */
+    quint32 ReferTo(quint32 offset);
+
+    QByteArray Buffer;                   // Storage; the written bytes are at its end
+    int Head;                            // Index of the first written byte in Buffer
+    int TableStart;                      // Size when the current table was started
+    QVector<QPair<int, int>> TableFields;  // Field id and position of the fields of the current table
+};
+
+/**
+ * @brief Streaming writer of Arrow IPC files (Feather version 2)
+ * Rows are appended straight from a stepped SQLite statement into columnar buffers:
+ * numbers as little-endian 64-bit values, text and blobs as offsets plus bytes, never
+ * through QVariant or QString. Every BatchRows rows the buffers become one record batch,
+ * so memory is bounded by one batch and readers can memory-map the columns
+ */
+class ArrowIpcWriter
+{
+public:
+    /**
+     * @brief Constructor for ArrowIpcWriter
+     * Declared types map to Arrow types by SQLite's affinity rules like ParquetWriter:
+     * INT and BOOL to int64, REAL/FLOA/DOUB and other numeric types to float64, BLOB to
+     * binary, and text, DATE/TIME and undeclared types to utf8
+     * @param device Output device (not owned, must stay open until Finish)
+     * @param columnNames Column names in statement column order
+     * @param declaredTypes Declared SQLite types in statement column order (empty string if none)
+     * @param batchRows Rows per record batch
+     */
+    ArrowIpcWriter(QIODevice *device, const QStringList &columnNames, const QStringList &declaredTypes, int batchRows);
+
+    /**
+     * @brief Write the file magic and the schema
+     * @return true if the device accepted them, false otherwise
+     */
+    bool Begin();
+
+    /**
+     * @brief Append the row a statement is positioned on
+     * Values that do not convert to the column's type are written as null
+     * @param statement Statement after a sqlite3_step that returned SQLITE_ROW
+     * @return true if writing can continue, false after a write error
+     */
+    bool AppendRow(sqlite3_stmt *statement);
+
+    /**
+     * @brief Write the last record batch and the footer
+     * @return true if the file is complete, false otherwise
+     */
+    bool Finish();
+
+    /**
+     * @brief Get the number of rows appended so far
+     * @return Rows appended
+     */
+    qint64 GetRowCount() const;
+
+    /**
+     * @brief Get the number of values written as null because they did not fit their column type
+     * @return Converted values
+     */
+    qint64 GetMismatchCount() const;
+
+    static const int DEFAULT_BATCH_ROWS;     // Rows per record batch unless configured otherwise
+    static const int BATCH_MAX_BYTES;        // Buffered bytes that complete a record batch early
+
+private:
+    /**
+     * @brief Arrow types used for SQLite values
+     */
+    enum ColumnType {
+        TYPE_INT64,
+        TYPE_FLOAT64,
+        TYPE_UTF8,
+        TYPE_BINARY
+    };
+
+    /**
+     * @brief Schema and buffers of one column of the current record batch
+     */
+    struct ColumnBuilder {
+        QString Name;                      // Column name
+        ColumnType Type = TYPE_UTF8;       // Arrow type
+        QByteArray Validity;               // Validity bitmap, bit set for non-null rows
+        QByteArray Offsets;                // Int32 start offsets into Values plus the end (text and binary only)
+        QByteArray Values;                 // Fixed-width values or variable-length bytes
+        qint64 NullCount = 0;              // Null rows in the batch
+    };
+
+    /**
+     * @brief Position of a record batch message in the file, kept for the footer
+     */
+    struct Block {
+        qint64 Offset;                     // File offset of the message
+        qint32 MetadataLength;             // Bytes of prefix and metadata
+        qint64 BodyLength;                 // Bytes of the buffers
+    };
+
+    /**
+     * @brief Map a declared SQLite type to the Arrow type of a column
+     */
+    static ColumnType MapDeclaredType(const QString &declaredType);
+
+    /**
+     * @brief Mark the next row of a column as null or valid
+     */
+    static void AppendValidity(ColumnBuilder &column, int row, bool valid);
+
+    /**
+     * @brief Create the Schema table in a builder
+     * @return Reference to the table
+     */
+    quint32 BuildSchema(FlatBufferBuilder &builder) const;
+
+    /**
+     * @brief Write the buffered rows as a record batch and reset the buffers
+     */
+    bool WriteBatch();
+
+    /**
+     * @brief Write an encapsulated message: continuation marker, length, metadata and body
+     * @param metadata Finished Message flatbuffer
+     * @param body Buffers, each already padded to 8 bytes
+     * @return Position of the message for the footer
+     */
+    Block WriteMessage(const QByteArray &metadata, const QVector<QByteArray> &body);
+
+    /**
+     * @brief Append bytes to the device, tracking the file offset
+     */
+    bool WriteBytes(const QByteArray &bytes);
+
+    QIODevice *Device;                   // Output device (not owned)
+    QVector<ColumnBuilder> Columns;      // Schema and buffers per column
+    QVector<Block> Batches;              // Written record batches
+    int BatchRows;                       // Rows per record batch
+    int BufferedRows;                    // Rows in the current batch
+    qint64 BufferedBytes;                // Bytes buffered for the current batch
+    qint64 FileOffset;                   // Bytes written to the device
+    qint64 RowCount;                     // Rows appended so far
+    qint64 MismatchCount;                // Values written as null because of their type
+    bool Failed;                         // Flag indicating a write failed (true) or not (false)
+};
+
+#endif // ARROWIPCWRITER_H
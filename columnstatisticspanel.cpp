@@ -0,0 +1,222 @@
+#include "columnstatisticspanel.h"
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QThread>
+
+// Define panel constants
+const int ColumnStatisticsPanel::MAX_PARALLEL_TASKS = 4;
+const int ColumnStatisticsPanel::MAX_VALUE_LENGTH = 40;
+
+/**
+ * @brief Constructor initializes the panel widgets
+ */
+ColumnStatisticsPanel::ColumnStatisticsPanel(QWidget *parent)
+    : QDockWidget("Column Statistics", parent)
+    , StatusLabel(nullptr)             // Progress line
+    , StatisticsTable(nullptr)         // Statistics grid
+    , RunningTasks()                   // Running tasks
+    , PendingStatistics()              // Results of the running tasks
+    , PendingFailed(false)             // Failure flag of the running tasks
+    , Cache()                          // Statistics per table
+    , CurrentFilePath("")              // File of the table shown
+    , CurrentTableName("")             // Table shown
+    , CurrentColumns()                 // Columns shown
+    , CurrentDataVersion(-1)           // Data version being computed
+{
+    QWidget *_content = new QWidget(this);  // Dock content container
+    QVBoxLayout *_layout = new QVBoxLayout(_content);  // Layout of label and grid
+
+    StatusLabel = new QLabel(_content);
+    StatisticsTable = new QTableWidget(0, 7, _content);
+    StatisticsTable->setHorizontalHeaderLabels({"Column", "Nulls", "Min", "Max", "Distinct", "Avg length", "Top values"});
+    StatisticsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    StatisticsTable->verticalHeader()->hide();
+    StatisticsTable->horizontalHeader()->setStretchLastSection(true);
+
+    _layout->addWidget(StatusLabel);
+    _layout->addWidget(StatisticsTable, 1);
+    setWidget(_content);
+}
+
+/**
+ * @brief Destructor cancels running statistics tasks
+ */
+ColumnStatisticsPanel::~ColumnStatisticsPanel()
+{
+    Stop();
+}
+
+/**
+ * @brief Show statistics of a table, computing them unless cached for this data version
+ */
+void ColumnStatisticsPanel::ShowTable(const QString &filePath, const QString &tableName, const QStringList &columnNames, qint64 dataVersion)
+{
+    // Statistics of the same table and version are already on screen or being computed
+    if (tableName == CurrentTableName && dataVersion == CurrentDataVersion && filePath == CurrentFilePath) {
+        return;
+    }
+
+    Stop();
+    CurrentFilePath = filePath;
+    CurrentTableName = tableName;
+    CurrentColumns = columnNames;
+    CurrentDataVersion = dataVersion;
+
+    StatisticsTable->setRowCount(columnNames.size());
+    for (int _row = 0; _row < columnNames.size(); ++_row) {  // One row per column
+        StatisticsTable->setItem(_row, 0, new QTableWidgetItem(columnNames[_row]));
+        for (int _col = 1; _col < StatisticsTable->columnCount(); ++_col) {
+            StatisticsTable->setItem(_row, _col, new QTableWidgetItem(""));
+        }
+    }
+
+    auto _cached = Cache.constFind(tableName);  // Cached statistics (end if never computed)
+    if (_cached != Cache.constEnd() && _cached->DataVersion == dataVersion) {
+        for (int _row = 0; _row < _cached->Statistics.size() && _row < columnNames.size(); ++_row) {
+            ShowStatistics(_row, _cached->Statistics[_row]);
+        }
+        StatusLabel->setText(QString("%1 - unchanged since last computed").arg(tableName));
+        return;
+    }
+
+    StartTasks();
+}
+
+/**
+ * @brief Cancel and dispose of running statistics tasks
+ */
+void ColumnStatisticsPanel::Stop()
+{
+    for (ColumnStatisticsTask *_task : RunningTasks) {
+        _task->disconnect(this);
+        _task->Stop();
+        delete _task;  // Thread has left Run, so no member is still in use
+    }
+    RunningTasks.clear();
+
+    // A cancelled run must be restarted when the same table is shown again
+    CurrentTableName.clear();
+    CurrentDataVersion = -1;
+}
+
+/**
+ * @brief Forget cached statistics
+ */
+void ColumnStatisticsPanel::ClearCache()
+{
+    Stop();
+    Cache.clear();
+}
+
+/**
+ * @brief Start tasks computing the statistics of the current table in parallel
+ * Columns are split into contiguous slices, one per read connection
+ */
+void ColumnStatisticsPanel::StartTasks()
+{
+    PendingStatistics = QVector<ColumnStatistics>(CurrentColumns.size());
+    PendingFailed = false;
+
+    int _taskCount = qBound(1, QThread::idealThreadCount() - 1, MAX_PARALLEL_TASKS);  // Leave one core for the GUI
+    _taskCount = qMin(_taskCount, CurrentColumns.size());
+    if (_taskCount == 0) {
+        StatusLabel->setText(QString("%1 has no columns").arg(CurrentTableName));
+        return;
+    }
+
+    int _sliceSize = (CurrentColumns.size() + _taskCount - 1) / _taskCount;  // Columns per task
+    for (int _start = 0; _start < CurrentColumns.size(); _start += _sliceSize) {  // First column of the slice
+        ColumnStatisticsTask *_task = new ColumnStatisticsTask(CurrentFilePath, CurrentTableName,
+                                                               CurrentColumns.mid(_start, _sliceSize));  // Task for this slice
+        connect(_task, &DatabaseTask::Finished, this, [this, _task](bool success, const QString &message) {
+            OnTaskFinished(_task, success, message);
+        });
+        RunningTasks.append(_task);
+    }
+
+    StatusLabel->setText(QString("Computing statistics of %1 on %2 connection(s)...").arg(CurrentTableName).arg(RunningTasks.size()));
+    for (ColumnStatisticsTask *_task : RunningTasks) {
+        _task->Start();
+    }
+}
+
+/**
+ * @brief Collect the results of a finished task and cache them once all tasks are done
+ */
+void ColumnStatisticsPanel::OnTaskFinished(ColumnStatisticsTask *task, bool success, const QString &message)
+{
+    if (!RunningTasks.removeOne(task)) {
+        return;
+    }
+
+    if (success) {
+        // Results arrive in slice order; match them to panel rows by column name
+        for (const ColumnStatistics &_statistics : task->GetStatistics()) {
+            int _row = CurrentColumns.indexOf(_statistics.ColumnName);  // Panel row of the column
+            if (_row >= 0) {
+                PendingStatistics[_row] = _statistics;
+                ShowStatistics(_row, _statistics);
+            }
+        }
+    } else {
+        PendingFailed = true;
+        qDebug() << "Error: Column statistics task failed:" << message;
+    }
+    task->deleteLater();
+
+    if (!RunningTasks.isEmpty()) {
+        return;
+    }
+
+    if (PendingFailed) {
+        StatusLabel->setText(QString("Statistics of %1 incomplete: %2").arg(CurrentTableName, message));
+        CurrentDataVersion = -1;  // Retry on the next request
+        return;
+    }
+
+    CachedStatistics _entry;  // Finished statistics of the current table
+    _entry.DataVersion = CurrentDataVersion;
+    _entry.Statistics = PendingStatistics;
+    Cache.insert(CurrentTableName, _entry);
+
+    qint64 _rowCount = PendingStatistics.isEmpty() ? 0 : PendingStatistics.first().RowCount;  // Rows in the table
+    StatusLabel->setText(QString("%1 - %2 rows").arg(CurrentTableName).arg(_rowCount));
+}
+
+/**
+ * @brief Fill the row of one column with its statistics
+ */
+void ColumnStatisticsPanel::ShowStatistics(int row, const ColumnStatistics &statistics)
+{
+    QStringList _topValues;  // "value (count)" per frequent value
+    for (const QPair<QString, qint64> &_value : statistics.TopValues) {
+        _topValues.append(QString("%1 (%2)").arg(FormatValue(_value.first)).arg(_value.second));
+    }
+
+    StatisticsTable->item(row, 1)->setText(QString::number(statistics.NullCount));
+    StatisticsTable->item(row, 2)->setText(FormatValue(statistics.MinValue));
+    StatisticsTable->item(row, 3)->setText(FormatValue(statistics.MaxValue));
+    QString _distinct = statistics.DistinctCount >= 0 ? QString::number(statistics.DistinctCount) : QString();  // Distinct count text
+    if (statistics.DistinctApproximate && !_distinct.isEmpty()) {
+        _distinct.prepend("~");  // HyperLogLog estimate
+    }
+    StatisticsTable->item(row, 4)->setText(_distinct);
+    StatisticsTable->item(row, 5)->setText(QString::number(statistics.AverageLength, 'f', 1));
+    StatisticsTable->item(row, 6)->setText((statistics.TopValuesSampled ? "sample: " : "") + _topValues.join(", "));
+}
+
+/**
+ * @brief Format a value for display, shortening long texts
+ */
+QString ColumnStatisticsPanel::FormatValue(const QVariant &value)
+{
+    if (value.isNull()) {
+        return "NULL";
+    }
+
+    QString _text = value.toString();  // Value as text
+    if (_text.size() > MAX_VALUE_LENGTH) {
+        _text = _text.left(MAX_VALUE_LENGTH) + "...";
+    }
+    return _text;
+}
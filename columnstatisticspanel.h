@@ -0,0 +1,101 @@
+#ifndef COLUMNSTATISTICSPANEL_H
+#define COLUMNSTATISTICSPANEL_H
+
+#include <QDockWidget>
+#include <QTableWidget>
+#include <QLabel>
+#include <QHash>
+#include <QList>
+#include "columnstatisticstask.h"
+
+/**
+ * @brief Dock panel listing null count, bounds, distinct count, average length and top values per column
+ * Statistics are computed by several ColumnStatisticsTask instances in parallel and
+ * cached per table until the data version of the file changes
+ */
+class ColumnStatisticsPanel : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for ColumnStatisticsPanel
+     * @param parent Parent widget pointer (usually the main window)
+     */
+    explicit ColumnStatisticsPanel(QWidget *parent = nullptr);
+
+    /**
+     * @brief Destructor cancels running statistics tasks
+     */
+    ~ColumnStatisticsPanel() override;
+
+    /**
+     * @brief Show statistics of a table, computing them unless cached for this data version
+     * @param filePath Path to the SQL database file containing the table
+     * @param tableName Name of the table
+     * @param columnNames Columns of the table in display order
+     * @param dataVersion Data version of the file (see SQLWorker::GetDataVersion)
+     */
+    void ShowTable(const QString &filePath, const QString &tableName, const QStringList &columnNames, qint64 dataVersion);
+
+    /**
+     * @brief Cancel and dispose of running statistics tasks
+     */
+    void Stop();
+
+    /**
+     * @brief Forget cached statistics (e.g. when another file is loaded)
+     */
+    void ClearCache();
+
+private:
+    /**
+     * @brief Cached statistics of one table
+     */
+    struct CachedStatistics {
+        qint64 DataVersion = -1;         // Data version the statistics were computed for
+        QVector<ColumnStatistics> Statistics;  // Statistics per column in display order
+    };
+
+    /**
+     * @brief Start tasks computing the statistics of the current table in parallel
+     */
+    void StartTasks();
+
+    /**
+     * @brief Collect the results of a finished task and cache them once all tasks are done
+     * @param task Task that finished
+     * @param success true if the task computed its columns, false otherwise
+     * @param message Summary or error reported by the task
+     */
+    void OnTaskFinished(ColumnStatisticsTask *task, bool success, const QString &message);
+
+    /**
+     * @brief Fill the row of one column with its statistics
+     * @param row Panel row of the column (0-based)
+     * @param statistics Statistics of the column
+     */
+    void ShowStatistics(int row, const ColumnStatistics &statistics);
+
+    /**
+     * @brief Format a value for display, shortening long texts
+     * @return Display text
+     */
+    static QString FormatValue(const QVariant &value);
+
+    QLabel *StatusLabel;                 // Progress or summary line above the statistics
+    QTableWidget *StatisticsTable;       // One row per column, one column per statistic
+    QList<ColumnStatisticsTask *> RunningTasks;  // Tasks still computing (empty if idle)
+    QVector<ColumnStatistics> PendingStatistics;  // Results collected for the current table
+    bool PendingFailed;                  // Flag indicating a task of the current run failed (true) or not (false)
+    QHash<QString, CachedStatistics> Cache;  // Finished statistics per table name
+    QString CurrentFilePath;             // File of the table shown
+    QString CurrentTableName;            // Table shown in the panel (empty if none)
+    QStringList CurrentColumns;          // Columns of the table shown in display order
+    qint64 CurrentDataVersion;           // Data version the running tasks compute for
+
+    static const int MAX_PARALLEL_TASKS;  // Upper bound of concurrent read connections
+    static const int MAX_VALUE_LENGTH;    // Characters shown of long values
+};
+
+#endif // COLUMNSTATISTICSPANEL_H
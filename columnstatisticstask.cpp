@@ -0,0 +1,157 @@
+#include "columnstatisticstask.h"
+#include "sqlworker.h"
+#include "sqlitefunctions.h"
+
+// Define statistics constants
+const int ColumnStatisticsTask::TOP_VALUE_COUNT = 5;
+const qint64 ColumnStatisticsTask::EXACT_DISTINCT_ROW_LIMIT = 1000000;
+const int ColumnStatisticsTask::TOP_VALUE_SAMPLE_ROWS = 100000;
+
+/**
+ * @brief Constructor initializes ColumnStatisticsTask with the columns to analyze
+ */
+ColumnStatisticsTask::ColumnStatisticsTask(const QString &filePath, const QString &tableName, const QStringList &columnNames)
+    : DatabaseTask(filePath)
+    , TableName(tableName)             // Analyzed table
+    , Statistics()                     // Results per column
+{
+    for (const QString &_columnName : columnNames) {
+        ColumnStatistics _statistics;  // Empty result for this column
+        _statistics.ColumnName = _columnName;
+        Statistics.append(_statistics);
+    }
+}
+
+/**
+ * @brief Get the statistics computed by the task
+ */
+QVector<ColumnStatistics> ColumnStatisticsTask::GetStatistics() const
+{
+    return Statistics;
+}
+
+/**
+ * @brief Run the aggregate scan and the per-column grouped queries
+ * @param database Open connection owned by the task thread
+ * @param message Output summary or error description
+ * @return true if statistics of every column were computed, false otherwise
+ */
+bool ColumnStatisticsTask::Run(QSqlDatabase &database, QString &message)
+{
+    if (Statistics.isEmpty()) {
+        return true;
+    }
+
+    emit ProgressChanged(0, QString("Scanning %1").arg(TableName));
+    if (!ComputeAggregates(database, message)) {
+        return false;
+    }
+
+    for (int _i = 0; _i < Statistics.size(); ++_i) {  // Current column (0-based)
+        if (IsCancelled()) {
+            return false;
+        }
+
+        emit ProgressChanged(10 + _i * 90 / Statistics.size(),
+                             QString("Counting values of %1").arg(Statistics[_i].ColumnName));
+        if (!ComputeValueFrequencies(database, Statistics[_i], message)) {
+            return false;
+        }
+    }
+
+    emit ProgressChanged(100, "Column statistics finished");
+    message = QString("Statistics of %1 column(s) of %2 computed").arg(Statistics.size()).arg(TableName);
+    return true;
+}
+
+/**
+ * @brief Compute counts, bounds, average lengths and distinct estimates of all columns in one table scan
+ */
+bool ColumnStatisticsTask::ComputeAggregates(QSqlDatabase &database, QString &message)
+{
+    // Five aggregates per column after the shared row count; the HyperLogLog sketch uses fixed memory
+    QStringList _aggregates("COUNT(*)");  // SELECT list of the aggregate scan
+    for (const ColumnStatistics &_statistics : Statistics) {
+        QString _column = SQLWorker::QuoteIdentifier(_statistics.ColumnName);  // Quoted column name
+        _aggregates.append(QString("COUNT(%1), MIN(%1), MAX(%1), AVG(LENGTH(%1)), %2(%1)")
+                               .arg(_column, SQLiteFunctions::APPROX_COUNT_DISTINCT));
+    }
+
+    QSqlQuery _query(database);  // Query object for the aggregate scan
+    _query.setForwardOnly(true);
+    QString _queryString = QString("SELECT %1 FROM %2").arg(_aggregates.join(", "), SQLWorker::QuoteIdentifier(TableName));  // Complete SELECT query string
+    if (!_query.exec(_queryString) || !_query.next()) {
+        message = IsCancelled() ? "Statistics cancelled" : "Cannot compute column statistics: " + _query.lastError().text();
+        return false;
+    }
+
+    qint64 _rowCount = _query.value(0).toLongLong();  // Rows in the table
+    for (int _i = 0; _i < Statistics.size(); ++_i) {  // Current column (0-based)
+        int _base = 1 + _i * 5;  // Result index of this column's first aggregate
+        ColumnStatistics &_statistics = Statistics[_i];  // Result being filled
+        _statistics.RowCount = _rowCount;
+        _statistics.NullCount = _rowCount - _query.value(_base).toLongLong();
+        _statistics.MinValue = _query.value(_base + 1);
+        _statistics.MaxValue = _query.value(_base + 2);
+        _statistics.AverageLength = _query.value(_base + 3).toDouble();
+        _statistics.DistinctCount = _query.value(_base + 4).toLongLong();
+        _statistics.DistinctApproximate = true;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Compute most frequent values of one column, and its exact distinct count for small tables
+ * Grouping every row of a huge table needs a temp B-tree as large as the column, so
+ * larger tables keep the HyperLogLog estimate and count top values over a sample.
+ * The sample keeps each row with the same probability, chosen so that about
+ * TOP_VALUE_SAMPLE_ROWS rows remain; unlike the first rows of the table it is not
+ * skewed by insertion order, and it needs no sort of the row ids
+ */
+bool ColumnStatisticsTask::ComputeValueFrequencies(QSqlDatabase &database, ColumnStatistics &statistics, QString &message)
+{
+    if (statistics.NullCount == statistics.RowCount) {
+        statistics.DistinctCount = 0;  // Only NULLs, nothing to group
+        return true;
+    }
+
+    QString _column = SQLWorker::QuoteIdentifier(statistics.ColumnName);  // Quoted column name
+    bool _exact = statistics.RowCount <= EXACT_DISTINCT_ROW_LIMIT;  // Group all rows (true) or a sample (false)
+    QString _queryString;  // Complete grouped query string
+    if (_exact) {
+        // The window count over the groups is the number of distinct values, so one GROUP BY gives both results
+        _queryString = QString("SELECT %1, COUNT(*) AS value_count, COUNT(*) OVER () FROM %2 "
+                               "WHERE %1 IS NOT NULL GROUP BY %1 ORDER BY value_count DESC LIMIT %3")
+                           .arg(_column, SQLWorker::QuoteIdentifier(TableName))
+                           .arg(TOP_VALUE_COUNT);
+    } else {
+        qint64 _sampleStride = (statistics.RowCount + TOP_VALUE_SAMPLE_ROWS - 1) / TOP_VALUE_SAMPLE_ROWS;  // One row in this many is kept
+        _queryString = QString("SELECT %1, COUNT(*) AS value_count FROM %2 WHERE %1 IS NOT NULL AND random() % %3 = 0 "
+                               "GROUP BY %1 ORDER BY value_count DESC LIMIT %4")
+                           .arg(_column, SQLWorker::QuoteIdentifier(TableName))
+                           .arg(_sampleStride)
+                           .arg(TOP_VALUE_COUNT);
+    }
+
+    QSqlQuery _query(database);  // Query object for the grouped query
+    _query.setForwardOnly(true);
+    if (!_query.exec(_queryString)) {
+        message = IsCancelled() ? "Statistics cancelled" : "Cannot count values: " + _query.lastError().text();
+        return false;
+    }
+
+    if (_exact) {
+        statistics.DistinctCount = 0;
+        statistics.DistinctApproximate = false;
+    }
+    statistics.TopValuesSampled = !_exact;
+    while (_query.next()) {  // Most frequent values first
+        statistics.TopValues.append(qMakePair(_query.value(0).toString(), _query.value(1).toLongLong()));
+        if (_exact) {
+            statistics.DistinctCount = _query.value(2).toLongLong();
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef COLUMNSTATISTICSTASK_H
+#define COLUMNSTATISTICSTASK_H
+
+#include <QStringList>
+#include <QVector>
+#include <QPair>
+#include <QVariant>
+#include "databasetask.h"
+
+/**
+ * @brief Summary statistics of one table column
+ */
+struct ColumnStatistics {
+    QString ColumnName;                  // Name of the column
+    qint64 RowCount = 0;                 // Rows in the table
+    qint64 NullCount = 0;                // Rows with NULL in the column
+    QVariant MinValue;                   // Smallest value in SQLite order (invalid if all NULL)
+    QVariant MaxValue;                   // Largest value in SQLite order (invalid if all NULL)
+    qint64 DistinctCount = -1;           // Number of distinct non-NULL values (-1 if not computed)
+    bool DistinctApproximate = false;    // Flag indicating DistinctCount is a HyperLogLog estimate (true) or exact (false)
+    double AverageLength = 0.0;          // Average length of non-NULL values (characters for text, bytes for blobs)
+    QList<QPair<QString, qint64>> TopValues;  // Most frequent non-NULL values with their counts
+    bool TopValuesSampled = false;       // Flag indicating TopValues were counted over a random sample of rows (true) or all rows (false)
+};
+
+/**
+ * @brief Background computation of column statistics for a slice of a table's columns
+ * Several tasks run side by side on their own read connections, each covering
+ * different columns; one aggregate scan yields counts, bounds, lengths and
+ * HyperLogLog distinct estimates for the whole slice, a grouped query per column
+ * adds top values (and exact distinct counts for tables small enough to group fully)
+ */
+class ColumnStatisticsTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for ColumnStatisticsTask
+     * @param filePath Path to the SQL database file containing the table
+     * @param tableName Name of the table to analyze
+     * @param columnNames Columns this task computes statistics for
+     */
+    ColumnStatisticsTask(const QString &filePath, const QString &tableName, const QStringList &columnNames);
+
+    /**
+     * @brief Get the statistics computed by the task (complete once Finished was emitted)
+     * @return QVector with one entry per requested column, in request order
+     */
+    QVector<ColumnStatistics> GetStatistics() const;
+
+protected:
+    /**
+     * @brief Run the aggregate scan and the per-column grouped queries
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    /**
+     * @brief Compute counts, bounds, average lengths and distinct estimates of all columns in one table scan
+     * @return true if the scan succeeded, false otherwise
+     */
+    bool ComputeAggregates(QSqlDatabase &database, QString &message);
+
+    /**
+     * @brief Compute most frequent values of one column, and its exact distinct count for small tables
+     * @return true if the query succeeded, false otherwise
+     */
+    bool ComputeValueFrequencies(QSqlDatabase &database, ColumnStatistics &statistics, QString &message);
+
+    QString TableName;                   // Table being analyzed
+    QVector<ColumnStatistics> Statistics;  // Results per requested column (filled by Run)
+
+    static const int TOP_VALUE_COUNT;    // Most frequent values reported per column
+    static const qint64 EXACT_DISTINCT_ROW_LIMIT;  // Largest table whose columns are grouped in full
+    static const int TOP_VALUE_SAMPLE_ROWS;  // Approximate rows in the random sample for top values of larger tables
+};
+
+#endif // COLUMNSTATISTICSTASK_H
@@ -0,0 +1,165 @@
+#include "compacttask.h"
+#include "sqlworker.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QUuid>
+
+// Define compaction constants
+const int CompactTask::PROGRESS_INTERVAL_MS = 250;
+
+/**
+ * @brief Constructor initializes CompactTask with default values
+ */
+CompactTask::CompactTask(const QString &filePath)
+    : DatabaseTask(filePath)
+    , TargetFilePath("")               // Compacted copy path
+    , ExpectedBytes(0)                 // Progress estimate
+    , ProgressTimer()                  // Progress throttle
+    , TargetReleased(false)            // Copy ownership flag
+{
+}
+
+/**
+ * @brief Destructor cancels a running copy and removes an unused compacted copy
+ * Cancellation interrupts VACUUM INTO, so closing the window does not wait for the whole copy
+ */
+CompactTask::~CompactTask()
+{
+    Stop();
+    if (!TargetReleased && !TargetFilePath.isEmpty()) {
+        QFile::remove(TargetFilePath);
+    }
+}
+
+/**
+ * @brief Get the verified compacted copy produced by the task
+ */
+QString CompactTask::GetCompactedFilePath() const
+{
+    return TargetFilePath;
+}
+
+/**
+ * @brief Mark the compacted copy as consumed so it is not deleted
+ */
+void CompactTask::ReleaseCompactedFile()
+{
+    TargetReleased = true;
+}
+
+/**
+ * @brief Run VACUUM INTO and verify the result
+ * @param database Open connection owned by the task thread
+ * @param message Output summary or error description
+ * @return true if a verified compacted copy was written, false otherwise
+ */
+bool CompactTask::Run(QSqlDatabase &database, QString &message)
+{
+    QElapsedTimer _timer;  // Measures total compaction time
+    _timer.start();
+
+    qint64 _bytesBefore = QFileInfo(FilePath).size();  // Size of the original file
+
+    // Estimate the copy size from the pages actually in use
+    QSqlQuery _query(database);  // Query object for size estimation and VACUUM INTO
+    qint64 _pageSize = 0;        // Size of one database page in bytes
+    qint64 _usedPages = 0;       // Pages in use (page_count - freelist_count)
+    if (_query.exec("SELECT page_size, page_count - freelist_count FROM pragma_page_size, pragma_page_count, pragma_freelist_count")
+        && _query.next()) {
+        _pageSize = _query.value(0).toLongLong();
+        _usedPages = _query.value(1).toLongLong();
+    }
+    ExpectedBytes = qMax<qint64>(_pageSize * _usedPages, 1);
+
+    int _sourceSchemaCount = -1;  // Number of schema objects in the original file
+    if (_query.exec("SELECT COUNT(*) FROM sqlite_master") && _query.next()) {
+        _sourceSchemaCount = _query.value(0).toInt();
+    }
+
+    // Write the copy next to the original so the final rename stays on one file system
+    TargetFilePath = QString("%1.compact-%2.tmp").arg(FilePath, QUuid::createUuid().toString(QUuid::WithoutBraces));
+    ProgressTimer.start();
+    emit ProgressChanged(0, "Compacting database");
+
+    if (!_query.prepare("VACUUM INTO ?")) {
+        message = "Cannot prepare VACUUM INTO: " + _query.lastError().text();
+        return false;
+    }
+    _query.addBindValue(TargetFilePath);
+
+    if (!_query.exec()) {
+        message = IsCancelled() ? "Compaction cancelled" : "VACUUM INTO failed: " + _query.lastError().text();
+        QFile::remove(TargetFilePath);
+        TargetFilePath.clear();
+        return false;
+    }
+    _query.finish();
+
+    emit ProgressChanged(95, "Verifying compacted copy");
+    if (!VerifyCompactedFile(_sourceSchemaCount, message)) {
+        QFile::remove(TargetFilePath);
+        TargetFilePath.clear();
+        return false;
+    }
+
+    qint64 _bytesAfter = QFileInfo(TargetFilePath).size();  // Size of the compacted copy
+    qint64 _elapsedMs = _timer.elapsed();                    // Total compaction time
+
+    emit ProgressChanged(100, "Compaction finished");
+    emit CompactReport(_bytesBefore, _bytesAfter, _elapsedMs);
+
+    message = QString("Compacted %1 KB to %2 KB in %3 ms")
+                  .arg(_bytesBefore / 1024)
+                  .arg(_bytesAfter / 1024)
+                  .arg(_elapsedMs);
+    qDebug() << message;
+    return true;
+}
+
+/**
+ * @brief Report copy progress based on the size of the growing target file
+ */
+void CompactTask::ProgressTick()
+{
+    if (TargetFilePath.isEmpty() || ProgressTimer.elapsed() < PROGRESS_INTERVAL_MS) {
+        return;
+    }
+    ProgressTimer.restart();
+
+    qint64 _writtenBytes = QFileInfo(TargetFilePath).size();  // Bytes written to the copy so far
+    int _percent = static_cast<int>(qMin<qint64>(94, _writtenBytes * 94 / ExpectedBytes));  // Copy phase maps to 0-94%
+    emit ProgressChanged(_percent, QString("Compacting database (%1 KB written)").arg(_writtenBytes / 1024));
+}
+
+/**
+ * @brief Check the compacted copy with quick_check and a schema comparison
+ */
+bool CompactTask::VerifyCompactedFile(int sourceSchemaCount, QString &message)
+{
+    bool _valid = false;  // Verification result
+    QString _connectionName = QString("CompactTask_Verify_%1")
+                                  .arg(QUuid::createUuid().toString(QUuid::WithoutBraces));  // Connection used only for verification
+
+    {
+        QSqlDatabase _copy = SQLWorker::OpenDatabaseConnection(TargetFilePath, _connectionName);  // Connection to the compacted copy
+        QSqlQuery _query(_copy);  // Query object for verification
+
+        if (!_copy.isOpen()) {
+            message = "Cannot open compacted copy for verification";
+        } else if (!_query.exec("PRAGMA quick_check(1)") || !_query.next()
+                   || _query.value(0).toString() != "ok") {
+            message = "Compacted copy failed quick_check";
+        } else if (!_query.exec("SELECT COUNT(*) FROM sqlite_master") || !_query.next()
+                   || _query.value(0).toInt() != sourceSchemaCount) {
+            message = "Compacted copy schema does not match the original";
+        } else {
+            _valid = true;
+        }
+
+        _query.finish();
+        _copy.close();
+    }
+    QSqlDatabase::removeDatabase(_connectionName);
+
+    return _valid;
+}
@@ -0,0 +1,75 @@
+#ifndef COMPACTTASK_H
+#define COMPACTTASK_H
+
+#include <QElapsedTimer>
+#include "databasetask.h"
+
+/**
+ * @brief Background compaction of a database file with VACUUM INTO
+ * Writes a compacted copy next to the original and verifies it; the caller
+ * swaps it in with SQLWorker::ReplaceDatabaseFile once no connection uses the file
+ */
+class CompactTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for CompactTask
+     * @param filePath Path to the SQL database file to compact
+     */
+    explicit CompactTask(const QString &filePath);
+
+    /**
+     * @brief Destructor cancels a running copy, waits for it and removes the copy unless it was swapped in
+     */
+    ~CompactTask() override;
+
+    /**
+     * @brief Get the verified compacted copy produced by the task
+     * @return Path to the compacted file (empty if compaction failed)
+     */
+    QString GetCompactedFilePath() const;
+
+    /**
+     * @brief Mark the compacted copy as consumed so it is not deleted
+     */
+    void ReleaseCompactedFile();
+
+signals:
+    /**
+     * @brief Emitted with the compaction results before Finished
+     * @param bytesBefore Size of the original file in bytes
+     * @param bytesAfter Size of the compacted copy in bytes
+     * @param elapsedMs Time spent copying and verifying in milliseconds
+     */
+    void CompactReport(qint64 bytesBefore, qint64 bytesAfter, qint64 elapsedMs);
+
+protected:
+    /**
+     * @brief Run VACUUM INTO and verify the result
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+    /**
+     * @brief Report copy progress based on the size of the growing target file
+     */
+    void ProgressTick() override;
+
+private:
+    /**
+     * @brief Check the compacted copy with quick_check and a schema comparison
+     * @param sourceSchemaCount Number of schema objects in the original file
+     * @return true if the copy is valid, false otherwise
+     */
+    bool VerifyCompactedFile(int sourceSchemaCount, QString &message);
+
+    QString TargetFilePath;              // Path to the compacted copy (empty until the task runs)
+    qint64 ExpectedBytes;                // Estimated size of the compacted copy used for progress
+    QElapsedTimer ProgressTimer;         // Throttles progress reports from the SQLite callback
+    bool TargetReleased;                 // Flag indicating the caller took ownership of the copy (true) or not (false)
+
+    static const int PROGRESS_INTERVAL_MS;    // Minimum time between two progress reports
+};
+
+#endif // COMPACTTASK_H
@@ -0,0 +1,379 @@
+#include "compressingdevice.h"
+#include <QMutexLocker>
+#include <QDebug>
+#include <cstring>
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// Define compressing device constants
+const int CompressingDevice::CHUNK_SIZE = 1 << 20;
+const int CompressingDevice::QUEUE_MAX_CHUNKS = 8;
+const int CompressingDevice::GZIP_LEVEL = 6;
+const int CompressingDevice::ZSTD_LEVEL = 3;
+
+/**
+ * @brief Constructor initializes CompressingDevice for a file
+ */
+CompressingDevice::CompressingDevice(const QString &filePath, Codec codec)
+    : QIODevice()
+    , File(filePath)                   // Output file
+    , FileCodec(codec)                 // Compression format
+    , Chunk()                          // Empty chunk
+    , Output()                         // Compressed bytes
+    , Queue()                          // No chunks queued
+    , InputEnded(false)                // Input open
+    , DropInput(false)                 // Chunks are compressed
+    , PipelineError()                  // No error
+    , Failed(false)                    // No failure
+    , PipelineThread(nullptr)          // Started by open
+    , GzipStream(nullptr)              // Created by open
+    , ZstdContext(nullptr)             // Created by open
+{
+}
+
+/**
+ * @brief Destructor finishes the file if it is still open
+ */
+CompressingDevice::~CompressingDevice()
+{
+    if (isOpen()) {
+        Finish();
+    }
+    FreeStreams();
+}
+
+/**
+ * @brief Open the file and start the pipeline thread
+ */
+bool CompressingDevice::open(OpenMode mode)
+{
+    if (isOpen() || (mode & ReadOnly) || !(mode & WriteOnly)) {
+        setErrorString("Compressed files can only be opened once for writing");
+        return false;
+    }
+    if (!IsAvailable(FileCodec)) {
+        setErrorString("Compression format not available in this build");
+        return false;
+    }
+    if (!File.open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+        setErrorString(File.errorString());
+        return false;
+    }
+
+    if (FileCodec == Codec::Gzip) {
+        // windowBits 15 + 16 writes a gzip header and trailer around the deflate stream
+        GzipStream = new z_stream;
+        std::memset(GzipStream, 0, sizeof(z_stream));
+        if (deflateInit2(GzipStream, GZIP_LEVEL, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            delete GzipStream;
+            GzipStream = nullptr;
+            setErrorString("Cannot initialize gzip compression");
+            File.remove();
+            return false;
+        }
+    }
+#ifdef HAVE_ZSTD
+    if (FileCodec == Codec::Zstd) {
+        ZstdContext = ZSTD_createCCtx();
+        if (!ZstdContext || ZSTD_isError(ZSTD_CCtx_setParameter(ZstdContext, ZSTD_c_compressionLevel, ZSTD_LEVEL))
+            || ZSTD_isError(ZSTD_CCtx_setParameter(ZstdContext, ZSTD_c_checksumFlag, 1))) {
+            FreeStreams();
+            setErrorString("Cannot initialize zstd compression");
+            File.remove();
+            return false;
+        }
+    }
+#endif
+
+    Chunk.reserve(CHUNK_SIZE);
+    InputEnded = false;
+    DropInput = false;
+    PipelineError.clear();
+    Failed = false;
+    PipelineThread = QThread::create([this]() { RunPipeline(); });
+    PipelineThread->start();
+    return QIODevice::open(mode | Unbuffered);
+}
+
+/**
+ * @brief Finish the file like Finish, ignoring the result
+ */
+void CompressingDevice::close()
+{
+    if (isOpen()) {
+        Finish();
+    }
+}
+
+/**
+ * @brief The device is a stream without positions
+ */
+bool CompressingDevice::isSequential() const
+{
+    return true;
+}
+
+/**
+ * @brief Compress the remaining chunks, end the compressed stream and close the file
+ */
+bool CompressingDevice::Finish()
+{
+    if (!isOpen()) {
+        return !Failed;
+    }
+
+    if (!Chunk.isEmpty()) {
+        QueueChunk();
+    }
+    StopPipeline(true);
+    QIODevice::close();
+    File.close();
+
+    if (Failed) {
+        setErrorString(PipelineError);
+        qDebug() << "Error: Failed to write compressed file" << File.fileName() << ":" << PipelineError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stop the pipeline without finishing the stream and delete the file
+ */
+void CompressingDevice::Remove()
+{
+    if (isOpen()) {
+        StopPipeline(false);
+        QIODevice::close();
+    }
+    File.remove();
+}
+
+/**
+ * @brief Get the file name suffix of a codec
+ */
+QString CompressingDevice::GetFileSuffix(Codec codec)
+{
+    switch (codec) {
+    case Codec::Gzip:
+        return ".gz";
+    case Codec::Zstd:
+        return ".zst";
+    case Codec::None:
+        break;
+    }
+    return QString();
+}
+
+/**
+ * @brief Check if a codec is built in
+ */
+bool CompressingDevice::IsAvailable(Codec codec)
+{
+#ifdef HAVE_ZSTD
+    Q_UNUSED(codec);
+    return true;
+#else
+    return codec != Codec::Zstd;
+#endif
+}
+
+/**
+ * @brief Reading is not supported
+ */
+qint64 CompressingDevice::readData(char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+/**
+ * @brief Append bytes to the current chunk, queueing it once full
+ * Large writes are split so every queued chunk holds at most CHUNK_SIZE bytes
+ */
+qint64 CompressingDevice::writeData(const char *data, qint64 length)
+{
+    qint64 _written = 0;  // Bytes accepted so far
+    while (_written < length) {
+        if (Failed) {
+            setErrorString(PipelineError);
+            return -1;
+        }
+        int _take = static_cast<int>(qMin<qint64>(length - _written, CHUNK_SIZE - Chunk.size()));  // Bytes fitting the chunk
+        Chunk.append(data + _written, _take);
+        _written += _take;
+        if (Chunk.size() >= CHUNK_SIZE && !QueueChunk()) {
+            setErrorString(PipelineError);
+            return -1;
+        }
+    }
+    return _written;
+}
+
+/**
+ * @brief Queue the current chunk, waiting while the queue is full
+ */
+bool CompressingDevice::QueueChunk()
+{
+    QMutexLocker _locker(&Mutex);  // Held while the queue is changed
+    while (Queue.size() >= QUEUE_MAX_CHUNKS && !Failed) {
+        QueueNotFull.wait(&Mutex);
+    }
+    if (Failed) {
+        Chunk.resize(0);
+        return false;
+    }
+
+    Queue.enqueue(Chunk);
+    QueueNotEmpty.wakeOne();
+    _locker.unlock();
+
+    // The queued copy keeps the bytes; a fresh buffer avoids detaching it again
+    Chunk = QByteArray();
+    Chunk.reserve(CHUNK_SIZE);
+    return true;
+}
+
+/**
+ * @brief Stop the pipeline thread after the queued chunks
+ */
+void CompressingDevice::StopPipeline(bool finishStream)
+{
+    {
+        QMutexLocker _locker(&Mutex);  // Held while the input is ended
+        InputEnded = true;
+        DropInput = !finishStream;
+        QueueNotEmpty.wakeOne();
+    }
+    if (PipelineThread) {
+        PipelineThread->wait();
+        delete PipelineThread;
+        PipelineThread = nullptr;
+    }
+    Chunk = QByteArray();
+    FreeStreams();
+}
+
+/**
+ * @brief Pipeline thread body: compress queued chunks until the input ends
+ */
+void CompressingDevice::RunPipeline()
+{
+    while (true) {
+        QByteArray _chunk;  // Next chunk to compress
+        bool _last = false;  // Input ended after this chunk
+        {
+            QMutexLocker _locker(&Mutex);  // Held while the queue is read
+            while (Queue.isEmpty() && !InputEnded) {
+                QueueNotEmpty.wait(&Mutex);
+            }
+            if (DropInput) {
+                Queue.clear();
+                QueueNotFull.wakeAll();
+                return;
+            }
+            if (!Queue.isEmpty()) {
+                _chunk = Queue.dequeue();
+                QueueNotFull.wakeOne();
+            }
+            _last = Queue.isEmpty() && InputEnded;
+        }
+
+        // A failure has already woken the writers, which stop queueing once they see it
+        if (!CompressChunk(_chunk, _last) || _last) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Compress one chunk and write the output
+ */
+bool CompressingDevice::CompressChunk(const QByteArray &chunk, bool last)
+{
+    if (FileCodec == Codec::Gzip) {
+        GzipStream->next_in = reinterpret_cast<Bytef *>(const_cast<char *>(chunk.constData()));
+        GzipStream->avail_in = static_cast<uInt>(chunk.size());
+        const int _flush = last ? Z_FINISH : Z_NO_FLUSH;  // Z_FINISH writes the trailer
+        int _result = Z_OK;  // Result of the last deflate call
+        do {
+            Output.resize(CHUNK_SIZE);
+            GzipStream->next_out = reinterpret_cast<Bytef *>(Output.data());
+            GzipStream->avail_out = static_cast<uInt>(Output.size());
+            _result = deflate(GzipStream, _flush);
+            if (_result == Z_STREAM_ERROR) {
+                SetFailed("gzip compression failed");
+                return false;
+            }
+            Output.resize(Output.size() - static_cast<int>(GzipStream->avail_out));
+            if (!Output.isEmpty() && File.write(Output) != Output.size()) {
+                SetFailed(File.errorString());
+                return false;
+            }
+        } while (GzipStream->avail_out == 0 || (last && _result != Z_STREAM_END));
+        return true;
+    }
+
+#ifdef HAVE_ZSTD
+    if (FileCodec == Codec::Zstd) {
+        ZSTD_inBuffer _input = {chunk.constData(), static_cast<size_t>(chunk.size()), 0};  // Chunk being consumed
+        const ZSTD_EndDirective _mode = last ? ZSTD_e_end : ZSTD_e_continue;  // ZSTD_e_end closes the frame
+        size_t _remaining = 0;  // Bytes still buffered in the context (ZSTD_e_end only)
+        Output.resize(static_cast<int>(ZSTD_CStreamOutSize()));
+        do {
+            ZSTD_outBuffer _output = {Output.data(), static_cast<size_t>(Output.size()), 0};  // Compressed bytes of this call
+            _remaining = ZSTD_compressStream2(ZstdContext, &_output, &_input, _mode);
+            if (ZSTD_isError(_remaining)) {
+                SetFailed(QString("zstd compression failed: %1").arg(ZSTD_getErrorName(_remaining)));
+                return false;
+            }
+            if (_output.pos > 0 && File.write(Output.constData(), static_cast<qint64>(_output.pos)) != static_cast<qint64>(_output.pos)) {
+                SetFailed(File.errorString());
+                return false;
+            }
+        } while (last ? _remaining != 0 : _input.pos < _input.size);
+        return true;
+    }
+#endif
+
+    if (!chunk.isEmpty() && File.write(chunk) != chunk.size()) {
+        SetFailed(File.errorString());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Record the first pipeline error and wake waiting writers
+ */
+void CompressingDevice::SetFailed(const QString &message)
+{
+    QMutexLocker _locker(&Mutex);  // Held while the error is recorded
+    if (!Failed) {
+        PipelineError = message;
+        Failed = true;
+    }
+    Queue.clear();
+    QueueNotFull.wakeAll();
+}
+
+/**
+ * @brief Release the compression streams
+ */
+void CompressingDevice::FreeStreams()
+{
+    if (GzipStream) {
+        deflateEnd(GzipStream);
+        delete GzipStream;
+        GzipStream = nullptr;
+    }
+#ifdef HAVE_ZSTD
+    if (ZstdContext) {
+        ZSTD_freeCCtx(ZstdContext);
+        ZstdContext = nullptr;
+    }
+#endif
+}
@@ -0,0 +1,162 @@
+#ifndef COMPRESSINGDEVICE_H
+#define COMPRESSINGDEVICE_H
+
+#include <QIODevice>
+#include <QFile>
+#include <QByteArray>
+#include <QQueue>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+#include <atomic>
+
+struct z_stream_s;
+struct ZSTD_CCtx_s;
+
+/**
+ * @brief Write-only device compressing everything written to it into a file
+ * Writes are collected into CHUNK_SIZE chunks that go through a queue of at most
+ * QUEUE_MAX_CHUNKS to a pipeline thread, which compresses them and writes the result.
+ * Formatting on the writing thread and compression overlap, memory stays bounded when
+ * the disk or the compressor is slower, and the file only ever receives compressed bytes
+ */
+class CompressingDevice : public QIODevice
+{
+public:
+    /**
+     * @brief Compression format of the file
+     */
+    enum class Codec {
+        None,  // Chunks are written as they are (still on the pipeline thread)
+        Gzip,  // gzip stream (RFC 1952)
+        Zstd   // Zstandard frame (only if built with libzstd)
+    };
+
+    /**
+     * @brief Constructor for CompressingDevice
+     * @param filePath Path of the file to write
+     * @param codec Compression format
+     */
+    CompressingDevice(const QString &filePath, Codec codec);
+
+    /**
+     * @brief Destructor finishes the file if it is still open
+     */
+    ~CompressingDevice() override;
+
+    /**
+     * @brief Open the file and start the pipeline thread
+     * @param mode Must be WriteOnly
+     * @return true if the file is open, false otherwise
+     */
+    bool open(OpenMode mode) override;
+
+    /**
+     * @brief Finish the file like Finish, ignoring the result
+     */
+    void close() override;
+
+    /**
+     * @brief The device is a stream without positions
+     * @return true always
+     */
+    bool isSequential() const override;
+
+    /**
+     * @brief Compress the remaining chunks, end the compressed stream and close the file
+     * @return true if every byte written reached the file, false otherwise (see errorString)
+     */
+    bool Finish();
+
+    /**
+     * @brief Stop the pipeline without finishing the stream and delete the file
+     * For failed or cancelled exports, which must not leave a partial file behind
+     */
+    void Remove();
+
+    /**
+     * @brief Get the file name suffix of a codec
+     * @param codec Compression format
+     * @return ".gz", ".zst" or an empty string
+     */
+    static QString GetFileSuffix(Codec codec);
+
+    /**
+     * @brief Check if a codec is built in
+     * @param codec Compression format
+     * @return true if files can be written with it, false otherwise
+     */
+    static bool IsAvailable(Codec codec);
+
+    static const int CHUNK_SIZE;         // Bytes collected before a chunk is queued
+    static const int QUEUE_MAX_CHUNKS;   // Chunks queued before writers wait for the pipeline
+    static const int GZIP_LEVEL;         // zlib compression level
+    static const int ZSTD_LEVEL;         // Zstandard compression level
+
+protected:
+    /**
+     * @brief Reading is not supported
+     * @return -1 always
+     */
+    qint64 readData(char *data, qint64 maxSize) override;
+
+    /**
+     * @brief Append bytes to the current chunk, queueing it once full
+     * @return Number of bytes accepted, -1 after the pipeline failed
+     */
+    qint64 writeData(const char *data, qint64 length) override;
+
+private:
+    /**
+     * @brief Queue the current chunk, waiting while the queue is full
+     * @return true if queued, false after the pipeline failed
+     */
+    bool QueueChunk();
+
+    /**
+     * @brief Stop the pipeline thread after the queued chunks
+     * @param finishStream true to end the compressed stream, false to drop the queued chunks
+     */
+    void StopPipeline(bool finishStream);
+
+    /**
+     * @brief Pipeline thread body: compress queued chunks until the input ends
+     */
+    void RunPipeline();
+
+    /**
+     * @brief Compress one chunk and write the output
+     * @param chunk Input bytes
+     * @param last true for the final call, which ends the compressed stream
+     * @return true if written, false otherwise
+     */
+    bool CompressChunk(const QByteArray &chunk, bool last);
+
+    /**
+     * @brief Record the first pipeline error and wake waiting writers
+     */
+    void SetFailed(const QString &message);
+
+    /**
+     * @brief Release the compression streams
+     */
+    void FreeStreams();
+
+    QFile File;                          // Output file
+    Codec FileCodec;                     // Compression format
+    QByteArray Chunk;                    // Bytes of the chunk being filled by writers
+    QByteArray Output;                   // Compressed bytes of one chunk (pipeline thread only)
+    QQueue<QByteArray> Queue;            // Chunks waiting for the pipeline
+    QMutex Mutex;                        // Guards Queue, InputEnded, DropInput and PipelineError
+    QWaitCondition QueueNotEmpty;        // Signalled when a chunk is queued or the input ends
+    QWaitCondition QueueNotFull;         // Signalled when a chunk is taken or the pipeline fails
+    bool InputEnded;                     // Flag indicating no more chunks will be queued
+    bool DropInput;                      // Flag indicating queued chunks are discarded (true) or compressed (false)
+    QString PipelineError;               // First error of the pipeline (empty if none)
+    std::atomic<bool> Failed;            // Flag indicating the pipeline failed (true) or not (false)
+    QThread *PipelineThread;             // Thread compressing and writing chunks (nullptr until opened)
+    z_stream_s *GzipStream;              // zlib stream state (Gzip only)
+    ZSTD_CCtx_s *ZstdContext;            // Zstandard context (Zstd only)
+};
+
+#endif // COMPRESSINGDEVICE_H
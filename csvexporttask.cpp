@@ -0,0 +1,315 @@
+#include "csvexporttask.h"
+#include "csvwriter.h"
+#include "sqlworker.h"
+#include <QSqlRecord>
+
+// Define CSV export constants
+const int CsvExportTask::PROGRESS_INTERVAL_ROWS = 100000;
+const int ParallelCsvExportTask::MAX_PARALLEL_TASKS = 8;
+const int ParallelCsvExportTask::COPY_BLOCK_SIZE = 4 << 20;
+const unsigned long ParallelCsvExportTask::POLL_INTERVAL_MS = 100;
+const unsigned long ParallelCsvExportTask::CURSOR_POLL_MS = 5;
+
+/**
+ * @brief Constructor initializes CsvExportTask with the query and the output file
+ */
+CsvExportTask::CsvExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                             const QString &outputPath, bool writeHeader, CompressingDevice::Codec codec)
+    : DatabaseTask(filePath)
+    , QueryString(queryString)         // Exported rows
+    , BindValues(bindValues)           // Placeholder values
+    , OutputPath(outputPath)           // CSV file
+    , WriteHeader(writeHeader)         // Header flag
+    , Codec(codec)                     // File compression
+    , RowCount(0)                      // No row written
+    , Complete(false)                  // File not written yet
+    , CursorOpened(false)              // Query not started
+{
+}
+
+/**
+ * @brief Get the number of rows written so far
+ */
+qint64 CsvExportTask::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Check if the task wrote its complete file
+ */
+bool CsvExportTask::IsComplete() const
+{
+    return Complete;
+}
+
+/**
+ * @brief Check if the query has started reading
+ */
+bool CsvExportTask::HasOpenedCursor() const
+{
+    return CursorOpened;
+}
+
+/**
+ * @brief Run the query and write its rows
+ * @param database Open connection owned by the task thread
+ * @param message Output summary or error description
+ * @return true if every row was written, false otherwise
+ */
+bool CsvExportTask::Run(QSqlDatabase &database, QString &message)
+{
+    // A searched view reads its row ids from the index file, which this connection must attach itself
+    if (!SQLWorker::AttachSearchIndexFile(database, FilePath)) {
+        message = "Cannot open search index file of " + FilePath;
+        return false;
+    }
+
+    QSqlQuery _query(database);  // Forward-only cursor over the exported rows
+    _query.setForwardOnly(true);
+    if (!_query.prepare(QueryString)) {
+        message = "Cannot prepare export query: " + _query.lastError().text();
+        return false;
+    }
+    for (int _i = 0; _i < BindValues.size(); ++_i) {
+        _query.bindValue(_i, BindValues[_i]);
+    }
+    if (!_query.exec()) {
+        message = "Export query failed: " + _query.lastError().text();
+        return false;
+    }
+    CursorOpened = true;  // exec steps to the first row, which starts the read transaction
+
+    // Rows are formatted on this thread while the device compresses and writes on its pipeline thread
+    CompressingDevice _file(OutputPath, Codec);  // Output file
+    if (!_file.open(QIODevice::WriteOnly)) {
+        message = QString("Cannot open %1: %2").arg(OutputPath, _file.errorString());
+        return false;
+    }
+
+    bool _written = false;  // Every row reached the file
+    {
+        CsvWriter _writer(&_file);  // Encoder writing fields straight into the file
+        const int _columnCount = _query.record().count();  // Values per row
+        if (WriteHeader) {
+            _writer.WriteBom();
+            for (int _col = 0; _col < _columnCount; ++_col) {
+                _writer.WriteText(_query.record().fieldName(_col));
+            }
+            _writer.EndRow();
+        }
+
+        while (_query.next() && !_writer.HasError()) {
+            for (int _col = 0; _col < _columnCount; ++_col) {
+                _writer.WriteValue(_query.value(_col));
+            }
+            _writer.EndRow();
+
+            if (++RowCount % PROGRESS_INTERVAL_ROWS == 0) {
+                emit ProgressChanged(-1, QString("%1 rows written").arg(RowCount.load()));
+            }
+        }
+
+        if (IsCancelled()) {
+            message = "Export cancelled";
+        } else if (_query.lastError().isValid()) {
+            message = "Export query failed: " + _query.lastError().text();
+        } else if (!_writer.Flush()) {
+            message = QString("Cannot write %1: %2").arg(OutputPath, _file.errorString());
+        } else {
+            _written = true;
+        }
+    }
+
+    if (_written && !_file.Finish()) {
+        message = QString("Cannot write %1: %2").arg(OutputPath, _file.errorString());
+        _written = false;
+    }
+
+    // A partial file must not be mistaken for a complete export
+    if (!_written) {
+        _file.Remove();
+        return false;
+    }
+
+    Complete = true;
+    message = QString("%1 rows written to %2").arg(RowCount.load()).arg(OutputPath);
+    return true;
+}
+
+/**
+ * @brief Constructor initializes ParallelCsvExportTask with the range query and the output file
+ */
+ParallelCsvExportTask::ParallelCsvExportTask(const QString &filePath, const QString &tableName, const QString &rangeQueryString,
+                                             const QVariantList &bindValues, const QString &outputPath,
+                                             CompressingDevice::Codec codec)
+    : DatabaseTask(filePath)
+    , TableName(tableName)             // Exported table
+    , RangeQueryString(rangeQueryString)  // Ranged statement
+    , BindValues(bindValues)           // View placeholder values
+    , OutputPath(outputPath)           // CSV file
+    , Codec(codec)                     // File compression
+    , RowCount(0)                      // No row written
+{
+}
+
+/**
+ * @brief Get the number of rows written by all ranges so far
+ */
+qint64 ParallelCsvExportTask::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Split the rowid span, export the ranges in parallel and join the parts
+ * The span comes from min/max(rowid), two b-tree seeks; gaps in the row ids can make
+ * ranges uneven, which costs balance but never order.
+ * Each range reads on its own connection, so without care a commit between two range
+ * starts would mix versions of the file. An empty write transaction (BEGIN IMMEDIATE)
+ * keeps other writers out while the span is read and every range opens its cursor;
+ * readers are not blocked by it, and a save waits for it within the busy timeout
+ */
+bool ParallelCsvExportTask::Run(QSqlDatabase &database, QString &message)
+{
+    QSqlQuery _query(database);  // Query object for the rowid span and the write lock
+    bool _pinned = _query.exec("BEGIN IMMEDIATE");  // Commits are held off until the ranges read
+    if (!_pinned) {
+        // A file that cannot be locked (e.g. read-only) is still exported consistently in one range
+        qDebug() << "Error: Cannot lock" << FilePath << "for a parallel export:" << _query.lastError().text();
+    }
+
+    if (!_query.exec(QString("SELECT min(rowid), max(rowid) FROM %1").arg(SQLWorker::QuoteIdentifier(TableName))) || !_query.next()) {
+        message = "Cannot read the row ids of " + TableName + ": " + _query.lastError().text();
+        if (_pinned) {
+            _query.exec("ROLLBACK");
+        }
+        return false;
+    }
+
+    // An empty table still gets a file with the header row
+    qint64 _firstRowId = _query.value(0).isNull() ? 0 : _query.value(0).toLongLong();  // Smallest row id
+    qint64 _lastRowId = _query.value(1).isNull() ? -1 : _query.value(1).toLongLong();  // Largest row id
+    _query.finish();
+
+    // The offset of the last row id stays below 2^64 even when the row ids span the whole
+    // 64-bit range, where their count would wrap to 0
+    quint64 _lastOffset = _lastRowId >= _firstRowId ? static_cast<quint64>(_lastRowId) - static_cast<quint64>(_firstRowId) : 0;  // Last row id relative to the first
+    int _partCount = qBound(1, QThread::idealThreadCount(), MAX_PARALLEL_TASKS);  // One range per core
+    quint64 _step = _lastOffset / static_cast<quint64>(_partCount) + 1;  // Row ids per range
+    _partCount = static_cast<int>(_lastOffset / _step) + 1;  // Ranges that start within the span (at least 1)
+    if (!_pinned) {
+        _partCount = 1;  // The only range ends at the last row id
+    }
+
+    QList<CsvExportTask *> _parts;  // Range exports in rowid order
+    QStringList _partPaths;         // Files of the ranges (the first is the output itself)
+    for (int _i = 0; _i < _partCount; ++_i) {
+        qint64 _rangeFirst = static_cast<qint64>(static_cast<quint64>(_firstRowId) + _i * _step);  // First row id of the range
+        qint64 _rangeLast = (_i == _partCount - 1) ? _lastRowId
+                                                   : static_cast<qint64>(static_cast<quint64>(_rangeFirst) + _step - 1);  // Last row id of the range
+        QVariantList _bindValues = BindValues;  // View values followed by the range
+        _bindValues << _rangeFirst << _rangeLast;
+
+        QString _partPath = _i == 0 ? OutputPath : QString("%1.part%2").arg(OutputPath).arg(_i);  // File of this range
+        _partPaths.append(_partPath);
+        _parts.append(new CsvExportTask(FilePath, RangeQueryString, _bindValues, _partPath, _i == 0, Codec));
+    }
+
+    emit ProgressChanged(-1, QString("Exporting %1 on %2 connection(s)").arg(TableName).arg(_partCount));
+    for (CsvExportTask *_part : _parts) {
+        _part->Start();
+    }
+
+    // Once every range reads (or has already finished), commits can no longer split the export
+    if (_pinned) {
+        for (CsvExportTask *_part : _parts) {
+            while (!_part->HasOpenedCursor() && !_part->Wait(CURSOR_POLL_MS)) {
+            }
+        }
+        _query.exec("ROLLBACK");
+    }
+
+    // Wait for the ranges, passing cancellation on and reporting the combined row count
+    for (CsvExportTask *_part : _parts) {
+        while (!_part->Wait(POLL_INTERVAL_MS)) {
+            if (IsCancelled()) {
+                for (CsvExportTask *_other : _parts) {
+                    _other->Cancel();
+                }
+            }
+
+            qint64 _rowCount = 0;  // Rows written by all ranges
+            for (CsvExportTask *_other : _parts) {
+                _rowCount += _other->GetRowCount();
+            }
+            RowCount = _rowCount;
+            emit ProgressChanged(-1, QString("%1 rows written").arg(_rowCount));
+        }
+    }
+
+    bool _allComplete = !IsCancelled();  // Every range written
+    qint64 _totalRows = 0;  // Rows in the output
+    for (CsvExportTask *_part : _parts) {
+        _allComplete = _allComplete && _part->IsComplete();
+        _totalRows += _part->GetRowCount();
+    }
+    RowCount = _totalRows;
+    qDeleteAll(_parts);
+    _parts.clear();
+
+    if (_allComplete) {
+        QFile _output(OutputPath);
+        if (!_output.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            message = QString("Cannot open %1: %2").arg(OutputPath, _output.errorString());
+            _allComplete = false;
+        }
+        for (int _i = 1; _allComplete && _i < _partPaths.size(); ++_i) {
+            emit ProgressChanged(-1, QString("Joining part %1 of %2").arg(_i + 1).arg(_partPaths.size()));
+            _allComplete = AppendPart(_output, _partPaths[_i]);
+            if (!_allComplete) {
+                message = IsCancelled() ? "Export cancelled" : QString("Cannot join %1 into %2").arg(_partPaths[_i], OutputPath);
+            }
+        }
+    } else if (message.isEmpty()) {
+        message = IsCancelled() ? "Export cancelled" : "Export of a row range failed";
+    }
+
+    // Leftover parts and a partial output must not stay next to the exports
+    for (int _i = 1; _i < _partPaths.size(); ++_i) {
+        QFile::remove(_partPaths[_i]);
+    }
+    if (!_allComplete) {
+        QFile::remove(OutputPath);
+        return false;
+    }
+
+    message = QString("%1 rows of %2 written to %3").arg(_totalRows).arg(TableName, OutputPath);
+    return true;
+}
+
+/**
+ * @brief Append a part file to the output and remove it
+ */
+bool ParallelCsvExportTask::AppendPart(QFile &output, const QString &partPath)
+{
+    QFile _part(partPath);
+    if (!_part.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QByteArray _block;  // Bytes of the part being copied
+    while (!_part.atEnd()) {
+        if (IsCancelled()) {
+            return false;
+        }
+        _block = _part.read(COPY_BLOCK_SIZE);
+        if (_block.isEmpty() || output.write(_block) != _block.size()) {
+            return false;
+        }
+    }
+
+    _part.close();
+    _part.remove();
+    return true;
+}
@@ -0,0 +1,135 @@
+#ifndef CSVEXPORTTASK_H
+#define CSVEXPORTTASK_H
+
+#include <QStringList>
+#include <QFile>
+#include <QVariantList>
+#include <atomic>
+#include "databasetask.h"
+#include "compressingdevice.h"
+
+/**
+ * @brief Background export of the rows of one query to a CSV file
+ * Rows are stepped on the task's own connection and encoded by a CsvWriter
+ */
+class CsvExportTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for CsvExportTask
+     * @param filePath Path to the SQL database file to read
+     * @param queryString SELECT statement returning the exported rows
+     * @param bindValues Values for the placeholders of the statement in order
+     * @param outputPath Path of the CSV file to write
+     * @param writeHeader true to start the file with the byte order mark and a header row
+     * @param codec Compression of the file
+     */
+    CsvExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                  const QString &outputPath, bool writeHeader, CompressingDevice::Codec codec);
+
+    /**
+     * @brief Get the number of rows written so far (safe to call while running)
+     * @return Rows written
+     */
+    qint64 GetRowCount() const;
+
+    /**
+     * @brief Check if the task wrote its complete file (safe to call while running)
+     * @return true once every row was written and flushed, false before or after a failure
+     */
+    bool IsComplete() const;
+
+    /**
+     * @brief Check if the query has started reading (safe to call while running)
+     * From then on the task reads one fixed version of the file, whatever commits follow
+     * @return true once the first row was stepped, false before
+     */
+    bool HasOpenedCursor() const;
+
+protected:
+    /**
+     * @brief Run the query and write its rows
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if every row was written, false otherwise
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    QString QueryString;                 // SELECT statement of the exported rows
+    QVariantList BindValues;             // Placeholder values of the statement
+    QString OutputPath;                  // CSV file written by the task
+    bool WriteHeader;                    // Flag indicating the file starts with BOM and header (true) or rows only (false)
+    CompressingDevice::Codec Codec;      // Compression of the file
+    std::atomic<qint64> RowCount;        // Rows written so far
+    std::atomic<bool> Complete;          // Flag indicating the file was written completely (true) or not yet (false)
+    std::atomic<bool> CursorOpened;      // Flag indicating the read transaction of the query has started (true) or not yet (false)
+
+    static const int PROGRESS_INTERVAL_ROWS;  // Rows between progress reports
+};
+
+/**
+ * @brief Background CSV export of a table split into rowid ranges on several connections
+ * Each range is formatted by its own CsvExportTask into a part file; the parts are
+ * appended to the first one in range order, which keeps the rowid order of the view.
+ * The ranges open their cursors while this task holds off commits with a write lock,
+ * so every range reads the same version of the file.
+ * Compressed parts are joined the same way, as gzip members or zstd frames in sequence
+ * decompress to the concatenation of their contents
+ */
+class ParallelCsvExportTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for ParallelCsvExportTask
+     * @param filePath Path to the SQL database file to read
+     * @param tableName Name of the exported table
+     * @param rangeQueryString SELECT statement from SQLWorker::BuildTableRangeQuery
+     * @param bindValues Values for the view placeholders of the statement
+     * @param outputPath Path of the CSV file to write
+     * @param codec Compression of the file
+     */
+    ParallelCsvExportTask(const QString &filePath, const QString &tableName, const QString &rangeQueryString,
+                          const QVariantList &bindValues, const QString &outputPath, CompressingDevice::Codec codec);
+
+    /**
+     * @brief Get the number of rows written by all ranges so far (safe to call while running)
+     * @return Rows written
+     */
+    qint64 GetRowCount() const;
+
+    static const int MAX_PARALLEL_TASKS;  // Upper bound of concurrent read connections
+
+protected:
+    /**
+     * @brief Split the rowid span, export the ranges in parallel and join the parts
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if the complete file was written, false otherwise
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    /**
+     * @brief Append a part file to the output and remove it
+     * @return true if every byte was copied, false otherwise
+     */
+    bool AppendPart(QFile &output, const QString &partPath);
+
+    QString TableName;                   // Exported table
+    QString RangeQueryString;            // Statement selecting one rowid range in rowid order
+    QVariantList BindValues;             // View placeholder values (range values follow)
+    QString OutputPath;                  // CSV file written by the export
+    CompressingDevice::Codec Codec;      // Compression of the file and its parts
+    std::atomic<qint64> RowCount;        // Rows written by all ranges so far
+
+    static const int COPY_BLOCK_SIZE;    // Bytes copied per read when joining parts
+    static const unsigned long POLL_INTERVAL_MS;  // Time between progress and cancellation checks
+    static const unsigned long CURSOR_POLL_MS;    // Time between checks whether the ranges have opened their cursors
+};
+
+#endif // CSVEXPORTTASK_H
@@ -0,0 +1,277 @@
+#include "csvwriter.h"
+#include <QLocale>
+#include <QDebug>
+#include <QtAlgorithms>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Define CSV writer constants
+const int CsvWriter::BUFFER_SIZE = 1 << 20;
+
+/**
+ * @brief Constructor initializes CsvWriter with an empty buffer
+ */
+CsvWriter::CsvWriter(QIODevice *device)
+    : Device(device)                   // Output device
+    , Buffer()                         // Encoded bytes
+    , RowStarted(false)                // No field in the first row yet
+    , Failed(false)                    // No write failed
+{
+    Buffer.reserve(BUFFER_SIZE + 4096);  // Room for the field that crosses the flush threshold
+}
+
+/**
+ * @brief Destructor writes buffered bytes that were not flushed yet
+ */
+CsvWriter::~CsvWriter()
+{
+    Flush();
+}
+
+/**
+ * @brief Write the UTF-8 byte order mark
+ */
+void CsvWriter::WriteBom()
+{
+    Buffer.append("\xEF\xBB\xBF");
+}
+
+/**
+ * @brief Append a text field to the current row
+ */
+void CsvWriter::WriteText(const QString &text)
+{
+    BeginField();
+    QByteArray _utf8 = text.toUtf8();  // Field as UTF-8
+    EncodeField(_utf8.constData(), _utf8.size(), Buffer);
+    FlushIfFull();
+}
+
+/**
+ * @brief Append a database value to the current row
+ */
+void CsvWriter::WriteValue(const QVariant &value)
+{
+    BeginField();
+    if (value.isNull()) {
+        return;
+    }
+
+    switch (value.userType()) {
+    case QMetaType::LongLong:
+    case QMetaType::Int:
+        // Digits and a sign never need quoting
+        Buffer.append(QByteArray::number(value.toLongLong()));
+        break;
+    case QMetaType::Double:
+        Buffer.append(QByteArray::number(value.toDouble(), 'g', QLocale::FloatingPointShortest));
+        break;
+    case QMetaType::QByteArray: {
+        const QByteArray _blob = value.toByteArray();  // Raw bytes (shares the value's data)
+        EncodeField(_blob.constData(), _blob.size(), Buffer);
+        break;
+    }
+    default: {
+        QByteArray _utf8 = value.toString().toUtf8();  // Text as UTF-8
+        EncodeField(_utf8.constData(), _utf8.size(), Buffer);
+        break;
+    }
+    }
+    FlushIfFull();
+}
+
+/**
+ * @brief Terminate the current row
+ */
+void CsvWriter::EndRow()
+{
+    Buffer.append('\n');
+    RowStarted = false;
+    FlushIfFull();
+}
+
+/**
+ * @brief Hand all buffered bytes to the device
+ */
+bool CsvWriter::Flush()
+{
+    if (!Buffer.isEmpty() && !Failed) {
+        if (Device->write(Buffer) != Buffer.size()) {
+            qDebug() << "Error: Failed to write CSV output:" << Device->errorString();
+            Failed = true;
+        }
+    }
+    Buffer.resize(0);  // Keeps the reserved capacity for the next block
+    return !Failed;
+}
+
+/**
+ * @brief Check if a write to the device failed
+ */
+bool CsvWriter::HasError() const
+{
+    return Failed;
+}
+
+/**
+ * @brief Write the separator before every field but the first of a row
+ */
+void CsvWriter::BeginField()
+{
+    if (RowStarted) {
+        Buffer.append(',');
+    }
+    RowStarted = true;
+}
+
+/**
+ * @brief Append field bytes to a buffer, quoting them if they contain a special character
+ * A vector scan finds the first separator, quote or line break; a field without one is
+ * appended as is. Otherwise the field is written quoted straight into the buffer, sized
+ * for the worst case up front, with the bytes from the first special one on copied by a
+ * second vector loop that only looks for quotes to double
+ */
+void CsvWriter::EncodeField(const char *data, int length, QByteArray &output)
+{
+    const int _special = FindSpecial(data, length);  // Offset of the first byte requiring quotes
+    if (_special == length) {
+        output.append(data, length);
+        return;
+    }
+
+    const int _fieldOffset = output.size();  // Offset of the field in the buffer
+    output.resize(_fieldOffset + 2 * length - _special + 2);  // Worst case: every byte from the first special one a quote
+    char *_out = output.data() + _fieldOffset;  // Next output byte
+    *_out++ = '"';
+    std::memcpy(_out, data, static_cast<size_t>(_special));
+    _out = AppendQuoted(data + _special, length - _special, _out + _special);
+    *_out++ = '"';
+    output.resize(static_cast<int>(_out - output.constData()));
+}
+
+/**
+ * @brief Find the first byte that requires the field to be quoted
+ * Blocks of 32 (AVX2) or 16 (SSE2) bytes are compared against all four special bytes at once
+ */
+int CsvWriter::FindSpecial(const char *data, int length)
+{
+    int _i = 0;  // Next byte to check
+
+#if defined(__AVX2__)
+    const __m256i _comma = _mm256_set1_epi8(',');       // Separator in every lane
+    const __m256i _quote = _mm256_set1_epi8('"');       // Quote in every lane
+    const __m256i _lineFeed = _mm256_set1_epi8('\n');   // Line feed in every lane
+    const __m256i _return = _mm256_set1_epi8('\r');     // Carriage return in every lane
+    for (; _i + 32 <= length; _i += 32) {
+        __m256i _block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + _i));
+        __m256i _matches = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(_block, _comma), _mm256_cmpeq_epi8(_block, _quote)),
+                                           _mm256_or_si256(_mm256_cmpeq_epi8(_block, _lineFeed), _mm256_cmpeq_epi8(_block, _return)));
+        quint32 _mask = static_cast<quint32>(_mm256_movemask_epi8(_matches));  // One bit per special byte
+        if (_mask != 0) {
+            return _i + static_cast<int>(qCountTrailingZeroBits(_mask));
+        }
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i _comma = _mm_set1_epi8(',');          // Separator in every lane
+    const __m128i _quote = _mm_set1_epi8('"');          // Quote in every lane
+    const __m128i _lineFeed = _mm_set1_epi8('\n');      // Line feed in every lane
+    const __m128i _return = _mm_set1_epi8('\r');        // Carriage return in every lane
+    for (; _i + 16 <= length; _i += 16) {
+        __m128i _block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + _i));
+        __m128i _matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(_block, _comma), _mm_cmpeq_epi8(_block, _quote)),
+                                        _mm_or_si128(_mm_cmpeq_epi8(_block, _lineFeed), _mm_cmpeq_epi8(_block, _return)));
+        quint32 _mask = static_cast<quint32>(_mm_movemask_epi8(_matches));  // One bit per special byte
+        if (_mask != 0) {
+            return _i + static_cast<int>(qCountTrailingZeroBits(_mask));
+        }
+    }
+#endif
+
+    // Scalar fallback and tail of the vector loops
+    for (; _i < length; ++_i) {
+        const char _c = data[_i];  // Current byte
+        if (_c == ',' || _c == '"' || _c == '\n' || _c == '\r') {
+            return _i;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Copy field bytes into quoted output, doubling every quote
+ * Blocks without a quote are stored whole; runs between quotes are copied at once
+ */
+char *CsvWriter::AppendQuoted(const char *data, int length, char *out)
+{
+    int _i = 0;  // Next byte to copy
+
+#if defined(__AVX2__)
+    const __m256i _quote = _mm256_set1_epi8('"');  // Quote in every lane
+    for (; _i + 32 <= length; _i += 32) {
+        __m256i _block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + _i));
+        quint32 _mask = static_cast<quint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_block, _quote)));  // One bit per quote
+        if (_mask == 0) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _block);
+            out += 32;
+            continue;
+        }
+        int _copied = 0;  // Bytes of the block copied
+        while (_mask != 0) {
+            const int _next = static_cast<int>(qCountTrailingZeroBits(_mask)) + 1;  // Block bytes up to and including the next quote
+            std::memcpy(out, data + _i + _copied, static_cast<size_t>(_next - _copied));
+            out += _next - _copied;
+            *out++ = '"';
+            _copied = _next;
+            _mask &= _mask - 1;
+        }
+        std::memcpy(out, data + _i + _copied, static_cast<size_t>(32 - _copied));
+        out += 32 - _copied;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i _quote = _mm_set1_epi8('"');  // Quote in every lane
+    for (; _i + 16 <= length; _i += 16) {
+        __m128i _block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + _i));
+        quint32 _mask = static_cast<quint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_block, _quote)));  // One bit per quote
+        if (_mask == 0) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _block);
+            out += 16;
+            continue;
+        }
+        int _copied = 0;  // Bytes of the block copied
+        while (_mask != 0) {
+            const int _next = static_cast<int>(qCountTrailingZeroBits(_mask)) + 1;  // Block bytes up to and including the next quote
+            std::memcpy(out, data + _i + _copied, static_cast<size_t>(_next - _copied));
+            out += _next - _copied;
+            *out++ = '"';
+            _copied = _next;
+            _mask &= _mask - 1;
+        }
+        std::memcpy(out, data + _i + _copied, static_cast<size_t>(16 - _copied));
+        out += 16 - _copied;
+    }
+#endif
+
+    // Scalar fallback and tail of the vector loops
+    for (; _i < length; ++_i) {
+        const char _c = data[_i];  // Current byte
+        if (_c == '"') {
+            *out++ = '"';
+        }
+        *out++ = _c;
+    }
+    return out;
+}
+
+/**
+ * @brief Write the buffer to the device once it is full
+ */
+void CsvWriter::FlushIfFull()
+{
+    if (Buffer.size() >= BUFFER_SIZE) {
+        Flush();
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QVariant>
+#include <QString>
+
+/**
+ * @brief Buffered CSV encoder writing fields straight into an output device
+ * Fields are encoded as UTF-8 into one large buffer that is handed to the device
+ * in big blocks, so rows never exist as intermediate string lists and memory use
+ * does not depend on the number of rows written
+ */
+class CsvWriter
+{
+public:
+    /**
+     * @brief Constructor for CsvWriter
+     * @param device Open output device (not owned, must outlive the writer)
+     */
+    explicit CsvWriter(QIODevice *device);
+
+    /**
+     * @brief Destructor writes buffered bytes that were not flushed yet
+     */
+    ~CsvWriter();
+
+    /**
+     * @brief Write the UTF-8 byte order mark Excel uses to detect the encoding
+     */
+    void WriteBom();
+
+    /**
+     * @brief Append a text field to the current row
+     * @param text Field text, quoted if it contains a separator, quote or line break
+     */
+    void WriteText(const QString &text);
+
+    /**
+     * @brief Append a database value to the current row
+     * Numbers are formatted without going through QString, NULL becomes an empty field
+     * and BLOBs are written as their raw bytes
+     * @param value Value as returned by QSqlQuery::value
+     */
+    void WriteValue(const QVariant &value);
+
+    /**
+     * @brief Terminate the current row
+     */
+    void EndRow();
+
+    /**
+     * @brief Hand all buffered bytes to the device
+     * @return true if every byte written so far reached the device, false otherwise
+     */
+    bool Flush();
+
+    /**
+     * @brief Check if a write to the device failed
+     * @return true if output was lost, false otherwise
+     */
+    bool HasError() const;
+
+    /**
+     * @brief Append field bytes to a buffer, quoting them if they contain a special character
+     * This is the quoting kernel behind WriteText and WriteValue
+     * @param data UTF-8 bytes of the field
+     * @param length Number of bytes
+     * @param output Buffer receiving the encoded field
+     */
+    static void EncodeField(const char *data, int length, QByteArray &output);
+
+    static const int BUFFER_SIZE;        // Bytes collected before they are written to the device
+
+private:
+    /**
+     * @brief Write the separator before every field but the first of a row
+     */
+    void BeginField();
+
+    /**
+     * @brief Find the first byte that requires the field to be quoted
+     * @param data UTF-8 bytes of the field
+     * @param length Number of bytes
+     * @return Offset of the first separator, quote or line break, length if there is none
+     */
+    static int FindSpecial(const char *data, int length);
+
+    /**
+     * @brief Copy field bytes into quoted output, doubling every quote
+     * @param data Bytes to copy
+     * @param length Number of bytes
+     * @param out Output position with room for 2 * length bytes
+     * @return Output position after the copied bytes
+     */
+    static char *AppendQuoted(const char *data, int length, char *out);
+
+    /**
+     * @brief Write the buffer to the device once it is full
+     */
+    void FlushIfFull();
+
+    QIODevice *Device;                   // Output device (not owned)
+    QByteArray Buffer;                   // Encoded bytes not yet written (capacity BUFFER_SIZE)
+    bool RowStarted;                     // Flag indicating the current row has a field (true) or is empty (false)
+    bool Failed;                         // Flag indicating a device write failed (true) or all succeeded (false)
+};
+
+#endif // CSVWRITER_H
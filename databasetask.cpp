@@ -0,0 +1,167 @@
+#include "databasetask.h"
+#include "sqlworker.h"
+#include <QUuid>
+#include <climits>
+#include <sqlite3.h>
+
+// Define progress handler constants
+const int DatabaseTask::PROGRESS_HANDLER_INSTRUCTIONS = 10000;
+
+/**
+ * @brief Constructor initializes DatabaseTask with default values
+ */
+DatabaseTask::DatabaseTask(const QString &filePath)
+    : QObject(nullptr)
+    , FilePath(filePath)               // Path to SQL database file
+    , TaskThread(nullptr)              // Background thread (created on start)
+    , CancelRequested(false)           // Cancellation flag
+    , Running(false)                   // Execution state flag
+{
+}
+
+/**
+ * @brief Destructor releases the background thread
+ * The join here is only a last resort; by this point the derived parts of the object are
+ * already destroyed, so owners must have called Stop on a running task
+ */
+DatabaseTask::~DatabaseTask()
+{
+    if (TaskThread) {
+        CancelRequested = true;
+        TaskThread->wait();
+        delete TaskThread;
+    }
+}
+
+/**
+ * @brief Start the task on a new background thread
+ */
+void DatabaseTask::Start()
+{
+    if (Running) {
+        qDebug() << "Error: Database task is already running";
+        return;
+    }
+
+    // Release the thread of a previous run before starting a new one
+    if (TaskThread) {
+        TaskThread->wait();
+        delete TaskThread;
+    }
+
+    CancelRequested = false;
+    Running = true;
+
+    TaskThread = QThread::create([this]() { Execute(); });
+    TaskThread->start(QThread::LowPriority);
+}
+
+/**
+ * @brief Request cooperative cancellation of the running task
+ */
+void DatabaseTask::Cancel()
+{
+    CancelRequested = true;
+}
+
+/**
+ * @brief Request cancellation and block until the task thread has finished
+ */
+void DatabaseTask::Stop()
+{
+    Cancel();
+    Wait(ULONG_MAX);
+}
+
+/**
+ * @brief Check if cancellation has been requested
+ */
+bool DatabaseTask::IsCancelled() const
+{
+    return CancelRequested;
+}
+
+/**
+ * @brief Check if the task is currently executing
+ */
+bool DatabaseTask::IsRunning() const
+{
+    return Running;
+}
+
+/**
+ * @brief Block until the task thread has finished
+ */
+bool DatabaseTask::Wait(unsigned long timeoutMs)
+{
+    if (!TaskThread) {
+        return true;
+    }
+    return TaskThread->wait(timeoutMs);
+}
+
+/**
+ * @brief Called periodically from SQLite while a statement of this task executes
+ */
+void DatabaseTask::ProgressTick()
+{
+}
+
+/**
+ * @brief Called from SQLite to abort the running statement for a reason other than cancellation
+ */
+bool DatabaseTask::ShouldInterrupt()
+{
+    return false;
+}
+
+/**
+ * @brief sqlite3_progress_handler callback that interrupts cancelled tasks
+ */
+int DatabaseTask::ProgressHandler(void *context)
+{
+    DatabaseTask *_task = static_cast<DatabaseTask *>(context);  // Task owning the connection
+    _task->ProgressTick();
+    return (_task->IsCancelled() || _task->ShouldInterrupt()) ? 1 : 0;
+}
+
+/**
+ * @brief Open the background connection, run the task and clean up
+ */
+void DatabaseTask::Execute()
+{
+    bool _success = false;  // Result of the task work
+    QString _message;       // Summary or error description reported to the caller
+    QString _connectionName = QString("DatabaseTask_Connection_%1")
+                                  .arg(QUuid::createUuid().toString(QUuid::WithoutBraces));  // Unique connection name for this thread
+
+    {
+        // Connection must go out of scope before it can be removed
+        QSqlDatabase _database = SQLWorker::OpenDatabaseConnection(FilePath, _connectionName);  // Connection owned by the task thread
+
+        if (!_database.isOpen()) {
+            _message = QString("Cannot open database file %1").arg(FilePath);
+        } else {
+            // Let SQLite abort long statements as soon as cancellation is requested
+            sqlite3 *_handle = SQLWorker::GetNativeHandle(_database);  // Native handle of the task connection
+            if (_handle) {
+                sqlite3_progress_handler(_handle, PROGRESS_HANDLER_INSTRUCTIONS, &DatabaseTask::ProgressHandler, this);
+            }
+
+            _success = Run(_database, _message);
+
+            if (_handle) {
+                sqlite3_progress_handler(_handle, 0, nullptr, nullptr);
+            }
+            _database.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(_connectionName);
+
+    if (CancelRequested && _message.isEmpty()) {
+        _message = "Task cancelled";
+    }
+
+    Running = false;
+    emit Finished(_success && !CancelRequested, _message);
+}
@@ -0,0 +1,131 @@
+#ifndef DATABASETASK_H
+#define DATABASETASK_H
+
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <atomic>
+
+/**
+ * @brief Base class for database work executed on a background thread
+ * Each task opens its own SQLite connection on a dedicated thread so the GUI
+ * connection owned by SQLWorker is never blocked or shared across threads
+ */
+class DatabaseTask : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for DatabaseTask
+     * @param filePath Path to the SQL database file the task connects to
+     */
+    explicit DatabaseTask(const QString &filePath);
+
+    /**
+     * @brief Destructor for DatabaseTask
+     * Call Stop before deleting a running task: the worker thread runs the derived Run,
+     * which would otherwise still use members the derived destructor has already destroyed
+     */
+    ~DatabaseTask() override;
+
+    /**
+     * @brief Start the task on a new background thread
+     * The task object itself stays in the GUI thread, so its signals are queued to GUI receivers
+     */
+    void Start();
+
+    /**
+     * @brief Request cooperative cancellation of the running task
+     */
+    void Cancel();
+
+    /**
+     * @brief Request cancellation and block until the task thread has finished
+     * Owners call this before deleting a task that may still be running
+     */
+    void Stop();
+
+    /**
+     * @brief Check if cancellation has been requested
+     * @return true if Cancel was called, false otherwise
+     */
+    bool IsCancelled() const;
+
+    /**
+     * @brief Check if the task is currently executing
+     * @return true if task thread is running, false otherwise
+     */
+    bool IsRunning() const;
+
+    /**
+     * @brief Block until the task thread has finished
+     * @param timeoutMs Longest time to wait in milliseconds
+     * @return true if the task is not running anymore, false if the wait timed out
+     */
+    bool Wait(unsigned long timeoutMs);
+
+signals:
+    /**
+     * @brief Emitted periodically while the task is running
+     * @param percent Completion percentage (0-100, -1 if unknown)
+     * @param message Human readable description of the current step
+     */
+    void ProgressChanged(int percent, const QString &message);
+
+    /**
+     * @brief Emitted once when the task has finished or was cancelled
+     * @param success true if the task completed successfully, false otherwise
+     * @param message Summary or error description
+     */
+    void Finished(bool success, const QString &message);
+
+protected:
+    /**
+     * @brief Perform the task work on the background connection
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if work completed successfully, false otherwise
+     */
+    virtual bool Run(QSqlDatabase &database, QString &message) = 0;
+
+    /**
+     * @brief Called periodically from SQLite while a statement of this task executes
+     * Override to report progress of long single statements; default does nothing
+     */
+    virtual void ProgressTick();
+
+    /**
+     * @brief Called from SQLite with ProgressTick to abort the running statement for a reason other than cancellation
+     * Override to enforce limits such as a time budget; default never interrupts
+     * @return true to abort the running statement, false to continue
+     */
+    virtual bool ShouldInterrupt();
+
+    QString FilePath;                    // Path to SQL database file used by this task
+
+private:
+    /**
+     * @brief Open the background connection, run the task and clean up
+     */
+    void Execute();
+
+    /**
+     * @brief sqlite3_progress_handler callback that interrupts cancelled tasks
+     * @param context Pointer to the DatabaseTask owning the connection
+     * @return Non-zero to abort the running statement, 0 to continue
+     */
+    static int ProgressHandler(void *context);
+
+    static const int PROGRESS_HANDLER_INSTRUCTIONS;  // Virtual machine instructions between progress callbacks
+
+    QThread *TaskThread;                 // Background thread executing the task (nullptr until started, owned by task)
+    std::atomic<bool> CancelRequested;   // Flag set by Cancel (true once cancellation requested)
+    std::atomic<bool> Running;           // Flag indicating task is executing (true) or idle (false)
+};
+
+#endif // DATABASETASK_H
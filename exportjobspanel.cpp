@@ -0,0 +1,232 @@
+#include "exportjobspanel.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QLocale>
+
+// Define panel constants
+const int ExportJobsPanel::REFRESH_INTERVAL_MS = 500;
+
+/**
+ * @brief Constructor initializes the panel widgets
+ */
+ExportJobsPanel::ExportJobsPanel(QWidget *parent)
+    : QDockWidget("Export Jobs", parent)
+    , StatusLabel(nullptr)             // Job count line
+    , JobsTable(nullptr)               // Job list
+    , RefreshTimer(nullptr)            // Progress timer
+    , Jobs()                           // No jobs
+{
+    QWidget *_content = new QWidget(this);  // Dock content container
+    QVBoxLayout *_layout = new QVBoxLayout(_content);  // Layout of label, list and buttons
+
+    StatusLabel = new QLabel("No exports running", _content);
+    JobsTable = new QTableWidget(0, 6, _content);
+    JobsTable->setHorizontalHeaderLabels({"Job", "Status", "Rows", "Throughput", "File", ""});
+    JobsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    JobsTable->setSelectionMode(QAbstractItemView::NoSelection);
+    JobsTable->verticalHeader()->hide();
+    JobsTable->horizontalHeader()->setSectionResizeMode(4, QHeaderView::Stretch);
+
+    QPushButton *_clearButton = new QPushButton("Clear Finished", _content);  // Removes finished jobs from the list
+    connect(_clearButton, &QPushButton::clicked, this, &ExportJobsPanel::ClearFinished);
+    QHBoxLayout *_buttonLayout = new QHBoxLayout();  // Buttons below the list
+    _buttonLayout->addStretch();
+    _buttonLayout->addWidget(_clearButton);
+
+    _layout->addWidget(StatusLabel);
+    _layout->addWidget(JobsTable, 1);
+    _layout->addLayout(_buttonLayout);
+    setWidget(_content);
+
+    RefreshTimer = new QTimer(this);
+    RefreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(RefreshTimer, &QTimer::timeout, this, &ExportJobsPanel::RefreshProgress);
+}
+
+/**
+ * @brief Destructor cancels running jobs and waits for them
+ */
+ExportJobsPanel::~ExportJobsPanel()
+{
+    Stop();
+    qDeleteAll(Jobs);
+}
+
+/**
+ * @brief Add a job to the list and start it
+ */
+void ExportJobsPanel::AddJob(DatabaseTask *task, const QString &title, const QString &outputPath, const RowCounter &rowCounter)
+{
+    Job *_job = new Job();  // State of the new job
+    _job->Task = task;
+    _job->Title = title;
+    _job->OutputPath = outputPath;
+    _job->Rows = rowCounter;
+    _job->StatusItem = new QTableWidgetItem("Running");
+
+    int _row = JobsTable->rowCount();  // List row of the job
+    JobsTable->insertRow(_row);
+    JobsTable->setItem(_row, 0, new QTableWidgetItem(title));
+    JobsTable->setItem(_row, 1, _job->StatusItem);
+    JobsTable->setItem(_row, 2, new QTableWidgetItem("0"));
+    JobsTable->setItem(_row, 3, new QTableWidgetItem(""));
+    JobsTable->setItem(_row, 4, new QTableWidgetItem(outputPath));
+
+    // Cancellation is cooperative; the task removes its partial file before it reports back
+    QPushButton *_cancelButton = new QPushButton("Cancel", JobsTable);  // Cancels this job
+    connect(_cancelButton, &QPushButton::clicked, this, [_job, _cancelButton]() {
+        if (_job->Task) {
+            _job->Task->Cancel();
+            _job->StatusItem->setText("Cancelling...");
+            _cancelButton->setEnabled(false);
+        }
+    });
+    JobsTable->setCellWidget(_row, 5, _cancelButton);
+
+    connect(task, &DatabaseTask::Finished, this, [this, task](bool success, const QString &message) {
+        OnTaskFinished(task, success, message);
+    });
+    Jobs.append(_job);
+
+    _job->Timer.start();
+    task->Start();
+    RefreshTimer->start();
+    UpdateStatusLabel();
+}
+
+/**
+ * @brief Check if any job is still running
+ */
+bool ExportJobsPanel::HasRunningJobs() const
+{
+    for (const Job *_job : Jobs) {
+        if (_job->Task) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Cancel all running jobs and wait for them
+ */
+void ExportJobsPanel::Stop()
+{
+    for (Job *_job : Jobs) {
+        if (_job->Task) {
+            _job->Task->disconnect(this);
+            _job->Task->Stop();
+            delete _job->Task;  // Thread has left Run, so no member is still in use
+            _job->Task = nullptr;
+            _job->StatusItem->setText("Cancelled");
+        }
+    }
+    RefreshTimer->stop();
+    UpdateStatusLabel();
+}
+
+/**
+ * @brief Update rows and throughput of the running jobs
+ */
+void ExportJobsPanel::RefreshProgress()
+{
+    for (int _row = 0; _row < Jobs.size(); ++_row) {
+        const Job *_job = Jobs[_row];  // Job shown in this row
+        if (!_job->Task) {
+            continue;
+        }
+        qint64 _rowCount = _job->Rows();  // Rows written so far
+        JobsTable->item(_row, 2)->setText(QLocale().toString(_rowCount));
+        JobsTable->item(_row, 3)->setText(FormatThroughput(_rowCount, _job->Timer.elapsed()));
+    }
+}
+
+/**
+ * @brief Record the result of a finished job and dispose of its task
+ */
+void ExportJobsPanel::OnTaskFinished(DatabaseTask *task, bool success, const QString &message)
+{
+    Job *_job = nullptr;  // Job of the finished task
+    for (Job *_candidate : Jobs) {
+        if (_candidate->Task == task) {
+            _job = _candidate;
+            break;
+        }
+    }
+    if (!_job) {
+        return;
+    }
+
+    // The final count and average rate stay listed after the task is gone
+    int _row = FindRow(_job);  // List row of the job
+    qint64 _rowCount = _job->Rows();  // Rows written in total
+    JobsTable->item(_row, 2)->setText(QLocale().toString(_rowCount));
+    JobsTable->item(_row, 3)->setText(FormatThroughput(_rowCount, _job->Timer.elapsed()));
+    _job->StatusItem->setText(success ? "Done" : (task->IsCancelled() ? "Cancelled" : "Failed: " + message));
+    _job->StatusItem->setToolTip(message);
+    if (QWidget *_cancelButton = JobsTable->cellWidget(_row, 5)) {
+        _cancelButton->setEnabled(false);
+    }
+
+    _job->Task = nullptr;
+    task->deleteLater();
+    if (!HasRunningJobs()) {
+        RefreshTimer->stop();
+    }
+    UpdateStatusLabel();
+
+    emit JobFinished(_job->Title, success, message, _job->OutputPath);
+}
+
+/**
+ * @brief Remove finished jobs from the list
+ */
+void ExportJobsPanel::ClearFinished()
+{
+    for (int _row = Jobs.size() - 1; _row >= 0; --_row) {
+        if (!Jobs[_row]->Task) {
+            JobsTable->removeRow(_row);
+            delete Jobs.takeAt(_row);
+        }
+    }
+}
+
+/**
+ * @brief Find the list row of a job
+ */
+int ExportJobsPanel::FindRow(const Job *job) const
+{
+    for (int _row = 0; _row < Jobs.size(); ++_row) {
+        if (Jobs[_row] == job) {
+            return _row;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Show the running job count above the list
+ */
+void ExportJobsPanel::UpdateStatusLabel()
+{
+    int _running = 0;  // Jobs still running
+    for (const Job *_job : Jobs) {
+        if (_job->Task) {
+            _running++;
+        }
+    }
+    StatusLabel->setText(_running > 0 ? QString("%1 export(s) running").arg(_running) : QString("No exports running"));
+}
+
+/**
+ * @brief Format a row rate for display
+ */
+QString ExportJobsPanel::FormatThroughput(qint64 rowCount, qint64 elapsedMs)
+{
+    if (elapsedMs <= 0) {
+        return QString();
+    }
+    return QString("%1 rows/s").arg(QLocale().toString(rowCount * 1000 / elapsedMs));
+}
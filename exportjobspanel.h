@@ -0,0 +1,126 @@
+#ifndef EXPORTJOBSPANEL_H
+#define EXPORTJOBSPANEL_H
+
+#include <QDockWidget>
+#include <QTableWidget>
+#include <QLabel>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QList>
+#include <functional>
+#include "databasetask.h"
+
+/**
+ * @brief Dock panel running export tasks in the background and listing their progress
+ * Every job is a DatabaseTask on its own connection and thread, so several exports run
+ * concurrently while the window stays usable. The list shows rows written and throughput
+ * per job; cancelled or failed jobs remove their partial files themselves
+ */
+class ExportJobsPanel : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Reports the rows a job has written so far (called on the GUI thread)
+     */
+    using RowCounter = std::function<qint64()>;
+
+    /**
+     * @brief Constructor for ExportJobsPanel
+     * @param parent Parent widget pointer (usually the main window)
+     */
+    explicit ExportJobsPanel(QWidget *parent = nullptr);
+
+    /**
+     * @brief Destructor cancels running jobs and waits for them
+     */
+    ~ExportJobsPanel() override;
+
+    /**
+     * @brief Add a job to the list and start it
+     * @param task Export task, owned by the panel from now on
+     * @param title Short description shown in the list
+     * @param outputPath File the task writes
+     * @param rowCounter Function returning the rows the task has written
+     */
+    void AddJob(DatabaseTask *task, const QString &title, const QString &outputPath, const RowCounter &rowCounter);
+
+    /**
+     * @brief Check if any job is still running
+     * @return true while a job runs, false otherwise
+     */
+    bool HasRunningJobs() const;
+
+    /**
+     * @brief Cancel all running jobs and wait for them
+     */
+    void Stop();
+
+signals:
+    /**
+     * @brief Emitted once when a job has finished, failed or was cancelled
+     * @param title Description of the job
+     * @param success true if the file was written completely, false otherwise
+     * @param message Summary or error reported by the task
+     * @param outputPath File of the job (removed again unless success)
+     */
+    void JobFinished(const QString &title, bool success, const QString &message, const QString &outputPath);
+
+private:
+    /**
+     * @brief State of one listed job
+     */
+    struct Job {
+        DatabaseTask *Task = nullptr;    // Running task (nullptr once finished)
+        QString Title;                   // Description of the job
+        QString OutputPath;              // File written by the job
+        RowCounter Rows;                 // Rows written so far
+        QElapsedTimer Timer;             // Time since the job was started
+        QTableWidgetItem *StatusItem = nullptr;  // Status cell of the job
+    };
+
+    /**
+     * @brief Update rows and throughput of the running jobs
+     */
+    void RefreshProgress();
+
+    /**
+     * @brief Record the result of a finished job and dispose of its task
+     * @param task Task that finished
+     * @param success true if the task completed, false otherwise
+     * @param message Summary or error reported by the task
+     */
+    void OnTaskFinished(DatabaseTask *task, bool success, const QString &message);
+
+    /**
+     * @brief Remove finished jobs from the list
+     */
+    void ClearFinished();
+
+    /**
+     * @brief Find the list row of a job
+     * @return Row index (-1 if the job is not listed)
+     */
+    int FindRow(const Job *job) const;
+
+    /**
+     * @brief Show the running job count above the list
+     */
+    void UpdateStatusLabel();
+
+    /**
+     * @brief Format a row rate for display
+     * @return Text such as "125,000 rows/s"
+     */
+    static QString FormatThroughput(qint64 rowCount, qint64 elapsedMs);
+
+    QLabel *StatusLabel;                 // Running job count above the list
+    QTableWidget *JobsTable;             // One row per job
+    QTimer *RefreshTimer;                // Triggers progress updates while jobs run
+    QList<Job *> Jobs;                   // Jobs in list order (owned)
+
+    static const int REFRESH_INTERVAL_MS;  // Time between progress updates
+};
+
+#endif // EXPORTJOBSPANEL_H
@@ -0,0 +1,151 @@
+#include "filterheaderview.h"
+
+/**
+ * @brief Constructor initializes the header and measures the filter row
+ */
+FilterHeaderView::FilterHeaderView(QWidget *parent)
+    : QHeaderView(Qt::Horizontal, parent)
+    , Editors()                        // Lazily created editors
+    , FilterTexts()                    // Confirmed filter texts
+    , EditorHeight(QLineEdit().sizeHint().height())  // Height of one filter editor
+    , ChangePending(false)             // No filter proposed
+{
+    setSectionsClickable(true);
+
+    connect(this, &QHeaderView::sectionResized, this, &FilterHeaderView::UpdateEditorPositions);
+    connect(this, &QHeaderView::sectionMoved, this, &FilterHeaderView::UpdateEditorPositions);
+}
+
+/**
+ * @brief Get filter texts of all columns with a non-empty filter
+ */
+QMap<int, QString> FilterHeaderView::GetFilterTexts() const
+{
+    return FilterTexts;
+}
+
+/**
+ * @brief Store the filter text of a column once the filter was applied
+ */
+void FilterHeaderView::SetFilterText(int logicalIndex, const QString &text)
+{
+    if (text.isEmpty()) {
+        FilterTexts.remove(logicalIndex);
+    } else {
+        FilterTexts.insert(logicalIndex, text);
+    }
+}
+
+/**
+ * @brief Remove all filter texts
+ */
+void FilterHeaderView::ClearFilters()
+{
+    FilterTexts.clear();
+    for (QLineEdit *_editor : Editors) {
+        _editor->clear();
+    }
+}
+
+/**
+ * @brief Header size including the filter row
+ */
+QSize FilterHeaderView::sizeHint() const
+{
+    QSize _size = QHeaderView::sizeHint();  // Size of the title row
+    _size.setHeight(_size.height() + EditorHeight);
+    return _size;
+}
+
+/**
+ * @brief Reserve space for the filter row and reposition editors
+ */
+void FilterHeaderView::updateGeometries()
+{
+    setViewportMargins(0, 0, 0, EditorHeight);  // Titles stay in the viewport, editors use the bottom margin
+    QHeaderView::updateGeometries();
+    UpdateEditorPositions();
+}
+
+/**
+ * @brief Position the editors of visible sections below their titles
+ */
+void FilterHeaderView::UpdateEditorPositions()
+{
+    int _top = QHeaderView::sizeHint().height();  // Editors start below the title row
+    int _viewWidth = viewport()->width();         // Visible header width
+
+    // Sections that disappeared with a new model lose their editors
+    for (auto _it = Editors.begin(); _it != Editors.end();) {
+        if (_it.key() >= count()) {
+            _it.value()->deleteLater();
+            _it = Editors.erase(_it);
+        } else {
+            ++_it;
+        }
+    }
+
+    for (auto _it = Editors.begin(); _it != Editors.end(); ++_it) {
+        _it.value()->hide();  // Shown again below if still in view
+    }
+
+    int _firstVisual = visualIndexAt(0);  // Leftmost visible section (-1 if none)
+    if (_firstVisual < 0) {
+        return;
+    }
+
+    for (int _visual = _firstVisual; _visual < count(); ++_visual) {  // Visible sections from left to right
+        int _logical = logicalIndex(_visual);  // Column shown at this visual position
+        if (isSectionHidden(_logical)) {
+            continue;
+        }
+
+        int _x = sectionViewportPosition(_logical);  // Section left edge relative to the viewport
+        if (_x >= _viewWidth) {
+            break;
+        }
+
+        QLineEdit *_editor = GetEditor(_logical);  // Filter editor of this column
+        _editor->setGeometry(_x, _top, sectionSize(_logical), EditorHeight);
+        _editor->show();
+    }
+}
+
+/**
+ * @brief Get or create the editor of a section
+ */
+QLineEdit *FilterHeaderView::GetEditor(int logicalIndex)
+{
+    auto _existing = Editors.constFind(logicalIndex);  // Previously created editor (end if none)
+    if (_existing != Editors.constEnd()) {
+        return _existing.value();
+    }
+
+    QLineEdit *_editor = new QLineEdit(this);  // New filter editor for the column
+    _editor->setPlaceholderText("Filter");
+    _editor->setToolTip("value  =  |  a..b  range  |  >x  <x  >=x  <=x  |  %text%  LIKE  |  a;b;c  IN list  |  ~regex  REGEXP  |  NULL  |  !NULL");
+    _editor->setText(FilterTexts.value(logicalIndex));
+
+    connect(_editor, &QLineEdit::editingFinished, this, [this, _editor, logicalIndex]() {
+        // A confirmation dialog takes the focus, which finishes editing a second time
+        if (ChangePending) {
+            return;
+        }
+
+        QString _text = _editor->text().trimmed();  // Proposed filter text
+        if (_text == FilterTexts.value(logicalIndex)) {
+            return;  // Leaving an unchanged editor must not reload the table
+        }
+
+        // The receiver stores the text only if it is valid and the reload was confirmed
+        ChangePending = true;
+        emit FilterChanged(logicalIndex, _text);
+        ChangePending = false;
+        if (FilterTexts.value(logicalIndex) != _text) {
+            _editor->setText(FilterTexts.value(logicalIndex));
+        }
+    });
+
+    Editors.insert(logicalIndex, _editor);
+    return _editor;
+}
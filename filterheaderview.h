@@ -0,0 +1,84 @@
+#ifndef FILTERHEADERVIEW_H
+#define FILTERHEADERVIEW_H
+
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QHash>
+#include <QMap>
+
+/**
+ * @brief Horizontal header with a filter line edit below every column title
+ * Editors are created only for sections that are scrolled into view, so wide
+ * tables do not pay for thousands of widgets
+ */
+class FilterHeaderView : public QHeaderView
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for FilterHeaderView
+     * @param parent Parent widget pointer (usually the table view)
+     */
+    explicit FilterHeaderView(QWidget *parent = nullptr);
+
+    /**
+     * @brief Get filter texts of all columns with a non-empty filter
+     * @return QMap containing logical column index -> filter expression
+     */
+    QMap<int, QString> GetFilterTexts() const;
+
+    /**
+     * @brief Store the filter text of a column once the filter was applied
+     * @param logicalIndex Logical column index
+     * @param text Filter expression (empty to remove the filter of the column)
+     */
+    void SetFilterText(int logicalIndex, const QString &text);
+
+    /**
+     * @brief Remove all filter texts (e.g. when a different table is shown)
+     */
+    void ClearFilters();
+
+    /**
+     * @brief Header size including the filter row
+     */
+    QSize sizeHint() const override;
+
+signals:
+    /**
+     * @brief Emitted when the user confirms a changed filter with Enter or by leaving the editor
+     * The text is only stored if the receiver applies it with SetFilterText; otherwise the
+     * editor shows the previous text again
+     * @param logicalIndex Logical column index
+     * @param text Proposed filter expression (empty to remove the filter of the column)
+     */
+    void FilterChanged(int logicalIndex, const QString &text);
+
+public slots:
+    /**
+     * @brief Position the editors of visible sections below their titles
+     */
+    void UpdateEditorPositions();
+
+protected:
+    /**
+     * @brief Reserve space for the filter row and reposition editors
+     */
+    void updateGeometries() override;
+
+private:
+    /**
+     * @brief Get or create the editor of a section
+     * @param logicalIndex Logical column index
+     * @return Line edit used for the column filter
+     */
+    QLineEdit *GetEditor(int logicalIndex);
+
+    QHash<int, QLineEdit *> Editors;     // Editors created so far (logical index -> editor)
+    QMap<int, QString> FilterTexts;      // Confirmed filter text per logical index (empty columns omitted)
+    int EditorHeight;                    // Height of the filter row in pixels
+    bool ChangePending;                  // Flag indicating a proposed filter is being validated or confirmed (true) or not (false)
+};
+
+#endif // FILTERHEADERVIEW_H
@@ -0,0 +1,215 @@
+#include "globalsearchdialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QThread>
+
+// Define global search dialog constants
+const int GlobalSearchDialog::MAX_PARALLEL_TASKS = 4;
+
+/**
+ * @brief Constructor builds the search box and the result list
+ */
+GlobalSearchDialog::GlobalSearchDialog(const QString &filePath, const QStringList &tableNames, QWidget *parent)
+    : QDialog(parent)
+    , FilePath(filePath)               // File of the tables
+    , TableNames(tableNames)           // Searched tables
+    , SearchEdit(nullptr)              // Search text box
+    , SearchButton(nullptr)            // Search start button
+    , StatusLabel(nullptr)             // Search status
+    , ResultTable(nullptr)             // Hit list
+    , RunningTasks()                   // No search running
+    , SearchedTableCount(0)            // No table searched
+    , IncompleteTables()               // No table stopped early
+{
+    setWindowTitle("Search All Tables");
+    resize(700, 500);
+
+    SearchEdit = new QLineEdit(this);
+    SearchEdit->setClearButtonEnabled(true);
+    SearchEdit->setPlaceholderText("Text to find in every table (press Enter)");
+    SearchButton = new QPushButton("Search", this);
+    QPushButton *_closeButton = new QPushButton("Close", this);  // Closes the dialog
+    StatusLabel = new QLabel(QString("%1 table(s)").arg(tableNames.size()), this);
+
+    ResultTable = new QTableWidget(0, 3, this);
+    ResultTable->setHorizontalHeaderLabels({"Table", "Row id", "Column"});
+    ResultTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ResultTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    ResultTable->verticalHeader()->hide();
+    ResultTable->horizontalHeader()->setStretchLastSection(true);
+
+    QHBoxLayout *_searchLayout = new QHBoxLayout();  // Search box and button
+    _searchLayout->addWidget(SearchEdit, 1);
+    _searchLayout->addWidget(SearchButton);
+
+    QHBoxLayout *_buttonLayout = new QHBoxLayout();  // Status and close button
+    _buttonLayout->addWidget(StatusLabel, 1);
+    _buttonLayout->addWidget(_closeButton);
+
+    QVBoxLayout *_layout = new QVBoxLayout(this);  // Dialog layout
+    _layout->addLayout(_searchLayout);
+    _layout->addWidget(ResultTable, 1);
+    _layout->addLayout(_buttonLayout);
+
+    connect(SearchEdit, &QLineEdit::returnPressed, this, &GlobalSearchDialog::OnSearchClicked);
+    connect(SearchButton, &QPushButton::clicked, this, &GlobalSearchDialog::OnSearchClicked);
+    connect(ResultTable, &QTableWidget::cellDoubleClicked, this, &GlobalSearchDialog::OnResultDoubleClicked);
+    connect(_closeButton, &QPushButton::clicked, this, &QDialog::close);
+}
+
+/**
+ * @brief Destructor cancels a running search
+ */
+GlobalSearchDialog::~GlobalSearchDialog()
+{
+    Stop();
+}
+
+/**
+ * @brief Cancel and dispose of running search tasks
+ */
+void GlobalSearchDialog::Stop()
+{
+    if (RunningTasks.isEmpty()) {
+        return;
+    }
+
+    for (GlobalSearchTask *_task : RunningTasks) {
+        _task->disconnect(this);
+        _task->Stop();
+        delete _task;  // Thread has left Run, so no member is still in use
+    }
+    RunningTasks.clear();
+    SearchButton->setText("Search");
+}
+
+/**
+ * @brief Start searching for the text in the search box, or cancel the running search
+ * Tables go into one shared queue; each task takes the next table when done with the last
+ */
+void GlobalSearchDialog::OnSearchClicked()
+{
+    if (!RunningTasks.isEmpty()) {
+        Stop();
+        UpdateStatus();
+        StatusLabel->setText("Cancelled - " + StatusLabel->text());
+        return;
+    }
+
+    QString _text = SearchEdit->text();  // Text to find
+    if (_text.isEmpty() || TableNames.isEmpty()) {
+        return;
+    }
+
+    ResultTable->setRowCount(0);
+    SearchedTableCount = 0;
+    IncompleteTables.clear();
+
+    QSharedPointer<GlobalSearchQueue> _queue(new GlobalSearchQueue(TableNames));  // Tables shared by the pool
+    int _taskCount = qBound(1, QThread::idealThreadCount() - 1, MAX_PARALLEL_TASKS);  // Leave one core for the GUI
+    _taskCount = qMin(_taskCount, TableNames.size());
+    for (int _i = 0; _i < _taskCount; ++_i) {
+        GlobalSearchTask *_task = new GlobalSearchTask(FilePath, _queue, _text);  // Pooled read connection
+        // Signals still queued from a cancelled search must not reach the new result
+        connect(_task, &GlobalSearchTask::HitsFound, this, [this, _task](const QVector<GlobalSearchHit> &hits) {
+            if (RunningTasks.contains(_task)) {
+                AppendHits(hits);
+            }
+        });
+        connect(_task, &GlobalSearchTask::TableSearched, this, [this, _task](const QString &tableName, int hitCount, bool complete) {
+            if (RunningTasks.contains(_task)) {
+                OnTableSearched(tableName, hitCount, complete);
+            }
+        });
+        connect(_task, &DatabaseTask::Finished, this, [this, _task](bool success, const QString &message) {
+            OnTaskFinished(_task, success, message);
+        });
+        RunningTasks.append(_task);
+    }
+
+    SearchButton->setText("Cancel");
+    UpdateStatus();
+    for (GlobalSearchTask *_task : RunningTasks) {
+        _task->Start();
+    }
+}
+
+/**
+ * @brief Forward the double-clicked hit to the main window
+ */
+void GlobalSearchDialog::OnResultDoubleClicked(int row)
+{
+    QTableWidgetItem *_tableItem = ResultTable->item(row, 0);  // Table name of the hit
+    QTableWidgetItem *_rowIdItem = ResultTable->item(row, 1);  // Row id of the hit
+    if (_tableItem && _rowIdItem) {
+        emit HitActivated(_tableItem->text(), _rowIdItem->data(Qt::UserRole).toLongLong());
+    }
+}
+
+/**
+ * @brief Append a batch of hits to the result list
+ */
+void GlobalSearchDialog::AppendHits(const QVector<GlobalSearchHit> &hits)
+{
+    int _row = ResultTable->rowCount();  // First new row
+    ResultTable->setRowCount(_row + hits.size());
+    for (const GlobalSearchHit &_hit : hits) {
+        QTableWidgetItem *_rowIdItem = new QTableWidgetItem(QString::number(_hit.RowId));  // Row id (number kept as data)
+        _rowIdItem->setData(Qt::UserRole, _hit.RowId);
+        _rowIdItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+        ResultTable->setItem(_row, 0, new QTableWidgetItem(_hit.TableName));
+        ResultTable->setItem(_row, 1, _rowIdItem);
+        ResultTable->setItem(_row, 2, new QTableWidgetItem(_hit.ColumnName));
+        _row++;
+    }
+    UpdateStatus();
+}
+
+/**
+ * @brief Count a finished table and update the status line
+ */
+void GlobalSearchDialog::OnTableSearched(const QString &tableName, int hitCount, bool complete)
+{
+    Q_UNUSED(hitCount);
+    SearchedTableCount++;
+    if (!complete) {
+        IncompleteTables.append(tableName);
+    }
+    UpdateStatus();
+}
+
+/**
+ * @brief Dispose of a finished task and show the summary once all tasks are done
+ */
+void GlobalSearchDialog::OnTaskFinished(GlobalSearchTask *task, bool success, const QString &message)
+{
+    if (!RunningTasks.removeOne(task)) {
+        return;
+    }
+
+    if (!success) {
+        qDebug() << "Error: Global search task failed:" << message;
+    }
+    task->deleteLater();
+
+    if (RunningTasks.isEmpty()) {
+        SearchButton->setText("Search");
+        ResultTable->resizeColumnsToContents();
+        UpdateStatus();
+    }
+}
+
+/**
+ * @brief Show searched tables, hits and incomplete tables in the status line
+ */
+void GlobalSearchDialog::UpdateStatus()
+{
+    QString _status = QString("%1 of %2 table(s) searched, %3 hit(s)")
+                          .arg(SearchedTableCount).arg(TableNames.size()).arg(ResultTable->rowCount());  // Status text
+    if (!IncompleteTables.isEmpty()) {
+        _status += QString(" - not fully searched (time budget, hit limit or no row ids): %1").arg(IncompleteTables.join(", "));
+    }
+    StatusLabel->setText(_status);
+}
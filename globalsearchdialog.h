@@ -0,0 +1,101 @@
+#ifndef GLOBALSEARCHDIALOG_H
+#define GLOBALSEARCHDIALOG_H
+
+#include <QDialog>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QLabel>
+#include <QList>
+#include "globalsearchtask.h"
+
+/**
+ * @brief Search of the text columns of every table of the file
+ * Tables are searched by a pool of GlobalSearchTask instances sharing one queue,
+ * and hits (table, row id, column) are listed as they arrive
+ */
+class GlobalSearchDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for GlobalSearchDialog
+     * @param filePath Path to the SQL database file to search
+     * @param tableNames Tables to search
+     * @param parent Parent widget pointer
+     */
+    GlobalSearchDialog(const QString &filePath, const QStringList &tableNames, QWidget *parent = nullptr);
+
+    /**
+     * @brief Destructor cancels a running search
+     */
+    ~GlobalSearchDialog() override;
+
+    /**
+     * @brief Cancel and dispose of running search tasks, keeping the hits listed so far
+     */
+    void Stop();
+
+signals:
+    /**
+     * @brief Emitted when the user opens a hit
+     * @param tableName Table of the hit
+     * @param rowId Row id of the hit
+     */
+    void HitActivated(const QString &tableName, qint64 rowId);
+
+private slots:
+    /**
+     * @brief Start searching for the text in the search box, or cancel the running search
+     */
+    void OnSearchClicked();
+
+    /**
+     * @brief Forward the double-clicked hit to the main window
+     * @param row Result row that was double-clicked
+     */
+    void OnResultDoubleClicked(int row);
+
+private:
+    /**
+     * @brief Append a batch of hits to the result list
+     * @param hits Hits to list
+     */
+    void AppendHits(const QVector<GlobalSearchHit> &hits);
+
+    /**
+     * @brief Count a finished table and update the status line
+     * @param tableName Table that was searched
+     * @param hitCount Hits found in the table
+     * @param complete true if every row was searched, false if the scan stopped early
+     */
+    void OnTableSearched(const QString &tableName, int hitCount, bool complete);
+
+    /**
+     * @brief Dispose of a finished task and show the summary once all tasks are done
+     * @param task Task that finished
+     * @param success true if the task searched its tables, false otherwise
+     * @param message Summary or error reported by the task
+     */
+    void OnTaskFinished(GlobalSearchTask *task, bool success, const QString &message);
+
+    /**
+     * @brief Show searched tables, hits and incomplete tables in the status line
+     */
+    void UpdateStatus();
+
+    QString FilePath;                    // File of the searched tables
+    QStringList TableNames;              // Tables searched
+    QLineEdit *SearchEdit;               // Text to find
+    QPushButton *SearchButton;           // Starts or cancels the search
+    QLabel *StatusLabel;                 // Progress or summary of the search
+    QTableWidget *ResultTable;           // One row per hit: table, row id, column
+    QList<GlobalSearchTask *> RunningTasks;  // Tasks still searching (empty if idle)
+    int SearchedTableCount;              // Tables finished in the current search
+    QStringList IncompleteTables;        // Tables not fully searched (time budget, hit limit or no row ids)
+
+    static const int MAX_PARALLEL_TASKS;  // Upper bound of concurrent read connections
+};
+
+#endif // GLOBALSEARCHDIALOG_H
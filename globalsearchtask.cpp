@@ -0,0 +1,205 @@
+#include "globalsearchtask.h"
+#include "sqlworker.h"
+
+// Define global search constants
+const qint64 GlobalSearchTask::TABLE_TIME_BUDGET_MS = 5000;
+const int GlobalSearchTask::MAX_HITS_PER_TABLE = 1000;
+const int GlobalSearchTask::HITS_PER_BATCH = 200;
+
+/**
+ * @brief Constructor initializes GlobalSearchQueue with the tables to search
+ */
+GlobalSearchQueue::GlobalSearchQueue(const QStringList &tableNames)
+    : Mutex()                          // Queue lock
+    , TableNames(tableNames)           // Tables not yet taken
+{
+}
+
+/**
+ * @brief Take the next table to search
+ */
+bool GlobalSearchQueue::TakeNext(QString &tableName)
+{
+    QMutexLocker _locker(&Mutex);  // Held while the list is changed
+    if (TableNames.isEmpty()) {
+        return false;
+    }
+    tableName = TableNames.takeFirst();
+    return true;
+}
+
+/**
+ * @brief Constructor initializes GlobalSearchTask with the shared queue and the text
+ */
+GlobalSearchTask::GlobalSearchTask(const QString &filePath, const QSharedPointer<GlobalSearchQueue> &queue, const QString &text)
+    : DatabaseTask(filePath)
+    , Queue(queue)                     // Shared table queue
+    , Pattern()                        // LIKE pattern (built below)
+    , TableTimer()                     // No table being searched
+{
+    // The text is matched literally, so LIKE wildcards in it are escaped
+    QString _escaped = text;  // Text with wildcards escaped
+    _escaped.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+    Pattern = "%" + _escaped + "%";
+
+    // Hit batches cross from the task thread to the GUI thread
+    qRegisterMetaType<QVector<GlobalSearchHit>>("QVector<GlobalSearchHit>");
+}
+
+/**
+ * @brief Search tables from the queue until it is empty
+ * @param database Open connection owned by the task thread
+ * @param message Output summary or error description
+ * @return true if every table taken was searched or skipped, false if cancelled
+ */
+bool GlobalSearchTask::Run(QSqlDatabase &database, QString &message)
+{
+    QString _tableName;  // Table taken from the queue
+    int _tableCount = 0;  // Tables searched by this task
+    while (!IsCancelled() && Queue->TakeNext(_tableName)) {
+        emit ProgressChanged(-1, QString("Searching %1").arg(_tableName));
+
+        int _hitCount = 0;  // Hits reported for the table
+        bool _complete = SearchTable(database, _tableName, _hitCount);  // Every row of the table searched
+        if (IsCancelled()) {
+            break;
+        }
+
+        emit TableSearched(_tableName, _hitCount, _complete);
+        _tableCount++;
+    }
+
+    if (IsCancelled()) {
+        message = "Search cancelled";
+        return false;
+    }
+
+    message = QString("Searched %1 table(s)").arg(_tableCount);
+    return true;
+}
+
+/**
+ * @brief Interrupt the scan of a table that ran out of time
+ */
+bool GlobalSearchTask::ShouldInterrupt()
+{
+    return TableTimer.isValid() && TableTimer.hasExpired(TABLE_TIME_BUDGET_MS);
+}
+
+/**
+ * @brief Search the text columns of one table
+ * One LIKE per text column is evaluated in a single scan; a flag per column tells
+ * which of the columns of a matching row contain the text
+ */
+bool GlobalSearchTask::SearchTable(QSqlDatabase &database, const QString &tableName, int &hitCount)
+{
+    hitCount = 0;
+    QStringList _columns = GetTextColumns(database, tableName);  // Columns that can hold text
+    if (_columns.isEmpty()) {
+        return true;
+    }
+
+    QString _quotedTable = SQLWorker::QuoteIdentifier(tableName);  // Quoted table name
+    QSqlQuery _query(database);  // Query object for the scan
+    _query.setForwardOnly(true);
+
+    // Hits are reported by row id, which WITHOUT ROWID tables do not have
+    if (!_query.prepare(QString("SELECT rowid FROM %1 LIMIT 0").arg(_quotedTable))) {
+        qDebug() << "Error: Table" << tableName << "has no row ids and is not searched";
+        return false;
+    }
+
+    QStringList _flags;    // "column LIKE ?" per text column
+    QStringList _matches;  // Outer condition: any flag set
+    for (int _i = 0; _i < _columns.size(); ++_i) {
+        _flags.append(QString("(%1 LIKE ? ESCAPE '\\') AS m%2").arg(SQLWorker::QuoteIdentifier(_columns[_i])).arg(_i));
+        _matches.append(QString("m%1").arg(_i));
+    }
+    QString _queryString = QString("SELECT * FROM (SELECT rowid AS r, %1 FROM %2) WHERE %3")
+                               .arg(_flags.join(", "), _quotedTable, _matches.join(" OR "));  // Complete scan query string
+
+    if (!_query.prepare(_queryString)) {
+        qDebug() << "Error: Failed to prepare search of table" << tableName;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return false;
+    }
+    for (int _i = 0; _i < _columns.size(); ++_i) {
+        _query.addBindValue(Pattern);
+    }
+
+    // The budget also covers time SQLite spends stepping over rows that do not match
+    TableTimer.start();
+    bool _success = _query.exec();  // Result of starting the scan
+    bool _limitReached = false;     // Hit limit stopped the scan
+    QVector<GlobalSearchHit> _batch;  // Hits not yet sent to the GUI
+    _batch.reserve(HITS_PER_BATCH);
+
+    while (_success && !_limitReached && _query.next()) {
+        qint64 _rowId = _query.value(0).toLongLong();  // Row id of the matching row
+        for (int _i = 0; _i < _columns.size(); ++_i) {
+            if (!_query.value(_i + 1).toBool()) {
+                continue;
+            }
+
+            GlobalSearchHit _hit;  // Matching cell
+            _hit.TableName = tableName;
+            _hit.RowId = _rowId;
+            _hit.ColumnName = _columns[_i];
+            _batch.append(_hit);
+
+            if (++hitCount >= MAX_HITS_PER_TABLE) {
+                _limitReached = true;
+                break;
+            }
+        }
+
+        if (_batch.size() >= HITS_PER_BATCH) {
+            emit HitsFound(_batch);
+            _batch.clear();
+        }
+    }
+
+    bool _stopped = !_success || _query.lastError().isValid();  // Scan ended by an error or an interrupt
+    bool _timedOut = _stopped && ShouldInterrupt();  // Interrupted by the time budget
+    TableTimer.invalidate();
+
+    if (_stopped && !_timedOut && !IsCancelled()) {
+        qDebug() << "Error: Failed to search table" << tableName;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        _success = false;
+    }
+
+    if (!_batch.isEmpty() && !IsCancelled()) {
+        emit HitsFound(_batch);
+    }
+    return _success && !_limitReached && !_timedOut;
+}
+
+/**
+ * @brief Get the columns of a table that can hold text
+ */
+QStringList GlobalSearchTask::GetTextColumns(QSqlDatabase &database, const QString &tableName)
+{
+    QStringList _columns;  // Searched columns in declaration order
+    QSqlQuery _query(database);  // Query object for the schema lookup
+    if (!_query.exec(QString("PRAGMA table_info(%1)").arg(SQLWorker::QuoteIdentifier(tableName)))) {
+        qDebug() << "Error: Failed to read columns of table" << tableName;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return _columns;
+    }
+
+    while (_query.next()) {
+        QString _type = _query.value(2).toString().toUpper();  // Declared type is in third field (index 2)
+        // Affinity rules of SQLite, applied in its order: INT wins over the text markers, so "POINT" is integer
+        bool _textAffinity = _type.contains("CHAR") || _type.contains("CLOB") || _type.contains("TEXT");  // Column stores text as text
+        bool _integerAffinity = _type.contains("INT");  // Text that looks like a number is stored as an integer
+        bool _blobAffinity = _type.contains("BLOB");  // Values are stored as given (an empty type also is, but may hold text)
+        bool _realAffinity = _type.contains("REAL") || _type.contains("FLOA") || _type.contains("DOUB");  // Numbers are stored as floats
+        // NUMERIC affinity (DATE, DATETIME, BOOLEAN, JSON...) keeps text that is not a number, so it is searched
+        bool _skipped = _integerAffinity || (!_textAffinity && (_blobAffinity || _realAffinity));  // Column cannot hold searchable text
+        if (!_skipped) {
+            _columns.append(_query.value(1).toString());  // Column name is in second field (index 1)
+        }
+    }
+    return _columns;
+}
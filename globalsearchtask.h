@@ -0,0 +1,121 @@
+#ifndef GLOBALSEARCHTASK_H
+#define GLOBALSEARCHTASK_H
+
+#include <QStringList>
+#include <QVector>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QElapsedTimer>
+#include "databasetask.h"
+
+/**
+ * @brief One cell containing the searched text
+ */
+struct GlobalSearchHit {
+    QString TableName;                   // Table of the row
+    qint64 RowId = 0;                    // Row id of the row
+    QString ColumnName;                  // Column whose value contains the text
+};
+
+/**
+ * @brief Tables still waiting to be searched, shared by all tasks of one search
+ * Each task takes the next table when it is done with the previous one, so a
+ * large table keeps one connection busy while the others work through the rest
+ */
+class GlobalSearchQueue
+{
+public:
+    /**
+     * @brief Constructor for GlobalSearchQueue
+     * @param tableNames Tables to search in order
+     */
+    explicit GlobalSearchQueue(const QStringList &tableNames);
+
+    /**
+     * @brief Take the next table to search
+     * @param tableName Output name of the table
+     * @return true if a table was taken, false if the queue is empty
+     */
+    bool TakeNext(QString &tableName);
+
+private:
+    QMutex Mutex;                        // Guards TableNames across task threads
+    QStringList TableNames;              // Tables not yet taken
+};
+
+/**
+ * @brief Background search of the text columns of several tables for a substring
+ * Several tasks share one GlobalSearchQueue, each on its own read connection; hits
+ * are streamed to the GUI in batches while a table is still being scanned
+ */
+class GlobalSearchTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for GlobalSearchTask
+     * @param filePath Path to the SQL database file containing the tables
+     * @param queue Tables to search, shared with the other tasks of the search
+     * @param text Text to find (case-insensitive for ASCII letters, like LIKE)
+     */
+    GlobalSearchTask(const QString &filePath, const QSharedPointer<GlobalSearchQueue> &queue, const QString &text);
+
+    static const qint64 TABLE_TIME_BUDGET_MS;  // Time one table may take before its scan is interrupted
+    static const int MAX_HITS_PER_TABLE;       // Hits reported per table before its scan stops
+
+signals:
+    /**
+     * @brief Emitted from the task thread with the next batch of hits
+     * @param hits Cells containing the text
+     */
+    void HitsFound(const QVector<GlobalSearchHit> &hits);
+
+    /**
+     * @brief Emitted from the task thread when a table is done
+     * @param tableName Table that was searched
+     * @param hitCount Hits reported for the table
+     * @param complete true if every row was searched, false if the time budget or hit limit stopped the scan
+     */
+    void TableSearched(const QString &tableName, int hitCount, bool complete);
+
+protected:
+    /**
+     * @brief Search tables from the queue until it is empty
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if every table taken was searched or skipped, false if cancelled
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+    /**
+     * @brief Interrupt the scan of a table that ran out of time
+     */
+    bool ShouldInterrupt() override;
+
+private:
+    /**
+     * @brief Search the text columns of one table
+     * @param database Open connection owned by the task thread
+     * @param tableName Table to search
+     * @param hitCount Output number of hits reported
+     * @return true if every row was searched, false if the scan stopped early or failed
+     */
+    bool SearchTable(QSqlDatabase &database, const QString &tableName, int &hitCount);
+
+    /**
+     * @brief Get the columns of a table that can hold text
+     * Only columns with INTEGER, REAL or BLOB affinity are skipped; text, NUMERIC (dates,
+     * booleans, JSON) and untyped columns are searched
+     * @return Column names in declaration order
+     */
+    QStringList GetTextColumns(QSqlDatabase &database, const QString &tableName);
+
+    QSharedPointer<GlobalSearchQueue> Queue;  // Tables shared with the other tasks of the search
+    QString Pattern;                     // LIKE pattern matching the text anywhere in a value
+    QElapsedTimer TableTimer;            // Time spent on the current table (invalid between tables)
+
+    static const int HITS_PER_BATCH;     // Hits collected before they are sent to the GUI
+};
+
+#endif // GLOBALSEARCHTASK_H
@@ -0,0 +1,119 @@
+#include "integritychecktask.h"
+#include "sqlworker.h"
+
+/**
+ * @brief Constructor initializes IntegrityCheckTask with scan settings
+ */
+IntegrityCheckTask::IntegrityCheckTask(const QString &filePath, CheckMode mode, int maxErrors)
+    : DatabaseTask(filePath)
+    , Mode(mode)                       // Scan depth
+    , MaxErrors(qMax(1, maxErrors))    // Early stop threshold
+    , Errors()                         // Problems found
+{
+}
+
+/**
+ * @brief Get all problems reported so far
+ */
+QStringList IntegrityCheckTask::GetErrors() const
+{
+    return Errors;
+}
+
+/**
+ * @brief Run the selected integrity scan on the background connection
+ * @param database Open connection owned by the task thread
+ * @param message Output summary of the scan
+ * @return true if the scan ran to completion (even if problems were found), false otherwise
+ */
+bool IntegrityCheckTask::Run(QSqlDatabase &database, QString &message)
+{
+    if (Mode == FullCheck) {
+        // A full check cannot be split per table without skipping free list verification
+        emit ProgressChanged(-1, "Running full integrity check");
+        if (!RunCheckPragma(database, QString("PRAGMA integrity_check(%1)").arg(MaxErrors))) {
+            message = "Integrity check could not be executed";
+            return false;
+        }
+    } else {
+        // Collect table names first so progress can be reported per table
+        QStringList _tableNames;  // All tables in the file, including internal ones
+        QSqlQuery _tablesQuery(database);  // Query object for schema listing
+        if (!_tablesQuery.exec("SELECT name FROM sqlite_master WHERE type='table'")) {
+            message = "Cannot read database schema: " + _tablesQuery.lastError().text();
+            ReportError(message);
+            return false;
+        }
+        while (_tablesQuery.next()) {
+            _tableNames.append(_tablesQuery.value(0).toString());
+        }
+
+        for (int _i = 0; _i < _tableNames.size(); ++_i) {  // Current table index (0-based)
+            if (IsCancelled() || Errors.size() >= MaxErrors) {
+                break;
+            }
+
+            emit ProgressChanged(_i * 100 / _tableNames.size(), QString("Checking table %1").arg(_tableNames[_i]));
+
+            QString _pragmaText = QString("PRAGMA quick_check(%1)").arg(SQLWorker::QuoteIdentifier(_tableNames[_i]));  // Per-table quick check
+            if (!RunCheckPragma(database, _pragmaText)) {
+                break;
+            }
+        }
+    }
+
+    if (IsCancelled()) {
+        return false;
+    }
+
+    emit ProgressChanged(100, "Integrity check finished");
+
+    if (Errors.isEmpty()) {
+        message = "Integrity check passed";
+    } else if (Errors.size() >= MaxErrors) {
+        message = QString("Integrity check stopped after %1 problem(s)").arg(Errors.size());
+    } else {
+        message = QString("Integrity check found %1 problem(s)").arg(Errors.size());
+    }
+
+    qDebug() << message;
+    return true;
+}
+
+/**
+ * @brief Execute one check PRAGMA and report its rows
+ */
+bool IntegrityCheckTask::RunCheckPragma(QSqlDatabase &database, const QString &pragmaText)
+{
+    QSqlQuery _query(database);  // Query object for the check PRAGMA
+    _query.setForwardOnly(true);
+
+    if (!_query.exec(pragmaText)) {
+        // A file too damaged to run the check is itself a problem worth reporting
+        ReportError(QString("%1 failed: %2").arg(pragmaText, _query.lastError().text()));
+        return false;
+    }
+
+    while (_query.next() && !IsCancelled()) {  // Each row is either "ok" or one problem description
+        QString _rowText = _query.value(0).toString();  // Result text reported by SQLite
+        if (_rowText == "ok") {
+            continue;
+        }
+
+        ReportError(_rowText);
+        if (Errors.size() >= MaxErrors) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Record and report a single problem
+ */
+void IntegrityCheckTask::ReportError(const QString &errorText)
+{
+    Errors.append(errorText);
+    emit ErrorFound(errorText);
+}
@@ -0,0 +1,70 @@
+#ifndef INTEGRITYCHECKTASK_H
+#define INTEGRITYCHECKTASK_H
+
+#include <QStringList>
+#include "databasetask.h"
+
+/**
+ * @brief Background integrity scan of a database file
+ * Runs quick_check table by table or a full integrity_check on a separate
+ * connection, streaming every problem found and stopping after a maximum
+ */
+class IntegrityCheckTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Integrity scan depth
+     */
+    enum CheckMode {
+        QuickCheck,                      // PRAGMA quick_check per table (skips index content verification)
+        FullCheck                        // PRAGMA integrity_check over the whole file
+    };
+
+    /**
+     * @brief Constructor for IntegrityCheckTask
+     * @param filePath Path to the SQL database file to scan
+     * @param mode Scan depth to run
+     * @param maxErrors Stop after this many problems have been reported
+     */
+    IntegrityCheckTask(const QString &filePath, CheckMode mode, int maxErrors);
+
+    /**
+     * @brief Get all problems reported so far
+     * @return QStringList containing error descriptions (empty if file is healthy)
+     */
+    QStringList GetErrors() const;
+
+signals:
+    /**
+     * @brief Emitted for every problem as soon as it is found
+     * @param errorText Description reported by SQLite
+     */
+    void ErrorFound(const QString &errorText);
+
+protected:
+    /**
+     * @brief Run the selected integrity scan on the background connection
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    /**
+     * @brief Execute one check PRAGMA and report its rows
+     * @param pragmaText Complete PRAGMA statement to run
+     * @return false if the PRAGMA itself failed, true otherwise
+     */
+    bool RunCheckPragma(QSqlDatabase &database, const QString &pragmaText);
+
+    /**
+     * @brief Record and report a single problem
+     */
+    void ReportError(const QString &errorText);
+
+    CheckMode Mode;                      // Scan depth selected by the caller
+    int MaxErrors;                       // Maximum number of problems to report before stopping
+    QStringList Errors;                  // Problems found so far (written by task thread, read after Finished)
+};
+
+#endif // INTEGRITYCHECKTASK_H
@@ -0,0 +1,109 @@
+#include "jsonlinesexporttask.h"
+#include "jsonlineswriter.h"
+#include "sqlworker.h"
+#include <QSqlRecord>
+
+// Define JSON Lines export constants
+const int JsonLinesExportTask::PROGRESS_INTERVAL_ROWS = 100000;
+
+/**
+ * @brief Constructor initializes JsonLinesExportTask with the query and the output file
+ */
+JsonLinesExportTask::JsonLinesExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                                         const QString &outputPath, CompressingDevice::Codec codec)
+    : DatabaseTask(filePath)
+    , QueryString(queryString)         // Exported rows
+    , BindValues(bindValues)           // Placeholder values
+    , OutputPath(outputPath)           // JSON Lines file
+    , Codec(codec)                     // File compression
+    , RowCount(0)                      // No row written
+{
+}
+
+/**
+ * @brief Get the number of rows written so far
+ */
+qint64 JsonLinesExportTask::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Run the query and write its rows
+ */
+bool JsonLinesExportTask::Run(QSqlDatabase &database, QString &message)
+{
+    // A searched view reads its row ids from the index file, which this connection must attach itself
+    if (!SQLWorker::AttachSearchIndexFile(database, FilePath)) {
+        message = "Cannot open search index file of " + FilePath;
+        return false;
+    }
+
+    QSqlQuery _query(database);  // Forward-only cursor over the exported rows
+    _query.setForwardOnly(true);
+    if (!_query.prepare(QueryString)) {
+        message = "Cannot prepare export query: " + _query.lastError().text();
+        return false;
+    }
+    for (int _i = 0; _i < BindValues.size(); ++_i) {
+        _query.bindValue(_i, BindValues[_i]);
+    }
+    if (!_query.exec()) {
+        message = "Export query failed: " + _query.lastError().text();
+        return false;
+    }
+
+    QSqlRecord _record = _query.record();  // Result columns of the cursor
+    const int _columnCount = _record.count();  // Values per row
+    QStringList _names;  // Object keys in column order
+    for (int _col = 0; _col < _columnCount; ++_col) {
+        _names.append(_record.fieldName(_col));
+    }
+
+    // Rows are encoded on this thread while the device compresses and writes on its pipeline thread
+    CompressingDevice _file(OutputPath, Codec);  // Output file
+    if (!_file.open(QIODevice::WriteOnly)) {
+        message = QString("Cannot open %1: %2").arg(OutputPath, _file.errorString());
+        return false;
+    }
+
+    bool _written = false;  // Every row reached the file
+    {
+        // Only the current row is held; each value goes from SQLite into the write buffer
+        JsonLinesWriter _writer(&_file, _names);  // Encoder writing objects straight into the file
+        while (!_writer.HasError() && !IsCancelled() && _query.next()) {
+            for (int _col = 0; _col < _columnCount; ++_col) {
+                _writer.WriteValue(_query.value(_col));
+            }
+            _writer.EndRow();
+
+            if (++RowCount % PROGRESS_INTERVAL_ROWS == 0) {
+                emit ProgressChanged(-1, QString("%1 rows written to JSON Lines").arg(RowCount.load()));
+            }
+        }
+
+        if (IsCancelled()) {
+            message = "Export cancelled";
+        } else if (_query.lastError().isValid()) {
+            message = "Export query failed: " + _query.lastError().text();
+        } else if (!_writer.Flush()) {
+            message = QString("Cannot write %1: %2").arg(OutputPath, _file.errorString());
+        } else {
+            _written = true;
+        }
+    }
+
+    if (_written && !_file.Finish()) {
+        message = QString("Cannot write %1: %2").arg(OutputPath, _file.errorString());
+        _written = false;
+    }
+
+    // Partial exports would look complete to line-oriented consumers, so they are removed
+    if (!_written) {
+        _file.Remove();
+        return false;
+    }
+
+    message = QString("%1 rows written to %2").arg(RowCount.load()).arg(OutputPath);
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef JSONLINESEXPORTTASK_H
+#define JSONLINESEXPORTTASK_H
+
+#include <QStringList>
+#include <QVariantList>
+#include <atomic>
+#include "databasetask.h"
+#include "compressingdevice.h"
+
+/**
+ * @brief Background export of the rows of one query to a JSON Lines file
+ * Rows are stepped on the task's own connection and encoded by a JsonLinesWriter,
+ * one object per row keyed by column name
+ */
+class JsonLinesExportTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for JsonLinesExportTask
+     * @param filePath Path to the SQL database file to read
+     * @param queryString SELECT statement returning the exported rows
+     * @param bindValues Values for the placeholders of the statement in order
+     * @param outputPath Path of the JSON Lines file to write
+     * @param codec Compression of the file
+     */
+    JsonLinesExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                        const QString &outputPath, CompressingDevice::Codec codec);
+
+    /**
+     * @brief Get the number of rows written so far (safe to call while running)
+     * @return Rows written
+     */
+    qint64 GetRowCount() const;
+
+protected:
+    /**
+     * @brief Run the query and write its rows
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if every row was written, false otherwise
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    QString QueryString;                 // SELECT statement of the exported rows
+    QVariantList BindValues;             // Placeholder values of the statement
+    QString OutputPath;                  // JSON Lines file written by the task
+    CompressingDevice::Codec Codec;      // Compression of the file
+    std::atomic<qint64> RowCount;        // Rows written so far
+
+    static const int PROGRESS_INTERVAL_ROWS;  // Rows between progress reports
+};
+
+#endif // JSONLINESEXPORTTASK_H
@@ -0,0 +1,355 @@
+#include "jsonlinesreader.h"
+#include <QDebug>
+
+/**
+ * @brief Constructor initializes JsonLinesReader with the columns keys are matched against
+ */
+JsonLinesReader::JsonLinesReader(QIODevice *device, const QStringList &columnNames, const QStringList &declaredTypes)
+    : Device(device)                   // Input device
+    , ColumnIndex()                    // Filled below
+    , BlobColumns(columnNames.size())  // Filled below
+    , UnknownKeys()                    // No unknown keys yet
+    , KeyBytes()                       // Reused key buffer
+    , StringBytes()                    // Reused string buffer
+    , LineNumber(0)                    // Nothing read
+    , ErrorString()                    // No error
+{
+    for (int _col = 0; _col < columnNames.size(); ++_col) {
+        ColumnIndex.insert(columnNames[_col].toUtf8(), _col);
+        BlobColumns[_col] = declaredTypes.value(_col).toUpper().contains("BLOB");
+    }
+}
+
+/**
+ * @brief Read the next non-empty line as a row
+ */
+bool JsonLinesReader::ReadRow(QVariantList &values, QVector<bool> &present)
+{
+    if (!ErrorString.isEmpty()) {
+        return false;
+    }
+
+    while (!Device->atEnd()) {
+        QByteArray _line = Device->readLine();  // Next line including its line break
+        LineNumber++;
+
+        const char *_p = _line.constData();  // Parse position
+        const char *_end = _p + _line.size();  // End of the line
+        if (LineNumber == 1 && _line.startsWith("\xEF\xBB\xBF")) {
+            _p += 3;
+        }
+        SkipWhitespace(_p, _end);
+        if (_p == _end) {
+            continue;
+        }
+
+        values = QVariantList();
+        values.reserve(BlobColumns.size());
+        for (int _col = 0; _col < BlobColumns.size(); ++_col) {
+            values.append(QVariant());
+        }
+        present.fill(false, BlobColumns.size());
+        return ParseObject(_p, _end, values, present);
+    }
+    return false;
+}
+
+/**
+ * @brief Check if reading stopped at a line that is not a valid JSON object
+ */
+bool JsonLinesReader::HasError() const
+{
+    return !ErrorString.isEmpty();
+}
+
+/**
+ * @brief Get the description of the parse error
+ */
+QString JsonLinesReader::GetErrorString() const
+{
+    return ErrorString;
+}
+
+/**
+ * @brief Get the number of the last line read
+ */
+qint64 JsonLinesReader::GetLineNumber() const
+{
+    return LineNumber;
+}
+
+/**
+ * @brief Get the object keys that matched no column
+ */
+QStringList JsonLinesReader::GetUnknownKeys() const
+{
+    return UnknownKeys.values();
+}
+
+/**
+ * @brief Parse the object of one line
+ */
+bool JsonLinesReader::ParseObject(const char *&p, const char *end, QVariantList &values, QVector<bool> &present)
+{
+    if (*p != '{') {
+        return Fail("Expected '{' at the start of the line");
+    }
+    ++p;
+    SkipWhitespace(p, end);
+    bool _empty = p < end && *p == '}';  // Object has no members
+
+    while (!_empty) {
+        SkipWhitespace(p, end);
+        if (p == end || *p != '"') {
+            return Fail("Expected a key string");
+        }
+        ++p;
+        if (!ParseString(p, end, KeyBytes)) {
+            return false;
+        }
+        SkipWhitespace(p, end);
+        if (p == end || *p != ':') {
+            return Fail("Expected ':' after a key");
+        }
+        ++p;
+        SkipWhitespace(p, end);
+
+        // Values of unknown keys are parsed into a scratch variant to find their end
+        int _col = ColumnIndex.value(KeyBytes, -1);  // Column of the key (-1 if none)
+        QVariant _unknownValue;  // Value of a key without column
+        if (_col < 0) {
+            UnknownKeys.insert(QString::fromUtf8(KeyBytes));
+        }
+        if (!ParseValue(p, end, _col >= 0 && BlobColumns[_col], _col >= 0 ? values[_col] : _unknownValue)) {
+            return false;
+        }
+        if (_col >= 0) {
+            present[_col] = true;
+        }
+
+        SkipWhitespace(p, end);
+        if (p < end && *p == ',') {
+            ++p;
+            continue;
+        }
+        break;
+    }
+
+    if (p == end || *p != '}') {
+        return Fail("Expected ',' or '}' after a value");
+    }
+    ++p;
+    SkipWhitespace(p, end);
+    if (p != end) {
+        return Fail("Unexpected characters after the object");
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a value into the QVariant of a column
+ */
+bool JsonLinesReader::ParseValue(const char *&p, const char *end, bool isBlob, QVariant &value)
+{
+    if (p == end) {
+        return Fail("Expected a value");
+    }
+
+    switch (*p) {
+    case '"':
+        ++p;
+        if (!ParseString(p, end, StringBytes)) {
+            return false;
+        }
+        value = isBlob ? QVariant(QByteArray::fromBase64(StringBytes)) : QVariant(QString::fromUtf8(StringBytes));
+        return true;
+    case '{':
+    case '[': {
+        const char *_start = p;  // Start of the nested JSON text
+        if (!SkipNested(p, end)) {
+            return false;
+        }
+        value = QString::fromUtf8(_start, static_cast<int>(p - _start));
+        return true;
+    }
+    case 'n':
+        if (end - p >= 4 && qstrncmp(p, "null", 4) == 0) {
+            p += 4;
+            value = QVariant();
+            return true;
+        }
+        break;
+    case 't':
+        if (end - p >= 4 && qstrncmp(p, "true", 4) == 0) {
+            p += 4;
+            value = QVariant(qint64(1));
+            return true;
+        }
+        break;
+    case 'f':
+        if (end - p >= 5 && qstrncmp(p, "false", 5) == 0) {
+            p += 5;
+            value = QVariant(qint64(0));
+            return true;
+        }
+        break;
+    default: {
+        const char *_start = p;  // Start of the number
+        bool _integral = true;   // No fraction or exponent seen
+        while (p < end && ((*p >= '0' && *p <= '9') || *p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E')) {
+            _integral = _integral && *p != '.' && *p != 'e' && *p != 'E';
+            ++p;
+        }
+        QByteArray _number = QByteArray::fromRawData(_start, static_cast<int>(p - _start));  // Number text
+        bool _ok = false;  // Text is a valid number
+        if (_integral) {
+            qint64 _integer = _number.toLongLong(&_ok);  // Integer value
+            if (_ok) {
+                value = QVariant(_integer);
+                return true;
+            }
+        }
+        // Fractions, exponents and integers beyond 64 bits
+        double _real = _number.toDouble(&_ok);  // Real value
+        if (_ok) {
+            value = QVariant(_real);
+            return true;
+        }
+        break;
+    }
+    }
+    return Fail("Invalid value");
+}
+
+/**
+ * @brief Parse a string after its opening quote, decoding the escapes to UTF-8
+ * Runs without escapes are copied at once
+ */
+bool JsonLinesReader::ParseString(const char *&p, const char *end, QByteArray &utf8)
+{
+    utf8.resize(0);
+    const char *_start = p;  // First byte not copied yet
+    while (p < end) {
+        if (*p == '"') {
+            utf8.append(_start, static_cast<int>(p - _start));
+            ++p;
+            return true;
+        }
+        if (*p != '\\') {
+            ++p;
+            continue;
+        }
+
+        utf8.append(_start, static_cast<int>(p - _start));
+        if (end - p < 2) {
+            break;
+        }
+        char _escape = p[1];  // Character after the backslash
+        p += 2;
+        switch (_escape) {
+        case '"':  utf8.append('"');  break;
+        case '\\': utf8.append('\\'); break;
+        case '/':  utf8.append('/');  break;
+        case 'b':  utf8.append('\b'); break;
+        case 'f':  utf8.append('\f'); break;
+        case 'n':  utf8.append('\n'); break;
+        case 'r':  utf8.append('\r'); break;
+        case 't':  utf8.append('\t'); break;
+        case 'u': {
+            bool _ok = false;  // Four hex digits follow
+            quint32 _codePoint = end - p >= 4 ? QByteArray::fromRawData(p, 4).toUInt(&_ok, 16) : 0;  // UTF-16 unit
+            if (!_ok) {
+                return Fail("Invalid \\u escape");
+            }
+            p += 4;
+            // A high surrogate combines with the low surrogate escape that follows it
+            if (_codePoint >= 0xD800 && _codePoint < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                quint32 _low = QByteArray::fromRawData(p + 2, 4).toUInt(&_ok, 16);  // Second UTF-16 unit
+                if (_ok && _low >= 0xDC00 && _low < 0xE000) {
+                    _codePoint = 0x10000 + ((_codePoint - 0xD800) << 10) + (_low - 0xDC00);
+                    p += 6;
+                }
+            }
+            if (_codePoint >= 0xD800 && _codePoint < 0xE000) {
+                _codePoint = 0xFFFD;  // Unpaired surrogate
+            }
+            AppendUtf8(_codePoint, utf8);
+            break;
+        }
+        default:
+            return Fail("Invalid escape in string");
+        }
+        _start = p;
+    }
+    return Fail("Unterminated string");
+}
+
+/**
+ * @brief Skip a nested object or array, respecting strings
+ */
+bool JsonLinesReader::SkipNested(const char *&p, const char *end)
+{
+    int _depth = 0;  // Open brackets
+    while (p < end) {
+        char _c = *p++;  // Current character
+        if (_c == '"') {
+            // Escaped characters are skipped with their backslash
+            while (p < end && *p != '"') {
+                p += *p == '\\' ? 2 : 1;
+            }
+            if (p >= end) {
+                break;
+            }
+            ++p;
+        } else if (_c == '{' || _c == '[') {
+            _depth++;
+        } else if (_c == '}' || _c == ']') {
+            if (--_depth == 0) {
+                return true;
+            }
+        }
+    }
+    return Fail("Unterminated nested value");
+}
+
+/**
+ * @brief Record a parse error at the current line
+ */
+bool JsonLinesReader::Fail(const QString &message)
+{
+    ErrorString = QString("Line %1: %2").arg(LineNumber).arg(message);
+    qDebug() << "Error: Invalid JSON Lines input:" << ErrorString;
+    return false;
+}
+
+/**
+ * @brief Skip JSON whitespace
+ */
+void JsonLinesReader::SkipWhitespace(const char *&p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+        ++p;
+    }
+}
+
+/**
+ * @brief Append a code point as UTF-8
+ */
+void JsonLinesReader::AppendUtf8(quint32 codePoint, QByteArray &utf8)
+{
+    if (codePoint < 0x80) {
+        utf8.append(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        utf8.append(static_cast<char>(0xC0 | (codePoint >> 6)));
+        utf8.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        utf8.append(static_cast<char>(0xE0 | (codePoint >> 12)));
+        utf8.append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        utf8.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        utf8.append(static_cast<char>(0xF0 | (codePoint >> 18)));
+        utf8.append(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        utf8.append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        utf8.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
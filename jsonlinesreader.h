@@ -0,0 +1,115 @@
+#ifndef JSONLINESREADER_H
+#define JSONLINESREADER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+/**
+ * @brief Streaming JSON Lines (NDJSON) decoder reading one object per line into column values
+ * Lines are read and parsed one at a time, so memory does not depend on the file size.
+ * The parser is hand-written for flat objects: integers keep their full 64 bits (QJsonValue
+ * would round them through double), strings are decoded straight to UTF-8, and nested
+ * objects or arrays are kept as their JSON text
+ */
+class JsonLinesReader
+{
+public:
+    /**
+     * @brief Constructor for JsonLinesReader
+     * Strings of columns whose declared type contains BLOB are decoded from base64, matching
+     * what JsonLinesWriter writes for BLOB values
+     * @param device Open input device (not owned, must outlive the reader)
+     * @param columnNames Column names the object keys are matched against
+     * @param declaredTypes Declared SQLite types in column order (empty string if none)
+     */
+    JsonLinesReader(QIODevice *device, const QStringList &columnNames, const QStringList &declaredTypes);
+
+    /**
+     * @brief Read the next non-empty line as a row
+     * JSON numbers become qint64 when integral and in range, otherwise double; true and false
+     * become 1 and 0 and null a null QVariant
+     * @param values Output value per column (null if absent)
+     * @param present Output flag per column, true if the object has its key
+     * @return true if a row was read, false at the end of the input or on a parse error
+     */
+    bool ReadRow(QVariantList &values, QVector<bool> &present);
+
+    /**
+     * @brief Check if reading stopped at a line that is not a valid JSON object
+     * @return true after a parse error, false otherwise
+     */
+    bool HasError() const;
+
+    /**
+     * @brief Get the description of the parse error
+     * @return Error text including the line number (empty if none)
+     */
+    QString GetErrorString() const;
+
+    /**
+     * @brief Get the number of the last line read (1-based)
+     * @return Line number
+     */
+    qint64 GetLineNumber() const;
+
+    /**
+     * @brief Get the object keys that matched no column
+     * @return Distinct unknown keys
+     */
+    QStringList GetUnknownKeys() const;
+
+private:
+    /**
+     * @brief Parse the object of one line
+     * @return true if the line holds exactly one object, false otherwise
+     */
+    bool ParseObject(const char *&p, const char *end, QVariantList &values, QVector<bool> &present);
+
+    /**
+     * @brief Parse a value into the QVariant of a column
+     * @param isBlob Flag indicating strings are base64 encoded BLOBs (true) or text (false)
+     */
+    bool ParseValue(const char *&p, const char *end, bool isBlob, QVariant &value);
+
+    /**
+     * @brief Parse a string after its opening quote, decoding the escapes to UTF-8
+     */
+    bool ParseString(const char *&p, const char *end, QByteArray &utf8);
+
+    /**
+     * @brief Skip a nested object or array, respecting strings
+     */
+    bool SkipNested(const char *&p, const char *end);
+
+    /**
+     * @brief Record a parse error at the current line
+     * @return false, for returning straight from the parse functions
+     */
+    bool Fail(const QString &message);
+
+    /**
+     * @brief Skip JSON whitespace
+     */
+    static void SkipWhitespace(const char *&p, const char *end);
+
+    /**
+     * @brief Append a code point as UTF-8
+     */
+    static void AppendUtf8(quint32 codePoint, QByteArray &utf8);
+
+    QIODevice *Device;                   // Input device (not owned)
+    QHash<QByteArray, int> ColumnIndex;  // UTF-8 column name -> column index
+    QVector<bool> BlobColumns;           // Flag per column indicating base64 BLOB strings
+    QSet<QString> UnknownKeys;           // Keys that matched no column
+    QByteArray KeyBytes;                 // Decoded key of the current member (reused)
+    QByteArray StringBytes;              // Decoded string value of the current member (reused)
+    qint64 LineNumber;                   // Number of the last line read
+    QString ErrorString;                 // Description of the parse error (empty if none)
+};
+
+#endif // JSONLINESREADER_H
@@ -0,0 +1,189 @@
+#include "jsonlineswriter.h"
+#include <QLocale>
+#include <QDebug>
+#include <cmath>
+
+// Define JSON Lines writer constants
+const int JsonLinesWriter::BUFFER_SIZE = 1 << 20;
+
+/**
+ * @brief Constructor initializes JsonLinesWriter and encodes the keys
+ */
+JsonLinesWriter::JsonLinesWriter(QIODevice *device, const QStringList &columnNames)
+    : Device(device)                   // Output device
+    , KeyPrefixes()                    // Encoded keys
+    , Buffer()                         // Encoded bytes
+    , CurrentColumn(0)                 // First value of the first row
+    , RowCount(0)                      // No rows written
+    , Failed(false)                    // No write failed
+{
+    for (int _col = 0; _col < columnNames.size(); ++_col) {
+        QByteArray _prefix(_col == 0 ? "{\"" : ",\"");  // Object start or separator, then the key
+        QByteArray _name = columnNames[_col].toUtf8();  // Key as UTF-8
+        AppendEscaped(_name.constData(), _name.size(), _prefix);
+        _prefix.append("\":");
+        KeyPrefixes.append(_prefix);
+    }
+    Buffer.reserve(BUFFER_SIZE + 4096);  // Room for the value that crosses the flush threshold
+}
+
+/**
+ * @brief Destructor writes buffered bytes that were not flushed yet
+ */
+JsonLinesWriter::~JsonLinesWriter()
+{
+    Flush();
+}
+
+/**
+ * @brief Append the next value of the current row
+ */
+void JsonLinesWriter::WriteValue(const QVariant &value)
+{
+    if (CurrentColumn >= KeyPrefixes.size()) {
+        return;
+    }
+    Buffer.append(KeyPrefixes[CurrentColumn++]);
+
+    if (value.isNull()) {
+        Buffer.append("null");
+        return;
+    }
+
+    switch (value.userType()) {
+    case QMetaType::LongLong:
+    case QMetaType::Int:
+        Buffer.append(QByteArray::number(value.toLongLong()));
+        break;
+    case QMetaType::Double: {
+        // JSON has no literal for NaN or infinity
+        double _real = value.toDouble();  // Value to format
+        if (std::isfinite(_real)) {
+            Buffer.append(QByteArray::number(_real, 'g', QLocale::FloatingPointShortest));
+        } else {
+            Buffer.append("null");
+        }
+        break;
+    }
+    case QMetaType::QByteArray:
+        // Base64 never needs escaping
+        Buffer.append('"');
+        Buffer.append(value.toByteArray().toBase64());
+        Buffer.append('"');
+        break;
+    default: {
+        QByteArray _utf8 = value.toString().toUtf8();  // Text as UTF-8
+        Buffer.append('"');
+        AppendEscaped(_utf8.constData(), _utf8.size(), Buffer);
+        Buffer.append('"');
+        break;
+    }
+    }
+    FlushIfFull();
+}
+
+/**
+ * @brief Close the object of the current row and start a new line
+ * Values missing from the row are written as null so every line has every key
+ */
+void JsonLinesWriter::EndRow()
+{
+    while (CurrentColumn < KeyPrefixes.size()) {
+        Buffer.append(KeyPrefixes[CurrentColumn++]);
+        Buffer.append("null");
+    }
+    Buffer.append(KeyPrefixes.isEmpty() ? "{}\n" : "}\n");
+    CurrentColumn = 0;
+    RowCount++;
+    FlushIfFull();
+}
+
+/**
+ * @brief Hand all buffered bytes to the device
+ */
+bool JsonLinesWriter::Flush()
+{
+    if (!Buffer.isEmpty() && !Failed) {
+        if (Device->write(Buffer) != Buffer.size()) {
+            qDebug() << "Error: Failed to write JSON Lines output:" << Device->errorString();
+            Failed = true;
+        }
+    }
+    Buffer.resize(0);  // Keeps the reserved capacity for the next block
+    return !Failed;
+}
+
+/**
+ * @brief Check if a write to the device failed
+ */
+bool JsonLinesWriter::HasError() const
+{
+    return Failed;
+}
+
+/**
+ * @brief Get the number of rows written so far
+ */
+qint64 JsonLinesWriter::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Append bytes as the contents of a JSON string
+ * Bytes that need no escaping are copied in runs up to the next special byte
+ */
+void JsonLinesWriter::AppendEscaped(const char *data, int length, QByteArray &output)
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";  // Digits of \u escapes
+    const char *_start = data;  // First byte not copied yet
+    const char *_end = data + length;  // End of the input
+    for (const char *_p = data; _p < _end; ++_p) {
+        const unsigned char _c = static_cast<unsigned char>(*_p);  // Current byte
+        if (_c >= 0x20 && _c != '"' && _c != '\\') {
+            continue;
+        }
+
+        output.append(_start, static_cast<int>(_p - _start));
+        _start = _p + 1;
+        switch (_c) {
+        case '"':
+            output.append("\\\"", 2);
+            break;
+        case '\\':
+            output.append("\\\\", 2);
+            break;
+        case '\n':
+            output.append("\\n", 2);
+            break;
+        case '\r':
+            output.append("\\r", 2);
+            break;
+        case '\t':
+            output.append("\\t", 2);
+            break;
+        case '\b':
+            output.append("\\b", 2);
+            break;
+        case '\f':
+            output.append("\\f", 2);
+            break;
+        default: {
+            const char _escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[_c >> 4], HEX_DIGITS[_c & 0xF]};  // \u00XX
+            output.append(_escape, 6);
+            break;
+        }
+        }
+    }
+    output.append(_start, static_cast<int>(_end - _start));
+}
+
+/**
+ * @brief Write the buffer to the device once it is full
+ */
+void JsonLinesWriter::FlushIfFull()
+{
+    if (Buffer.size() >= BUFFER_SIZE) {
+        Flush();
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef JSONLINESWRITER_H
+#define JSONLINESWRITER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QVariant>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief Buffered JSON Lines (NDJSON) encoder writing one object per row into an output device
+ * Like CsvWriter, values are encoded straight into one large buffer without building a
+ * QJsonDocument per row; the "name": prefix of every key is encoded once up front
+ */
+class JsonLinesWriter
+{
+public:
+    /**
+     * @brief Constructor for JsonLinesWriter
+     * @param device Open output device (not owned, must outlive the writer)
+     * @param columnNames Object keys in value order
+     */
+    JsonLinesWriter(QIODevice *device, const QStringList &columnNames);
+
+    /**
+     * @brief Destructor writes buffered bytes that were not flushed yet
+     */
+    ~JsonLinesWriter();
+
+    /**
+     * @brief Append the next value of the current row
+     * Integers and finite reals are written unquoted, NULL (and non-finite reals) as null,
+     * BLOBs as base64 strings and everything else as escaped strings
+     * @param value Value as returned by QSqlQuery::value
+     */
+    void WriteValue(const QVariant &value);
+
+    /**
+     * @brief Close the object of the current row and start a new line
+     */
+    void EndRow();
+
+    /**
+     * @brief Hand all buffered bytes to the device
+     * @return true if every byte written so far reached the device, false otherwise
+     */
+    bool Flush();
+
+    /**
+     * @brief Check if a write to the device failed
+     * @return true if output was lost, false otherwise
+     */
+    bool HasError() const;
+
+    /**
+     * @brief Get the number of rows written so far
+     * @return Rows ended with EndRow
+     */
+    qint64 GetRowCount() const;
+
+    /**
+     * @brief Append bytes as the contents of a JSON string (without the quotes)
+     * Quotes, backslashes and control characters are escaped; other bytes, including
+     * UTF-8 sequences, are copied in runs
+     * @param data UTF-8 bytes
+     * @param length Number of bytes
+     * @param output Buffer receiving the escaped bytes
+     */
+    static void AppendEscaped(const char *data, int length, QByteArray &output);
+
+    static const int BUFFER_SIZE;        // Bytes collected before they are written to the device
+
+private:
+    /**
+     * @brief Write the buffer to the device once it is full
+     */
+    void FlushIfFull();
+
+    QIODevice *Device;                   // Output device (not owned)
+    QVector<QByteArray> KeyPrefixes;     // Encoded "{"name": or ,"name": per column
+    QByteArray Buffer;                   // Encoded bytes not yet written (capacity BUFFER_SIZE)
+    int CurrentColumn;                   // Column of the next value in the current row
+    qint64 RowCount;                     // Rows written so far
+    bool Failed;                         // Flag indicating a device write failed (true) or all succeeded (false)
+};
+
+#endif // JSONLINESWRITER_H
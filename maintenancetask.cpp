@@ -0,0 +1,224 @@
+#include "maintenancetask.h"
+#include "sqlworker.h"
+
+// Define maintenance constants
+const int MaintenanceTask::DEFAULT_STEP_BUDGET_MS = 200;
+const int MaintenanceTask::VACUUM_PAGES_PER_STEP = 64;
+const int MaintenanceTask::ANALYSIS_ROWS_PER_MS = 2000;
+const int MaintenanceTask::PROBE_ROW_LIMIT = 1000;
+
+/**
+ * @brief Constructor initializes MaintenanceTask with the tables to process
+ */
+MaintenanceTask::MaintenanceTask(const QString &filePath, const QStringList &changedTables, int stepBudgetMs)
+    : DatabaseTask(filePath)
+    , ChangedTables(changedTables)     // Tables pending ANALYZE
+    , StepBudgetMs(stepBudgetMs)       // Per-step time budget
+{
+}
+
+/**
+ * @brief Get the tables this task was asked to maintain
+ */
+QStringList MaintenanceTask::GetChangedTables() const
+{
+    return ChangedTables;
+}
+
+/**
+ * @brief Run all maintenance steps on the background connection
+ * @param database Open connection owned by the task thread
+ * @param message Output summary of the maintenance run
+ * @return true if maintenance completed, false on error or cancellation
+ */
+bool MaintenanceTask::Run(QSqlDatabase &database, QString &message)
+{
+    qint64 _probeBeforeMs = MeasureProbeQueries(database);  // Probe query time before maintenance
+
+    emit ProgressChanged(10, "Optimizing query planner statistics");
+    if (!RunOptimize(database) || IsCancelled()) {
+        message = "PRAGMA optimize failed or was cancelled";
+        return false;
+    }
+
+    emit ProgressChanged(40, "Analyzing changed tables");
+    int _analyzedTables = RunAnalyze(database);  // Number of tables analyzed within the budget
+    if (IsCancelled()) {
+        return false;
+    }
+
+    emit ProgressChanged(70, "Reclaiming free pages");
+    qint64 _bytesReclaimed = RunIncrementalVacuum(database);  // Bytes returned to the file system
+    if (IsCancelled()) {
+        return false;
+    }
+
+    qint64 _probeAfterMs = MeasureProbeQueries(database);  // Probe query time after maintenance
+
+    emit ProgressChanged(100, "Maintenance finished");
+    emit MaintenanceReport(_bytesReclaimed, _probeBeforeMs, _probeAfterMs);
+
+    message = QString("Maintenance finished: %1 table(s) analyzed, %2 KB reclaimed")
+                  .arg(_analyzedTables)
+                  .arg(_bytesReclaimed / 1024);
+    if (_probeBeforeMs >= 0 && _probeAfterMs >= 0) {
+        message += QString(", probe queries %1 ms -> %2 ms").arg(_probeBeforeMs).arg(_probeAfterMs);
+    }
+
+    qDebug() << message;
+    return true;
+}
+
+/**
+ * @brief Run PRAGMA optimize with an analysis limit derived from the step budget
+ */
+bool MaintenanceTask::RunOptimize(QSqlDatabase &database)
+{
+    QSqlQuery _query(database);  // Query object for maintenance pragmas
+
+    // Bound the work ANALYZE may do on large indexes so one step stays within budget
+    int _analysisLimit = StepBudgetMs * ANALYSIS_ROWS_PER_MS;  // Approximate rows examined per index
+    if (!_query.exec(QString("PRAGMA analysis_limit=%1").arg(_analysisLimit))) {
+        qDebug() << "Error: Failed to set analysis limit";
+        qDebug() << "SQL error:" << _query.lastError().text();
+    }
+
+    if (!_query.exec("PRAGMA optimize")) {
+        qDebug() << "Error: PRAGMA optimize failed";
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return false;
+    }
+
+    while (_query.next()) {}  // Drain result rows so every optimization step is executed
+    return true;
+}
+
+/**
+ * @brief Run ANALYZE on every changed table until the budget is spent
+ */
+int MaintenanceTask::RunAnalyze(QSqlDatabase &database)
+{
+    int _analyzedTables = 0;  // Number of tables analyzed successfully
+    QSqlQuery _query(database);  // Query object for ANALYZE statements
+
+    for (const QString &_tableName : ChangedTables) {  // Each table modified since the last run
+        if (IsCancelled()) {
+            break;
+        }
+
+        QElapsedTimer _stepTimer;  // Measures time spent on this table
+        _stepTimer.start();
+
+        if (!_query.exec(QString("ANALYZE %1").arg(SQLWorker::QuoteIdentifier(_tableName)))) {
+            qDebug() << "Error: ANALYZE failed for table" << _tableName;
+            qDebug() << "SQL error:" << _query.lastError().text();
+            continue;
+        }
+
+        _analyzedTables++;
+
+        // Yield the file to the editor for as long as the step took
+        QThread::msleep(static_cast<unsigned long>(qMin<qint64>(_stepTimer.elapsed(), StepBudgetMs)));
+    }
+
+    return _analyzedTables;
+}
+
+/**
+ * @brief Reclaim free pages in small incremental_vacuum steps
+ */
+qint64 MaintenanceTask::RunIncrementalVacuum(QSqlDatabase &database)
+{
+    // incremental_vacuum only works on files created with auto_vacuum=INCREMENTAL (2)
+    if (ReadPragma(database, "auto_vacuum") != 2) {
+        qDebug() << "Incremental vacuum skipped: auto_vacuum is not INCREMENTAL, free pages:"
+                 << ReadPragma(database, "freelist_count");
+        return 0;
+    }
+
+    qint64 _pageSize = ReadPragma(database, "page_size");          // Size of one database page in bytes
+    qint64 _freePagesBefore = ReadPragma(database, "freelist_count");  // Free pages before vacuuming
+    if (_pageSize <= 0 || _freePagesBefore <= 0) {
+        return 0;
+    }
+
+    QSqlQuery _query(database);  // Query object for incremental_vacuum calls
+    qint64 _freePages = _freePagesBefore;  // Free pages remaining after the latest step
+
+    while (_freePages > 0 && !IsCancelled()) {
+        QElapsedTimer _stepTimer;  // Measures time spent in this step
+        _stepTimer.start();
+
+        // Release small batches until the step budget is used up; each call is its own short transaction
+        while (_freePages > 0 && _stepTimer.elapsed() < StepBudgetMs && !IsCancelled()) {
+            if (!_query.exec(QString("PRAGMA incremental_vacuum(%1)").arg(VACUUM_PAGES_PER_STEP))) {
+                qDebug() << "Error: incremental_vacuum failed";
+                qDebug() << "SQL error:" << _query.lastError().text();
+                _freePages = 0;
+                break;
+            }
+            while (_query.next()) {}  // Step the statement to completion
+            _query.finish();
+
+            _freePages = ReadPragma(database, "freelist_count");
+        }
+
+        int _percent = 70 + static_cast<int>(29 * (_freePagesBefore - qMax<qint64>(_freePages, 0)) / _freePagesBefore);  // Progress within the vacuum phase
+        emit ProgressChanged(_percent, QString("Reclaiming free pages (%1 left)").arg(qMax<qint64>(_freePages, 0)));
+
+        // Leave the file idle between steps so the editor never waits long for a lock
+        QThread::msleep(static_cast<unsigned long>(StepBudgetMs));
+    }
+
+    qint64 _freePagesAfter = qMax<qint64>(ReadPragma(database, "freelist_count"), 0);  // Free pages left after vacuuming
+    return (_freePagesBefore - _freePagesAfter) * _pageSize;
+}
+
+/**
+ * @brief Time the first page query of every changed table
+ * An unmeasured pass loads the probed pages first, so the before and after times are both
+ * taken with a warm page cache instead of the first one paying for the disk reads
+ */
+qint64 MaintenanceTask::MeasureProbeQueries(QSqlDatabase &database)
+{
+    if (ChangedTables.isEmpty()) {
+        return -1;
+    }
+
+    RunProbeQueries(database);  // Warm-up pass, not timed
+
+    QElapsedTimer _timer;  // Measures total probe time
+    _timer.start();
+    RunProbeQueries(database);
+    return _timer.elapsed();
+}
+
+/**
+ * @brief Run the probe query of every changed table and fetch its rows
+ */
+void MaintenanceTask::RunProbeQueries(QSqlDatabase &database)
+{
+    QSqlQuery _query(database);  // Query object for probe queries
+    _query.setForwardOnly(true);
+
+    for (const QString &_tableName : ChangedTables) {  // Each changed table gets one probe
+        if (!_query.exec(QString("SELECT * FROM %1 LIMIT %2").arg(SQLWorker::QuoteIdentifier(_tableName)).arg(PROBE_ROW_LIMIT))) {
+            continue;
+        }
+        while (_query.next()) {}  // Fetch all probe rows like the editor would
+    }
+}
+
+/**
+ * @brief Read a single integer PRAGMA value
+ */
+qint64 MaintenanceTask::ReadPragma(QSqlDatabase &database, const QString &pragmaName)
+{
+    QSqlQuery _query(database);  // Query object for PRAGMA read
+    if (!_query.exec(QString("PRAGMA %1").arg(pragmaName)) || !_query.next()) {
+        qDebug() << "Error: Failed to read PRAGMA" << pragmaName;
+        return -1;
+    }
+
+    return _query.value(0).toLongLong();
+}
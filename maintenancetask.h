@@ -0,0 +1,92 @@
+#ifndef MAINTENANCETASK_H
+#define MAINTENANCETASK_H
+
+#include <QStringList>
+#include <QElapsedTimer>
+#include "databasetask.h"
+
+/**
+ * @brief Background database maintenance executed on an idle connection
+ * Runs PRAGMA optimize, ANALYZE on changed tables and incremental_vacuum in
+ * small steps, each bounded by a time budget so the file lock is held briefly
+ */
+class MaintenanceTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for MaintenanceTask
+     * @param filePath Path to the SQL database file to maintain
+     * @param changedTables Tables modified since the last maintenance run
+     * @param stepBudgetMs Time budget for each maintenance step in milliseconds
+     */
+    MaintenanceTask(const QString &filePath, const QStringList &changedTables, int stepBudgetMs = DEFAULT_STEP_BUDGET_MS);
+
+    /**
+     * @brief Get the tables this task was asked to maintain
+     * @return QStringList containing changed table names
+     */
+    QStringList GetChangedTables() const;
+
+    static const int DEFAULT_STEP_BUDGET_MS;  // Default time budget for one maintenance step
+
+signals:
+    /**
+     * @brief Emitted with the maintenance results before Finished
+     * @param bytesReclaimed Bytes returned to the file system by incremental_vacuum
+     * @param probeBeforeMs Probe query time before maintenance in milliseconds (-1 if not measured)
+     * @param probeAfterMs Probe query time after maintenance in milliseconds (-1 if not measured)
+     */
+    void MaintenanceReport(qint64 bytesReclaimed, qint64 probeBeforeMs, qint64 probeAfterMs);
+
+protected:
+    /**
+     * @brief Run all maintenance steps on the background connection
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    /**
+     * @brief Run PRAGMA optimize with an analysis limit derived from the step budget
+     */
+    bool RunOptimize(QSqlDatabase &database);
+
+    /**
+     * @brief Run ANALYZE on every changed table until the budget is spent
+     * @return Number of tables analyzed
+     */
+    int RunAnalyze(QSqlDatabase &database);
+
+    /**
+     * @brief Reclaim free pages in small incremental_vacuum steps
+     * @return Number of bytes reclaimed
+     */
+    qint64 RunIncrementalVacuum(QSqlDatabase &database);
+
+    /**
+     * @brief Time the first page query of every changed table after an unmeasured warm-up pass
+     * @return Total elapsed milliseconds, or -1 if no probe could run
+     */
+    qint64 MeasureProbeQueries(QSqlDatabase &database);
+
+    /**
+     * @brief Run the probe query of every changed table and fetch its rows
+     */
+    void RunProbeQueries(QSqlDatabase &database);
+
+    /**
+     * @brief Read a single integer PRAGMA value
+     * @return PRAGMA value, or -1 on error
+     */
+    qint64 ReadPragma(QSqlDatabase &database, const QString &pragmaName);
+
+    QStringList ChangedTables;           // Tables modified since the last maintenance run (may be empty)
+    int StepBudgetMs;                    // Time budget for each maintenance step in milliseconds
+
+    static const int VACUUM_PAGES_PER_STEP;   // Pages released by one incremental_vacuum call
+    static const int ANALYSIS_ROWS_PER_MS;    // Approximate rows ANALYZE can examine per millisecond
+    static const int PROBE_ROW_LIMIT;         // Rows fetched by the probe query of each table
+};
+
+#endif // MAINTENANCETASK_H
@@ -4,6 +4,14 @@
 const QString MainWindow::NORMAL_BUTTON_STYLE = "QPushButton { background-color: #f0f0f0; border: 1px solid #c0c0c0; padding: 5px; color: black; }";
 const QString MainWindow::ACTIVE_BUTTON_STYLE = "QPushButton { background-color: #90EE90; border: 2px solid #228B22; padding: 5px; font-weight: bold; color: black; }";
 const QString MainWindow::DISABLED_BUTTON_STYLE = "QPushButton:disabled { background-color: #e0e0e0; border: 1px solid #d0d0d0; padding: 5px; color: #a0a0a0; }";
+const int MainWindow::MAINTENANCE_IDLE_DELAY_MS = 60000;
+const int MainWindow::INTEGRITY_MAX_ERRORS = 100;
+const QString MainWindow::INTEGRITY_MODE_SETTING = "IntegrityCheck/Mode";
+const QString MainWindow::HIDDEN_COLUMNS_SETTING = "HiddenColumns";
+const int MainWindow::COLUMN_FETCH_LOOKAHEAD = 8;
+const int MainWindow::RESIZE_SAMPLE_ROWS = 200;
+const QString MainWindow::ARROW_BATCH_ROWS_SETTING = "Export/ArrowBatchRows";
+const QString MainWindow::EXPORT_COMPRESSION_SETTING = "Export/Compression";
 
 /**
  * @brief Constructor initializes the main window and sets up UI components
@@ -18,15 +26,37 @@ MainWindow::MainWindow(QWidget *parent)
     , ChooseFileButton(nullptr)        // File selection button
     , LoadFileButton(nullptr)          // File loading button
     , FilePathLabel(nullptr)           // Current file path display
+    , IntegrityModeComboBox(nullptr)   // Open-time integrity scan selector
+    , CompactButton(nullptr)           // File compaction button
+    , GlobalSearchButton(nullptr)      // All-table search button
     , TableComboBox(nullptr)           // Table selection dropdown
     , TableLabel(nullptr)              // Table selection label
+    , SearchEdit(nullptr)              // Full-text search box
+    , SearchIndexButton(nullptr)       // Search index build button
+    , GoToKeyEdit(nullptr)             // Go-to-key box
     , AddButton(nullptr)               // Row addition toggle button
     , DeleteButton(nullptr)            // Row deletion toggle button
     , EditButton(nullptr)              // Cell editing toggle button
     , UpdateButton(nullptr)            // Changes save button
     , CancelButton(nullptr)            // Changes discard button
     , PrintButton(nullptr)             // Table export button
+    , ExportButton(nullptr)            // Data export format button
+    , ImportButton(nullptr)            // JSON Lines import button
+    , StatisticsButton(nullptr)        // Column statistics button
+    , PivotButton(nullptr)             // Pivot view button
     , DataTable(nullptr)               // Main data display table
+    , FilterHeader(nullptr)            // Column header with filter row
+    , MaintenanceTimer(nullptr)        // Idle maintenance timer
+    , FindBar(nullptr)                 // Find-in-table bar
+    , FindEdit(nullptr)                // Find text box
+    , FindPreviousButton(nullptr)      // Previous hit button
+    , FindNextButton(nullptr)          // Next hit button
+    , FindStatusLabel(nullptr)         // Hit position display
+    , Finder(nullptr)                  // Find-in-table scanner
+    , StatisticsPanel(nullptr)         // Column statistics dock
+    , ExportJobs(nullptr)              // Background export jobs dock
+    , ActivePivot(nullptr)             // No pivot view open
+    , ActiveGlobalSearch(nullptr)      // No global search open
     , Worker(nullptr)                  // SQL processing worker
     , CurrentFilePath("")              // Path to active SQL file
     , CurrentTableName("")             // Name of selected table
@@ -34,6 +64,13 @@ MainWindow::MainWindow(QWidget *parent)
     , IsDeleteMode(false)              // Delete mode state flag
     , IsEditMode(false)                // Edit mode state flag
     , HasUnsavedChanges(false)         // Unsaved changes indicator
+    , IsLoadingTable(false)            // Table load in progress flag
+    , ActiveMaintenance(nullptr)       // Background maintenance task
+    , ActiveIntegrityCheck(nullptr)    // Open-time integrity scan
+    , IntegrityProblemsFound(false)    // Integrity scan result flag
+    , ActiveCompaction(nullptr)        // Background compaction task
+    , ActiveSearchIndexing(nullptr)    // Background search index build
+    , CurrentFindHit(-1)               // Selected find hit
 {
     InitializeUI();
     SetupConnections();
@@ -52,6 +89,18 @@ MainWindow::MainWindow(QWidget *parent)
  */
 MainWindow::~MainWindow()
 {
+    StopMaintenance();  // Wait for background maintenance before closing the database
+    StopIntegrityCheck();
+    StopSearchIndexing();
+    StatisticsPanel->Stop();
+    ExportJobs->Stop();  // Cancelled exports remove their partial files
+    delete ActivePivot;  // Destructor cancels its query
+    delete ActiveGlobalSearch;  // Destructor cancels its search
+    if (ActiveCompaction) {
+        ActiveCompaction->disconnect(this);
+        ActiveCompaction->Stop();  // Interrupts VACUUM INTO instead of waiting for the whole copy
+    }
+    delete ActiveCompaction;  // Removes the copy, which was never swapped in
     delete Worker;  // Clean up SQL worker instance
 }
 
@@ -85,9 +134,28 @@ void MainWindow::InitializeUI()
     FilePathLabel->setMinimumWidth(300);
     FilePathLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
 
+    // Integrity scan selection is remembered between sessions
+    IntegrityModeComboBox = new QComboBox(this);
+    IntegrityModeComboBox->addItem("No integrity check");
+    IntegrityModeComboBox->addItem("Quick check on load");
+    IntegrityModeComboBox->addItem("Full check on load");
+    IntegrityModeComboBox->setMinimumHeight(35);
+    IntegrityModeComboBox->setCurrentIndex(QSettings().value(INTEGRITY_MODE_SETTING, 0).toInt());
+
     FileLayout->addWidget(ChooseFileButton);
     FileLayout->addWidget(LoadFileButton);
+    CompactButton = new QPushButton("Compact File", this);
+    CompactButton->setMinimumHeight(35);
+    CompactButton->setEnabled(false);  // Disabled until file loaded
+
     FileLayout->addWidget(FilePathLabel, 1);  // Stretch factor for path label
+    FileLayout->addWidget(IntegrityModeComboBox);
+    FileLayout->addWidget(CompactButton);
+
+    GlobalSearchButton = new QPushButton("Search All Tables", this);
+    GlobalSearchButton->setMinimumHeight(35);
+    GlobalSearchButton->setEnabled(false);  // Disabled until file loaded
+    FileLayout->addWidget(GlobalSearchButton);
 
     // Setup table selection section
     TableLayout = new QHBoxLayout();
@@ -100,6 +168,27 @@ void MainWindow::InitializeUI()
     TableLayout->addWidget(TableLabel);
     TableLayout->addWidget(TableComboBox, 1);  // Stretch factor for combo box
 
+    // Full-text search is opt-in per table and needs an index first
+    SearchEdit = new QLineEdit(this);
+    SearchEdit->setMinimumHeight(30);
+    SearchEdit->setClearButtonEnabled(true);
+    SearchEdit->setEnabled(false);  // Enabled once the table has a search index
+    SearchIndexButton = new QPushButton("Build Search Index", this);
+    SearchIndexButton->setMinimumHeight(30);
+    SearchIndexButton->setEnabled(false);  // Disabled until table selected
+
+    TableLayout->addWidget(SearchEdit, 1);
+    TableLayout->addWidget(SearchIndexButton);
+
+    // Jumping loads only the page around the key instead of scrolling through every page before it
+    GoToKeyEdit = new QLineEdit(this);
+    GoToKeyEdit->setMinimumHeight(30);
+    GoToKeyEdit->setClearButtonEnabled(true);
+    GoToKeyEdit->setPlaceholderText("Go to key (primary key or rowid)");
+    GoToKeyEdit->setEnabled(false);  // Disabled until table selected
+
+    TableLayout->addWidget(GoToKeyEdit);
+
     // Setup action buttons section
     ButtonLayout = new QHBoxLayout();
     AddButton = new QPushButton("Add Row", this);
@@ -108,6 +197,10 @@ void MainWindow::InitializeUI()
     UpdateButton = new QPushButton("Update SQL", this);
     CancelButton = new QPushButton("Cancel", this);
     PrintButton = new QPushButton("Print Table", this);
+    ExportButton = new QPushButton("Export As", this);
+    ImportButton = new QPushButton("Import JSON Lines", this);
+    StatisticsButton = new QPushButton("Column Statistics", this);
+    PivotButton = new QPushButton("Pivot", this);
 
     // Configure action buttons
     AddButton->setMinimumHeight(35);
@@ -116,6 +209,10 @@ void MainWindow::InitializeUI()
     UpdateButton->setMinimumHeight(35);
     CancelButton->setMinimumHeight(35);
     PrintButton->setMinimumHeight(35);
+    ExportButton->setMinimumHeight(35);
+    ImportButton->setMinimumHeight(35);
+    StatisticsButton->setMinimumHeight(35);
+    PivotButton->setMinimumHeight(35);
 
     // Set initial button states
     AddButton->setCheckable(true);      // Make toggle button
@@ -130,6 +227,10 @@ void MainWindow::InitializeUI()
     UpdateButton->setStyleSheet(combinedStyle);
     CancelButton->setStyleSheet(combinedStyle);
     PrintButton->setStyleSheet(combinedStyle);
+    ExportButton->setStyleSheet(combinedStyle);
+    ImportButton->setStyleSheet(combinedStyle);
+    StatisticsButton->setStyleSheet(combinedStyle);
+    PivotButton->setStyleSheet(combinedStyle);
 
     // Disable action buttons until table is selected
     AddButton->setEnabled(false);
@@ -138,6 +239,10 @@ void MainWindow::InitializeUI()
     UpdateButton->setEnabled(false);
     CancelButton->setEnabled(false);
     PrintButton->setEnabled(false);
+    ExportButton->setEnabled(false);
+    ImportButton->setEnabled(false);
+    StatisticsButton->setEnabled(false);
+    PivotButton->setEnabled(false);
 
     ButtonLayout->addWidget(AddButton);
     ButtonLayout->addWidget(DeleteButton);
@@ -145,20 +250,71 @@ void MainWindow::InitializeUI()
     ButtonLayout->addWidget(UpdateButton);
     ButtonLayout->addWidget(CancelButton);
     ButtonLayout->addWidget(PrintButton);
+    ButtonLayout->addWidget(ExportButton);
+    ButtonLayout->addWidget(ImportButton);
+    ButtonLayout->addWidget(StatisticsButton);
+    ButtonLayout->addWidget(PivotButton);
     ButtonLayout->addStretch();  // Push buttons to left
 
     // Setup main data table
     DataTable = new QTableWidget(this);
+    FilterHeader = new FilterHeaderView(DataTable);
+    DataTable->setHorizontalHeader(FilterHeader);  // Header with a filter row under the column titles
+    FilterHeader->setSortIndicatorShown(false);   // Shown once a sort is chosen
     DataTable->setAlternatingRowColors(true);
     DataTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     DataTable->horizontalHeader()->setStretchLastSection(true);
+    DataTable->horizontalHeader()->setContextMenuPolicy(Qt::CustomContextMenu);  // Right-click chooses visible columns
+    DataTable->horizontalHeader()->setResizeContentsPrecision(RESIZE_SAMPLE_ROWS);  // Size columns from a sample, not every row
     DataTable->setEditTriggers(QAbstractItemView::NoEditTriggers);  // Initially read-only
 
+    // Setup find bar over the loaded rows (shown with Ctrl+F)
+    FindBar = new QWidget(this);
+    QHBoxLayout *_findLayout = new QHBoxLayout(FindBar);  // Layout of the find bar (owned by the bar)
+    _findLayout->setContentsMargins(0, 0, 0, 0);
+    FindEdit = new QLineEdit(FindBar);
+    FindEdit->setPlaceholderText("Find in loaded rows");
+    FindEdit->setClearButtonEnabled(true);
+    FindPreviousButton = new QPushButton("Previous", FindBar);
+    FindNextButton = new QPushButton("Next", FindBar);
+    FindStatusLabel = new QLabel(FindBar);
+    QPushButton *_findCloseButton = new QPushButton("Close", FindBar);  // Hides the find bar
+    connect(_findCloseButton, &QPushButton::clicked, this, &MainWindow::OnFindClosed);
+
+    _findLayout->addWidget(new QLabel("Find:", FindBar));
+    _findLayout->addWidget(FindEdit, 1);
+    _findLayout->addWidget(FindPreviousButton);
+    _findLayout->addWidget(FindNextButton);
+    _findLayout->addWidget(FindStatusLabel);
+    _findLayout->addWidget(_findCloseButton);
+    FindBar->hide();
+
+    Finder = new TableFindScanner(DataTable, this);
+
+    // Column statistics dock (shown with the statistics button)
+    StatisticsPanel = new ColumnStatisticsPanel(this);
+    addDockWidget(Qt::RightDockWidgetArea, StatisticsPanel);
+    StatisticsPanel->hide();
+
+    // Background export jobs dock (shown when an export starts)
+    ExportJobs = new ExportJobsPanel(this);
+    addDockWidget(Qt::BottomDockWidgetArea, ExportJobs);
+    ExportJobs->hide();
+    connect(ExportJobs, &ExportJobsPanel::JobFinished, this, &MainWindow::OnExportJobFinished);
+
     // Add all layouts to main layout
     MainLayout->addLayout(FileLayout);
     MainLayout->addLayout(TableLayout);
     MainLayout->addLayout(ButtonLayout);
+    MainLayout->addWidget(FindBar);
     MainLayout->addWidget(DataTable, 1);  // Table gets most space
+
+    // Setup idle maintenance timer
+    MaintenanceTimer = new QTimer(this);
+    MaintenanceTimer->setSingleShot(true);
+    MaintenanceTimer->setInterval(MAINTENANCE_IDLE_DELAY_MS);
+
+    statusBar()->showMessage("Ready");
 }
 
 /**
@@ -169,11 +325,20 @@ void MainWindow::SetupConnections()
     // File operation connections
     connect(ChooseFileButton, &QPushButton::clicked, this, &MainWindow::OnChooseFileClicked);
     connect(LoadFileButton, &QPushButton::clicked, this, &MainWindow::OnLoadFileClicked);
+    connect(IntegrityModeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::OnIntegrityModeChanged);
+    connect(CompactButton, &QPushButton::clicked, this, &MainWindow::OnCompactButtonClicked);
+    connect(GlobalSearchButton, &QPushButton::clicked, this, &MainWindow::OnGlobalSearchButtonClicked);
 
     // Table selection connection
     connect(TableComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::OnTableSelectionChanged);
 
+    // Full-text search connections
+    connect(SearchEdit, &QLineEdit::returnPressed, this, &MainWindow::OnSearchSubmitted);
+    connect(SearchIndexButton, &QPushButton::clicked, this, &MainWindow::OnSearchIndexButtonClicked);
+    connect(GoToKeyEdit, &QLineEdit::returnPressed, this, &MainWindow::OnGoToKeySubmitted);
+
     // Connect action buttons
     connect(AddButton, &QPushButton::clicked, this, &MainWindow::OnAddButtonClicked);
     connect(DeleteButton, &QPushButton::clicked, this, &MainWindow::OnDeleteButtonClicked);
@@ -182,8 +347,76 @@ void MainWindow::SetupConnections()
     connect(CancelButton, &QPushButton::clicked, this, &MainWindow::OnCancelButtonClicked);
     connect(PrintButton, &QPushButton::clicked, this, &MainWindow::OnPrintButtonClicked);
 
+    // Export formats are entries of the export button's menu
+    QMenu *_exportMenu = new QMenu(ExportButton);  // Menu of export formats (owned by the button)
+    _exportMenu->addAction("Parquet (.parquet)", this, [this]() {
+        OnExportParquetRequested(ParquetWriter::Compression::None);
+    });
+    _exportMenu->addAction("Parquet, gzip compressed (.parquet)", this, [this]() {
+        OnExportParquetRequested(ParquetWriter::Compression::Gzip);
+    });
+    _exportMenu->addAction("Arrow IPC / Feather (.arrow)", this, &MainWindow::OnExportArrowRequested);
+    _exportMenu->addAction("JSON Lines (.jsonl)", this, &MainWindow::OnExportJsonLinesRequested);
+    _exportMenu->addAction("Excel workbook (.xlsx)", this, &MainWindow::OnExportXlsxRequested);
+
+    // Compression of the streamed exports, remembered across sessions
+    QMenu *_compressionMenu = _exportMenu->addMenu("Compression");  // Exclusive codec choices
+    QActionGroup *_compressionGroup = new QActionGroup(_compressionMenu);  // Keeps one codec checked
+    const QList<QPair<QString, CompressingDevice::Codec>> _codecs = {
+        {"None", CompressingDevice::Codec::None},
+        {"gzip (.gz)", CompressingDevice::Codec::Gzip},
+        {"zstd (.zst)", CompressingDevice::Codec::Zstd}
+    };  // Menu text and codec of each choice
+    for (const QPair<QString, CompressingDevice::Codec> &_codec : _codecs) {
+        QAction *_action = _compressionMenu->addAction(_codec.first);  // Choice of one codec
+        _action->setCheckable(true);
+        _action->setChecked(_codec.second == GetExportCodec());
+        _action->setEnabled(CompressingDevice::IsAvailable(_codec.second));
+        _compressionGroup->addAction(_action);
+        const CompressingDevice::Codec _value = _codec.second;  // Codec stored when chosen
+        connect(_action, &QAction::triggered, this, [_value]() {
+            QSettings().setValue(EXPORT_COMPRESSION_SETTING, static_cast<int>(_value));
+        });
+    }
+    ExportButton->setMenu(_exportMenu);
+    connect(ImportButton, &QPushButton::clicked, this, &MainWindow::OnImportButtonClicked);
+    connect(StatisticsButton, &QPushButton::clicked, this, &MainWindow::OnStatisticsButtonClicked);
+    connect(PivotButton, &QPushButton::clicked, this, &MainWindow::OnPivotButtonClicked);
+
     // Table interaction connections
     connect(DataTable, &QTableWidget::cellDoubleClicked, this, &MainWindow::OnRowDoubleClicked);
+    connect(DataTable->horizontalHeader(), &QHeaderView::customContextMenuRequested,
+            this, &MainWindow::OnHeaderContextMenuRequested);
+
+    // Columns scrolled into view (or revealed by resizing) are fetched on demand
+    connect(DataTable->horizontalScrollBar(), &QScrollBar::valueChanged, this, &MainWindow::OnHorizontalScrollChanged);
+    connect(DataTable->horizontalScrollBar(), &QScrollBar::rangeChanged, this, &MainWindow::OnHorizontalScrollChanged);
+    connect(DataTable->horizontalScrollBar(), &QScrollBar::valueChanged, FilterHeader, &FilterHeaderView::UpdateEditorPositions);
+
+    // Further rows are fetched page by page when scrolling near the end
+    connect(DataTable->verticalScrollBar(), &QScrollBar::valueChanged, this, &MainWindow::OnVerticalScrollChanged);
+
+    // Filters are pushed down into the SQL query
+    connect(FilterHeader, &FilterHeaderView::FilterChanged, this, &MainWindow::OnFilterChanged);
+
+    // Header clicks sort in SQL; Shift+click adds a secondary sort column
+    connect(FilterHeader, &QHeaderView::sectionClicked, this, &MainWindow::OnHeaderSectionClicked);
+
+    // Find-in-table connections
+    connect(new QShortcut(QKeySequence::Find, this), &QShortcut::activated, this, &MainWindow::OnFindRequested);
+    connect(new QShortcut(QKeySequence::FindNext, this), &QShortcut::activated, this, &MainWindow::OnFindNext);
+    connect(new QShortcut(QKeySequence::FindPrevious, this), &QShortcut::activated, this, &MainWindow::OnFindPrevious);
+    QShortcut *_findEscape = new QShortcut(QKeySequence(Qt::Key_Escape), FindBar);  // Escape closes the find bar while it has focus
+    _findEscape->setContext(Qt::WidgetWithChildrenShortcut);
+    connect(_findEscape, &QShortcut::activated, this, &MainWindow::OnFindClosed);
+    connect(FindEdit, &QLineEdit::textChanged, this, &MainWindow::OnFindTextChanged);
+    connect(FindEdit, &QLineEdit::returnPressed, this, &MainWindow::OnFindNext);
+    connect(FindNextButton, &QPushButton::clicked, this, &MainWindow::OnFindNext);
+    connect(FindPreviousButton, &QPushButton::clicked, this, &MainWindow::OnFindPrevious);
+    connect(Finder, &TableFindScanner::HitsFound, this, &MainWindow::OnFindHitsFound);
+
+    // Background maintenance connection
+    connect(MaintenanceTimer, &QTimer::timeout, this, &MainWindow::OnMaintenanceTimerTimeout);
 }
 
 /**
@@ -226,6 +459,19 @@ void MainWindow::OnLoadFileClicked()
         return;
     }
 
+    if (ActiveCompaction) {
+        QMessageBox::warning(this, "Warning", "Please wait for the running compaction to finish.");
+        return;
+    }
+
+    // Background tasks must not run against the previous file
+    StopMaintenance();
+    StopIntegrityCheck();
+    StopSearchIndexing();
+    StatisticsPanel->ClearCache();
+    delete ActivePivot;
+    delete ActiveGlobalSearch;
+
     // Reset UI state
     TableComboBox->clear();
     DataTable->setRowCount(0);
@@ -244,6 +490,11 @@ void MainWindow::OnLoadFileClicked()
         // Populate table selection dropdown
         TableComboBox->addItems(_tableNames);
         TableComboBox->setEnabled(true);
+        CompactButton->setEnabled(true);
+        GlobalSearchButton->setEnabled(true);
+
+        StartIntegrityCheck();
+        ScheduleMaintenance();
 
         QMessageBox::information(this, "Success", "SQL database file loaded successfully.");
     } else {
@@ -258,6 +509,17 @@ void MainWindow::OnTableSelectionChanged()
 {
     if (TableComboBox->currentIndex() >= 0) {
         CurrentTableName = TableComboBox->currentText();
+
+        // Filters belong to the table they were typed for
+        QString _errorMessage;  // Unused: clearing a filter cannot fail
+        FilterHeader->ClearFilters();
+        Worker->SetTableFilter(CurrentTableName, QMap<QString, QString>(), _errorMessage);
+        Worker->SetTableSort(CurrentTableName, QList<SQLWorker::SortKey>());
+        FilterHeader->setSortIndicatorShown(false);
+        SearchEdit->clear();
+        Worker->SetTableSearch(CurrentTableName, QString());
+        UpdateSearchControls();
+
         LoadTableData();
 
         // Configure for table usage
@@ -265,9 +527,15 @@ void MainWindow::OnTableSelectionChanged()
         AddButton->setEnabled(true);
         DeleteButton->setEnabled(true);
         EditButton->setEnabled(true);
-        UpdateButton->setEnabled(true);
+        UpdateButton->setEnabled(!ActiveCompaction && !ActiveSearchIndexing);  // Saving stays blocked while a background task copies the file
         CancelButton->setEnabled(true);
         PrintButton->setEnabled(true);  // Enable print button when table is selected
+        ExportButton->setEnabled(true);
+        ImportButton->setEnabled(true);
+        StatisticsButton->setEnabled(true);
+        PivotButton->setEnabled(true);
+        GoToKeyEdit->setEnabled(true);
+        RefreshStatistics();
 
         // Reset any active modes
         ResetToggleButtons();
@@ -348,6 +616,18 @@ void MainWindow::OnUpdateButtonClicked()
         return;
     }
 
+    if (IntegrityProblemsFound) {
+        int _result = QMessageBox::question(  // Dialog result: QMessageBox::Yes or QMessageBox::No
+            this,
+            "Integrity Problems",
+            "The integrity check reported problems in this file. Saving may fail or damage data further.\n\nSave anyway?",
+            QMessageBox::Yes | QMessageBox::No
+            );
+        if (_result != QMessageBox::Yes) {
+            return;
+        }
+    }
+
     bool success = false;
 
     if (IsAddMode || IsEditMode) {
@@ -368,6 +648,9 @@ void MainWindow::OnUpdateButtonClicked()
         ResetToggleButtons();
         LoadTableData();
         HasUnsavedChanges = false;
+
+        RefreshStatistics();  // The data version moved, cached statistics are stale
+        ScheduleMaintenance();
     } else {
         QMessageBox::critical(this, "Error", "Failed to save changes to SQL database file.");
     }
@@ -403,7 +686,7 @@ void MainWindow::OnCancelButtonClicked()
 }
 
 /**
- * @brief Handle print button click to export table to PDF and Excel files
+ * @brief Handle print button click to export table to PDF and CSV files in the background
  */
 void MainWindow::OnPrintButtonClicked()
 {
@@ -411,7 +694,250 @@ void MainWindow::OnPrintButtonClicked()
         QMessageBox::warning(this, "Warning", "No table data to export.");
         return;
     }
+    // The compacted copy replaces the file when it finishes, which must not happen under export readers
+    if (ActiveCompaction) {
+        QMessageBox::warning(this, "Warning", "Please wait for the compaction to finish before exporting.");
+        return;
+    }
+
+    QString _basePath = GetExportBasePath(CurrentTableName);  // Export path without extension
+    CompressingDevice::Codec _codec = GetExportCodec();  // Compression of the CSV
+    QString _pdfPath = _basePath + ".pdf";
+    QString _excelPath = _basePath + ".csv" + CompressingDevice::GetFileSuffix(_codec);
+
+    // Both files stream every matching row from their own connection and thread, so they are
+    // written concurrently while the window stays usable; the jobs panel reports each result
+    StartCsvExportJob(CurrentTableName, _excelPath, _codec);
+    StartPdfExportJob(CurrentTableName, "Table: " + CurrentTableName, _pdfPath);
+
+    ExportJobs->show();
+    ExportJobs->raise();
+    statusBar()->showMessage(QString("Exporting %1 in the background").arg(CurrentTableName), 5000);
+}
+
+/**
+ * @brief Export the current table to a Parquet file in the downloads folder as a background job
+ */
+void MainWindow::OnExportParquetRequested(ParquetWriter::Compression compression)
+{
+    if (CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    // The swap at the end of a compaction replaces the file the job reads
+    if (ActiveCompaction) {
+        QMessageBox::warning(this, "Warning", "Please wait for the compaction to finish before exporting.");
+        return;
+    }
+
+    QString _parquetPath = GetExportBasePath(CurrentTableName) + ".parquet";  // Export file
+    QString _queryString;      // Statement of the view's rows
+    QVariantList _bindValues;  // View placeholder values
+    Worker->BuildTableQuery(CurrentTableName, _queryString, _bindValues);
+
+    ParquetExportTask *_task = new ParquetExportTask(Worker->GetCurrentFilePath(), _queryString, _bindValues,
+                                                     Worker->GetTableColumns(CurrentTableName),
+                                                     Worker->GetTableColumnTypes(CurrentTableName), _parquetPath,
+                                                     compression);  // Export job
+    ExportJobs->AddJob(_task, QString("%1 (Parquet)").arg(CurrentTableName), _parquetPath, [_task]() { return _task->GetRowCount(); });
+    ExportJobs->show();
+    ExportJobs->raise();
+}
+
+/**
+ * @brief Export the current table to an Arrow IPC (Feather) file in the downloads folder as a background job
+ */
+void MainWindow::OnExportArrowRequested()
+{
+    if (CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    // The swap at the end of a compaction replaces the file the job reads
+    if (ActiveCompaction) {
+        QMessageBox::warning(this, "Warning", "Please wait for the compaction to finish before exporting.");
+        return;
+    }
+
+    // Larger batches suit scans, smaller ones keep memory low and let readers start sooner
+    bool _accepted = false;  // Dialog confirmed
+    int _batchRows = QInputDialog::getInt(this, "Arrow Export", "Rows per record batch:",
+                                          QSettings().value(ARROW_BATCH_ROWS_SETTING, ArrowIpcWriter::DEFAULT_BATCH_ROWS).toInt(),
+                                          1, 16777216, 1024, &_accepted);  // Rows per record batch
+    if (!_accepted) {
+        return;
+    }
+    QSettings().setValue(ARROW_BATCH_ROWS_SETTING, _batchRows);
+
+    // Readers memory-map Arrow IPC files, so the compression choice of the other exports is not applied
+    QString _arrowPath = GetExportBasePath(CurrentTableName) + ".arrow";  // Export file
+    QString _queryString;      // Statement of the view's rows
+    QVariantList _bindValues;  // View placeholder values
+    Worker->BuildTableQuery(CurrentTableName, _queryString, _bindValues);
+
+    ArrowExportTask *_task = new ArrowExportTask(Worker->GetCurrentFilePath(), _queryString, _bindValues,
+                                                 Worker->GetTableColumns(CurrentTableName),
+                                                 Worker->GetTableColumnTypes(CurrentTableName), _arrowPath, _batchRows);  // Export job
+    ExportJobs->AddJob(_task, QString("%1 (Arrow)").arg(CurrentTableName), _arrowPath, [_task]() { return _task->GetRowCount(); });
+    ExportJobs->show();
+    ExportJobs->raise();
+}
+
+/**
+ * @brief Export the current table to a JSON Lines file in the downloads folder as a background job
+ */
+void MainWindow::OnExportJsonLinesRequested()
+{
+    if (CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    // The swap at the end of a compaction replaces the file the job reads
+    if (ActiveCompaction) {
+        QMessageBox::warning(this, "Warning", "Please wait for the compaction to finish before exporting.");
+        return;
+    }
+
+    CompressingDevice::Codec _codec = GetExportCodec();  // Compression of the file
+    QString _jsonPath = GetExportBasePath(CurrentTableName) + ".jsonl" + CompressingDevice::GetFileSuffix(_codec);  // Export file
+    QString _queryString;      // Statement of the view's rows
+    QVariantList _bindValues;  // View placeholder values
+    Worker->BuildTableQuery(CurrentTableName, _queryString, _bindValues);
+
+    JsonLinesExportTask *_task = new JsonLinesExportTask(Worker->GetCurrentFilePath(), _queryString, _bindValues,
+                                                         _jsonPath, _codec);  // Export job
+    ExportJobs->AddJob(_task, QString("%1 (JSON Lines)").arg(CurrentTableName), _jsonPath, [_task]() { return _task->GetRowCount(); });
+    ExportJobs->show();
+    ExportJobs->raise();
+}
+
+/**
+ * @brief Export the current table to an Excel workbook in the downloads folder as a background job
+ */
+void MainWindow::OnExportXlsxRequested()
+{
+    if (CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    // The swap at the end of a compaction replaces the file the job reads
+    if (ActiveCompaction) {
+        QMessageBox::warning(this, "Warning", "Please wait for the compaction to finish before exporting.");
+        return;
+    }
+
+    // The workbook is a zip container already, so the export compression does not apply
+    QString _xlsxPath = GetExportBasePath(CurrentTableName) + ".xlsx";  // Export file
+    QString _queryString;      // Statement of the view's rows
+    QVariantList _bindValues;  // View placeholder values
+    Worker->BuildTableQuery(CurrentTableName, _queryString, _bindValues);
+
+    XlsxExportTask *_task = new XlsxExportTask(Worker->GetCurrentFilePath(), _queryString, _bindValues,
+                                               CurrentTableName, _xlsxPath);  // Export job
+    ExportJobs->AddJob(_task, QString("%1 (Excel)").arg(CurrentTableName), _xlsxPath, [_task]() { return _task->GetRowCount(); });
+    ExportJobs->show();
+    ExportJobs->raise();
+}
+
+/**
+ * @brief Insert the rows of a JSON Lines file into the current table
+ */
+void MainWindow::OnImportButtonClicked()
+{
+    if (CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+    // Rows written during compaction or an index build would be lost by the file swap or missing from the index
+    if (ActiveCompaction || ActiveSearchIndexing) {
+        QMessageBox::warning(this, "Warning", "Please wait for the background task to finish before importing.");
+        return;
+    }
+    if (HasUnsavedChanges) {
+        int _result = QMessageBox::question(  // Dialog result: QMessageBox::Yes or QMessageBox::No
+            this,
+            "Unsaved Changes",
+            "The table is reloaded after the import and unsaved changes are discarded.\n\nImport anyway?",
+            QMessageBox::Yes | QMessageBox::No
+            );
+        if (_result != QMessageBox::Yes) {
+            return;
+        }
+    }
+
+    QString _filePath = QFileDialog::getOpenFileName(  // Path to selected JSON Lines file (empty if canceled)
+        this,
+        "Select JSON Lines File",
+        QDir::homePath(),
+        "JSON Lines Files (*.jsonl *.ndjson *.json);;All Files (*.*)"
+        );
+    if (_filePath.isEmpty()) {
+        return;
+    }
+
+    QFile _file(_filePath);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        QMessageBox::critical(this, "Import Failed", QString("Cannot open %1.").arg(_filePath));
+        return;
+    }
+
+    QProgressDialog _progress(QString("Importing into %1...").arg(CurrentTableName), "Cancel", 0, 0, this);  // Modal progress while inserting
+    _progress.setWindowModality(Qt::WindowModal);
+    _progress.setMinimumDuration(500);
+
+    qint64 _importedRows = 0;  // Rows committed
+    QStringList _unknownKeys;  // Keys without a column
+    QString _errorMessage;     // Reason the import stopped
+    bool _success = Worker->ImportJsonLines(CurrentTableName, &_file, [&_progress](qint64 rowCount) {
+        _progress.setLabelText(QString("%1 rows imported").arg(rowCount));
+        QCoreApplication::processEvents();
+        return !_progress.wasCanceled();
+    }, _importedRows, _unknownKeys, _errorMessage);  // Every line was imported
+    _progress.close();
+
+    if (_importedRows > 0) {
+        ResetToggleButtons();
+        LoadTableData();
+        HasUnsavedChanges = false;
+
+        RefreshStatistics();  // The data version moved, cached statistics are stale
+        ScheduleMaintenance();
+    }
+
+    QString _message = QString("%1 rows imported into %2.").arg(_importedRows).arg(CurrentTableName);  // Result text
+    if (!_unknownKeys.isEmpty()) {
+        _message += QString("\n\nKeys without a matching column were ignored: %1").arg(_unknownKeys.join(", "));
+    }
+    if (!_success) {
+        QMessageBox::critical(this, "Import Failed", QString("Import stopped: %1\n\n%2").arg(_errorMessage, _message));
+        return;
+    }
+    QMessageBox::information(this, "Import Successful", _message);
+}
+
+/**
+ * @brief Export a table model to PDF and CSV files in the downloads folder and report the result
+ */
+void MainWindow::ExportModel(const QAbstractItemModel *model, const QString &title, const QString &baseName)
+{
+    QString _basePath = GetExportBasePath(baseName);  // Export path without extension
+    CompressingDevice::Codec _codec = GetExportCodec();  // Compression of the CSV
+    QString _pdfPath = _basePath + ".pdf";
+    QString _excelPath = _basePath + ".csv" + CompressingDevice::GetFileSuffix(_codec);
+
+    // Export to PDF
+    bool _pdfSuccess = ExportTableToPDF(model, title, _pdfPath);
 
+    // Export to Excel-compatible CSV
+    bool _excelSuccess = ExportTableToExcel(model, _excelPath, _codec);
+
+    ReportExportResult(_pdfSuccess, _pdfPath, _excelSuccess, _excelPath);
+}
+
+/**
+ * @brief Get the path of new export files in the downloads folder, without extension
+ */
+QString MainWindow::GetExportBasePath(const QString &baseName)
+{
     // Create export directory
     QString _downloadsPath = QStandardPaths::writableLocation(QStandardPaths::DownloadLocation);
     if (_downloadsPath.isEmpty()) {
@@ -425,34 +951,88 @@ void MainWindow::OnPrintButtonClicked()
 
     // Generate file names with timestamp
     QString _timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss");
-    QString _baseName = QString("%1_%2").arg(CurrentTableName, _timestamp);
-
-    QString _pdfPath = _exportDir.filePath(_baseName + ".pdf");
-    QString _excelPath = _exportDir.filePath(_baseName + ".csv");
-
-    bool _pdfSuccess = false;
-    bool _excelSuccess = false;
-
-    // Export to PDF
-    _pdfSuccess = ExportTableToPDF(_pdfPath);
+    return _exportDir.filePath(QString("%1_%2").arg(baseName, _timestamp));
+}
 
-    // Export to Excel-compatible CSV
-    _excelSuccess = ExportTableToExcel(_excelPath);
+/**
+ * @brief Get the compression chosen for exports
+ */
+CompressingDevice::Codec MainWindow::GetExportCodec() const
+{
+    int _stored = QSettings().value(EXPORT_COMPRESSION_SETTING, static_cast<int>(CompressingDevice::Codec::None)).toInt();  // Saved choice
+    CompressingDevice::Codec _codec = static_cast<CompressingDevice::Codec>(_stored);  // Codec of the choice
+    if (_stored < 0 || _stored > static_cast<int>(CompressingDevice::Codec::Zstd) || !CompressingDevice::IsAvailable(_codec)) {
+        return CompressingDevice::Codec::None;
+    }
+    return _codec;
+}
 
-    // Show results
+/**
+ * @brief Tell the user which export files were written
+ */
+void MainWindow::ReportExportResult(bool pdfSuccess, const QString &pdfPath, bool excelSuccess, const QString &excelPath)
+{
     QString _message;
-    if (_pdfSuccess && _excelSuccess) {
-        _message = QString("Table exported successfully!\n\nPDF: %1\nExcel: %2").arg(_pdfPath, _excelPath);
+    if (pdfSuccess && excelSuccess) {
+        _message = QString("Table exported successfully!\n\nPDF: %1\nCSV: %2").arg(pdfPath, excelPath);
         QMessageBox::information(this, "Export Successful", _message);
-    } else if (_pdfSuccess) {
-        _message = QString("PDF exported successfully: %1\n\nExcel export failed.").arg(_pdfPath);
+    } else if (pdfSuccess) {
+        _message = QString("PDF exported successfully: %1\n\nCSV export failed.").arg(pdfPath);
         QMessageBox::warning(this, "Partial Export", _message);
-    } else if (_excelSuccess) {
-        _message = QString("Excel exported successfully: %1\n\nPDF export failed.").arg(_excelPath);
+    } else if (excelSuccess) {
+        _message = QString("CSV exported successfully: %1\n\nPDF export failed.").arg(excelPath);
         QMessageBox::warning(this, "Partial Export", _message);
     } else {
-        QMessageBox::critical(this, "Export Failed", "Both PDF and Excel export failed.");
+        QMessageBox::critical(this, "Export Failed", "Both PDF and CSV export failed.");
+    }
+}
+
+/**
+ * @brief Show the column statistics panel for the current table
+ */
+void MainWindow::OnStatisticsButtonClicked()
+{
+    if (CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    StatisticsPanel->show();
+    StatisticsPanel->raise();
+    RefreshStatistics();
+}
+
+/**
+ * @brief Open the pivot view for the current table
+ */
+void MainWindow::OnPivotButtonClicked()
+{
+    if (CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    // One pivot view at a time, always for the selected table
+    if (ActivePivot && ActivePivot->GetTableName() != CurrentTableName) {
+        delete ActivePivot;
     }
+
+    if (!ActivePivot) {
+        ActivePivot = new PivotDialog(Worker->GetCurrentFilePath(), CurrentTableName, Worker->GetTableColumns(CurrentTableName),
+                                      Worker->GetTableFilter(CurrentTableName), this);
+        ActivePivot->setAttribute(Qt::WA_DeleteOnClose);
+        connect(ActivePivot, &PivotDialog::ExportRequested, this, &MainWindow::OnPivotExportRequested);
+    }
+
+    ActivePivot->show();
+    ActivePivot->raise();
+    ActivePivot->activateWindow();
+}
+
+/**
+ * @brief Export a pivot result through the normal export paths
+ */
+void MainWindow::OnPivotExportRequested(const QAbstractItemModel *model, const QString &title, const QString &baseName)
+{
+    ExportModel(model, title, baseName);
 }
 
 /**
@@ -535,9 +1115,17 @@ void MainWindow::LoadTableData()
         return;
     }
 
-    if (Worker->LoadTableData(CurrentTableName, DataTable)) {
-        DataTable->resizeColumnsToContents();
+    // Only the columns that fit into the viewport are fetched; the rest follow on horizontal scroll
+    int _visibleColumns = DataTable->viewport()->width() / qMax(1, DataTable->horizontalHeader()->minimumSectionSize());  // Upper bound of columns on screen
+
+    IsLoadingTable = true;  // Scroll signals raised while the widget is rebuilt must not fetch columns
+    bool _loaded = Worker->LoadTableData(CurrentTableName, DataTable, GetHiddenColumns(), _visibleColumns + COLUMN_FETCH_LOOKAHEAD);  // Result of loading the table
+    IsLoadingTable = false;
+
+    if (_loaded) {
+        ResizeLoadedColumns(0, DataTable->columnCount() - 1);
         HasUnsavedChanges = false;
+        UpdateRowCountStatus();
     } else {
         QMessageBox::warning(this, "Warning", "Failed to load table data.");
     }
@@ -591,131 +1179,1054 @@ void MainWindow::DisableTableEditing()
 }
 
 /**
- * @brief Export current table to PDF file
+ * @brief Export a table model to PDF file
+ * @param model Model to export
+ * @param title Heading of the document
  * @param filePath Path where PDF file will be saved
  * @return true if export successful, false otherwise
  */
-bool MainWindow::ExportTableToPDF(const QString &filePath)
+bool MainWindow::ExportTableToPDF(const QAbstractItemModel *model, const QString &title, const QString &filePath)
 {
+    QStringList _headers;  // Column headers of the model
+    for (int _col = 0; _col < model->columnCount(); ++_col) {
+        _headers.append(model->headerData(_col, Qt::Horizontal).toString());
+    }
+
     QPrinter _printer(QPrinter::HighResolution);
-    _printer.setOutputFormat(QPrinter::PdfFormat);
-    _printer.setOutputFileName(filePath);
-    _printer.setPageSize(QPageSize::A4);
-    _printer.setPageOrientation(QPageLayout::Landscape);
+    SetupPdfPrinter(_printer, filePath);
 
-    QTextDocument _document;
-    _document.setHtml(GenerateHTMLTable());
+    PdfTableWriter _writer(&_printer, title, _headers);  // Painter of the table pages
+    if (!_writer.Begin()) {
+        return false;
+    }
 
-    _document.print(&_printer);
+    QStringList _cells;  // Texts of the current row
+    for (int _row = 0; _row < model->rowCount(); ++_row) {
+        _cells.clear();
+        for (int _col = 0; _col < model->columnCount(); ++_col) {
+            _cells.append(model->data(model->index(_row, _col)).toString());
+        }
+        if (!_writer.AddRow(_cells)) {
+            break;
+        }
+    }
 
+    if (!_writer.Finish()) {
+        QFile::remove(filePath);
+        return false;
+    }
     return QFile::exists(filePath);
 }
 
 /**
- * @brief Export current table to Excel-compatible CSV file
+ * @brief Start a background job painting every row of a table to PDF
+ */
+void MainWindow::StartPdfExportJob(const QString &tableName, const QString &title, const QString &filePath)
+{
+    QString _queryString;      // Statement of the view's rows
+    QVariantList _bindValues;  // View placeholder values
+    Worker->BuildTableQuery(tableName, _queryString, _bindValues);
+
+    PdfExportTask *_task = new PdfExportTask(Worker->GetCurrentFilePath(), _queryString, _bindValues, title, filePath);  // Export job
+    ExportJobs->AddJob(_task, QString("%1 (PDF)").arg(tableName), filePath, [_task]() { return _task->GetRowCount(); });
+}
+
+/**
+ * @brief Configure a printer for A4 landscape PDF output
+ */
+void MainWindow::SetupPdfPrinter(QPrinter &printer, const QString &filePath)
+{
+    printer.setOutputFormat(QPrinter::PdfFormat);
+    printer.setOutputFileName(filePath);
+    printer.setPageSize(QPageSize::A4);
+    printer.setPageOrientation(QPageLayout::Landscape);
+}
+
+/**
+ * @brief Export a table model to Excel-compatible CSV file
+ * @param model Model to export
  * @param filePath Path where Excel file will be saved
+ * @param codec Compression of the file
  * @return true if export successful, false otherwise
  */
-bool MainWindow::ExportTableToExcel(const QString &filePath)
+bool MainWindow::ExportTableToExcel(const QAbstractItemModel *model, const QString &filePath, CompressingDevice::Codec codec)
 {
-    QFile _file(filePath);
-    if (!_file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    CompressingDevice _file(filePath, codec);  // Output file, compressed on the pipeline thread
+    if (!_file.open(QIODevice::WriteOnly)) {
         return false;
     }
 
+    CsvWriter _writer(&_file);  // Encoder writing fields straight into the file
     // Write UTF-8 BOM first for Excel compatibility
-    _file.write("\xEF\xBB\xBF");
-
-    QTextStream _stream(&_file);
-    // Qt 6 uses UTF-8 by default, Qt 5 should handle it properly too
+    _writer.WriteBom();
 
     // Write headers
-    QStringList _headers;
-    for (int _col = 0; _col < DataTable->columnCount(); ++_col) {
-        QTableWidgetItem *_headerItem = DataTable->horizontalHeaderItem(_col);
-        QString _headerText = _headerItem ? _headerItem->text() : QString("Column_%1").arg(_col + 1);
-
-        // Escape quotes and wrap in quotes if contains comma, quote, or newline
-        if (_headerText.contains(',') || _headerText.contains('"') || _headerText.contains('\n')) {
-            _headerText.replace('"', "\"\"");
-            _headerText = '"' + _headerText + '"';
-        }
-        _headers.append(_headerText);
+    for (int _col = 0; _col < model->columnCount(); ++_col) {
+        _writer.WriteText(model->headerData(_col, Qt::Horizontal).toString());
     }
-    _stream << _headers.join(',') << '\n';
+    _writer.EndRow();
 
     // Write data rows
-    for (int _row = 0; _row < DataTable->rowCount(); ++_row) {
-        QStringList _rowData;
-        for (int _col = 0; _col < DataTable->columnCount(); ++_col) {
-            QTableWidgetItem *_item = DataTable->item(_row, _col);
-            QString _cellText = _item ? _item->text() : "";
-
-            // Escape quotes and wrap in quotes if contains comma, quote, or newline
-            if (_cellText.contains(',') || _cellText.contains('"') || _cellText.contains('\n')) {
-                _cellText.replace('"', "\"\"");
-                _cellText = '"' + _cellText + '"';
-            }
-            _rowData.append(_cellText);
+    for (int _row = 0; _row < model->rowCount(); ++_row) {
+        for (int _col = 0; _col < model->columnCount(); ++_col) {
+            _writer.WriteValue(model->data(model->index(_row, _col)));
         }
-        _stream << _rowData.join(',') << '\n';
+        _writer.EndRow();
     }
 
-    _file.close();
+    if (!_writer.Flush() || !_file.Finish()) {
+        _file.Remove();
+        return false;
+    }
     return true;
 }
 
 /**
- * @brief Generate HTML table representation for PDF export
- * @return QString containing HTML table markup
+ * @brief Start a background job writing every row of a table to Excel-compatible CSV
  */
-QString MainWindow::GenerateHTMLTable()
+void MainWindow::StartCsvExportJob(const QString &tableName, const QString &filePath, CompressingDevice::Codec codec)
 {
-    QString _html = "<html><head><style>";
-    _html += "body { font-family: Arial, sans-serif; margin: 20px; }";
-    _html += "h1 { color: #333; text-align: center; margin-bottom: 20px; }";
-    _html += "table { border-collapse: collapse; width: 100%; margin: 0 auto; }";
-    _html += "th, td { border: 1px solid #ddd; padding: 8px; text-align: left; }";
-    _html += "th { background-color: #f2f2f2; font-weight: bold; }";
-    _html += "tr:nth-child(even) { background-color: #f9f9f9; }";
-    _html += ".info { font-size: 12px; color: #666; text-align: center; margin-top: 20px; }";
-    _html += "</style></head><body>";
+    // Formatting is the bottleneck, so views in rowid order are split into ranges on several connections
+    QString _rangeQuery;       // Statement selecting one rowid range
+    QVariantList _bindValues;  // View placeholder values
+    if (Worker->BuildTableRangeQuery(tableName, _rangeQuery, _bindValues)) {
+        Worker->EnableWriteAheadLog();  // The range readers must not hold off saves while they run
+        ParallelCsvExportTask *_task = new ParallelCsvExportTask(Worker->GetCurrentFilePath(), tableName, _rangeQuery,
+                                                                 _bindValues, filePath, codec);  // Range export job
+        ExportJobs->AddJob(_task, QString("%1 (CSV)").arg(tableName), filePath, [_task]() { return _task->GetRowCount(); });
+        return;
+    }
 
-    // Add title
-    _html += QString("<h1>Table: %1</h1>").arg(CurrentTableName);
+    QString _queryString;  // Statement of the view's rows
+    Worker->BuildTableQuery(tableName, _queryString, _bindValues);
+    CsvExportTask *_task = new CsvExportTask(Worker->GetCurrentFilePath(), _queryString, _bindValues, filePath, true, codec);  // Export job
+    ExportJobs->AddJob(_task, QString("%1 (CSV)").arg(tableName), filePath, [_task]() { return _task->GetRowCount(); });
+}
 
-    // Add table
-    _html += "<table>";
+/**
+ * @brief Start background maintenance once the editor has been idle
+ */
+void MainWindow::OnMaintenanceTimerTimeout()
+{
+    if (ActiveMaintenance || !Worker->IsFileLoaded()) {
+        return;
+    }
 
-    // Add headers
-    _html += "<tr>";
-    for (int _col = 0; _col < DataTable->columnCount(); ++_col) {
-        QTableWidgetItem *_headerItem = DataTable->horizontalHeaderItem(_col);
-        QString _headerText = _headerItem ? _headerItem->text() : QString("Column_%1").arg(_col + 1);
-        _html += QString("<th>%1</th>").arg(_headerText.toHtmlEscaped());
+    // Postpone while the user is in the middle of editing or another task is using the file
+    if (ActiveIntegrityCheck || ActiveCompaction || ActiveSearchIndexing || HasUnsavedChanges || IsAddMode || IsDeleteMode || IsEditMode) {
+        ScheduleMaintenance();
+        return;
     }
-    _html += "</tr>";
 
-    // Add data rows
-    for (int _row = 0; _row < DataTable->rowCount(); ++_row) {
-        _html += "<tr>";
-        for (int _col = 0; _col < DataTable->columnCount(); ++_col) {
-            QTableWidgetItem *_item = DataTable->item(_row, _col);
-            QString _cellText = _item ? _item->text() : "";
-            _html += QString("<td>%1</td>").arg(_cellText.toHtmlEscaped());
-        }
-        _html += "</tr>";
+    ActiveMaintenance = new MaintenanceTask(Worker->GetCurrentFilePath(), Worker->GetChangedTables());
+    connect(ActiveMaintenance, &DatabaseTask::ProgressChanged, this, [this](int percent, const QString &message) {
+        statusBar()->showMessage(QString("Maintenance %1%: %2").arg(percent).arg(message));
+    });
+    connect(ActiveMaintenance, &DatabaseTask::Finished, this, &MainWindow::OnMaintenanceFinished);
+
+    ActiveMaintenance->Start();
+}
+
+/**
+ * @brief Handle completion of a background maintenance run
+ */
+void MainWindow::OnMaintenanceFinished(bool success, const QString &message)
+{
+    if (!ActiveMaintenance) {
+        return;
+    }
+
+    if (success) {
+        // Tables changed while maintenance was running stay queued for the next run
+        Worker->ClearChangedTables(ActiveMaintenance->GetChangedTables());
+    }
+
+    statusBar()->showMessage(message, 10000);
+
+    ActiveMaintenance->deleteLater();
+    ActiveMaintenance = nullptr;
+}
+
+/**
+ * @brief Restart the idle timer that triggers background maintenance
+ */
+void MainWindow::ScheduleMaintenance()
+{
+    MaintenanceTimer->start();
+}
+
+/**
+ * @brief Cancel and dispose of a running maintenance task
+ */
+void MainWindow::StopMaintenance()
+{
+    MaintenanceTimer->stop();
+
+    if (ActiveMaintenance) {
+        ActiveMaintenance->disconnect(this);
+        ActiveMaintenance->Stop();
+        delete ActiveMaintenance;  // Thread has left Run, so no member is still in use
+        ActiveMaintenance = nullptr;
+    }
+}
+
+/**
+ * @brief Remember the integrity check mode selected by the user
+ */
+void MainWindow::OnIntegrityModeChanged()
+{
+    QSettings().setValue(INTEGRITY_MODE_SETTING, IntegrityModeComboBox->currentIndex());
+}
+
+/**
+ * @brief Handle completion of the open-time integrity scan
+ */
+void MainWindow::OnIntegrityCheckFinished(bool success, const QString &message)
+{
+    if (!ActiveIntegrityCheck) {
+        return;
     }
 
-    _html += "</table>";
+    QStringList _errors = ActiveIntegrityCheck->GetErrors();  // Problems reported by the scan (empty if healthy)
+    IntegrityProblemsFound = !_errors.isEmpty();
+
+    ActiveIntegrityCheck->deleteLater();
+    ActiveIntegrityCheck = nullptr;
 
-    // Add export info
-    QString _timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    _html += QString("<div class='info'>Exported on %1 | Total rows: %2</div>")
-                 .arg(_timestamp)
-                 .arg(DataTable->rowCount());
+    statusBar()->showMessage(message, 10000);
 
-    _html += "</body></html>";
+    if (success && IntegrityProblemsFound) {
+        QStringList _shownErrors = _errors.mid(0, 10);  // First problems listed in the dialog
+        QMessageBox::warning(this, "Integrity Problems",
+                             QString("%1.\n\n%2%3")
+                                 .arg(message, _shownErrors.join('\n'),
+                                      _errors.size() > _shownErrors.size() ? "\n..." : ""));
+    }
+}
+
+/**
+ * @brief Start the integrity scan selected in the integrity combo box
+ */
+void MainWindow::StartIntegrityCheck()
+{
+    IntegrityProblemsFound = false;
+
+    int _modeIndex = IntegrityModeComboBox->currentIndex();  // 0 = off, 1 = quick, 2 = full
+    if (_modeIndex <= 0 || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    IntegrityCheckTask::CheckMode _mode = (_modeIndex == 2) ? IntegrityCheckTask::FullCheck
+                                                            : IntegrityCheckTask::QuickCheck;  // Scan depth requested
+    ActiveIntegrityCheck = new IntegrityCheckTask(Worker->GetCurrentFilePath(), _mode, INTEGRITY_MAX_ERRORS);
+
+    connect(ActiveIntegrityCheck, &DatabaseTask::ProgressChanged, this, [this](int percent, const QString &message) {
+        statusBar()->showMessage(percent >= 0 ? QString("%1 (%2%)").arg(message).arg(percent) : message);
+    });
+    connect(ActiveIntegrityCheck, &IntegrityCheckTask::ErrorFound, this, [this](const QString &errorText) {
+        statusBar()->showMessage("Integrity problem: " + errorText);
+    });
+    connect(ActiveIntegrityCheck, &DatabaseTask::Finished, this, &MainWindow::OnIntegrityCheckFinished);
+
+    ActiveIntegrityCheck->Start();
+}
+
+/**
+ * @brief Cancel and dispose of a running integrity scan
+ */
+void MainWindow::StopIntegrityCheck()
+{
+    if (ActiveIntegrityCheck) {
+        ActiveIntegrityCheck->disconnect(this);
+        ActiveIntegrityCheck->Stop();
+        delete ActiveIntegrityCheck;  // Thread has left Run, so no member is still in use
+        ActiveIntegrityCheck = nullptr;
+    }
+}
+
+/**
+ * @brief Handle compact button click to start background compaction
+ */
+void MainWindow::OnCompactButtonClicked()
+{
+    if (ActiveCompaction || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    if (HasUnsavedChanges) {
+        QMessageBox::warning(this, "Warning", "Please save or discard your changes before compacting the file.");
+        return;
+    }
+
+    if (ActiveSearchIndexing) {
+        QMessageBox::warning(this, "Warning", "Please wait for the search index to finish before compacting the file.");
+        return;
+    }
+
+    // Exports keep reading the current file, which the swap would replace under them
+    if (ExportJobs->HasRunningJobs()) {
+        QMessageBox::warning(this, "Warning", "Please wait for the running exports to finish before compacting the file.");
+        return;
+    }
+
+    StopMaintenance();
+
+    // Saving is blocked while the copy is written, otherwise the swap would discard those changes
+    CompactButton->setEnabled(false);
+    UpdateButton->setEnabled(false);
+    SearchIndexButton->setEnabled(false);
+
+    ActiveCompaction = new CompactTask(Worker->GetCurrentFilePath());
+    connect(ActiveCompaction, &DatabaseTask::ProgressChanged, this, [this](int percent, const QString &message) {
+        statusBar()->showMessage(QString("%1 (%2%)").arg(message).arg(percent));
+    });
+    connect(ActiveCompaction, &DatabaseTask::Finished, this, &MainWindow::OnCompactFinished);
+
+    ActiveCompaction->Start();
+}
+
+/**
+ * @brief Tell the user about a finished export job without interrupting their work
+ */
+void MainWindow::OnExportJobFinished(const QString &title, bool success, const QString &message, const QString &outputPath)
+{
+    if (success) {
+        statusBar()->showMessage(QString("Export finished: %1").arg(outputPath), 10000);
+    } else {
+        statusBar()->showMessage(QString("Export %1 did not complete: %2").arg(title, message), 10000);
+    }
+    QApplication::alert(this);  // Flashes the taskbar entry if the window is in the background
+}
+
+/**
+ * @brief Swap in the compacted file once background compaction has finished
+ */
+void MainWindow::OnCompactFinished(bool success, const QString &message)
+{
+    if (!ActiveCompaction) {
+        return;
+    }
+
+    bool _replaced = false;  // Result of swapping in the compacted copy
+
+    if (success) {
+        // No other connection may hold the file while it is replaced
+        StopMaintenance();
+        StopIntegrityCheck();
+        StatisticsPanel->ClearCache();  // The reopened file starts a new data version sequence
+        if (ActivePivot) {
+            ActivePivot->Stop();  // Keeps the groups already shown
+        }
+        delete ActiveGlobalSearch;  // Row ids of the hits may change with the rewrite
+
+        _replaced = Worker->ReplaceDatabaseFile(ActiveCompaction->GetCompactedFilePath());
+        if (_replaced) {
+            ActiveCompaction->ReleaseCompactedFile();
+        }
+    }
+
+    ActiveCompaction->deleteLater();  // Removes the copy if it was not swapped in
+    ActiveCompaction = nullptr;
+
+    CompactButton->setEnabled(Worker->IsFileLoaded());
+    UpdateButton->setEnabled(!CurrentTableName.isEmpty() && Worker->IsFileLoaded());
+    UpdateSearchControls();  // Compaction removes the search index
+
+    if (_replaced) {
+        LoadTableData();
+        RefreshStatistics();
+        statusBar()->showMessage(message, 10000);
+        QMessageBox::information(this, "Compaction Finished", message);
+        ScheduleMaintenance();
+    } else {
+        statusBar()->showMessage("Compaction failed", 10000);
+        QMessageBox::critical(this, "Compaction Failed",
+                              success ? "The compacted file could not be swapped in." : message);
+    }
+}
+
+/**
+ * @brief Show column visibility menu for the table header
+ */
+void MainWindow::OnHeaderContextMenuRequested(const QPoint &position)
+{
+    if (CurrentTableName.isEmpty() || DataTable->columnCount() == 0) {
+        return;
+    }
+
+    QMenu _menu(this);  // Menu with one checkable entry per column
+    for (int _col = 0; _col < DataTable->columnCount(); ++_col) {  // Current column index (0-based)
+        QTableWidgetItem *_headerItem = DataTable->horizontalHeaderItem(_col);  // Header item with column name
+        QAction *_action = _menu.addAction(_headerItem ? _headerItem->text() : QString("Column_%1").arg(_col + 1));  // Visibility toggle for this column
+        _action->setCheckable(true);
+        _action->setChecked(!DataTable->isColumnHidden(_col));
+        connect(_action, &QAction::toggled, this, [this, _col](bool checked) { SetColumnVisible(_col, checked); });
+    }
+
+    _menu.exec(DataTable->horizontalHeader()->mapToGlobal(position));
+}
+
+/**
+ * @brief Get the columns the user hid for the current table
+ */
+QStringList MainWindow::GetHiddenColumns() const
+{
+    QSettings _settings;  // Application settings storing column visibility
+    _settings.beginGroup(HIDDEN_COLUMNS_SETTING);
+    return _settings.value(GetHiddenColumnsKey()).toStringList();
+}
+
+/**
+ * @brief Get the settings key of the hidden columns of the current table
+ */
+QString MainWindow::GetHiddenColumnsKey() const
+{
+    QFileInfo _fileInfo(CurrentFilePath);  // Loaded database file
+    QString _filePath = _fileInfo.canonicalFilePath();  // Path without links or relative parts
+    if (_filePath.isEmpty()) {
+        _filePath = _fileInfo.absoluteFilePath();  // File no longer exists
+    }
+    return QString::fromLatin1(QUrl::toPercentEncoding(_filePath)) + "|" + CurrentTableName;
+}
+
+/**
+ * @brief Show or hide a column, fetching its values when it is first shown
+ */
+void MainWindow::SetColumnVisible(int column, bool visible)
+{
+    QTableWidgetItem *_headerItem = DataTable->horizontalHeaderItem(column);  // Header item with column name
+    if (!_headerItem) {
+        return;
+    }
+
+    // Columns left out of the projection are fetched the first time they are shown
+    if (visible && !SQLWorker::IsColumnLoaded(DataTable, column)) {
+        if (!Worker->LoadTableColumns(CurrentTableName, DataTable, QStringList(_headerItem->text()))) {
+            QMessageBox::warning(this, "Warning", "Failed to load column data.");
+            return;
+        }
+    }
+
+    DataTable->setColumnHidden(column, !visible);
+
+    // Remember the hidden columns of this table for the next session
+    QStringList _hiddenColumns;  // Names of currently hidden columns
+    for (int _col = 0; _col < DataTable->columnCount(); ++_col) {
+        if (DataTable->isColumnHidden(_col) && DataTable->horizontalHeaderItem(_col)) {
+            _hiddenColumns.append(DataTable->horizontalHeaderItem(_col)->text());
+        }
+    }
+
+    QSettings _settings;  // Application settings storing column visibility
+    _settings.beginGroup(HIDDEN_COLUMNS_SETTING);
+    _settings.setValue(GetHiddenColumnsKey(), _hiddenColumns);
+}
+
+/**
+ * @brief Fetch columns that became visible after horizontal scrolling or resizing
+ */
+void MainWindow::OnHorizontalScrollChanged()
+{
+    if (IsLoadingTable || CurrentTableName.isEmpty() || DataTable->columnCount() == 0) {
+        return;
+    }
+
+    // Visible range plus a small lookahead on both sides
+    int _firstColumn = DataTable->columnAt(0);  // Leftmost visible column (-1 if none)
+    int _lastColumn = DataTable->columnAt(DataTable->viewport()->width() - 1);  // Rightmost visible column (-1 if past the end)
+    if (_firstColumn < 0) {
+        return;
+    }
+    if (_lastColumn < 0) {
+        _lastColumn = DataTable->columnCount() - 1;
+    }
+    _firstColumn = qMax(0, _firstColumn - COLUMN_FETCH_LOOKAHEAD);
+    _lastColumn = qMin(DataTable->columnCount() - 1, _lastColumn + COLUMN_FETCH_LOOKAHEAD);
+
+    QStringList _unloadedColumns;  // Visible columns that were not fetched yet
+    for (int _col = _firstColumn; _col <= _lastColumn; ++_col) {
+        if (!DataTable->isColumnHidden(_col) && !SQLWorker::IsColumnLoaded(DataTable, _col) && DataTable->horizontalHeaderItem(_col)) {
+            _unloadedColumns.append(DataTable->horizontalHeaderItem(_col)->text());
+        }
+    }
+
+    if (_unloadedColumns.isEmpty()) {
+        return;
+    }
+
+    if (Worker->LoadTableColumns(CurrentTableName, DataTable, _unloadedColumns)) {
+        ResizeLoadedColumns(_firstColumn, _lastColumn);
+    }
+}
+
+/**
+ * @brief Size loaded, visible columns in a range to their contents
+ */
+void MainWindow::ResizeLoadedColumns(int firstColumn, int lastColumn)
+{
+    for (int _col = firstColumn; _col <= lastColumn; ++_col) {  // Current column index (0-based)
+        if (!DataTable->isColumnHidden(_col) && SQLWorker::IsColumnLoaded(DataTable, _col)) {
+            DataTable->resizeColumnToContents(_col);
+        }
+    }
+}
+
+/**
+ * @brief Fetch the next page of rows when scrolling near the end of the loaded rows
+ */
+void MainWindow::OnVerticalScrollChanged(int value)
+{
+    QScrollBar *_scrollBar = DataTable->verticalScrollBar();  // Vertical scroll bar of the table
+    if (IsLoadingTable || CurrentTableName.isEmpty() || value < _scrollBar->maximum() - _scrollBar->pageStep()) {
+        return;
+    }
+
+    if (Worker->HasMoreRows(CurrentTableName)) {
+        IsLoadingTable = true;
+        int _fetchedRows = Worker->FetchNextPage(CurrentTableName, DataTable);  // Rows appended (-1 on error)
+        IsLoadingTable = false;
+
+        if (_fetchedRows < 0) {
+            statusBar()->showMessage("Failed to load more rows", 5000);
+            return;
+        }
+        UpdateRowCountStatus();
+    }
+}
+
+/**
+ * @brief Apply the filter bar expressions with one changed column and reload the table
+ * The header keeps the new text only when it is stored here, after it was confirmed and validated
+ */
+void MainWindow::OnFilterChanged(int logicalIndex, const QString &text)
+{
+    if (CurrentTableName.isEmpty()) {
+        return;
+    }
+
+    if (!ConfirmReloadWithUnsavedChanges("Apply Filter")) {
+        return;
+    }
+
+    // Translate column positions into column names
+    QMap<QString, QString> _expressions;  // Column name -> filter expression
+    QMap<int, QString> _filterTexts = FilterHeader->GetFilterTexts();  // Column index -> filter expression
+    if (text.isEmpty()) {
+        _filterTexts.remove(logicalIndex);
+    } else {
+        _filterTexts.insert(logicalIndex, text);
+    }
+    for (auto _it = _filterTexts.constBegin(); _it != _filterTexts.constEnd(); ++_it) {
+        QTableWidgetItem *_headerItem = DataTable->horizontalHeaderItem(_it.key());  // Header item with column name
+        if (_headerItem) {
+            _expressions.insert(_headerItem->text(), _it.value());
+        }
+    }
+
+    QString _errorMessage;  // Description of an invalid expression
+    if (!Worker->SetTableFilter(CurrentTableName, _expressions, _errorMessage)) {
+        QMessageBox::warning(this, "Invalid Filter", _errorMessage);
+        return;
+    }
+    FilterHeader->SetFilterText(logicalIndex, text);
+
+    ResetToggleButtons();
+    LoadTableData();
+}
+
+/**
+ * @brief Show the number of loaded rows and whether more are available
+ */
+void MainWindow::UpdateRowCountStatus()
+{
+    QString _message = QString("%1 rows loaded").arg(DataTable->rowCount());  // Status text
+    qint64 _firstRowPosition = Worker->GetFirstRowPosition(CurrentTableName);  // Rows skipped by a jump
+    if (_firstRowPosition > 0) {
+        _message += QString(" from row %1").arg(_firstRowPosition + 1);
+    }
+    if (Worker->HasMoreRows(CurrentTableName)) {
+        _message += " (scroll for more)";
+    }
+    if (Worker->IsTableFiltered(CurrentTableName)) {
+        _message += " - filtered";
+    }
+    if (Worker->IsTableSearched(CurrentTableName)) {
+        _message += " - search results";
+    }
+
+    QStringList _sortTerms;  // "column ASC|DESC" per sort key
+    for (const SQLWorker::SortKey &_key : Worker->GetTableSort(CurrentTableName)) {
+        _sortTerms.append(_key.ColumnName + (_key.Order == Qt::AscendingOrder ? " ASC" : " DESC"));
+    }
+    if (!_sortTerms.isEmpty()) {
+        _message += " - sorted by " + _sortTerms.join(", ");
+    }
+    statusBar()->showMessage(_message);
+}
+
+/**
+ * @brief Sort the table in SQL by the clicked column
+ * A click on the primary column cycles ascending, descending and unsorted; Shift+click
+ * adds the column as secondary key or flips its direction
+ */
+void MainWindow::OnHeaderSectionClicked(int logicalIndex)
+{
+    QTableWidgetItem *_headerItem = DataTable->horizontalHeaderItem(logicalIndex);  // Header item with column name
+    if (CurrentTableName.isEmpty() || !_headerItem) {
+        return;
+    }
+
+    QString _columnName = _headerItem->text();  // Column that was clicked
+    QList<SQLWorker::SortKey> _sortKeys = Worker->GetTableSort(CurrentTableName);  // Sort to modify
+    bool _addKey = QApplication::keyboardModifiers() & Qt::ShiftModifier;  // Shift+click builds a multi-column sort
+
+    int _existingIndex = -1;  // Position of the column in the current sort (-1 if not sorted by it)
+    for (int _i = 0; _i < _sortKeys.size(); ++_i) {
+        if (_sortKeys[_i].ColumnName == _columnName) {
+            _existingIndex = _i;
+            break;
+        }
+    }
+
+    if (_addKey) {
+        if (_existingIndex >= 0) {
+            Qt::SortOrder &_order = _sortKeys[_existingIndex].Order;  // Direction to flip
+            _order = (_order == Qt::AscendingOrder) ? Qt::DescendingOrder : Qt::AscendingOrder;
+        } else {
+            _sortKeys.append({_columnName, Qt::AscendingOrder});
+        }
+    } else if (_existingIndex == 0 && _sortKeys.size() == 1) {
+        if (_sortKeys.first().Order == Qt::AscendingOrder) {
+            _sortKeys.first().Order = Qt::DescendingOrder;
+        } else {
+            _sortKeys.clear();  // Third click returns to rowid order
+        }
+    } else {
+        _sortKeys = {{_columnName, Qt::AscendingOrder}};
+    }
+
+    if (!ConfirmReloadWithUnsavedChanges("Sort Table")) {
+        return;
+    }
+
+    if (!Worker->SetTableSort(CurrentTableName, _sortKeys)) {
+        QMessageBox::warning(this, "Warning", "Failed to sort table.");
+        return;
+    }
+
+    // The header indicator shows the primary key; the status bar lists all keys
+    FilterHeader->setSortIndicatorShown(!_sortKeys.isEmpty());
+    if (!_sortKeys.isEmpty()) {
+        int _primaryColumn = -1;  // Column index of the primary sort key
+        for (int _col = 0; _col < DataTable->columnCount(); ++_col) {
+            if (DataTable->horizontalHeaderItem(_col) && DataTable->horizontalHeaderItem(_col)->text() == _sortKeys.first().ColumnName) {
+                _primaryColumn = _col;
+                break;
+            }
+        }
+        FilterHeader->setSortIndicator(_primaryColumn, _sortKeys.first().Order);
+    }
+
+    ResetToggleButtons();
+    LoadTableData();
+}
+
+/**
+ * @brief Ask before reloading the table would discard unsaved changes
+ */
+bool MainWindow::ConfirmReloadWithUnsavedChanges(const QString &title)
+{
+    if (!HasUnsavedChanges) {
+        return true;
+    }
+
+    int _result = QMessageBox::question(  // Dialog result: QMessageBox::Yes or QMessageBox::No
+        this,
+        title,
+        "This reloads the table and discards unsaved changes. Continue?",
+        QMessageBox::Yes | QMessageBox::No
+        );
+    return _result == QMessageBox::Yes;
+}
+
+/**
+ * @brief Restrict the table to the rows matching the search box and reload it
+ */
+void MainWindow::OnSearchSubmitted()
+{
+    if (CurrentTableName.isEmpty()) {
+        return;
+    }
+
+    if (!ConfirmReloadWithUnsavedChanges("Search Table")) {
+        return;
+    }
+
+    if (!Worker->SetTableSearch(CurrentTableName, SearchEdit->text())) {
+        QMessageBox::warning(this, "Warning", "This table has no search index. Build one first.");
+        return;
+    }
+
+    ResetToggleButtons();
+    LoadTableData();
+}
+
+/**
+ * @brief Load the page around the row with the typed key and select it
+ */
+void MainWindow::OnGoToKeySubmitted()
+{
+    QString _key = GoToKeyEdit->text().trimmed();  // Primary key or rowid to find
+    if (CurrentTableName.isEmpty() || _key.isEmpty()) {
+        return;
+    }
+
+    if (!ConfirmReloadWithUnsavedChanges("Go To Key")) {
+        return;
+    }
+
+    JumpToKey(_key, false);
+}
+
+/**
+ * @brief Open the search over all tables of the loaded file
+ */
+void MainWindow::OnGlobalSearchButtonClicked()
+{
+    if (!Worker->IsFileLoaded()) {
+        return;
+    }
+
+    if (!ActiveGlobalSearch) {
+        ActiveGlobalSearch = new GlobalSearchDialog(Worker->GetCurrentFilePath(), Worker->GetTableNames(), this);
+        ActiveGlobalSearch->setAttribute(Qt::WA_DeleteOnClose);
+        connect(ActiveGlobalSearch, &GlobalSearchDialog::HitActivated, this, &MainWindow::OnGlobalSearchHitActivated);
+    }
+
+    ActiveGlobalSearch->show();
+    ActiveGlobalSearch->raise();
+    ActiveGlobalSearch->activateWindow();
+}
+
+/**
+ * @brief Show the row of a global search hit in the table view
+ */
+void MainWindow::OnGlobalSearchHitActivated(const QString &tableName, qint64 rowId)
+{
+    if (!ConfirmReloadWithUnsavedChanges("Open Search Hit")) {
+        return;
+    }
+
+    // Selecting the table clears its filter and search, so the row is part of the view
+    if (tableName != CurrentTableName) {
+        int _index = TableComboBox->findText(tableName);  // Combo box entry of the table
+        if (_index < 0) {
+            return;
+        }
+        TableComboBox->setCurrentIndex(_index);
+    }
+
+    JumpToKey(QString::number(rowId), true);
+    activateWindow();
+}
+
+/**
+ * @brief Load the page around a row of the current table and select the row
+ * The row keeps the current filter, search and sort; scrolling continues forward from there
+ */
+void MainWindow::JumpToKey(const QString &key, bool keyIsRowId)
+{
+    ResetToggleButtons();
+
+    int _visibleColumns = DataTable->viewport()->width() / qMax(1, DataTable->horizontalHeader()->minimumSectionSize());  // Upper bound of columns on screen
+    int _targetRow = -1;    // Widget row of the key
+    QString _errorMessage;  // Reason the key was not shown
+
+    IsLoadingTable = true;
+    bool _loaded = Worker->LoadTableAroundKey(CurrentTableName, DataTable, key, keyIsRowId, GetHiddenColumns(),
+                                              _visibleColumns + COLUMN_FETCH_LOOKAHEAD, _targetRow, _errorMessage);  // Result of the jump
+    IsLoadingTable = false;
+
+    if (!_loaded) {
+        QMessageBox::warning(this, "Go To Key", _errorMessage.isEmpty() ? "Failed to load table data." : _errorMessage);
+        return;
+    }
+
+    ResizeLoadedColumns(0, DataTable->columnCount() - 1);
+    HasUnsavedChanges = false;
+    UpdateRowCountStatus();
+
+    DataTable->selectRow(_targetRow);
+    DataTable->scrollTo(DataTable->model()->index(_targetRow, 0), QAbstractItemView::PositionAtCenter);
+}
+
+/**
+ * @brief Let the user pick the columns to index and start building the search index
+ */
+void MainWindow::OnSearchIndexButtonClicked()
+{
+    if (ActiveSearchIndexing || ActiveCompaction || CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    if (HasUnsavedChanges) {
+        QMessageBox::warning(this, "Warning", "Please save or discard your changes before indexing the table.");
+        return;
+    }
+
+    QStringList _columnNames;  // Columns chosen for the index
+    if (!ChooseSearchIndexColumns(_columnNames)) {
+        return;
+    }
+
+    // Saving is blocked during the build; rows saved meanwhile would be missing from the index
+    UpdateButton->setEnabled(false);
+    SearchIndexButton->setEnabled(false);
+    CompactButton->setEnabled(false);
+
+    ActiveSearchIndexing = new SearchIndexTask(Worker->GetCurrentFilePath(), CurrentTableName, _columnNames);
+    connect(ActiveSearchIndexing, &DatabaseTask::ProgressChanged, this, [this](int percent, const QString &message) {
+        statusBar()->showMessage(QString("%1 (%2%)").arg(message).arg(percent));
+    });
+    connect(ActiveSearchIndexing, &DatabaseTask::Finished, this, &MainWindow::OnSearchIndexFinished);
+
+    ActiveSearchIndexing->Start();
+}
+
+/**
+ * @brief Start using the search index once the background build has finished
+ */
+void MainWindow::OnSearchIndexFinished(bool success, const QString &message)
+{
+    if (!ActiveSearchIndexing) {
+        return;
+    }
+
+    ActiveSearchIndexing->deleteLater();
+    ActiveSearchIndexing = nullptr;
+
+    // Attach the index file if it was just created and pick up the new index list
+    Worker->ReloadSearchIndexes();
+
+    UpdateButton->setEnabled(!CurrentTableName.isEmpty() && Worker->IsFileLoaded());
+    CompactButton->setEnabled(Worker->IsFileLoaded());
+    UpdateSearchControls();
+
+    statusBar()->showMessage(message, 10000);
+    if (!success) {
+        QMessageBox::warning(this, "Search Index", message);
+    }
+}
+
+/**
+ * @brief Cancel and dispose of a running search index build
+ */
+void MainWindow::StopSearchIndexing()
+{
+    if (ActiveSearchIndexing) {
+        ActiveSearchIndexing->disconnect(this);
+        ActiveSearchIndexing->Stop();
+        delete ActiveSearchIndexing;  // Thread has left Run, so no member is still in use
+        ActiveSearchIndexing = nullptr;
+    }
+}
+
+/**
+ * @brief Enable the search box and label the index button for the current table
+ */
+void MainWindow::UpdateSearchControls()
+{
+    bool _tableReady = !CurrentTableName.isEmpty() && Worker->IsFileLoaded();  // A table is loaded
+    bool _indexed = _tableReady && !Worker->GetSearchIndexColumns(CurrentTableName).isEmpty();  // Current table has a search index
+
+    SearchEdit->setEnabled(_indexed);
+    SearchEdit->setPlaceholderText(_indexed ? "Search indexed columns (press Enter)" : "Build a search index to search this table");
+    if (!_indexed) {
+        SearchEdit->clear();
+    }
+
+    SearchIndexButton->setText(_indexed ? "Rebuild Search Index" : "Build Search Index");
+    SearchIndexButton->setEnabled(_tableReady && !ActiveSearchIndexing && !ActiveCompaction);
+}
+
+/**
+ * @brief Show statistics of the current table in the statistics panel if it is visible
+ * The panel reuses cached statistics while the data version is unchanged
+ */
+void MainWindow::RefreshStatistics()
+{
+    if (!StatisticsPanel->isVisible() || CurrentTableName.isEmpty() || !Worker->IsFileLoaded()) {
+        return;
+    }
+
+    StatisticsPanel->ShowTable(Worker->GetCurrentFilePath(), CurrentTableName,
+                               Worker->GetTableColumns(CurrentTableName), Worker->GetDataVersion());
+}
+
+/**
+ * @brief Ask which columns of the current table the search index should cover
+ */
+bool MainWindow::ChooseSearchIndexColumns(QStringList &columnNames)
+{
+    // Pre-select the current index columns, or every text column for a new index
+    QStringList _preselected = Worker->GetSearchIndexColumns(CurrentTableName);  // Columns checked initially
+    if (_preselected.isEmpty()) {
+        _preselected = Worker->GetTextColumns(CurrentTableName);
+    }
+
+    QDialog _dialog(this);  // Column selection dialog
+    _dialog.setWindowTitle(QString("Search Index - %1").arg(CurrentTableName));
+    QVBoxLayout *_layout = new QVBoxLayout(&_dialog);  // Dialog layout (owned by the dialog)
+    _layout->addWidget(new QLabel("Columns to include in the full-text index:", &_dialog));
+
+    QListWidget *_columnList = new QListWidget(&_dialog);  // One checkable entry per column
+    for (int _col = 0; _col < DataTable->columnCount(); ++_col) {  // Current column index (0-based)
+        QTableWidgetItem *_headerItem = DataTable->horizontalHeaderItem(_col);  // Header item with column name
+        if (!_headerItem) {
+            continue;
+        }
+        QListWidgetItem *_item = new QListWidgetItem(_headerItem->text(), _columnList);  // Entry for this column
+        _item->setFlags(_item->flags() | Qt::ItemIsUserCheckable);
+        _item->setCheckState(_preselected.contains(_headerItem->text()) ? Qt::Checked : Qt::Unchecked);
+    }
+    _layout->addWidget(_columnList);
+
+    QDialogButtonBox *_buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &_dialog);  // OK and Cancel buttons
+    connect(_buttons, &QDialogButtonBox::accepted, &_dialog, &QDialog::accept);
+    connect(_buttons, &QDialogButtonBox::rejected, &_dialog, &QDialog::reject);
+    _layout->addWidget(_buttons);
+
+    if (_dialog.exec() != QDialog::Accepted) {
+        return false;
+    }
+
+    columnNames.clear();
+    for (int _i = 0; _i < _columnList->count(); ++_i) {
+        if (_columnList->item(_i)->checkState() == Qt::Checked) {
+            columnNames.append(_columnList->item(_i)->text());
+        }
+    }
+
+    if (columnNames.isEmpty()) {
+        QMessageBox::warning(this, "Warning", "Select at least one column to index.");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Show the find bar and focus its text box
+ */
+void MainWindow::OnFindRequested()
+{
+    FindBar->show();
+    FindEdit->setFocus();
+    FindEdit->selectAll();
+
+    // Rows may have changed since the last scan, so search again
+    if (!FindEdit->text().isEmpty()) {
+        OnFindTextChanged();
+    }
+}
+
+/**
+ * @brief Restart the find-in-table scan for the edited text
+ */
+void MainWindow::OnFindTextChanged()
+{
+    CurrentFindHit = -1;
+    Finder->StartFind(FindEdit->text());
+    UpdateFindStatus();
+}
+
+/**
+ * @brief Select the next find hit, wrapping around at the end
+ */
+void MainWindow::OnFindNext()
+{
+    int _hitCount = Finder->GetHits().size();  // Hits found so far
+    if (!FindBar->isVisible() || _hitCount == 0) {
+        return;
+    }
+
+    SelectFindHit((CurrentFindHit + 1) % _hitCount);
+}
+
+/**
+ * @brief Select the previous find hit, wrapping around at the start
+ */
+void MainWindow::OnFindPrevious()
+{
+    int _hitCount = Finder->GetHits().size();  // Hits found so far
+    if (!FindBar->isVisible() || _hitCount == 0) {
+        return;
+    }
+
+    SelectFindHit(CurrentFindHit <= 0 ? _hitCount - 1 : CurrentFindHit - 1);
+}
+
+/**
+ * @brief Jump to the first hit and update the hit count while the scan proceeds
+ */
+void MainWindow::OnFindHitsFound(int hitCount, bool finished)
+{
+    Q_UNUSED(finished)  // Scan state is read back in UpdateFindStatus
+
+    if (CurrentFindHit < 0 && hitCount > 0) {
+        SelectFindHit(0);
+    } else {
+        UpdateFindStatus();
+    }
+}
+
+/**
+ * @brief Hide the find bar and stop the running scan
+ */
+void MainWindow::OnFindClosed()
+{
+    Finder->Cancel();
+    FindBar->hide();
+    DataTable->setFocus();
+}
+
+/**
+ * @brief Select a find hit in the table and show its position in the find bar
+ */
+void MainWindow::SelectFindHit(int hitIndex)
+{
+    const QVector<TableFindScanner::FindHit> &_hits = Finder->GetHits();  // Hits found so far
+    if (hitIndex < 0 || hitIndex >= _hits.size()) {
+        return;
+    }
+
+    // Hits of a scan stopped by a table change may point past the current rows
+    const TableFindScanner::FindHit &_hit = _hits[hitIndex];  // Hit to select
+    if (_hit.Row < DataTable->rowCount() && _hit.Column < DataTable->columnCount()) {
+        CurrentFindHit = hitIndex;
+        DataTable->setCurrentCell(_hit.Row, _hit.Column);
+        DataTable->scrollTo(DataTable->model()->index(_hit.Row, _hit.Column));
+    }
+
+    UpdateFindStatus();
+}
+
+/**
+ * @brief Show "n of m" for the current find hit in the find bar
+ */
+void MainWindow::UpdateFindStatus()
+{
+    int _hitCount = Finder->GetHits().size();  // Hits found so far
+    QString _text;  // Status text of the find bar
+
+    if (FindEdit->text().isEmpty()) {
+        _text = "";
+    } else if (_hitCount == 0) {
+        _text = Finder->IsScanning() ? "Searching..." : "No matches in loaded rows";
+    } else {
+        _text = QString("%1 of %2%3").arg(CurrentFindHit + 1).arg(_hitCount).arg(Finder->IsScanning() ? "+" : "");
+    }
 
-    return _html;
+    FindStatusLabel->setText(_text);
+    FindPreviousButton->setEnabled(_hitCount > 0);
+    FindNextButton->setEnabled(_hitCount > 0);
 }
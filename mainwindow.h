@@ -2,6 +2,7 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QApplication>
 #include <QTableWidget>
 #include <QComboBox>
 #include <QPushButton>
@@ -13,12 +14,48 @@
 #include <QLabel>
 #include <QPrinter>
 #include <QPainter>
-#include <QTextDocument>
 #include <QStandardPaths>
 #include <QDir>
 #include <QTextStream>
 #include <QDateTime>
+#include <QTimer>
+#include <QStatusBar>
+#include <QSettings>
+#include <QMenu>
+#include <QAction>
+#include <QScrollBar>
+#include <QLineEdit>
+#include <QDialog>
+#include <QListWidget>
+#include <QDialogButtonBox>
+#include <QShortcut>
+#include <QProgressDialog>
+#include <QInputDialog>
+#include <QActionGroup>
+#include <QUrl>
 #include "sqlworker.h"
+#include "filterheaderview.h"
+#include "maintenancetask.h"
+#include "integritychecktask.h"
+#include "compacttask.h"
+#include "searchindextask.h"
+#include "tablefindscanner.h"
+#include "columnstatisticspanel.h"
+#include "pivotdialog.h"
+#include "globalsearchdialog.h"
+#include "csvwriter.h"
+#include "csvexporttask.h"
+#include "pdfexporttask.h"
+#include "parquetexporttask.h"
+#include "arrowexporttask.h"
+#include "jsonlinesexporttask.h"
+#include "xlsxexporttask.h"
+#include "exportjobspanel.h"
+#include "pdftablewriter.h"
+#include "parquetwriter.h"
+#include "arrowipcwriter.h"
+#include "compressingdevice.h"
+#include <QPointer>
 
 QT_BEGIN_NAMESPACE
 QT_END_NAMESPACE
@@ -89,11 +126,197 @@ private slots:
      */
     void OnPrintButtonClicked();
 
+    /**
+     * @brief Export the current table to a Parquet file in the downloads folder as a background job
+     * @param compression Page compression of the file
+     */
+    void OnExportParquetRequested(ParquetWriter::Compression compression);
+
+    /**
+     * @brief Export the current table to an Arrow IPC (Feather) file in the downloads folder as a background job
+     * Asks for the rows per record batch, remembering the last choice
+     */
+    void OnExportArrowRequested();
+
+    /**
+     * @brief Export the current table to a JSON Lines file in the downloads folder as a background job
+     */
+    void OnExportJsonLinesRequested();
+
+    /**
+     * @brief Export the current table to an Excel workbook in the downloads folder as a background job
+     */
+    void OnExportXlsxRequested();
+
+    /**
+     * @brief Handle import button click to insert the rows of a JSON Lines file into the current table
+     */
+    void OnImportButtonClicked();
+
+    /**
+     * @brief Show the column statistics panel for the current table
+     */
+    void OnStatisticsButtonClicked();
+
+    /**
+     * @brief Open the pivot view for the current table
+     */
+    void OnPivotButtonClicked();
+
+    /**
+     * @brief Export a pivot result through the normal export paths
+     * @param model Model holding the pivot result
+     * @param title Heading describing the grouping
+     * @param baseName File name prefix for the exported files
+     */
+    void OnPivotExportRequested(const QAbstractItemModel *model, const QString &title, const QString &baseName);
+
     /**
      * @brief Handle row double click for deletion
      */
     void OnRowDoubleClicked(int row, int column);
 
+    /**
+     * @brief Start background maintenance once the editor has been idle
+     */
+    void OnMaintenanceTimerTimeout();
+
+    /**
+     * @brief Handle completion of a background maintenance run
+     * @param success true if maintenance completed, false otherwise
+     * @param message Summary reported by the maintenance task
+     */
+    void OnMaintenanceFinished(bool success, const QString &message);
+
+    /**
+     * @brief Remember the integrity check mode selected by the user
+     */
+    void OnIntegrityModeChanged();
+
+    /**
+     * @brief Handle completion of the open-time integrity scan
+     * @param success true if the scan ran to completion, false otherwise
+     * @param message Summary reported by the integrity task
+     */
+    void OnIntegrityCheckFinished(bool success, const QString &message);
+
+    /**
+     * @brief Handle compact button click to start background compaction
+     */
+    void OnCompactButtonClicked();
+
+    /**
+     * @brief Swap in the compacted file once background compaction has finished
+     * @param success true if a verified compacted copy was written, false otherwise
+     * @param message Summary reported by the compaction task
+     */
+    void OnCompactFinished(bool success, const QString &message);
+
+    /**
+     * @brief Tell the user about a finished export job without interrupting their work
+     * @param title Description of the job
+     * @param success true if the file was written completely, false otherwise
+     * @param message Summary or error reported by the job
+     * @param outputPath File of the job
+     */
+    void OnExportJobFinished(const QString &title, bool success, const QString &message, const QString &outputPath);
+
+    /**
+     * @brief Show column visibility menu for the table header
+     * @param position Click position in header coordinates
+     */
+    void OnHeaderContextMenuRequested(const QPoint &position);
+
+    /**
+     * @brief Fetch columns that became visible after horizontal scrolling or resizing
+     */
+    void OnHorizontalScrollChanged();
+
+    /**
+     * @brief Fetch the next page of rows when scrolling near the end of the loaded rows
+     * @param value Current vertical scroll bar position
+     */
+    void OnVerticalScrollChanged(int value);
+
+    /**
+     * @brief Apply the filter bar expressions with one changed column and reload the table
+     * @param logicalIndex Column whose filter text changed
+     * @param text New filter expression of the column (empty to remove its filter)
+     */
+    void OnFilterChanged(int logicalIndex, const QString &text);
+
+    /**
+     * @brief Sort the table in SQL by the clicked column
+     * @param logicalIndex Column index that was clicked
+     */
+    void OnHeaderSectionClicked(int logicalIndex);
+
+    /**
+     * @brief Restrict the table to the rows matching the search box and reload it
+     */
+    void OnSearchSubmitted();
+
+    /**
+     * @brief Let the user pick the columns to index and start building the search index
+     */
+    void OnSearchIndexButtonClicked();
+
+    /**
+     * @brief Load the page around the row with the typed key and select it
+     */
+    void OnGoToKeySubmitted();
+
+    /**
+     * @brief Open the search over all tables of the loaded file
+     */
+    void OnGlobalSearchButtonClicked();
+
+    /**
+     * @brief Show the row of a global search hit in the table view
+     * @param tableName Table of the hit
+     * @param rowId Row id of the hit
+     */
+    void OnGlobalSearchHitActivated(const QString &tableName, qint64 rowId);
+
+    /**
+     * @brief Start using the search index once the background build has finished
+     * @param success true if the index was built, false otherwise
+     * @param message Summary reported by the indexing task
+     */
+    void OnSearchIndexFinished(bool success, const QString &message);
+
+    /**
+     * @brief Show the find bar and focus its text box (Ctrl+F)
+     */
+    void OnFindRequested();
+
+    /**
+     * @brief Restart the find-in-table scan for the edited text
+     */
+    void OnFindTextChanged();
+
+    /**
+     * @brief Select the next find hit, wrapping around at the end (F3, Enter)
+     */
+    void OnFindNext();
+
+    /**
+     * @brief Select the previous find hit, wrapping around at the start (Shift+F3)
+     */
+    void OnFindPrevious();
+
+    /**
+     * @brief Jump to the first hit and update the hit count while the scan proceeds
+     * @param hitCount Number of hits found so far
+     * @param finished true if every loaded row has been scanned, false otherwise
+     */
+    void OnFindHitsFound(int hitCount, bool finished);
+
+    /**
+     * @brief Hide the find bar and stop the running scan (Escape)
+     */
+    void OnFindClosed();
+
 private:
     /**
      * @brief Initialize the user interface components
@@ -141,24 +364,181 @@ private:
     void DisableTableEditing();
 
     /**
-     * @brief Export current table to PDF file
+     * @brief Export a table model to PDF and CSV files in the downloads folder and report the result
+     * @param model Model to export (the data table or a pivot result)
+     * @param title Heading of the PDF document
+     * @param baseName File name prefix, completed with a timestamp
+     */
+    void ExportModel(const QAbstractItemModel *model, const QString &title, const QString &baseName);
+
+    /**
+     * @brief Get the path of new export files in the downloads folder, without extension
+     * @param baseName File name prefix, completed with a timestamp
+     * @return Absolute path prefix such as ".../Downloads/orders_2024-01-01_12-00-00"
+     */
+    QString GetExportBasePath(const QString &baseName);
+
+    /**
+     * @brief Tell the user which export files were written
+     * @param pdfSuccess true if the PDF was written
+     * @param pdfPath Path of the PDF file
+     * @param excelSuccess true if the CSV was written
+     * @param excelPath Path of the CSV file
+     */
+    void ReportExportResult(bool pdfSuccess, const QString &pdfPath, bool excelSuccess, const QString &excelPath);
+
+    /**
+     * @brief Export a table model to PDF file
+     * @param model Model to export
+     * @param title Heading of the document
      * @param filePath Path where PDF file will be saved
      * @return true if export successful, false otherwise
      */
-    bool ExportTableToPDF(const QString &filePath);
+    bool ExportTableToPDF(const QAbstractItemModel *model, const QString &title, const QString &filePath);
+
+    /**
+     * @brief Start a background job painting every row of a table to PDF
+     * Rows matching the view's filter and search are painted in view order with every column
+     * on the job's own connection; only the current page is held in memory
+     * @param tableName Table to export
+     * @param title Heading of the document
+     * @param filePath Path where the PDF file will be saved
+     */
+    void StartPdfExportJob(const QString &tableName, const QString &title, const QString &filePath);
+
+    /**
+     * @brief Configure a printer for A4 landscape PDF output
+     * @param printer Printer to configure
+     * @param filePath Path of the PDF file
+     */
+    void SetupPdfPrinter(QPrinter &printer, const QString &filePath);
 
     /**
-     * @brief Export current table to Excel-compatible CSV file
+     * @brief Export a table model to Excel-compatible CSV file
+     * @param model Model to export
      * @param filePath Path where Excel file will be saved
+     * @param codec Compression of the file
      * @return true if export successful, false otherwise
      */
-    bool ExportTableToExcel(const QString &filePath);
+    bool ExportTableToExcel(const QAbstractItemModel *model, const QString &filePath, CompressingDevice::Codec codec);
+
+    /**
+     * @brief Start a background job writing every row of a table to Excel-compatible CSV
+     * Rows matching the view's filter and search are written in view order; memory use does not
+     * depend on the row count. Views in rowid order are split into rowid ranges formatted in parallel
+     * @param tableName Table to export
+     * @param filePath Path where the CSV file will be saved
+     * @param codec Compression of the file
+     */
+    void StartCsvExportJob(const QString &tableName, const QString &filePath, CompressingDevice::Codec codec);
+
+    /**
+     * @brief Get the compression chosen for exports
+     * Applies to CSV, JSON Lines and Arrow; Parquet and PDF compress their contents themselves
+     * @return Chosen codec, or None if it is not available in this build
+     */
+    CompressingDevice::Codec GetExportCodec() const;
+
+    /**
+     * @brief Get the columns the user hid for the current table
+     * @return QStringList containing hidden column names (empty if all visible)
+     */
+    QStringList GetHiddenColumns() const;
+
+    /**
+     * @brief Get the settings key of the hidden columns of the current table
+     * The key holds the canonical path of the file, so files of the same name in different
+     * folders keep their own settings; it is percent-encoded because QSettings treats
+     * slashes in keys as group separators
+     * @return Key within the hidden columns settings group
+     */
+    QString GetHiddenColumnsKey() const;
+
+    /**
+     * @brief Show or hide a column, fetching its values when it is first shown
+     * @param column Column index (0-based)
+     * @param visible true to show the column, false to hide it
+     */
+    void SetColumnVisible(int column, bool visible);
+
+    /**
+     * @brief Size loaded, visible columns in a range to their contents
+     * @param firstColumn First column index of the range (0-based)
+     * @param lastColumn Last column index of the range (inclusive)
+     */
+    void ResizeLoadedColumns(int firstColumn, int lastColumn);
+
+    /**
+     * @brief Ask before reloading the table would discard unsaved changes
+     * @param title Dialog title naming the action
+     * @return true if reloading may proceed, false otherwise
+     */
+    bool ConfirmReloadWithUnsavedChanges(const QString &title);
+
+    /**
+     * @brief Show the number of loaded rows and whether more are available
+     */
+    void UpdateRowCountStatus();
+
+    /**
+     * @brief Restart the idle timer that triggers background maintenance
+     */
+    void ScheduleMaintenance();
+
+    /**
+     * @brief Cancel and dispose of a running maintenance task
+     */
+    void StopMaintenance();
+
+    /**
+     * @brief Start the integrity scan selected in the integrity combo box
+     */
+    void StartIntegrityCheck();
+
+    /**
+     * @brief Cancel and dispose of a running integrity scan
+     */
+    void StopIntegrityCheck();
+
+    /**
+     * @brief Cancel and dispose of a running search index build
+     */
+    void StopSearchIndexing();
+
+    /**
+     * @brief Enable the search box and label the index button for the current table
+     */
+    void UpdateSearchControls();
+
+    /**
+     * @brief Show statistics of the current table in the statistics panel if it is visible
+     */
+    void RefreshStatistics();
+
+    /**
+     * @brief Load the page around a row of the current table and select the row
+     * @param key Primary key value or rowid of the row
+     * @param keyIsRowId true to read the key only as rowid, false to try the primary key first
+     */
+    void JumpToKey(const QString &key, bool keyIsRowId);
+
+    /**
+     * @brief Select a find hit in the table and show its position in the find bar
+     * @param hitIndex Index into the scanner's hits (0-based)
+     */
+    void SelectFindHit(int hitIndex);
+
+    /**
+     * @brief Show "n of m" for the current find hit in the find bar
+     */
+    void UpdateFindStatus();
 
     /**
-     * @brief Generate HTML table representation for PDF export
-     * @return QString containing HTML table markup
+     * @brief Ask which columns of the current table the search index should cover
+     * @param columnNames Output list of chosen column names
+     * @return true if the user confirmed a non-empty choice, false otherwise
      */
-    QString GenerateHTMLTable();
+    bool ChooseSearchIndexColumns(QStringList &columnNames);
 
     // UI Components
     QWidget *CentralWidget;              // Main central widget container for the application
@@ -170,9 +550,15 @@ private:
     QPushButton *ChooseFileButton;       // Button to choose SQL file from filesystem
     QPushButton *LoadFileButton;         // Button to load the selected SQL file
     QLabel *FilePathLabel;               // Label showing current file path (empty if no file selected)
+    QComboBox *IntegrityModeComboBox;    // Integrity scan run at open time (Off, Quick or Full)
+    QPushButton *CompactButton;          // Button to compact the loaded file with VACUUM INTO
+    QPushButton *GlobalSearchButton;     // Button to search the text columns of all tables
 
     QComboBox *TableComboBox;            // Dropdown for table selection (empty until file loaded)
     QLabel *TableLabel;                  // Label for table selection section
+    QLineEdit *SearchEdit;               // Full-text search terms for the current table (disabled until indexed)
+    QPushButton *SearchIndexButton;      // Button to build or rebuild the search index of the current table
+    QLineEdit *GoToKeyEdit;              // Primary key or rowid of the row to jump to (disabled until table selected)
 
     QPushButton *AddButton;              // Toggle button for adding rows (green when active)
     QPushButton *DeleteButton;           // Toggle button for deleting rows (green when active)
@@ -180,8 +566,24 @@ private:
     QPushButton *UpdateButton;           // Button to save changes to the SQL file
     QPushButton *CancelButton;           // Button to discard all pending changes
     QPushButton *PrintButton;            // Button to export table to PDF and Excel files
+    QPushButton *ExportButton;           // Button with a menu of machine-readable export formats
+    QPushButton *ImportButton;           // Button to import rows from a JSON Lines file
+    QPushButton *StatisticsButton;       // Button to show the column statistics panel
+    QPushButton *PivotButton;            // Button to open the pivot view
 
     QTableWidget *DataTable;             // Main data display table for SQL content
+    FilterHeaderView *FilterHeader;      // Column header of DataTable with per-column filter editors
+    QTimer *MaintenanceTimer;            // Single-shot idle timer that triggers background maintenance
+    QWidget *FindBar;                    // Find-in-table bar above the data table (hidden until Ctrl+F)
+    QLineEdit *FindEdit;                 // Text to find in the loaded cells
+    QPushButton *FindPreviousButton;     // Button selecting the previous find hit
+    QPushButton *FindNextButton;         // Button selecting the next find hit
+    QLabel *FindStatusLabel;             // Position of the current hit and total hit count
+    TableFindScanner *Finder;            // Incremental scanner over the loaded cells
+    ColumnStatisticsPanel *StatisticsPanel;  // Dock with per-column statistics (hidden until requested)
+    ExportJobsPanel *ExportJobs;         // Dock listing background export jobs (hidden until an export starts)
+    QPointer<PivotDialog> ActivePivot;   // Open pivot view (null if closed, deletes itself on close)
+    QPointer<GlobalSearchDialog> ActiveGlobalSearch;  // Open search over all tables (null if closed, deletes itself on close)
 
     // State variables
     SQLWorker *Worker;                   // Worker object for SQL operations
@@ -191,11 +593,26 @@ private:
     bool IsDeleteMode;                   // Flag indicating delete mode is active (true) or inactive (false)
     bool IsEditMode;                     // Flag indicating edit mode is active (true) or inactive (false)
     bool HasUnsavedChanges;              // Flag indicating pending changes (true) or no changes (false)
+    bool IsLoadingTable;                 // Flag indicating the table widget is being rebuilt (true) or stable (false)
+    MaintenanceTask *ActiveMaintenance;  // Running background maintenance task (nullptr if idle)
+    IntegrityCheckTask *ActiveIntegrityCheck;  // Running open-time integrity scan (nullptr if idle)
+    bool IntegrityProblemsFound;         // Flag indicating the loaded file failed its integrity scan (true) or not (false)
+    CompactTask *ActiveCompaction;       // Running background compaction (nullptr if idle)
+    SearchIndexTask *ActiveSearchIndexing;  // Running search index build (nullptr if idle)
+    int CurrentFindHit;                  // Index of the selected find hit (-1 if none selected)
 
     // Constants
     static const QString NORMAL_BUTTON_STYLE;  // Default button style
     static const QString ACTIVE_BUTTON_STYLE;  // Green active button style
     static const QString DISABLED_BUTTON_STYLE;  // Style for disabled buttons
+    static const int MAINTENANCE_IDLE_DELAY_MS;  // Idle time before background maintenance starts
+    static const int INTEGRITY_MAX_ERRORS;       // Integrity scan stops after this many problems
+    static const QString INTEGRITY_MODE_SETTING; // Settings key storing the integrity scan mode
+    static const QString HIDDEN_COLUMNS_SETTING; // Settings group storing hidden columns per file and table
+    static const int COLUMN_FETCH_LOOKAHEAD;     // Columns fetched beyond the visible range while scrolling
+    static const int RESIZE_SAMPLE_ROWS;         // Rows sampled when sizing columns to their contents
+    static const QString ARROW_BATCH_ROWS_SETTING;   // Settings key storing the rows per Arrow record batch
+    static const QString EXPORT_COMPRESSION_SETTING; // Settings key storing the compression of exports
 };
 
 #endif // MAINWINDOW_H
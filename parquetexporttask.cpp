@@ -0,0 +1,108 @@
+#include "parquetexporttask.h"
+#include "sqlworker.h"
+#include <QSqlRecord>
+#include <QFile>
+
+// Define Parquet export constants
+const int ParquetExportTask::PROGRESS_INTERVAL_ROWS = 100000;
+
+/**
+ * @brief Constructor initializes ParquetExportTask with the query and the output file
+ */
+ParquetExportTask::ParquetExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                                     const QStringList &tableColumns, const QStringList &tableTypes, const QString &outputPath,
+                                     ParquetWriter::Compression compression)
+    : DatabaseTask(filePath)
+    , QueryString(queryString)         // Exported rows
+    , BindValues(bindValues)           // Placeholder values
+    , TableColumns(tableColumns)       // Declared column names
+    , TableTypes(tableTypes)           // Declared column types
+    , OutputPath(outputPath)           // Parquet file
+    , Compression(compression)         // Page compression
+    , RowCount(0)                      // No row written
+{
+}
+
+/**
+ * @brief Get the number of rows written so far
+ */
+qint64 ParquetExportTask::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Run the query and write its rows
+ */
+bool ParquetExportTask::Run(QSqlDatabase &database, QString &message)
+{
+    // A searched view reads its row ids from the index file, which this connection must attach itself
+    if (!SQLWorker::AttachSearchIndexFile(database, FilePath)) {
+        message = "Cannot open search index file of " + FilePath;
+        return false;
+    }
+
+    QSqlQuery _query(database);  // Forward-only cursor over the exported rows
+    _query.setForwardOnly(true);
+    if (!_query.prepare(QueryString)) {
+        message = "Cannot prepare export query: " + _query.lastError().text();
+        return false;
+    }
+    for (int _i = 0; _i < BindValues.size(); ++_i) {
+        _query.bindValue(_i, BindValues[_i]);
+    }
+    if (!_query.exec()) {
+        message = "Export query failed: " + _query.lastError().text();
+        return false;
+    }
+
+    // Declared types are matched by name, since they select the Parquet column types
+    QSqlRecord _record = _query.record();  // Result columns of the cursor
+    const int _columnCount = _record.count();  // Values per row
+    QStringList _names;  // Exported column names
+    QStringList _types;  // Declared types of the exported columns
+    for (int _col = 0; _col < _columnCount; ++_col) {
+        _names.append(_record.fieldName(_col));
+        _types.append(TableTypes.value(TableColumns.indexOf(_record.fieldName(_col))));
+    }
+
+    QFile _file(OutputPath);  // Output file
+    if (!_file.open(QIODevice::WriteOnly)) {
+        message = QString("Cannot open %1: %2").arg(OutputPath, _file.errorString());
+        return false;
+    }
+
+    ParquetWriter _writer(&_file, _names, _types, Compression);  // Encoder buffering one row group
+    bool _success = _writer.Begin();  // Every row so far was written
+    while (_success && !IsCancelled() && _query.next()) {
+        for (int _col = 0; _col < _columnCount; ++_col) {
+            _writer.WriteValue(_query.value(_col));
+        }
+        _success = _writer.EndRow();
+
+        if (++RowCount % PROGRESS_INTERVAL_ROWS == 0) {
+            emit ProgressChanged(-1, QString("%1 rows written to Parquet").arg(RowCount.load()));
+        }
+    }
+
+    if (IsCancelled()) {
+        message = "Export cancelled";
+    } else if (_success && _query.lastError().isValid()) {
+        message = "Export query failed: " + _query.lastError().text();
+    } else if (!_success || !_writer.Finish()) {
+        message = QString("Cannot write %1: %2").arg(OutputPath, _file.errorString());
+    }
+
+    // A file without its footer is unreadable, so partial exports are removed
+    if (!message.isEmpty()) {
+        _file.remove();
+        return false;
+    }
+    _file.close();
+
+    message = QString("%1 rows written to %2").arg(RowCount.load()).arg(OutputPath);
+    if (_writer.GetMismatchCount() > 0) {
+        message += QString(" (%1 values did not match their declared column type and were written as null)").arg(_writer.GetMismatchCount());
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#ifndef PARQUETEXPORTTASK_H
+#define PARQUETEXPORTTASK_H
+
+#include <QStringList>
+#include <QVariantList>
+#include <atomic>
+#include "databasetask.h"
+#include "parquetwriter.h"
+
+/**
+ * @brief Background export of the rows of one query to a Parquet file
+ * Rows are stepped on the task's own connection and encoded by a ParquetWriter,
+ * which holds one row group in memory
+ */
+class ParquetExportTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for ParquetExportTask
+     * @param filePath Path to the SQL database file to read
+     * @param queryString SELECT statement returning the exported rows
+     * @param bindValues Values for the placeholders of the statement in order
+     * @param tableColumns Column names of the table in declaration order
+     * @param tableTypes Declared types of the table columns in declaration order
+     * @param outputPath Path of the Parquet file to write
+     * @param compression Page compression of the file
+     */
+    ParquetExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                      const QStringList &tableColumns, const QStringList &tableTypes, const QString &outputPath,
+                      ParquetWriter::Compression compression);
+
+    /**
+     * @brief Get the number of rows written so far (safe to call while running)
+     * @return Rows written
+     */
+    qint64 GetRowCount() const;
+
+protected:
+    /**
+     * @brief Run the query and write its rows
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if the complete file was written, false otherwise
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    QString QueryString;                 // SELECT statement of the exported rows
+    QVariantList BindValues;             // Placeholder values of the statement
+    QStringList TableColumns;            // Column names in declaration order
+    QStringList TableTypes;              // Declared types in declaration order
+    QString OutputPath;                  // Parquet file written by the task
+    ParquetWriter::Compression Compression;  // Page compression of the file
+    std::atomic<qint64> RowCount;        // Rows written so far
+
+    static const int PROGRESS_INTERVAL_ROWS;  // Rows between progress reports
+};
+
+#endif // PARQUETEXPORTTASK_H
@@ -0,0 +1,729 @@
+#include "parquetwriter.h"
+#include <QtEndian>
+#include <QLocale>
+#include <QDebug>
+#include <cmath>
+#include <cstring>
+#include <zlib.h>
+
+// Define Parquet writer constants
+const qint64 ParquetWriter::ROW_GROUP_MAX_BYTES = 64 << 20;
+const int ParquetWriter::ROW_GROUP_MAX_ROWS = 1 << 20;
+const int ParquetWriter::PAGE_MAX_BYTES = 1 << 20;
+const int ParquetWriter::DICTIONARY_MAX_BYTES = 1 << 20;
+
+/**
+ * @brief Constructor initializes ThriftCompactEncoder at the top level
+ */
+ThriftCompactEncoder::ThriftCompactEncoder(QByteArray &output)
+    : Output(output)                   // Target buffer
+    , FieldIdStack()                   // No enclosing struct
+    , LastFieldId(0)                   // No field written
+{
+}
+
+/**
+ * @brief Start a struct (the top-level one or a list element)
+ */
+void ThriftCompactEncoder::BeginStruct()
+{
+    FieldIdStack.append(LastFieldId);
+    LastFieldId = 0;
+}
+
+/**
+ * @brief Write the stop field and return to the enclosing struct
+ */
+void ThriftCompactEncoder::EndStruct()
+{
+    Output.append('\0');
+    LastFieldId = FieldIdStack.takeLast();
+}
+
+/**
+ * @brief Write a field holding a nested struct and start that struct
+ */
+void ThriftCompactEncoder::BeginStructField(int fieldId)
+{
+    WriteFieldHeader(fieldId, TYPE_STRUCT);
+    BeginStruct();
+}
+
+/**
+ * @brief Write a 32-bit integer field (also used for enums)
+ */
+void ThriftCompactEncoder::WriteI32Field(int fieldId, qint32 value)
+{
+    WriteFieldHeader(fieldId, TYPE_I32);
+    WriteZigzag(value);
+}
+
+/**
+ * @brief Write a 64-bit integer field
+ */
+void ThriftCompactEncoder::WriteI64Field(int fieldId, qint64 value)
+{
+    WriteFieldHeader(fieldId, TYPE_I64);
+    WriteZigzag(value);
+}
+
+/**
+ * @brief Write a string or binary field
+ */
+void ThriftCompactEncoder::WriteBinaryField(int fieldId, const QByteArray &value)
+{
+    WriteFieldHeader(fieldId, TYPE_BINARY);
+    WriteBinary(value);
+}
+
+/**
+ * @brief Write a boolean field; the value is carried by the type code
+ */
+void ThriftCompactEncoder::WriteBoolField(int fieldId, bool value)
+{
+    WriteFieldHeader(fieldId, value ? TYPE_BOOLEAN_TRUE : TYPE_BOOLEAN_FALSE);
+}
+
+/**
+ * @brief Write the header of a list field; the elements follow
+ */
+void ThriftCompactEncoder::WriteListField(int fieldId, Type elementType, int size)
+{
+    WriteFieldHeader(fieldId, TYPE_LIST);
+    if (size < 15) {
+        Output.append(static_cast<char>((size << 4) | elementType));
+    } else {
+        Output.append(static_cast<char>(0xF0 | elementType));
+        WriteVarint(static_cast<quint64>(size));
+    }
+}
+
+/**
+ * @brief Write a 32-bit integer list element
+ */
+void ThriftCompactEncoder::WriteI32(qint32 value)
+{
+    WriteZigzag(value);
+}
+
+/**
+ * @brief Write a string or binary list element
+ */
+void ThriftCompactEncoder::WriteBinary(const QByteArray &value)
+{
+    WriteVarint(static_cast<quint64>(value.size()));
+    Output.append(value);
+}
+
+/**
+ * @brief Write a field header with its type
+ * Ids up to 15 above the previous one share a byte with the type
+ */
+void ThriftCompactEncoder::WriteFieldHeader(int fieldId, int type)
+{
+    int _delta = fieldId - LastFieldId;  // Distance to the previous field id
+    if (_delta > 0 && _delta <= 15) {
+        Output.append(static_cast<char>((_delta << 4) | type));
+    } else {
+        Output.append(static_cast<char>(type));
+        WriteZigzag(fieldId);
+    }
+    LastFieldId = fieldId;
+}
+
+/**
+ * @brief Write an unsigned LEB128 variable-length integer
+ */
+void ThriftCompactEncoder::WriteVarint(quint64 value)
+{
+    while (value >= 0x80) {
+        Output.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    Output.append(static_cast<char>(value));
+}
+
+/**
+ * @brief Write a zigzag-encoded signed integer
+ */
+void ThriftCompactEncoder::WriteZigzag(qint64 value)
+{
+    WriteVarint((static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63));
+}
+
+/**
+ * @brief Constructor initializes ParquetWriter with the schema of the columns
+ */
+ParquetWriter::ParquetWriter(QIODevice *device, const QStringList &columnNames, const QStringList &declaredTypes, Compression compression)
+    : Device(device)                   // Output device
+    , Codec(compression)               // Page compression
+    , Columns(columnNames.size())      // One state per column
+    , RowGroups()                      // No row group written
+    , CurrentColumn(0)                 // First value of the first row
+    , BufferedRows(0)                  // Empty row group
+    , BufferedBytes(0)                 // Empty row group
+    , FileOffset(0)                    // Nothing written
+    , RowCount(0)                      // No rows added
+    , MismatchCount(0)                 // No value converted
+    , Failed(false)                    // No write failed
+{
+    for (int _col = 0; _col < columnNames.size(); ++_col) {
+        Columns[_col].Name = columnNames[_col];
+        MapDeclaredType(declaredTypes.value(_col), Columns[_col]);
+    }
+}
+
+/**
+ * @brief Write the file magic
+ */
+bool ParquetWriter::Begin()
+{
+    return WriteBytes(QByteArrayLiteral("PAR1"));
+}
+
+/**
+ * @brief Add the next value of the current row
+ * Every value is kept PLAIN encoded; while the column's dictionary is in use its index
+ * is recorded as well, so the chunk can be written either way
+ */
+void ParquetWriter::WriteValue(const QVariant &value)
+{
+    if (CurrentColumn >= Columns.size()) {
+        return;
+    }
+    ColumnState &_column = Columns[CurrentColumn++];  // Column of the value
+
+    // A page ends at a row boundary once its values reach PAGE_MAX_BYTES
+    int _pageStart = _column.Pages.isEmpty() ? 0 : _column.Pages.last().PlainOffset;  // PLAIN offset of the current page
+    if (_column.PlainValues.size() - _pageStart >= PAGE_MAX_BYTES) {
+        _column.Pages.append({static_cast<int>(_column.DefinitionLevels.size()), _column.ValueCount,
+                              static_cast<int>(_column.PlainValues.size())});
+    }
+
+    bool _isNull = value.isNull();  // Value is stored as a definition level only
+    if (!_isNull && !EncodeValue(value, _column, ValueBytes)) {
+        MismatchCount++;
+        _isNull = true;
+    }
+    if (_isNull) {
+        _column.DefinitionLevels.append('\0');
+        _column.NullCount++;
+        BufferedBytes++;
+        return;
+    }
+
+    _column.DefinitionLevels.append('\1');
+    const int _plainStart = _column.PlainValues.size();  // Offset of the value in the PLAIN buffer
+    if (_column.Type == PHYSICAL_BYTE_ARRAY) {
+        char _length[4];  // Little-endian length prefix
+        qToLittleEndian<quint32>(static_cast<quint32>(ValueBytes.size()), _length);
+        _column.PlainValues.append(_length, 4);
+    }
+    _column.PlainValues.append(ValueBytes);
+    _column.ValueCount++;
+    const int _plainLength = _column.PlainValues.size() - _plainStart;  // PLAIN bytes of the value
+    BufferedBytes += 1 + _plainLength;
+
+    if (!_column.UseDictionary) {
+        return;
+    }
+
+    // The PLAIN bytes are the dictionary key, so equal values of any type share an entry
+    QByteArray _key = QByteArray::fromRawData(_column.PlainValues.constData() + _plainStart, _plainLength);  // Lookup key without copy
+    auto _entry = _column.Dictionary.constFind(_key);  // Existing dictionary entry (end if new)
+    if (_entry != _column.Dictionary.constEnd()) {
+        _column.DictionaryIndices.append(_entry.value());
+        BufferedBytes += 4;
+    } else if (_column.DictionaryValues.size() + _plainLength > DICTIONARY_MAX_BYTES) {
+        // Mostly distinct values: PLAIN for this and every later chunk of the column
+        BufferedBytes -= 2 * _column.DictionaryValues.size() + 4 * _column.DictionaryIndices.size();
+        _column.UseDictionary = false;
+        _column.Dictionary = QHash<QByteArray, quint32>();
+        _column.DictionaryValues = QByteArray();
+        _column.DictionaryIndices = QVector<quint32>();
+    } else {
+        quint32 _index = static_cast<quint32>(_column.Dictionary.size());  // Index of the new entry
+        _column.Dictionary.insert(QByteArray(_key.constData(), _key.size()), _index);
+        _column.DictionaryValues.append(_key.constData(), _key.size());
+        _column.DictionaryIndices.append(_index);
+        BufferedBytes += 4 + 2 * _plainLength;
+    }
+}
+
+/**
+ * @brief Terminate the current row, writing the row group once it is full
+ */
+bool ParquetWriter::EndRow()
+{
+    // Missing values are NULL so the columns stay aligned
+    while (CurrentColumn < Columns.size()) {
+        WriteValue(QVariant());
+    }
+    CurrentColumn = 0;
+    BufferedRows++;
+    RowCount++;
+
+    if (BufferedRows >= ROW_GROUP_MAX_ROWS || BufferedBytes >= ROW_GROUP_MAX_BYTES) {
+        return WriteRowGroup();
+    }
+    return !Failed;
+}
+
+/**
+ * @brief Write the last row group and the footer
+ */
+bool ParquetWriter::Finish()
+{
+    if (!WriteRowGroup() || !WriteFooter()) {
+        return false;
+    }
+
+    if (MismatchCount > 0) {
+        qDebug() << "Warning:" << MismatchCount << "values did not match their column type and were written as null";
+    }
+    return true;
+}
+
+/**
+ * @brief Check if a write to the device failed
+ */
+bool ParquetWriter::HasError() const
+{
+    return Failed;
+}
+
+/**
+ * @brief Get the number of rows added so far
+ */
+qint64 ParquetWriter::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Get the number of values written as NULL because they did not fit their column type
+ */
+qint64 ParquetWriter::GetMismatchCount() const
+{
+    return MismatchCount;
+}
+
+/**
+ * @brief Map a declared SQLite type to the physical type of a column
+ * Follows the affinity rules of SQLite (INT first, then text, BLOB and REAL markers);
+ * columns without a declared type can hold anything and are written as text
+ */
+void ParquetWriter::MapDeclaredType(const QString &declaredType, ColumnState &column)
+{
+    QString _type = declaredType.toUpper();  // Declared type in upper case
+    if (_type.contains("INT") || _type.contains("BOOL")) {
+        column.Type = PHYSICAL_INT64;
+    } else if (_type.isEmpty() || _type.contains("CHAR") || _type.contains("CLOB") || _type.contains("TEXT")
+               || _type.contains("DATE") || _type.contains("TIME")) {
+        column.Type = PHYSICAL_BYTE_ARRAY;
+        column.IsText = true;
+    } else if (_type.contains("BLOB")) {
+        column.Type = PHYSICAL_BYTE_ARRAY;
+    } else {
+        column.Type = PHYSICAL_DOUBLE;
+    }
+}
+
+/**
+ * @brief Convert a value to the PLAIN bytes of a column (without the BYTE_ARRAY length prefix)
+ */
+bool ParquetWriter::EncodeValue(const QVariant &value, const ColumnState &column, QByteArray &bytes)
+{
+    const int _valueType = value.userType();  // Storage class delivered by the driver
+    if (column.Type == PHYSICAL_INT64) {
+        qint64 _integer = 0;  // Value as integer
+        if (_valueType == QMetaType::LongLong || _valueType == QMetaType::Int || _valueType == QMetaType::Bool) {
+            _integer = value.toLongLong();
+        } else if (_valueType == QMetaType::Double) {
+            // Integral reals are stored as REAL when they do not fit, so only exact values convert
+            double _real = value.toDouble();  // Value as stored
+            if (std::floor(_real) != _real || _real < -9223372036854775808.0 || _real >= 9223372036854775808.0) {
+                return false;
+            }
+            _integer = static_cast<qint64>(_real);
+        } else {
+            bool _ok = false;  // Text holds an integer
+            _integer = value.toString().trimmed().toLongLong(&_ok);
+            if (!_ok) {
+                return false;
+            }
+        }
+        bytes.resize(8);
+        qToLittleEndian<qint64>(_integer, bytes.data());
+        return true;
+    }
+
+    if (column.Type == PHYSICAL_DOUBLE) {
+        double _real = 0;  // Value as double
+        if (_valueType == QMetaType::LongLong || _valueType == QMetaType::Int || _valueType == QMetaType::Double) {
+            _real = value.toDouble();
+        } else {
+            bool _ok = false;  // Text holds a number
+            _real = value.toString().trimmed().toDouble(&_ok);
+            if (!_ok) {
+                return false;
+            }
+        }
+        quint64 _bits = 0;  // IEEE 754 bits of the value
+        std::memcpy(&_bits, &_real, sizeof(_bits));
+        bytes.resize(8);
+        qToLittleEndian<quint64>(_bits, bytes.data());
+        return true;
+    }
+
+    switch (_valueType) {
+    case QMetaType::LongLong:
+    case QMetaType::Int:
+        bytes = QByteArray::number(value.toLongLong());
+        break;
+    case QMetaType::Double:
+        bytes = QByteArray::number(value.toDouble(), 'g', QLocale::FloatingPointShortest);
+        break;
+    case QMetaType::QByteArray:
+        bytes = value.toByteArray();
+        break;
+    default:
+        bytes = value.toString().toUtf8();
+        break;
+    }
+    return true;
+}
+
+/**
+ * @brief Write the buffered column chunks as a row group and reset the buffers
+ * Buffers keep their capacity, so later row groups reuse the memory
+ */
+bool ParquetWriter::WriteRowGroup()
+{
+    if (Failed) {
+        return false;
+    }
+    if (BufferedRows == 0) {
+        return true;
+    }
+
+    RowGroupInfo _group;  // Footer entry of the row group
+    _group.RowCount = BufferedRows;
+    _group.Chunks.resize(Columns.size());
+    for (int _col = 0; _col < Columns.size(); ++_col) {
+        if (!WriteColumnChunk(Columns[_col], _group.Chunks[_col])) {
+            return false;
+        }
+        _group.TotalByteSize += _group.Chunks[_col].UncompressedSize;
+    }
+    RowGroups.append(_group);
+
+    for (ColumnState &_column : Columns) {
+        _column.DefinitionLevels.resize(0);
+        _column.PlainValues.resize(0);
+        _column.ValueCount = 0;
+        _column.NullCount = 0;
+        _column.Pages.clear();
+        _column.Dictionary.clear();
+        _column.DictionaryValues.resize(0);
+        _column.DictionaryIndices.resize(0);
+    }
+    BufferedRows = 0;
+    BufferedBytes = 0;
+    return true;
+}
+
+/**
+ * @brief Write one column chunk as an optional dictionary page and its data pages
+ * A data page holds the definition levels (RLE, 1 bit) followed by either the bit width
+ * and RLE/bit-packed dictionary indices or the PLAIN values of its rows
+ */
+bool ParquetWriter::WriteColumnChunk(ColumnState &column, ChunkInfo &chunk)
+{
+    chunk.NullCount = column.NullCount;
+
+    // Dictionaries of mostly distinct values are dropped if they would not save space
+    bool _dictionary = column.UseDictionary && !column.Dictionary.isEmpty();  // Chunk is dictionary encoded
+    int _bitWidth = _dictionary ? GetBitWidth(static_cast<quint32>(column.Dictionary.size() - 1)) : 0;  // Bits per index
+    if (_dictionary && column.DictionaryValues.size() + static_cast<qint64>(column.ValueCount) * _bitWidth / 8 >= column.PlainValues.size()) {
+        _dictionary = false;
+    }
+    chunk.Dictionary = _dictionary;
+
+    if (_dictionary) {
+        chunk.DictionaryPageOffset = FileOffset;
+        if (!WritePage(PAGE_DICTIONARY, column.Dictionary.size(), ENCODING_PLAIN, column.DictionaryValues, chunk)) {
+            return false;
+        }
+    }
+    chunk.DataPageOffset = FileOffset;
+
+    const PageBoundary _chunkEnd = {static_cast<int>(column.DefinitionLevels.size()), column.ValueCount,
+                                    static_cast<int>(column.PlainValues.size())};  // End of the last page
+    QByteArray _body;  // Uncompressed body of the current page
+    for (int _page = 0; _page <= column.Pages.size(); ++_page) {
+        PageBoundary _start = _page == 0 ? PageBoundary{0, 0, 0} : column.Pages[_page - 1];  // First row and value of the page
+        PageBoundary _end = _page == column.Pages.size() ? _chunkEnd : column.Pages[_page];  // First row and value after the page
+        _body.resize(0);
+
+        // Definition levels with their 4-byte length prefix
+        _body.append(4, '\0');
+        EncodeRleHybrid(reinterpret_cast<const quint8 *>(column.DefinitionLevels.constData()) + _start.FirstRow,
+                        _end.FirstRow - _start.FirstRow, 1, _body);
+        qToLittleEndian<quint32>(static_cast<quint32>(_body.size() - 4), _body.data());
+
+        if (_dictionary) {
+            _body.append(static_cast<char>(_bitWidth));
+            EncodeRleHybrid(column.DictionaryIndices.constData() + _start.FirstValue, _end.FirstValue - _start.FirstValue, _bitWidth, _body);
+        } else {
+            _body.append(column.PlainValues.constData() + _start.PlainOffset, _end.PlainOffset - _start.PlainOffset);
+        }
+
+        if (!WritePage(PAGE_DATA, _end.FirstRow - _start.FirstRow, _dictionary ? ENCODING_RLE_DICTIONARY : ENCODING_PLAIN, _body, chunk)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Write a page header and its body, compressing the body if enabled
+ */
+bool ParquetWriter::WritePage(PageType pageType, int valueCount, Encoding encoding, const QByteArray &body, ChunkInfo &chunk)
+{
+    QByteArray _compressed;  // Compressed body (empty without compression)
+    if (Codec == Compression::Gzip && !CompressGzip(body, _compressed)) {
+        qDebug() << "Error: Failed to compress Parquet page";
+        Failed = true;
+        return false;
+    }
+    const QByteArray &_stored = Codec == Compression::Gzip ? _compressed : body;  // Body as written
+
+    QByteArray _header;  // Thrift encoded PageHeader
+    ThriftCompactEncoder _encoder(_header);
+    _encoder.BeginStruct();
+    _encoder.WriteI32Field(1, pageType);
+    _encoder.WriteI32Field(2, body.size());
+    _encoder.WriteI32Field(3, _stored.size());
+    if (pageType == PAGE_DATA) {
+        _encoder.BeginStructField(5);  // DataPageHeader
+        _encoder.WriteI32Field(1, valueCount);
+        _encoder.WriteI32Field(2, encoding);
+        _encoder.WriteI32Field(3, ENCODING_RLE);  // Definition levels
+        _encoder.WriteI32Field(4, ENCODING_RLE);  // Repetition levels (none, flat schema)
+        _encoder.EndStruct();
+    } else {
+        _encoder.BeginStructField(7);  // DictionaryPageHeader
+        _encoder.WriteI32Field(1, valueCount);
+        _encoder.WriteI32Field(2, encoding);
+        _encoder.EndStruct();
+    }
+    _encoder.EndStruct();
+
+    chunk.UncompressedSize += _header.size() + body.size();
+    chunk.CompressedSize += _header.size() + _stored.size();
+    return WriteBytes(_header) && WriteBytes(_stored);
+}
+
+/**
+ * @brief Write the file metadata, its length and the closing magic
+ */
+bool ParquetWriter::WriteFooter()
+{
+    if (Failed) {
+        return false;
+    }
+
+    const int _codec = Codec == Compression::Gzip ? 2 : 0;  // CompressionCodec: GZIP or UNCOMPRESSED
+    QByteArray _footer;  // Thrift encoded FileMetaData
+    ThriftCompactEncoder _encoder(_footer);
+    _encoder.BeginStruct();
+    _encoder.WriteI32Field(1, 1);  // Format version
+
+    // Flat schema: the root element followed by one OPTIONAL leaf per column
+    _encoder.WriteListField(2, ThriftCompactEncoder::TYPE_STRUCT, Columns.size() + 1);
+    _encoder.BeginStruct();
+    _encoder.WriteBinaryField(4, QByteArrayLiteral("schema"));
+    _encoder.WriteI32Field(5, Columns.size());
+    _encoder.EndStruct();
+    for (const ColumnState &_column : Columns) {
+        _encoder.BeginStruct();
+        _encoder.WriteI32Field(1, _column.Type);
+        _encoder.WriteI32Field(3, 1);  // OPTIONAL
+        _encoder.WriteBinaryField(4, _column.Name.toUtf8());
+        if (_column.IsText) {
+            _encoder.WriteI32Field(6, 0);  // ConvertedType UTF8
+            _encoder.BeginStructField(10);  // LogicalType
+            _encoder.BeginStructField(1);   // STRING
+            _encoder.EndStruct();
+            _encoder.EndStruct();
+        }
+        _encoder.EndStruct();
+    }
+    _encoder.WriteI64Field(3, RowCount);
+
+    _encoder.WriteListField(4, ThriftCompactEncoder::TYPE_STRUCT, RowGroups.size());
+    for (const RowGroupInfo &_group : RowGroups) {
+        _encoder.BeginStruct();
+        _encoder.WriteListField(1, ThriftCompactEncoder::TYPE_STRUCT, _group.Chunks.size());
+        for (int _col = 0; _col < _group.Chunks.size(); ++_col) {
+            const ChunkInfo &_chunk = _group.Chunks[_col];  // Chunk of the column
+            _encoder.BeginStruct();
+            _encoder.WriteI64Field(2, _chunk.Dictionary ? _chunk.DictionaryPageOffset : _chunk.DataPageOffset);
+            _encoder.BeginStructField(3);  // ColumnMetaData
+            _encoder.WriteI32Field(1, Columns[_col].Type);
+            _encoder.WriteListField(2, ThriftCompactEncoder::TYPE_I32, _chunk.Dictionary ? 3 : 2);
+            _encoder.WriteI32(ENCODING_PLAIN);
+            _encoder.WriteI32(ENCODING_RLE);
+            if (_chunk.Dictionary) {
+                _encoder.WriteI32(ENCODING_RLE_DICTIONARY);
+            }
+            _encoder.WriteListField(3, ThriftCompactEncoder::TYPE_BINARY, 1);
+            _encoder.WriteBinary(Columns[_col].Name.toUtf8());
+            _encoder.WriteI32Field(4, _codec);
+            _encoder.WriteI64Field(5, _group.RowCount);
+            _encoder.WriteI64Field(6, _chunk.UncompressedSize);
+            _encoder.WriteI64Field(7, _chunk.CompressedSize);
+            _encoder.WriteI64Field(9, _chunk.DataPageOffset);
+            if (_chunk.Dictionary) {
+                _encoder.WriteI64Field(11, _chunk.DictionaryPageOffset);
+            }
+            _encoder.BeginStructField(12);  // Statistics
+            _encoder.WriteI64Field(3, _chunk.NullCount);
+            _encoder.EndStruct();
+            _encoder.EndStruct();
+            _encoder.EndStruct();
+        }
+        _encoder.WriteI64Field(2, _group.TotalByteSize);
+        _encoder.WriteI64Field(3, _group.RowCount);
+        _encoder.EndStruct();
+    }
+    _encoder.WriteBinaryField(6, QByteArrayLiteral("SQLTableEditor"));
+    _encoder.EndStruct();
+
+    char _length[4];  // Little-endian footer length
+    qToLittleEndian<quint32>(static_cast<quint32>(_footer.size()), _length);
+    _footer.append(_length, 4);
+    _footer.append("PAR1");
+    return WriteBytes(_footer);
+}
+
+/**
+ * @brief Append bytes to the device, tracking the file offset
+ */
+bool ParquetWriter::WriteBytes(const QByteArray &bytes)
+{
+    if (Failed) {
+        return false;
+    }
+    if (Device->write(bytes) != bytes.size()) {
+        qDebug() << "Error: Failed to write Parquet output:" << Device->errorString();
+        Failed = true;
+        return false;
+    }
+    FileOffset += bytes.size();
+    return true;
+}
+
+/**
+ * @brief Compress a page body with gzip
+ */
+bool ParquetWriter::CompressGzip(const QByteArray &input, QByteArray &output)
+{
+    z_stream _stream;  // Deflate state writing a gzip wrapper
+    std::memset(&_stream, 0, sizeof(_stream));
+    if (deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    // One call suffices, since the bound covers incompressible input and the wrapper
+    output.resize(static_cast<int>(deflateBound(&_stream, static_cast<uLong>(input.size()))));
+    _stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.constData()));
+    _stream.avail_in = static_cast<uInt>(input.size());
+    _stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    _stream.avail_out = static_cast<uInt>(output.size());
+    int _result = deflate(&_stream, Z_FINISH);  // Z_STREAM_END once everything is compressed
+    output.resize(output.size() - static_cast<int>(_stream.avail_out));
+    deflateEnd(&_stream);
+    return _result == Z_STREAM_END;
+}
+
+/**
+ * @brief Append values with the RLE/bit-packed hybrid encoding
+ * Runs of at least 8 equal values become RLE runs; everything else is bit-packed in
+ * groups of 8, padded with zeros after the last value
+ */
+template <typename T>
+void ParquetWriter::EncodeRleHybrid(const T *values, int count, int bitWidth, QByteArray &output)
+{
+    const int _valueBytes = (bitWidth + 7) / 8;  // Bytes of an RLE run value
+    // Length of the run of equal values at a position, counted up to a limit
+    auto _runLength = [values, count](int position, int limit) {
+        int _length = 1;  // Values equal to the first one
+        while (position + _length < count && _length < limit && values[position + _length] == values[position]) {
+            ++_length;
+        }
+        return _length;
+    };
+
+    int _position = 0;  // First value not encoded yet
+    while (_position < count) {
+        if (_runLength(_position, 8) == 8) {
+            int _length = _runLength(_position, count);  // Values in the RLE run
+            AppendVarint(static_cast<quint64>(_length) << 1, output);
+            quint32 _value = static_cast<quint32>(values[_position]);  // Repeated value
+            for (int _byte = 0; _byte < _valueBytes; ++_byte) {
+                output.append(static_cast<char>((_value >> (8 * _byte)) & 0xFF));
+            }
+            _position += _length;
+            continue;
+        }
+
+        // Bit-packed groups until a run of 8 starts at a group boundary (at most 63 per header byte)
+        int _first = _position;  // First value of the bit-packed run
+        int _groups = 0;         // Groups of 8 values in the run
+        do {
+            _position += 8;
+            _groups++;
+        } while (_position < count && _groups < 63 && _runLength(_position, 8) < 8);
+
+        AppendVarint((static_cast<quint64>(_groups) << 1) | 1, output);
+        quint64 _bits = 0;  // Bits not yet written, least significant first
+        int _bitCount = 0;  // Number of pending bits
+        for (int _i = _first; _i < _first + _groups * 8; ++_i) {
+            quint64 _value = _i < count ? static_cast<quint64>(values[_i]) : 0;  // Padded after the last value
+            _bits |= _value << _bitCount;
+            _bitCount += bitWidth;
+            while (_bitCount >= 8) {
+                output.append(static_cast<char>(_bits & 0xFF));
+                _bits >>= 8;
+                _bitCount -= 8;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Append an unsigned LEB128 variable-length integer
+ */
+void ParquetWriter::AppendVarint(quint64 value, QByteArray &output)
+{
+    while (value >= 0x80) {
+        output.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    output.append(static_cast<char>(value));
+}
+
+/**
+ * @brief Get the number of bits needed to store values up to a maximum (at least 1)
+ */
+int ParquetWriter::GetBitWidth(quint32 maxValue)
+{
+    int _bits = 0;  // Bits needed so far
+    while (maxValue > 0) {
+        _bits++;
+        maxValue >>= 1;
+    }
+    return qMax(1, _bits);
+}
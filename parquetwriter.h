@@ -0,0 +1,349 @@
+#ifndef PARQUETWRITER_H
+#define PARQUETWRITER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QHash>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+/**
+ * @brief Encoder for the Thrift compact protocol used by Parquet page headers and the footer
+ * Fields must be written in increasing id order within a struct, as the ids are delta encoded
+ */
+class ThriftCompactEncoder
+{
+public:
+    /**
+     * @brief Compact protocol type codes
+     */
+    enum Type {
+        TYPE_BOOLEAN_TRUE = 1,
+        TYPE_BOOLEAN_FALSE = 2,
+        TYPE_I32 = 5,
+        TYPE_I64 = 6,
+        TYPE_BINARY = 8,
+        TYPE_LIST = 9,
+        TYPE_STRUCT = 12
+    };
+
+    /**
+     * @brief Constructor for ThriftCompactEncoder
+     * @param output Buffer the encoded bytes are appended to (must outlive the encoder)
+     */
+    explicit ThriftCompactEncoder(QByteArray &output);
+
+    /**
+     * @brief Start a struct (the top-level one or a list element)
+     */
+    void BeginStruct();
+
+    /**
+     * @brief Write the stop field and return to the enclosing struct
+     */
+    void EndStruct();
+
+    /**
+     * @brief Write a field holding a nested struct and start that struct
+     * @param fieldId Field id in the enclosing struct
+     */
+    void BeginStructField(int fieldId);
+
+    /**
+     * @brief Write a 32-bit integer field (also used for enums)
+     */
+    void WriteI32Field(int fieldId, qint32 value);
+
+    /**
+     * @brief Write a 64-bit integer field
+     */
+    void WriteI64Field(int fieldId, qint64 value);
+
+    /**
+     * @brief Write a string or binary field
+     */
+    void WriteBinaryField(int fieldId, const QByteArray &value);
+
+    /**
+     * @brief Write a boolean field
+     */
+    void WriteBoolField(int fieldId, bool value);
+
+    /**
+     * @brief Write the header of a list field; the elements follow
+     * @param fieldId Field id in the enclosing struct
+     * @param elementType Type code of the elements
+     * @param size Number of elements
+     */
+    void WriteListField(int fieldId, Type elementType, int size);
+
+    /**
+     * @brief Write a 32-bit integer list element
+     */
+    void WriteI32(qint32 value);
+
+    /**
+     * @brief Write a string or binary list element
+     */
+    void WriteBinary(const QByteArray &value);
+
+private:
+    /**
+     * @brief Write a field header with its type
+     */
+    void WriteFieldHeader(int fieldId, int type);
+
+    /**
+     * @brief Write an unsigned LEB128 variable-length integer
+     */
+    void WriteVarint(quint64 value);
+
+    /**
+     * @brief Write a zigzag-encoded signed integer
+     */
+    void WriteZigzag(qint64 value);
+
+    QByteArray &Output;                  // Buffer receiving the encoded bytes
+    QVector<int> FieldIdStack;           // Last field id of each enclosing struct
+    int LastFieldId;                     // Last field id written in the current struct
+};
+
+/**
+ * @brief Streaming writer of Apache Parquet files
+ * Rows are added value by value and buffered per column until the row group reaches
+ * ROW_GROUP_MAX_BYTES or ROW_GROUP_MAX_ROWS, then every column chunk is written and
+ * released, so memory is bounded by one row group whatever the row count.
+ * Column chunks use a dictionary with RLE/bit-packed indices until the dictionary grows
+ * past DICTIONARY_MAX_BYTES, then PLAIN values. Every column is OPTIONAL; NULLs are
+ * definition levels only
+ */
+class ParquetWriter
+{
+public:
+    /**
+     * @brief Compression codec of the pages
+     */
+    enum class Compression {
+        None,  // Pages stored as encoded
+        Gzip   // Pages compressed with gzip (readable by every Parquet reader)
+    };
+
+    /**
+     * @brief Constructor for ParquetWriter
+     * Declared types map to physical types by SQLite's affinity rules: INT and BOOL to INT64,
+     * REAL/FLOA/DOUB and other numeric types to DOUBLE, BLOB to binary BYTE_ARRAY, and
+     * text, DATE/TIME and undeclared types to UTF-8 BYTE_ARRAY
+     * @param device Output device (not owned, must stay open until Finish)
+     * @param columnNames Column names in value order
+     * @param declaredTypes Declared SQLite types in value order (empty string if none)
+     * @param compression Page compression
+     */
+    ParquetWriter(QIODevice *device, const QStringList &columnNames, const QStringList &declaredTypes, Compression compression);
+
+    /**
+     * @brief Write the file magic
+     * @return true if the device accepted it, false otherwise
+     */
+    bool Begin();
+
+    /**
+     * @brief Add the next value of the current row
+     * Values that do not convert to the column's physical type are written as NULL
+     * @param value Database value (null for NULL)
+     */
+    void WriteValue(const QVariant &value);
+
+    /**
+     * @brief Terminate the current row, writing the row group once it is full
+     * @return true if writing can continue, false after a write error
+     */
+    bool EndRow();
+
+    /**
+     * @brief Write the last row group and the footer
+     * @return true if the file is complete, false otherwise
+     */
+    bool Finish();
+
+    /**
+     * @brief Check if a write to the device failed
+     * @return true after a failed write, false otherwise
+     */
+    bool HasError() const;
+
+    /**
+     * @brief Get the number of rows added so far
+     * @return Rows added
+     */
+    qint64 GetRowCount() const;
+
+    /**
+     * @brief Get the number of values written as NULL because they did not fit their column type
+     * @return Converted values
+     */
+    qint64 GetMismatchCount() const;
+
+    static const qint64 ROW_GROUP_MAX_BYTES;   // Buffered bytes that complete a row group
+    static const int ROW_GROUP_MAX_ROWS;       // Rows that complete a row group
+    static const int PAGE_MAX_BYTES;           // Encoded value bytes that complete a data page
+    static const int DICTIONARY_MAX_BYTES;     // Dictionary size at which a column switches to PLAIN
+
+private:
+    /**
+     * @brief Parquet physical types used for SQLite values
+     */
+    enum PhysicalType {
+        PHYSICAL_INT64 = 2,
+        PHYSICAL_DOUBLE = 5,
+        PHYSICAL_BYTE_ARRAY = 6
+    };
+
+    /**
+     * @brief Parquet page types written
+     */
+    enum PageType {
+        PAGE_DATA = 0,
+        PAGE_DICTIONARY = 2
+    };
+
+    /**
+     * @brief Parquet encodings written
+     */
+    enum Encoding {
+        ENCODING_PLAIN = 0,
+        ENCODING_RLE = 3,
+        ENCODING_RLE_DICTIONARY = 8
+    };
+
+    /**
+     * @brief Start of a data page within the buffered column chunk
+     */
+    struct PageBoundary {
+        int FirstRow;                    // First row (definition level index) of the page
+        int FirstValue;                  // First non-null value of the page
+        int PlainOffset;                 // Offset of that value in the PLAIN buffer
+    };
+
+    /**
+     * @brief Location and sizes of a written column chunk, kept for the footer
+     */
+    struct ChunkInfo {
+        qint64 DictionaryPageOffset = -1;  // File offset of the dictionary page (-1 if none)
+        qint64 DataPageOffset = 0;         // File offset of the first data page
+        qint64 UncompressedSize = 0;       // Bytes of the chunk with uncompressed pages
+        qint64 CompressedSize = 0;         // Bytes of the chunk in the file
+        qint64 NullCount = 0;              // NULLs in the chunk
+        bool Dictionary = false;           // Flag indicating dictionary encoding (true) or PLAIN (false)
+    };
+
+    /**
+     * @brief Row count, size and chunks of a written row group, kept for the footer
+     */
+    struct RowGroupInfo {
+        qint64 RowCount = 0;               // Rows in the group
+        qint64 TotalByteSize = 0;          // Uncompressed bytes of all chunks
+        QVector<ChunkInfo> Chunks;         // One chunk per column
+    };
+
+    /**
+     * @brief Schema and buffered values of one column
+     */
+    struct ColumnState {
+        QString Name;                      // Column name
+        PhysicalType Type = PHYSICAL_BYTE_ARRAY;  // Parquet physical type
+        bool IsText = false;               // Flag indicating BYTE_ARRAY annotated as UTF-8 string (true) or binary (false)
+        QByteArray DefinitionLevels;       // 1 per non-null row, 0 per NULL row
+        QByteArray PlainValues;            // PLAIN encoded non-null values
+        int ValueCount = 0;                // Non-null values buffered
+        qint64 NullCount = 0;              // NULL rows buffered
+        QVector<PageBoundary> Pages;       // Data page starts after the first page
+        bool UseDictionary = true;         // Flag indicating dictionary encoding is still in use
+        QHash<QByteArray, quint32> Dictionary;  // PLAIN encoded value -> dictionary index
+        QByteArray DictionaryValues;       // PLAIN encoded dictionary entries in index order
+        QVector<quint32> DictionaryIndices;  // Dictionary index of every buffered value
+    };
+
+    /**
+     * @brief Map a declared SQLite type to the physical type of a column
+     */
+    static void MapDeclaredType(const QString &declaredType, ColumnState &column);
+
+    /**
+     * @brief Convert a value to the PLAIN bytes of a column (without the BYTE_ARRAY length prefix)
+     * @return true if the value fits the column type, false otherwise
+     */
+    static bool EncodeValue(const QVariant &value, const ColumnState &column, QByteArray &bytes);
+
+    /**
+     * @brief Write the buffered column chunks as a row group and reset the buffers
+     */
+    bool WriteRowGroup();
+
+    /**
+     * @brief Write one column chunk as an optional dictionary page and its data pages
+     */
+    bool WriteColumnChunk(ColumnState &column, ChunkInfo &chunk);
+
+    /**
+     * @brief Write a page header and its body, compressing the body if enabled
+     * @param pageType PAGE_DATA or PAGE_DICTIONARY
+     * @param valueCount Rows of a data page or entries of a dictionary page
+     * @param encoding Encoding of the values in the body
+     * @param body Uncompressed page body
+     * @param chunk Chunk whose sizes grow by the page
+     * @return true if written, false otherwise
+     */
+    bool WritePage(PageType pageType, int valueCount, Encoding encoding, const QByteArray &body, ChunkInfo &chunk);
+
+    /**
+     * @brief Write the file metadata, its length and the closing magic
+     */
+    bool WriteFooter();
+
+    /**
+     * @brief Append bytes to the device, tracking the file offset
+     */
+    bool WriteBytes(const QByteArray &bytes);
+
+    /**
+     * @brief Compress a page body with gzip
+     * @return true if compressed, false otherwise
+     */
+    static bool CompressGzip(const QByteArray &input, QByteArray &output);
+
+    /**
+     * @brief Append values with the RLE/bit-packed hybrid encoding
+     * @param values First value
+     * @param count Number of values
+     * @param bitWidth Bits per value (1-32)
+     * @param output Buffer receiving the runs
+     */
+    template <typename T>
+    static void EncodeRleHybrid(const T *values, int count, int bitWidth, QByteArray &output);
+
+    /**
+     * @brief Append an unsigned LEB128 variable-length integer
+     */
+    static void AppendVarint(quint64 value, QByteArray &output);
+
+    /**
+     * @brief Get the number of bits needed to store values up to a maximum
+     */
+    static int GetBitWidth(quint32 maxValue);
+
+    QIODevice *Device;                   // Output device (not owned)
+    Compression Codec;                   // Page compression
+    QVector<ColumnState> Columns;        // Schema and buffers per column
+    QVector<RowGroupInfo> RowGroups;     // Written row groups
+    int CurrentColumn;                   // Column of the next value in the current row
+    int BufferedRows;                    // Rows in the current row group
+    qint64 BufferedBytes;                // Approximate bytes buffered for the current row group
+    qint64 FileOffset;                   // Bytes written to the device
+    qint64 RowCount;                     // Rows added so far
+    qint64 MismatchCount;                // Values written as NULL because of their type
+    QByteArray ValueBytes;               // Encoded bytes of the value being added (reused)
+    bool Failed;                         // Flag indicating a write failed (true) or not (false)
+};
+
+#endif // PARQUETWRITER_H
@@ -0,0 +1,114 @@
+#include "pdfexporttask.h"
+#include "pdftablewriter.h"
+#include "sqlworker.h"
+#include <QPdfWriter>
+#include <QSqlRecord>
+#include <QFile>
+
+// Define PDF export constants
+const int PdfExportTask::PDF_RESOLUTION_DPI = 1200;
+
+/**
+ * @brief Constructor initializes PdfExportTask with the query and the output file
+ */
+PdfExportTask::PdfExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                             const QString &title, const QString &outputPath)
+    : DatabaseTask(filePath)
+    , QueryString(queryString)         // Exported rows
+    , BindValues(bindValues)           // Placeholder values
+    , Title(title)                     // Document heading
+    , OutputPath(outputPath)           // PDF file
+    , RowCount(0)                      // No row painted
+{
+}
+
+/**
+ * @brief Get the number of rows painted so far
+ */
+qint64 PdfExportTask::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Run the query and paint its rows
+ */
+bool PdfExportTask::Run(QSqlDatabase &database, QString &message)
+{
+    // A searched view reads its row ids from the index file, which this connection must attach itself
+    if (!SQLWorker::AttachSearchIndexFile(database, FilePath)) {
+        message = "Cannot open search index file of " + FilePath;
+        return false;
+    }
+
+    QSqlQuery _query(database);  // Forward-only cursor over the exported rows
+    _query.setForwardOnly(true);
+    if (!_query.prepare(QueryString)) {
+        message = "Cannot prepare export query: " + _query.lastError().text();
+        return false;
+    }
+    for (int _i = 0; _i < BindValues.size(); ++_i) {
+        _query.bindValue(_i, BindValues[_i]);
+    }
+    if (!_query.exec()) {
+        message = "Export query failed: " + _query.lastError().text();
+        return false;
+    }
+
+    QSqlRecord _record = _query.record();  // Result columns of the cursor
+    const int _columnCount = _record.count();  // Values per row
+    QStringList _headers;  // Column names of the table
+    for (int _col = 0; _col < _columnCount; ++_col) {
+        _headers.append(_record.fieldName(_col));
+    }
+
+    // QPrinter would set up the print backend, which belongs to the GUI thread; QPdfWriter
+    // only writes the file. Page setup and resolution match the QPrinter exports of the GUI thread
+    QPdfWriter _pdfWriter(OutputPath);  // PDF output device owned by the task thread
+    _pdfWriter.setResolution(PDF_RESOLUTION_DPI);
+    _pdfWriter.setPageSize(QPageSize(QPageSize::A4));
+    _pdfWriter.setPageOrientation(QPageLayout::Landscape);
+
+    PdfTableWriter _writer(&_pdfWriter, Title, _headers);  // Painter of the table pages
+    _writer.SetProgressCallback([this](qint64 rowCount) {
+        emit ProgressChanged(-1, QString("%1 rows written to PDF").arg(rowCount));
+        return !IsCancelled();
+    });
+    if (!_writer.Begin()) {
+        message = "Cannot start painting " + OutputPath;
+        return false;
+    }
+
+    // Only the rows of the page being laid out are held
+    QStringList _cells;  // Texts of the current row
+    bool _stopped = false;  // Painting was cancelled or failed
+    while (_query.next()) {
+        _cells.clear();
+        for (int _col = 0; _col < _columnCount; ++_col) {
+            _cells.append(_query.value(_col).toString());
+        }
+        if (!_writer.AddRow(_cells)) {
+            _stopped = true;
+            break;
+        }
+        RowCount = _writer.GetRowCount();
+    }
+
+    if (IsCancelled()) {
+        message = "Export cancelled";
+    } else if (!_stopped && _query.lastError().isValid()) {
+        message = "Export query failed: " + _query.lastError().text();
+    }
+
+    // A cancelled or incomplete document must not be mistaken for a complete export
+    if (!_writer.Finish() || !message.isEmpty() || !QFile::exists(OutputPath)) {
+        QFile::remove(OutputPath);
+        if (message.isEmpty()) {
+            message = "Cannot write " + OutputPath;
+        }
+        return false;
+    }
+
+    message = QString("%1 rows written to %2").arg(RowCount.load()).arg(OutputPath);
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef PDFEXPORTTASK_H
+#define PDFEXPORTTASK_H
+
+#include <QStringList>
+#include <QVariantList>
+#include <atomic>
+#include "databasetask.h"
+
+/**
+ * @brief Background export of the rows of one query to a PDF table
+ * Rows are stepped on the task's own connection and painted page by page by a
+ * PdfTableWriter onto a QPdfWriter owned by the task thread
+ */
+class PdfExportTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for PdfExportTask
+     * @param filePath Path to the SQL database file to read
+     * @param queryString SELECT statement returning the exported rows
+     * @param bindValues Values for the placeholders of the statement in order
+     * @param title Heading printed above the table
+     * @param outputPath Path of the PDF file to write
+     */
+    PdfExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                  const QString &title, const QString &outputPath);
+
+    /**
+     * @brief Get the number of rows painted so far (safe to call while running)
+     * @return Rows added to the document
+     */
+    qint64 GetRowCount() const;
+
+protected:
+    /**
+     * @brief Run the query and paint its rows
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if the complete document was written, false otherwise
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    QString QueryString;                 // SELECT statement of the exported rows
+    QVariantList BindValues;             // Placeholder values of the statement
+    QString Title;                       // Heading of the first page
+    QString OutputPath;                  // PDF file written by the task
+    std::atomic<qint64> RowCount;        // Rows painted so far
+
+    static const int PDF_RESOLUTION_DPI;  // Resolution of the PDF device (QPrinter::HighResolution for PDF output)
+};
+
+#endif // PDFEXPORTTASK_H
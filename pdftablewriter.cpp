@@ -0,0 +1,270 @@
+#include "pdftablewriter.h"
+#include <QFontMetricsF>
+#include <QDateTime>
+#include <QDebug>
+#include <cmath>
+
+// Define PDF table constants
+const int PdfTableWriter::LAYOUT_SAMPLE_ROWS = 200;
+
+/**
+ * @brief Constructor initializes PdfTableWriter with the heading and the headers
+ */
+PdfTableWriter::PdfTableWriter(QPagedPaintDevice *device, const QString &title, const QStringList &headers)
+    : Device(device)                   // Output device
+    , Painter()                        // Inactive until Begin
+    , Title(title)                     // First page heading
+    , Headers(headers)                 // Column headers
+    , PageRows()                       // No rows collected
+    , ColumnWidths()                   // Sized with the first page
+    , Progress()                       // No progress callback
+    , TitleFont("Arial", 14, QFont::Bold)  // Heading font
+    , HeaderFont("Arial", 8, QFont::Bold)  // Header row font
+    , CellFont("Arial", 8)             // Cell font
+    , PageRect()                       // Set by Begin
+    , RowHeight(0)                     // Set by Begin
+    , TitleHeight(0)                   // Set by Begin
+    , FooterHeight(0)                  // Set by Begin
+    , CellPadding(0)                   // Set by Begin
+    , PageNumber(1)                    // First page
+    , RowCount(0)                      // No rows added
+    , Failed(false)                    // Painting not stopped
+{
+}
+
+/**
+ * @brief Set the function told about progress after every page
+ */
+void PdfTableWriter::SetProgressCallback(const ProgressCallback &callback)
+{
+    Progress = callback;
+}
+
+/**
+ * @brief Start painting on the device
+ */
+bool PdfTableWriter::Begin()
+{
+    if (!Painter.begin(Device)) {
+        qDebug() << "Error: Cannot start painting the PDF document";
+        Failed = true;
+        return false;
+    }
+
+    ComputeMetrics();
+    return true;
+}
+
+/**
+ * @brief Add the next row, painting the current page once it is full
+ * A full page is painted only when the next row arrives, so the last page is known
+ * when Finish paints it with the summary
+ */
+bool PdfTableWriter::AddRow(const QStringList &cells)
+{
+    if (Failed) {
+        return false;
+    }
+
+    if (PageRows.size() >= GetPageCapacity() && !PaintPage(false)) {
+        return false;
+    }
+
+    PageRows.append(cells);
+    RowCount++;
+    return true;
+}
+
+/**
+ * @brief Paint the last page with the export summary and close the document
+ */
+bool PdfTableWriter::Finish()
+{
+    if (!Painter.isActive()) {
+        return false;
+    }
+
+    if (!Failed) {
+        PaintPage(true);
+    }
+    Painter.end();
+    return !Failed;
+}
+
+/**
+ * @brief Get the number of rows added so far
+ */
+qint64 PdfTableWriter::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Compute fonts, row height and rows per page from the device geometry
+ * Point sizes are resolved against the device resolution, so the layout is the same
+ * at any printer resolution
+ */
+void PdfTableWriter::ComputeMetrics()
+{
+    PageRect = QRectF(0, 0, Device->width(), Device->height());
+
+    QFontMetricsF _cellMetrics(CellFont, Device);    // Cell text metrics on the device
+    QFontMetricsF _titleMetrics(TitleFont, Device);  // Heading metrics on the device
+    RowHeight = std::ceil(_cellMetrics.height() * 1.6);
+    TitleHeight = std::ceil(_titleMetrics.height() * 2.0);
+    FooterHeight = std::ceil(_cellMetrics.height() * 2.0);
+    CellPadding = std::ceil(_cellMetrics.height() * 0.4);
+}
+
+/**
+ * @brief Size the columns from the headers and the rows collected so far
+ * Columns narrower than an equal share keep their natural width; the others split the
+ * rest of the page. Spare width is spread proportionally so the table spans the page
+ */
+void PdfTableWriter::ComputeColumnWidths()
+{
+    const int _columnCount = Headers.size();  // Number of columns
+    if (_columnCount == 0) {
+        return;
+    }
+
+    QFontMetricsF _headerMetrics(HeaderFont, Device);  // Header text metrics on the device
+    QFontMetricsF _cellMetrics(CellFont, Device);      // Cell text metrics on the device
+    QVector<qreal> _natural(_columnCount);  // Widest text per column plus padding
+    for (int _col = 0; _col < _columnCount; ++_col) {
+        _natural[_col] = _headerMetrics.horizontalAdvance(Headers[_col]);
+    }
+    for (int _row = 0; _row < PageRows.size() && _row < LAYOUT_SAMPLE_ROWS; ++_row) {
+        const QStringList &_cells = PageRows[_row];  // Measured row
+        for (int _col = 0; _col < _columnCount && _col < _cells.size(); ++_col) {
+            _natural[_col] = qMax(_natural[_col], _cellMetrics.horizontalAdvance(_cells[_col]));
+        }
+    }
+    qreal _naturalTotal = 0;  // Width of the table at natural column widths
+    for (qreal &_width : _natural) {
+        _width += 2 * CellPadding + 1;
+        _naturalTotal += _width;
+    }
+
+    ColumnWidths = _natural;
+    if (_naturalTotal <= PageRect.width()) {
+        qreal _scale = PageRect.width() / _naturalTotal;  // Stretch to the page width
+        for (qreal &_width : ColumnWidths) {
+            _width *= _scale;
+        }
+        return;
+    }
+
+    QVector<bool> _fixed(_columnCount, false);  // Column keeps its natural width
+    qreal _remaining = PageRect.width();  // Width not given to fixed columns
+    int _pending = _columnCount;          // Columns sharing the remaining width
+    bool _changed = true;  // A column was fixed in the last pass
+    while (_changed && _pending > 0) {
+        _changed = false;
+        qreal _share = _remaining / _pending;  // Equal share of the pending columns
+        for (int _col = 0; _col < _columnCount; ++_col) {
+            if (!_fixed[_col] && _natural[_col] <= _share) {
+                _fixed[_col] = true;
+                _remaining -= _natural[_col];
+                _pending--;
+                _changed = true;
+            }
+        }
+    }
+    for (int _col = 0; _col < _columnCount; ++_col) {
+        if (!_fixed[_col]) {
+            ColumnWidths[_col] = _remaining / _pending;
+        }
+    }
+}
+
+/**
+ * @brief Paint the collected rows as one page and release them
+ */
+bool PdfTableWriter::PaintPage(bool lastPage)
+{
+    if (ColumnWidths.isEmpty()) {
+        ComputeColumnWidths();
+    }
+
+    if (PageNumber > 1 && !Device->newPage()) {
+        qDebug() << "Error: Cannot add page" << PageNumber << "to the PDF document";
+        Failed = true;
+        return false;
+    }
+
+    qreal _top = PageRect.top();  // Top edge of the next element
+    if (PageNumber == 1) {
+        Painter.setFont(TitleFont);
+        Painter.setPen(QColor("#333333"));
+        Painter.drawText(QRectF(PageRect.left(), _top, PageRect.width(), TitleHeight), Qt::AlignCenter, Title);
+        _top += TitleHeight;
+    }
+
+    PaintRow(Headers, _top, true, false);
+    _top += RowHeight;
+    for (int _row = 0; _row < PageRows.size(); ++_row) {
+        PaintRow(PageRows[_row], _top, false, _row % 2 == 1);
+        _top += RowHeight;
+    }
+
+    // Footer: page number on every page, export summary on the last one
+    QRectF _footerRect(PageRect.left(), PageRect.bottom() - FooterHeight, PageRect.width(), FooterHeight);  // Footer area
+    Painter.setFont(CellFont);
+    Painter.setPen(QColor("#666666"));
+    if (lastPage) {
+        QString _timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
+        Painter.drawText(_footerRect, Qt::AlignLeft | Qt::AlignVCenter,
+                         QString("Exported on %1 | Total rows: %2").arg(_timestamp).arg(RowCount));
+    }
+    Painter.drawText(_footerRect, Qt::AlignRight | Qt::AlignVCenter, QString("Page %1").arg(PageNumber));
+
+    PageRows.clear();
+    PageNumber++;
+
+    if (Progress && !Progress(RowCount)) {
+        Failed = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Paint one row of cells at a vertical position
+ */
+void PdfTableWriter::PaintRow(const QStringList &cells, qreal top, bool header, bool shaded)
+{
+    Painter.setFont(header ? HeaderFont : CellFont);
+    QFontMetricsF _metrics(Painter.font(), Device);  // Metrics used for eliding
+
+    qreal _left = PageRect.left();  // Left edge of the next cell
+    for (int _col = 0; _col < ColumnWidths.size(); ++_col) {
+        QRectF _cellRect(_left, top, ColumnWidths[_col], RowHeight);  // Cell area
+        if (header || shaded) {
+            Painter.fillRect(_cellRect, QColor(header ? "#f2f2f2" : "#f9f9f9"));
+        }
+        Painter.setPen(QColor("#dddddd"));
+        Painter.drawRect(_cellRect);
+
+        // One line per cell keeps the row height fixed; longer texts are elided
+        QString _text = _col < cells.size() ? cells[_col] : QString();  // Cell text
+        _text.replace('\n', ' ');
+        QRectF _textRect = _cellRect.adjusted(CellPadding, 0, -CellPadding, 0);  // Area inside the padding
+        Painter.setPen(Qt::black);
+        Painter.drawText(_textRect, Qt::AlignLeft | Qt::AlignVCenter,
+                         _metrics.elidedText(_text, Qt::ElideRight, _textRect.width()));
+        _left += ColumnWidths[_col];
+    }
+}
+
+/**
+ * @brief Get the number of rows that fit on the current page
+ */
+int PdfTableWriter::GetPageCapacity() const
+{
+    qreal _available = PageRect.height() - FooterHeight - RowHeight;  // Height left for data rows under the header
+    if (PageNumber == 1) {
+        _available -= TitleHeight;
+    }
+    return qMax(1, static_cast<int>(_available / RowHeight));
+}
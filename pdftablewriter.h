@@ -0,0 +1,121 @@
+#ifndef PDFTABLEWRITER_H
+#define PDFTABLEWRITER_H
+
+#include <QPagedPaintDevice>
+#include <QPainter>
+#include <QFont>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief Paints a table page by page onto a paged device such as a PDF QPrinter or QPdfWriter
+ * Rows are added one at a time and only the rows of the current page are held;
+ * a full page is painted and released before the next one is collected, so memory
+ * is bounded by one page whatever the row count
+ */
+class PdfTableWriter
+{
+public:
+    /**
+     * @brief Called after each finished page with the rows painted so far
+     * @return true to continue, false to cancel the export
+     */
+    using ProgressCallback = std::function<bool(qint64 rowCount)>;
+
+    /**
+     * @brief Constructor for PdfTableWriter
+     * @param device Paged output device (not owned, must outlive the writer)
+     * @param title Heading printed above the table on the first page
+     * @param headers Column headers, repeated at the top of every page
+     */
+    PdfTableWriter(QPagedPaintDevice *device, const QString &title, const QStringList &headers);
+
+    /**
+     * @brief Set the function told about progress after every page
+     * @param callback Progress callback (may cancel the export)
+     */
+    void SetProgressCallback(const ProgressCallback &callback);
+
+    /**
+     * @brief Start painting on the device
+     * @return true if the device accepted the painter, false otherwise
+     */
+    bool Begin();
+
+    /**
+     * @brief Add the next row, painting the current page once it is full
+     * @param cells Cell texts in header order
+     * @return true to continue, false if the export was cancelled or painting failed
+     */
+    bool AddRow(const QStringList &cells);
+
+    /**
+     * @brief Paint the last page with the export summary and close the document
+     * @return true if the document was completed, false otherwise
+     */
+    bool Finish();
+
+    /**
+     * @brief Get the number of rows added so far
+     * @return Rows added
+     */
+    qint64 GetRowCount() const;
+
+    static const int LAYOUT_SAMPLE_ROWS;  // Rows measured to size the columns (at most the first page)
+
+private:
+    /**
+     * @brief Compute fonts, row height and rows per page from the device geometry
+     */
+    void ComputeMetrics();
+
+    /**
+     * @brief Size the columns from the headers and the rows collected so far
+     * Widths are fixed afterwards; wider texts are elided
+     */
+    void ComputeColumnWidths();
+
+    /**
+     * @brief Paint the collected rows as one page and release them
+     * @param lastPage true to add the export summary to the footer
+     * @return true if painting can continue, false otherwise
+     */
+    bool PaintPage(bool lastPage);
+
+    /**
+     * @brief Paint one row of cells at a vertical position
+     * @param cells Cell texts
+     * @param top Top edge of the row
+     * @param header true for the header row style
+     * @param shaded true to shade the row background
+     */
+    void PaintRow(const QStringList &cells, qreal top, bool header, bool shaded);
+
+    /**
+     * @brief Get the number of rows that fit on the current page
+     * @return Rows per page (the first page leaves room for the title)
+     */
+    int GetPageCapacity() const;
+
+    QPagedPaintDevice *Device;           // Output device (not owned)
+    QPainter Painter;                    // Painter active between Begin and Finish
+    QString Title;                       // Heading of the first page
+    QStringList Headers;                 // Column headers
+    QVector<QStringList> PageRows;       // Rows of the page being collected
+    QVector<qreal> ColumnWidths;         // Column widths in device pixels (empty until computed)
+    ProgressCallback Progress;           // Progress callback (empty if none)
+    QFont TitleFont;                     // Font of the heading
+    QFont HeaderFont;                    // Font of the header row
+    QFont CellFont;                      // Font of the cells and footer
+    QRectF PageRect;                     // Printable area in device pixels
+    qreal RowHeight;                     // Height of one table row in device pixels
+    qreal TitleHeight;                   // Height reserved for the heading on the first page
+    qreal FooterHeight;                  // Height reserved for the page footer
+    qreal CellPadding;                   // Horizontal space between cell border and text
+    int PageNumber;                      // Number of the page being collected (1-based)
+    qint64 RowCount;                     // Rows added so far
+    bool Failed;                         // Flag indicating painting stopped (true) or continues (false)
+};
+
+#endif // PDFTABLEWRITER_H
@@ -0,0 +1,256 @@
+#include "pivotdialog.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGridLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+
+/**
+ * @brief Constructor builds the grouping controls and the result view
+ */
+PivotDialog::PivotDialog(const QString &filePath, const QString &tableName, const QStringList &columnNames,
+                         const TableFilter &filter, QWidget *parent)
+    : QDialog(parent)
+    , FilePath(filePath)               // File of the table
+    , TableName(tableName)             // Grouped table
+    , Filter(filter)                   // Main view filter
+    , GroupColumnList(nullptr)         // Group column list
+    , FunctionComboBox(nullptr)        // Aggregate function selector
+    , AggregateColumnComboBox(nullptr) // Aggregate column selector
+    , AggregateList(nullptr)           // Chosen aggregates
+    , RunButton(nullptr)               // Query start button
+    , ExportButton(nullptr)            // Result export button
+    , StatusLabel(nullptr)             // Query status
+    , ResultView(nullptr)              // Result view
+    , ResultModel(nullptr)             // Result model
+    , ActiveQuery(nullptr)             // No query running
+    , ResultGroupColumns()             // No result yet
+{
+    setWindowTitle(QString("Pivot - %1").arg(tableName));
+    resize(900, 600);
+
+    GroupColumnList = new QListWidget(this);
+    for (const QString &_columnName : columnNames) {
+        QListWidgetItem *_item = new QListWidgetItem(_columnName, GroupColumnList);  // Checkable group column
+        _item->setFlags(_item->flags() | Qt::ItemIsUserCheckable);
+        _item->setCheckState(Qt::Unchecked);
+    }
+
+    FunctionComboBox = new QComboBox(this);
+    FunctionComboBox->addItems(PivotQueryTask::AGGREGATE_FUNCTIONS);
+    AggregateColumnComboBox = new QComboBox(this);
+    AggregateColumnComboBox->addItem("*");
+    AggregateColumnComboBox->addItems(columnNames);
+    QPushButton *_addButton = new QPushButton("Add", this);  // Adds the chosen aggregate
+    QPushButton *_removeButton = new QPushButton("Remove", this);  // Removes the selected aggregate
+    AggregateList = new QListWidget(this);
+
+    // COUNT(*) is the usual starting point of a pivot
+    PivotAggregate _count;  // Default aggregate
+    _count.Function = "COUNT";
+    QListWidgetItem *_countItem = new QListWidgetItem(PivotQueryTask::GetAggregateHeader(_count), AggregateList);  // Default aggregate item
+    _countItem->setData(Qt::UserRole, _count.Function);
+    _countItem->setData(Qt::UserRole + 1, _count.ColumnName);
+
+    RunButton = new QPushButton("Run", this);
+    ExportButton = new QPushButton("Export", this);
+    ExportButton->setEnabled(false);  // Enabled once a result is complete
+    QPushButton *_closeButton = new QPushButton("Close", this);  // Closes the dialog
+    StatusLabel = new QLabel(this);
+
+    ResultModel = new PivotTableModel(this);
+    ResultView = new QTableView(this);
+    ResultView->setModel(ResultModel);
+    ResultView->setAlternatingRowColors(true);
+    ResultView->horizontalHeader()->setStretchLastSection(true);
+
+    // Controls on the left, result on the right
+    QGridLayout *_controlLayout = new QGridLayout();  // Grouping and aggregate controls
+    _controlLayout->addWidget(new QLabel("Group by:", this), 0, 0, 1, 3);
+    _controlLayout->addWidget(GroupColumnList, 1, 0, 1, 3);
+    _controlLayout->addWidget(new QLabel("Aggregates:", this), 2, 0, 1, 3);
+    _controlLayout->addWidget(FunctionComboBox, 3, 0);
+    _controlLayout->addWidget(AggregateColumnComboBox, 3, 1);
+    _controlLayout->addWidget(_addButton, 3, 2);
+    _controlLayout->addWidget(AggregateList, 4, 0, 1, 3);
+    _controlLayout->addWidget(_removeButton, 5, 2);
+
+    QHBoxLayout *_contentLayout = new QHBoxLayout();  // Controls and result side by side
+    _contentLayout->addLayout(_controlLayout);
+    _contentLayout->addWidget(ResultView, 1);
+
+    QHBoxLayout *_buttonLayout = new QHBoxLayout();  // Status and dialog buttons
+    _buttonLayout->addWidget(StatusLabel, 1);
+    _buttonLayout->addWidget(RunButton);
+    _buttonLayout->addWidget(ExportButton);
+    _buttonLayout->addWidget(_closeButton);
+
+    QVBoxLayout *_layout = new QVBoxLayout(this);  // Dialog layout
+    _layout->addLayout(_contentLayout, 1);
+    _layout->addLayout(_buttonLayout);
+
+    connect(_addButton, &QPushButton::clicked, this, &PivotDialog::OnAddAggregateClicked);
+    connect(_removeButton, &QPushButton::clicked, this, &PivotDialog::OnRemoveAggregateClicked);
+    connect(RunButton, &QPushButton::clicked, this, &PivotDialog::OnRunClicked);
+    connect(ExportButton, &QPushButton::clicked, this, &PivotDialog::OnExportClicked);
+    connect(_closeButton, &QPushButton::clicked, this, &QDialog::close);
+
+    if (!Filter.IsEmpty()) {
+        StatusLabel->setText("Rows are filtered like the main view");
+    }
+}
+
+/**
+ * @brief Destructor cancels a running query
+ */
+PivotDialog::~PivotDialog()
+{
+    Stop();
+}
+
+/**
+ * @brief Get the table this dialog groups
+ */
+QString PivotDialog::GetTableName() const
+{
+    return TableName;
+}
+
+/**
+ * @brief Cancel and dispose of a running query
+ */
+void PivotDialog::Stop()
+{
+    if (!ActiveQuery) {
+        return;
+    }
+
+    ActiveQuery->disconnect(this);
+    ActiveQuery->Stop();
+    delete ActiveQuery;  // Thread has left Run, so no member is still in use
+    ActiveQuery = nullptr;
+    RunButton->setText("Run");
+}
+
+/**
+ * @brief Add the aggregate chosen in the function and column boxes
+ */
+void PivotDialog::OnAddAggregateClicked()
+{
+    PivotAggregate _aggregate;  // Aggregate to add
+    _aggregate.Function = FunctionComboBox->currentText();
+    _aggregate.ColumnName = AggregateColumnComboBox->currentIndex() > 0 ? AggregateColumnComboBox->currentText() : QString();
+
+    // Only COUNT accepts "*"; the other functions need a column
+    if (_aggregate.ColumnName.isEmpty() && _aggregate.Function != "COUNT") {
+        QMessageBox::warning(this, "Pivot", QString("%1 needs a column.").arg(_aggregate.Function));
+        return;
+    }
+
+    QListWidgetItem *_item = new QListWidgetItem(PivotQueryTask::GetAggregateHeader(_aggregate), AggregateList);  // New aggregate item
+    _item->setData(Qt::UserRole, _aggregate.Function);
+    _item->setData(Qt::UserRole + 1, _aggregate.ColumnName);
+}
+
+/**
+ * @brief Remove the selected aggregate
+ */
+void PivotDialog::OnRemoveAggregateClicked()
+{
+    delete AggregateList->currentItem();
+}
+
+/**
+ * @brief Start the GROUP BY query, or cancel the running one
+ */
+void PivotDialog::OnRunClicked()
+{
+    if (ActiveQuery) {
+        Stop();
+        StatusLabel->setText("Cancelled");
+        return;
+    }
+
+    QStringList _groupColumns;  // Checked group columns in table order
+    for (int _i = 0; _i < GroupColumnList->count(); ++_i) {
+        if (GroupColumnList->item(_i)->checkState() == Qt::Checked) {
+            _groupColumns.append(GroupColumnList->item(_i)->text());
+        }
+    }
+
+    QList<PivotAggregate> _aggregates;  // Aggregates in list order
+    for (int _i = 0; _i < AggregateList->count(); ++_i) {
+        PivotAggregate _aggregate;  // Aggregate stored in the item
+        _aggregate.Function = AggregateList->item(_i)->data(Qt::UserRole).toString();
+        _aggregate.ColumnName = AggregateList->item(_i)->data(Qt::UserRole + 1).toString();
+        _aggregates.append(_aggregate);
+    }
+
+    if (_groupColumns.isEmpty() && _aggregates.isEmpty()) {
+        QMessageBox::warning(this, "Pivot", "Choose at least one group column or aggregate.");
+        return;
+    }
+
+    ActiveQuery = new PivotQueryTask(FilePath, TableName, _groupColumns, _aggregates, Filter);
+    ResultGroupColumns = _groupColumns;
+    ResultModel->Reset(ActiveQuery->GetColumnNames());
+    ExportButton->setEnabled(false);
+
+    // Batches still queued from a cancelled query must not reach the new result
+    PivotQueryTask *_query = ActiveQuery;  // Query the batches belong to
+    connect(ActiveQuery, &PivotQueryTask::RowsReady, this, [this, _query](const QVector<QVariantList> &rows) {
+        if (_query == ActiveQuery) {
+            ResultModel->AppendRows(rows);
+        }
+    });
+    connect(ActiveQuery, &DatabaseTask::ProgressChanged, this, [this](int, const QString &message) {
+        StatusLabel->setText(message);
+    });
+    connect(ActiveQuery, &DatabaseTask::Finished, this, &PivotDialog::OnQueryFinished);
+
+    RunButton->setText("Cancel");
+    StatusLabel->setText("Running...");
+    ActiveQuery->Start();
+}
+
+/**
+ * @brief Forward the result to the main window's export
+ */
+void PivotDialog::OnExportClicked()
+{
+    if (ResultModel->rowCount() == 0) {
+        QMessageBox::warning(this, "Pivot", "No groups to export.");
+        return;
+    }
+
+    emit ExportRequested(ResultModel, GetTitle(), TableName + "_pivot");
+}
+
+/**
+ * @brief Show the outcome of the finished query
+ */
+void PivotDialog::OnQueryFinished(bool success, const QString &message)
+{
+    if (!ActiveQuery) {
+        return;
+    }
+
+    ActiveQuery->deleteLater();
+    ActiveQuery = nullptr;
+    RunButton->setText("Run");
+
+    StatusLabel->setText(success ? message : "Failed: " + message);
+    ExportButton->setEnabled(success && ResultModel->rowCount() > 0);
+    ResultView->resizeColumnsToContents();
+}
+
+/**
+ * @brief Get the description of the current grouping used as export title
+ */
+QString PivotDialog::GetTitle() const
+{
+    if (ResultGroupColumns.isEmpty()) {
+        return QString("Totals of %1").arg(TableName);
+    }
+    return QString("%1 grouped by %2").arg(TableName, ResultGroupColumns.join(", "));
+}
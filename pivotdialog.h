@@ -0,0 +1,110 @@
+#ifndef PIVOTDIALOG_H
+#define PIVOTDIALOG_H
+
+#include <QDialog>
+#include <QListWidget>
+#include <QComboBox>
+#include <QPushButton>
+#include <QTableView>
+#include <QLabel>
+#include "pivotquerytask.h"
+#include "pivottablemodel.h"
+
+/**
+ * @brief Aggregate view of one table grouped by user-chosen columns
+ * The GROUP BY query runs as a PivotQueryTask and its groups stream into a
+ * PivotTableModel; the result is exported through the main window's export paths
+ */
+class PivotDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for PivotDialog
+     * @param filePath Path to the SQL database file containing the table
+     * @param tableName Name of the table to group
+     * @param columnNames Columns of the table offered for grouping and aggregation
+     * @param filter Column filter of the main view, applied before grouping
+     * @param parent Parent widget pointer
+     */
+    PivotDialog(const QString &filePath, const QString &tableName, const QStringList &columnNames,
+                const TableFilter &filter, QWidget *parent = nullptr);
+
+    /**
+     * @brief Destructor cancels a running query
+     */
+    ~PivotDialog() override;
+
+    /**
+     * @brief Get the table this dialog groups
+     * @return QString containing the table name
+     */
+    QString GetTableName() const;
+
+    /**
+     * @brief Cancel and dispose of a running query, keeping the groups received so far
+     */
+    void Stop();
+
+signals:
+    /**
+     * @brief Emitted when the user asks to export the grouped result
+     * @param model Model holding the result
+     * @param title Heading describing the grouping
+     * @param baseName File name prefix for the exported files
+     */
+    void ExportRequested(const QAbstractItemModel *model, const QString &title, const QString &baseName);
+
+private slots:
+    /**
+     * @brief Add the aggregate chosen in the function and column boxes
+     */
+    void OnAddAggregateClicked();
+
+    /**
+     * @brief Remove the selected aggregate
+     */
+    void OnRemoveAggregateClicked();
+
+    /**
+     * @brief Start the GROUP BY query for the chosen columns and aggregates
+     */
+    void OnRunClicked();
+
+    /**
+     * @brief Forward the result to the main window's export
+     */
+    void OnExportClicked();
+
+    /**
+     * @brief Show the outcome of the finished query
+     * @param success true if every group was received, false otherwise
+     * @param message Summary or error reported by the task
+     */
+    void OnQueryFinished(bool success, const QString &message);
+
+private:
+    /**
+     * @brief Get the description of the current grouping used as export title
+     * @return Title such as "orders grouped by region"
+     */
+    QString GetTitle() const;
+
+    QString FilePath;                    // File of the grouped table
+    QString TableName;                   // Grouped table
+    TableFilter Filter;                  // Filter of the main view applied before grouping
+    QListWidget *GroupColumnList;        // Checkable list of group-by columns
+    QComboBox *FunctionComboBox;         // Aggregate function to add
+    QComboBox *AggregateColumnComboBox;  // Column of the aggregate to add ("*" for COUNT(*))
+    QListWidget *AggregateList;          // Aggregates of the query (function and column in item data)
+    QPushButton *RunButton;              // Starts the query
+    QPushButton *ExportButton;           // Exports the result
+    QLabel *StatusLabel;                 // Progress or summary of the query
+    QTableView *ResultView;              // View of the grouped result
+    PivotTableModel *ResultModel;        // Groups received from the query
+    PivotQueryTask *ActiveQuery;         // Running query (nullptr if idle)
+    QStringList ResultGroupColumns;      // Group columns of the result shown
+};
+
+#endif // PIVOTDIALOG_H
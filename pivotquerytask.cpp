@@ -0,0 +1,134 @@
+#include "pivotquerytask.h"
+#include "sqlworker.h"
+
+// Define pivot query constants
+// APPROX_COUNT_DISTINCT is the HyperLogLog aggregate registered by SQLiteFunctions
+const QStringList PivotQueryTask::AGGREGATE_FUNCTIONS = {"COUNT", "SUM", "AVG", "MIN", "MAX", "APPROX_COUNT_DISTINCT"};
+const int PivotQueryTask::ROWS_PER_BATCH = 1000;
+
+/**
+ * @brief Constructor initializes PivotQueryTask with the grouping to compute
+ */
+PivotQueryTask::PivotQueryTask(const QString &filePath, const QString &tableName, const QStringList &groupColumns,
+                               const QList<PivotAggregate> &aggregates, const TableFilter &filter)
+    : DatabaseTask(filePath)
+    , TableName(tableName)             // Grouped table
+    , GroupColumns(groupColumns)       // Grouping columns
+    , Aggregates(aggregates)           // Aggregate columns
+    , Filter(filter)                   // Row filter
+{
+    // Result batches cross from the task thread to the GUI thread
+    qRegisterMetaType<QVector<QVariantList>>("QVector<QVariantList>");
+}
+
+/**
+ * @brief Get the headers of the result columns
+ */
+QStringList PivotQueryTask::GetColumnNames() const
+{
+    QStringList _columnNames = GroupColumns;  // Group columns keep their names
+    for (const PivotAggregate &_aggregate : Aggregates) {
+        _columnNames.append(GetAggregateHeader(_aggregate));
+    }
+    return _columnNames;
+}
+
+/**
+ * @brief Get the display header of an aggregate column
+ */
+QString PivotQueryTask::GetAggregateHeader(const PivotAggregate &aggregate)
+{
+    return QString("%1(%2)").arg(aggregate.Function, aggregate.ColumnName.isEmpty() ? "*" : aggregate.ColumnName);
+}
+
+/**
+ * @brief Run the GROUP BY query and stream its rows
+ * @param database Open connection owned by the task thread
+ * @param message Output summary or error description
+ * @return true if every group was delivered, false otherwise
+ */
+bool PivotQueryTask::Run(QSqlDatabase &database, QString &message)
+{
+    if (GroupColumns.isEmpty() && Aggregates.isEmpty()) {
+        message = "Choose at least one group column or aggregate";
+        return false;
+    }
+
+    QStringList _groupColumns;  // Quoted group column names
+    for (const QString &_column : GroupColumns) {
+        _groupColumns.append(SQLWorker::QuoteIdentifier(_column));
+    }
+
+    QStringList _selectList = _groupColumns;  // SELECT list: group columns, then aggregates
+    for (const PivotAggregate &_aggregate : Aggregates) {
+        if (!AGGREGATE_FUNCTIONS.contains(_aggregate.Function)) {
+            message = "Unsupported aggregate function: " + _aggregate.Function;
+            return false;
+        }
+        _selectList.append(QString("%1(%2)").arg(_aggregate.Function, _aggregate.ColumnName.isEmpty()
+                                                                           ? QString("*")
+                                                                           : SQLWorker::QuoteIdentifier(_aggregate.ColumnName)));
+    }
+
+    QString _queryString = QString("SELECT %1 FROM %2").arg(_selectList.join(", "), SQLWorker::QuoteIdentifier(TableName));  // Complete GROUP BY query string
+    if (!Filter.IsEmpty()) {
+        _queryString += " WHERE " + Filter.BuildWhereClause();
+    }
+    if (!_groupColumns.isEmpty()) {
+        _queryString += QString(" GROUP BY %1 ORDER BY %1").arg(_groupColumns.join(", "));
+    }
+
+    QSqlQuery _query(database);  // Query object stepping through the groups
+    _query.setForwardOnly(true);
+    if (!_query.prepare(_queryString)) {
+        message = "Cannot prepare pivot query: " + _query.lastError().text();
+        return false;
+    }
+    for (const QVariant &_value : Filter.GetBindValues()) {
+        _query.addBindValue(_value);
+    }
+
+    emit ProgressChanged(-1, QString("Grouping %1").arg(TableName));
+    if (!_query.exec()) {
+        message = IsCancelled() ? "Pivot query cancelled" : "Pivot query failed: " + _query.lastError().text();
+        return false;
+    }
+
+    const int _columnCount = _selectList.size();  // Values per result row
+    qint64 _groupCount = 0;  // Groups delivered so far
+    QVector<QVariantList> _batch;  // Rows not yet sent to the GUI
+    _batch.reserve(ROWS_PER_BATCH);
+
+    while (_query.next()) {
+        QVariantList _row;  // Values of the current group
+        _row.reserve(_columnCount);
+        for (int _col = 0; _col < _columnCount; ++_col) {
+            _row.append(_query.value(_col));
+        }
+        _batch.append(_row);
+
+        if (_batch.size() >= ROWS_PER_BATCH) {
+            _groupCount += _batch.size();
+            emit RowsReady(_batch);
+            _batch.clear();
+            emit ProgressChanged(-1, QString("%1 groups").arg(_groupCount));
+        }
+    }
+
+    if (IsCancelled()) {
+        message = "Pivot query cancelled";
+        return false;
+    }
+    if (_query.lastError().isValid()) {
+        message = "Pivot query failed: " + _query.lastError().text();
+        return false;
+    }
+
+    if (!_batch.isEmpty()) {
+        _groupCount += _batch.size();
+        emit RowsReady(_batch);
+    }
+
+    message = QString("%1 groups").arg(_groupCount);
+    return true;
+}
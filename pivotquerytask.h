@@ -0,0 +1,76 @@
+#ifndef PIVOTQUERYTASK_H
+#define PIVOTQUERYTASK_H
+
+#include <QStringList>
+#include <QVector>
+#include <QVariantList>
+#include "databasetask.h"
+#include "tablefilter.h"
+
+/**
+ * @brief One aggregate column of a pivot query
+ */
+struct PivotAggregate {
+    QString Function;                    // Aggregate function (one of PivotQueryTask::AGGREGATE_FUNCTIONS)
+    QString ColumnName;                  // Aggregated column (empty for COUNT(*))
+};
+
+/**
+ * @brief Background GROUP BY query over one table
+ * Groups are computed by SQLite on the task's own connection and streamed to
+ * the GUI in batches through RowsReady while the query is still stepping
+ */
+class PivotQueryTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for PivotQueryTask
+     * @param filePath Path to the SQL database file containing the table
+     * @param tableName Name of the table to group
+     * @param groupColumns Columns to group by (empty for a single total row)
+     * @param aggregates Aggregate columns computed per group
+     * @param filter Column filter restricting the grouped rows (empty for all rows)
+     */
+    PivotQueryTask(const QString &filePath, const QString &tableName, const QStringList &groupColumns,
+                   const QList<PivotAggregate> &aggregates, const TableFilter &filter);
+
+    /**
+     * @brief Get the headers of the result columns (group columns first, then aggregates)
+     * @return QStringList with one header per result column
+     */
+    QStringList GetColumnNames() const;
+
+    /**
+     * @brief Get the display header of an aggregate column
+     * @param aggregate Aggregate to describe
+     * @return Header text such as "SUM(amount)"
+     */
+    static QString GetAggregateHeader(const PivotAggregate &aggregate);
+
+    static const QStringList AGGREGATE_FUNCTIONS;  // Aggregate functions offered for pivot columns
+
+signals:
+    /**
+     * @brief Emitted from the task thread with the next batch of result rows
+     * @param rows Result rows, one value per result column
+     */
+    void RowsReady(const QVector<QVariantList> &rows);
+
+protected:
+    /**
+     * @brief Run the GROUP BY query and stream its rows
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    QString TableName;                   // Grouped table
+    QStringList GroupColumns;            // Columns to group by
+    QList<PivotAggregate> Aggregates;    // Aggregate columns per group
+    TableFilter Filter;                  // Filter applied before grouping
+
+    static const int ROWS_PER_BATCH;     // Result rows sent per RowsReady signal
+};
+
+#endif // PIVOTQUERYTASK_H
@@ -0,0 +1,92 @@
+#include "pivottablemodel.h"
+
+/**
+ * @brief Constructor initializes an empty model
+ */
+PivotTableModel::PivotTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , ColumnNames()                    // No columns yet
+    , Rows()                           // No rows yet
+{
+}
+
+/**
+ * @brief Remove all rows and replace the column headers
+ */
+void PivotTableModel::Reset(const QStringList &columnNames)
+{
+    beginResetModel();
+    ColumnNames = columnNames;
+    Rows.clear();
+    endResetModel();
+}
+
+/**
+ * @brief Append a batch of result rows
+ */
+void PivotTableModel::AppendRows(const QVector<QVariantList> &rows)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), Rows.size(), Rows.size() + rows.size() - 1);
+    Rows += rows;
+    endInsertRows();
+}
+
+/**
+ * @brief Get the number of rows
+ */
+int PivotTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : Rows.size();
+}
+
+/**
+ * @brief Get the number of columns
+ */
+int PivotTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnNames.size();
+}
+
+/**
+ * @brief Get the value of a cell
+ */
+QVariant PivotTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= Rows.size()) {
+        return QVariant();
+    }
+
+    const QVariantList &_row = Rows[index.row()];  // Values of the requested group
+    if (index.column() >= _row.size()) {
+        return QVariant();
+    }
+
+    if (role == Qt::DisplayRole) {
+        return _row[index.column()].toString();
+    }
+    if (role == Qt::TextAlignmentRole) {
+        int _type = _row[index.column()].userType();  // Storage type reported by SQLite
+        bool _isNumber = _type == QMetaType::Int || _type == QMetaType::LongLong || _type == QMetaType::Double;  // Numbers are right aligned
+        return _isNumber ? QVariant(Qt::AlignRight | Qt::AlignVCenter) : QVariant();
+    }
+    return QVariant();
+}
+
+/**
+ * @brief Get the column headers and row numbers
+ */
+QVariant PivotTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    if (orientation == Qt::Horizontal) {
+        return section < ColumnNames.size() ? QVariant(ColumnNames[section]) : QVariant();
+    }
+    return section + 1;
+}
@@ -0,0 +1,62 @@
+#ifndef PIVOTTABLEMODEL_H
+#define PIVOTTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QVector>
+#include <QVariantList>
+
+/**
+ * @brief Read-only table model holding the groups of a pivot query
+ * Rows are appended in batches while the query streams, so views update
+ * incrementally without copying results into widget items
+ */
+class PivotTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for PivotTableModel
+     * @param parent Parent object pointer
+     */
+    explicit PivotTableModel(QObject *parent = nullptr);
+
+    /**
+     * @brief Remove all rows and replace the column headers
+     * @param columnNames Headers of the result columns
+     */
+    void Reset(const QStringList &columnNames);
+
+    /**
+     * @brief Append a batch of result rows
+     * @param rows Result rows, one value per column
+     */
+    void AppendRows(const QVector<QVariantList> &rows);
+
+    /**
+     * @brief Get the number of rows
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @brief Get the number of columns
+     */
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /**
+     * @brief Get the value of a cell (NULL shown as empty text)
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Get the column headers and row numbers
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QStringList ColumnNames;             // Headers of the result columns
+    QVector<QVariantList> Rows;          // Result rows received so far
+};
+
+#endif // PIVOTTABLEMODEL_H
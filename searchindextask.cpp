@@ -0,0 +1,176 @@
+#include "searchindextask.h"
+#include "sqlworker.h"
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <limits>
+
+// Define indexing constants
+const int SearchIndexTask::ROWS_PER_CHUNK = 20000;
+
+/**
+ * @brief Constructor initializes SearchIndexTask with the table and columns to index
+ */
+SearchIndexTask::SearchIndexTask(const QString &filePath, const QString &tableName, const QStringList &columnNames)
+    : DatabaseTask(filePath)
+    , TableName(tableName)             // Table to index
+    , ColumnNames(columnNames)         // Indexed columns
+{
+}
+
+/**
+ * @brief Get the table this task indexes
+ */
+QString SearchIndexTask::GetTableName() const
+{
+    return TableName;
+}
+
+/**
+ * @brief Create the FTS5 table, fill it chunk by chunk and register it
+ * @param database Open connection owned by the task thread
+ * @param message Output summary or error description
+ * @return true if the index was built and registered, false otherwise
+ */
+bool SearchIndexTask::Run(QSqlDatabase &database, QString &message)
+{
+    if (ColumnNames.isEmpty()) {
+        message = "No columns selected for the search index";
+        return false;
+    }
+
+    QSqlQuery _query(database);  // Query object for schema statements
+    QString _quotedTable = SQLWorker::QuoteIdentifier(TableName);  // Quoted source table name
+    QString _indexTable = SQLWorker::SEARCH_INDEX_SCHEMA + "."
+                          + SQLWorker::QuoteIdentifier(SQLWorker::GetSearchIndexTableName(TableName));  // Qualified FTS5 table name
+    QString _metaTable = SQLWorker::SEARCH_INDEX_SCHEMA + "."
+                         + SQLWorker::QuoteIdentifier(SQLWorker::SEARCH_INDEX_META_TABLE);  // Qualified index list table
+
+    // Search results are matched back by row id, so WITHOUT ROWID tables cannot be indexed
+    if (!_query.prepare(QString("SELECT rowid FROM main.%1 LIMIT 0").arg(_quotedTable))) {
+        message = QString("Table %1 has no row ids and cannot be indexed").arg(TableName);
+        return false;
+    }
+
+    qint64 _totalRows = 0;  // Rows in the table, used for progress
+    if (_query.exec(QString("SELECT COUNT(*) FROM main.%1").arg(_quotedTable)) && _query.next()) {
+        _totalRows = _query.value(0).toLongLong();
+    }
+    _query.finish();
+
+    _query.prepare(QString("ATTACH DATABASE ? AS %1").arg(SQLWorker::SEARCH_INDEX_SCHEMA));
+    _query.addBindValue(SQLWorker::GetSearchIndexFilePath(FilePath));
+    if (!_query.exec()) {
+        message = "Cannot open search index file: " + _query.lastError().text();
+        return false;
+    }
+
+    // Unlist the old index first so a cancelled rebuild is never used by the editor
+    emit ProgressChanged(0, QString("Indexing %1").arg(TableName));
+    QStringList _indexColumns = SQLWorker::GetSearchIndexColumnNames(ColumnNames.size());  // FTS5 column names
+    bool _created = database.transaction()
+                    && _query.exec(QString("CREATE TABLE IF NOT EXISTS %1 (table_name TEXT PRIMARY KEY, column_names TEXT)").arg(_metaTable))
+                    && _query.prepare(QString("DELETE FROM %1 WHERE table_name = ?").arg(_metaTable));  // Old index unlisted and empty index created
+    if (_created) {
+        _query.addBindValue(TableName);
+        _created = _query.exec()
+                   && _query.exec(QString("DROP TABLE IF EXISTS %1").arg(_indexTable))
+                   && _query.exec(QString("CREATE VIRTUAL TABLE %1 USING fts5(%2, content='')").arg(_indexTable, _indexColumns.join(", ")))
+                   && database.commit();
+    }
+    if (!_created) {
+        message = "Cannot create search index: " + _query.lastError().text();
+        database.rollback();
+        return false;
+    }
+
+    // Copy rows in committed chunks so the index file's journal stays small
+    qint64 _lastRowId = std::numeric_limits<qint64>::min();  // Row id the next chunk starts after
+    qint64 _indexedRows = 0;    // Rows copied so far (capped at the table size)
+    bool _hasMoreRows = true;   // Rows remain to be indexed
+    while (_hasMoreRows) {
+        if (IsCancelled() || !IndexNextChunk(database, _lastRowId, _hasMoreRows, message)) {
+            return false;
+        }
+
+        _indexedRows = qMin(_indexedRows + ROWS_PER_CHUNK, _totalRows);
+        int _percent = _totalRows > 0 ? static_cast<int>(_indexedRows * 95 / _totalRows) : 95;  // Copy phase maps to 0-95%
+        emit ProgressChanged(_percent, QString("Indexing %1 (%2 of %3 rows)").arg(TableName).arg(_indexedRows).arg(_totalRows));
+    }
+
+    // Merge the per-chunk segments so lookups touch a single b-tree
+    emit ProgressChanged(96, QString("Optimizing search index of %1").arg(TableName));
+    if (!_query.exec(QString("INSERT INTO %1(%2) VALUES('optimize')")
+                         .arg(_indexTable, SQLWorker::QuoteIdentifier(SQLWorker::GetSearchIndexTableName(TableName))))) {
+        qDebug() << "Error: Failed to optimize search index of" << TableName;
+        qDebug() << "SQL error:" << _query.lastError().text();
+    }
+    if (IsCancelled()) {
+        return false;
+    }
+
+    // Listing the table makes the editor use the index and keep it in sync from now on
+    QJsonArray _columnArray;  // Indexed source columns in FTS5 column order
+    for (const QString &_columnName : ColumnNames) {
+        _columnArray.append(_columnName);
+    }
+    _query.prepare(QString("INSERT OR REPLACE INTO %1 (table_name, column_names) VALUES (?, ?)").arg(_metaTable));
+    _query.addBindValue(TableName);
+    _query.addBindValue(QString::fromUtf8(QJsonDocument(_columnArray).toJson(QJsonDocument::Compact)));
+    if (!_query.exec()) {
+        message = "Cannot register search index: " + _query.lastError().text();
+        return false;
+    }
+
+    emit ProgressChanged(100, QString("Search index of %1 finished").arg(TableName));
+    message = QString("Indexed %1 rows of %2 (%3 column(s))").arg(_totalRows).arg(TableName).arg(ColumnNames.size());
+    qDebug() << message;
+    return true;
+}
+
+/**
+ * @brief Copy the indexed columns of rows after a row id into the FTS5 table
+ */
+bool SearchIndexTask::IndexNextChunk(QSqlDatabase &database, qint64 &lastRowId, bool &hasMoreRows, QString &message)
+{
+    QString _quotedTable = SQLWorker::QuoteIdentifier(TableName);  // Quoted source table name
+    QSqlQuery _query(database);  // Query object for the chunk
+
+    // The chunk ends at the ROWS_PER_CHUNK-th row id after the start; none means this is the last chunk
+    _query.prepare(QString("SELECT rowid FROM main.%1 WHERE rowid > ? ORDER BY rowid LIMIT 1 OFFSET %2")
+                       .arg(_quotedTable).arg(ROWS_PER_CHUNK - 1));
+    _query.addBindValue(lastRowId);
+    if (!_query.exec()) {
+        message = "Cannot read row ids: " + _query.lastError().text();
+        return false;
+    }
+    hasMoreRows = _query.next();
+    qint64 _endRowId = hasMoreRows ? _query.value(0).toLongLong() : std::numeric_limits<qint64>::max();  // Last row id of the chunk
+    _query.finish();
+
+    QStringList _sourceColumns;  // Quoted indexed columns of the table
+    for (const QString &_columnName : ColumnNames) {
+        _sourceColumns.append(SQLWorker::QuoteIdentifier(_columnName));
+    }
+
+    QString _queryString = QString("INSERT INTO %1.%2(rowid, %3) SELECT rowid, %4 FROM main.%5 WHERE rowid > ? AND rowid <= ?")
+                               .arg(SQLWorker::SEARCH_INDEX_SCHEMA,
+                                    SQLWorker::QuoteIdentifier(SQLWorker::GetSearchIndexTableName(TableName)),
+                                    SQLWorker::GetSearchIndexColumnNames(ColumnNames.size()).join(", "),
+                                    _sourceColumns.join(", "), _quotedTable);  // Complete INSERT ... SELECT string
+
+    if (!database.transaction()) {
+        message = "Cannot start search index transaction";
+        return false;
+    }
+    _query.prepare(_queryString);
+    _query.addBindValue(lastRowId);
+    _query.addBindValue(_endRowId);
+    if (!_query.exec() || !database.commit()) {
+        message = IsCancelled() ? "Indexing cancelled" : "Cannot fill search index: " + _query.lastError().text();
+        database.rollback();
+        return false;
+    }
+
+    lastRowId = _endRowId;
+    return true;
+}
@@ -0,0 +1,53 @@
+#ifndef SEARCHINDEXTASK_H
+#define SEARCHINDEXTASK_H
+
+#include <QStringList>
+#include "databasetask.h"
+
+/**
+ * @brief Background build of the full-text search index of one table
+ * Fills a contentless FTS5 table in the side database next to the file in
+ * row id chunks; the table is listed as indexed only once the build completed,
+ * after which SQLWorker keeps it in sync on every save
+ */
+class SearchIndexTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for SearchIndexTask
+     * @param filePath Path to the SQL database file containing the table
+     * @param tableName Name of the table to index (must have row ids)
+     * @param columnNames Columns whose text is indexed
+     */
+    SearchIndexTask(const QString &filePath, const QString &tableName, const QStringList &columnNames);
+
+    /**
+     * @brief Get the table this task indexes
+     * @return QString containing the table name
+     */
+    QString GetTableName() const;
+
+protected:
+    /**
+     * @brief Create the FTS5 table, fill it chunk by chunk and register it
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    /**
+     * @brief Copy the indexed columns of rows after a row id into the FTS5 table
+     * @param lastRowId Row id the chunk starts after; updated to the last row id of the chunk
+     * @param hasMoreRows Output flag indicating rows follow this chunk (true) or the table is done (false)
+     * @return true if the chunk was committed, false otherwise
+     */
+    bool IndexNextChunk(QSqlDatabase &database, qint64 &lastRowId, bool &hasMoreRows, QString &message);
+
+    QString TableName;                   // Table whose text is indexed
+    QStringList ColumnNames;             // Indexed columns in FTS5 column order
+
+    static const int ROWS_PER_CHUNK;     // Rows copied per committed chunk
+};
+
+#endif // SEARCHINDEXTASK_H
@@ -0,0 +1,106 @@
+#ifndef SQLITEFUNCTIONS_H
+#define SQLITEFUNCTIONS_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QRegularExpression>
+
+struct sqlite3;
+struct sqlite3_context;
+struct sqlite3_value;
+
+/**
+ * @brief Application-defined SQL functions registered on every connection
+ * SQLWorker::OpenDatabaseConnection registers them on the native handle, so the
+ * editor connection and all background task connections understand them
+ */
+class SQLiteFunctions
+{
+public:
+    /**
+     * @brief Register all functions on a connection
+     * @param handle Native handle of an open connection
+     * @return true if every function was registered, false otherwise
+     */
+    static bool Register(sqlite3 *handle);
+
+    static const QString APPROX_COUNT_DISTINCT;  // Name of the HyperLogLog distinct count aggregate
+    static const QString REGEXP;                 // Name of the function behind the REGEXP operator
+    static const QString REGEXP_REPLACE;         // Name of the regular expression replace function
+
+private:
+    static constexpr int HLL_PRECISION = 14;  // Index bits of the hash (2^HLL_PRECISION registers, sizes the sketch)
+
+    /**
+     * @brief HyperLogLog sketch kept as the aggregate context of approx_count_distinct
+     * The context is zero-filled by SQLite, which is the empty sketch
+     */
+    struct HyperLogLogState {
+        quint8 Registers[1 << HLL_PRECISION];  // Largest first-set-bit position seen per register
+    };
+
+    /**
+     * @brief Add one value to the sketch (NULLs are ignored like COUNT(DISTINCT))
+     */
+    static void ApproxCountDistinctStep(sqlite3_context *context, int argumentCount, sqlite3_value **arguments);
+
+    /**
+     * @brief Return the cardinality estimate of the sketch
+     */
+    static void ApproxCountDistinctFinal(sqlite3_context *context);
+
+    /**
+     * @brief Implement "text REGEXP pattern", called by SQLite as regexp(pattern, text)
+     * Returns 1 if the pattern matches anywhere in the text, 0 if not, NULL if either is NULL
+     */
+    static void RegexpFunction(sqlite3_context *context, int argumentCount, sqlite3_value **arguments);
+
+    /**
+     * @brief Implement regexp_replace(text, pattern, replacement) replacing every match
+     * The replacement may refer to captures as \1 ... \9
+     */
+    static void RegexpReplaceFunction(sqlite3_context *context, int argumentCount, sqlite3_value **arguments);
+
+    /**
+     * @brief Get the compiled pattern of an argument, compiling it unless cached for the statement
+     * @param context Function call context
+     * @param argumentIndex Index of the pattern argument
+     * @param pattern Pattern value
+     * @param cached Output flag: true if the pattern came from the statement cache
+     * @return Compiled pattern (owned by the caller unless cached), nullptr after reporting an invalid pattern
+     */
+    static QRegularExpression *GetPattern(sqlite3_context *context, int argumentIndex, sqlite3_value *pattern, bool &cached);
+
+    /**
+     * @brief Hand a freshly compiled pattern to SQLite's statement cache
+     * Must be the last use of the pointer, since SQLite may delete it immediately
+     */
+    static void CachePattern(sqlite3_context *context, int argumentIndex, QRegularExpression *expression);
+
+    /**
+     * @brief Destructor callback of cached patterns
+     */
+    static void DeletePattern(void *expression);
+
+    /**
+     * @brief Hash a SQL value so equal values compare equal as in GROUP BY
+     * Integral REAL values hash like the INTEGER of the same value, TEXT and BLOB are
+     * hashed over their bytes with different seeds
+     * @return 64-bit hash of the value
+     */
+    static quint64 HashValue(sqlite3_value *value);
+
+    /**
+     * @brief Hash a byte range (64-bit FNV-1a followed by a SplitMix64 finalizer)
+     * @return 64-bit hash of the bytes
+     */
+    static quint64 HashBytes(const unsigned char *data, int length, quint64 seed);
+
+    /**
+     * @brief Spread the bits of a 64-bit value (SplitMix64 finalizer)
+     * @return Mixed value
+     */
+    static quint64 MixBits(quint64 value);
+};
+
+#endif // SQLITEFUNCTIONS_H
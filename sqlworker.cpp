@@ -1,13 +1,34 @@
 #include "sqlworker.h"
+#include "sqlitefunctions.h"
+#include "jsonlinesreader.h"
 #include <QUuid>
 #include <QSqlDriver>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <sqlite3.h>
+#include <cstdio>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
 
 // Define SQL query constants
 const QString SQLWorker::GET_TABLES_QUERY = "SELECT name FROM sqlite_master WHERE type='table' AND name NOT LIKE 'sqlite_%'";
 const QString SQLWorker::GET_COLUMNS_QUERY = "PRAGMA table_info(%1)";
 const QString SQLWorker::SELECT_ALL_QUERY = "SELECT * FROM %1";
+const QString SQLWorker::SELECT_PROJECTION_QUERY = "SELECT rowid, %1 FROM %2";
 const QString SQLWorker::DELETE_ALL_QUERY = "DELETE FROM %1";
 const QString SQLWorker::INSERT_QUERY_TEMPLATE = "INSERT INTO %1 (%2) VALUES (%3)";
+const int SQLWorker::BUSY_TIMEOUT_MS = 5000;
+const int SQLWorker::ROW_ID_ROLE = Qt::UserRole;
+const int SQLWorker::COLUMN_LOADED_ROLE = Qt::UserRole + 1;
+const int SQLWorker::ROW_ALLOCATION_BLOCK = 1024;
+const int SQLWorker::PAGE_SIZE = 1000;
+const int SQLWorker::JUMP_CONTEXT_ROWS = 50;
+const int SQLWorker::ROW_ID_BATCH_SIZE = 500;
+const int SQLWorker::IMPORT_BATCH_ROWS = 10000;
+const QString SQLWorker::SEARCH_INDEX_SCHEMA = "search";
+const QString SQLWorker::SEARCH_INDEX_META_TABLE = "index_meta";
 
 /**
  * @brief Constructor initializes SQLWorker with default values
@@ -18,6 +39,17 @@ SQLWorker::SQLWorker()
     , FileLoaded(false)                // File loading status flag
     , ConnectionName("")               // Unique connection name
     , TableBackups()                   // Backup storage for rollback functionality
+    , ChangedTables()                  // Tables pending maintenance
+    , LoadedRowIds()                   // Row ids displayed per table
+    , SchemaCache()                    // Cached table schemas
+    , ViewStates()                     // Keyset scan position per table
+    , TableFilters()                   // Active filter per table
+    , TableSorts()                     // Active sort per table
+    , SearchIndexColumns()             // Indexed columns per table
+    , TableSearches()                  // Active full-text search per table
+    , SearchIndexAttached(false)       // Search index attachment flag
+    , OriginalJournalMode("")          // Journal mode not changed
+    , LocalCommitCount(0)              // Commits made through this worker
 {
     // Generate unique connection name for this worker instance
     ConnectionName = GenerateConnectionName();
@@ -30,6 +62,7 @@ SQLWorker::~SQLWorker()
 {
     // Close database connection if open
     if (SqlDatabase.isOpen()) {
+        RestoreJournalMode();
         SqlDatabase.close();
     }
 
@@ -54,6 +87,7 @@ bool SQLWorker::LoadSQLFile(const QString &filePath)
 
     // Close existing connection if open
     if (SqlDatabase.isOpen()) {
+        RestoreJournalMode();
         SqlDatabase.close();
     }
 
@@ -62,14 +96,9 @@ bool SQLWorker::LoadSQLFile(const QString &filePath)
         QSqlDatabase::removeDatabase(ConnectionName);
     }
 
-    // Create new SQLite database connection
-    SqlDatabase = QSqlDatabase::addDatabase("QSQLITE", ConnectionName);
-    SqlDatabase.setDatabaseName(filePath);
-
-    // Attempt to open the database
-    if (!SqlDatabase.open()) {
-        qDebug() << "Error: Cannot open database file" << filePath;
-        qDebug() << "Database error:" << SqlDatabase.lastError().text();
+    // Create and open new SQLite database connection
+    SqlDatabase = OpenDatabaseConnection(filePath, ConnectionName);
+    if (!SqlDatabase.isOpen()) {
         return false;
     }
 
@@ -82,8 +111,17 @@ bool SQLWorker::LoadSQLFile(const QString &filePath)
 
     // Store file path and extract table information
     CurrentFilePath = filePath;
+    ChangedTables.clear();
+    LoadedRowIds.clear();
+    SchemaCache.clear();
+    ViewStates.clear();
+    TableFilters.clear();
+    TableSorts.clear();
+    TableSearches.clear();
+    SearchIndexAttached = false;
     ParseSQLStructure();
     FileLoaded = true;
+    ReloadSearchIndexes();
 
     qDebug() << "Successfully loaded SQL database file:" << filePath;
     qDebug() << "Found" << AvailableTableNames.size() << "tables";
@@ -103,9 +141,20 @@ QStringList SQLWorker::GetTableNames() const
  * @brief Load specific table data into provided QTableWidget
  * @param tableName Name of the table to load (must exist in database)
  * @param tableWidget Pointer to QTableWidget that will display the data
+ * @param hiddenColumns Columns that are hidden and therefore not fetched
+ * @param maxLoadedColumns Maximum number of visible columns fetched now (-1 for all)
  * @return true if data loaded successfully, false on error
  */
-bool SQLWorker::LoadTableData(const QString &tableName, QTableWidget *tableWidget)
+bool SQLWorker::LoadTableData(const QString &tableName, QTableWidget *tableWidget, const QStringList &hiddenColumns, int maxLoadedColumns)
+{
+    return LoadTableWindow(tableName, tableWidget, hiddenColumns, maxLoadedColumns, TableViewState());
+}
+
+/**
+ * @brief Load a table into the widget, starting the keyset scan at a given position
+ */
+bool SQLWorker::LoadTableWindow(const QString &tableName, QTableWidget *tableWidget, const QStringList &hiddenColumns,
+                                int maxLoadedColumns, const TableViewState &startState)
 {
     // Validate input parameters
     if (!FileLoaded || tableName.isEmpty() || !tableWidget) {
@@ -120,157 +169,1405 @@ bool SQLWorker::LoadTableData(const QString &tableName, QTableWidget *tableWidge
     }
 
     // Get column information for the table
-    QStringList _columnNames = GetTableColumns(tableName);  // List of column names from table schema
+    TableSchema _schema = GetTableSchema(tableName);  // Cached column names and row id support
+    QStringList _columnNames = _schema.ColumnNames;   // List of column names from table schema
     if (_columnNames.isEmpty()) {
         qDebug() << "Error: Could not retrieve column information for table" << tableName;
         return false;
     }
 
-    // Prepare and execute query to get all table data
-    QSqlQuery _query(SqlDatabase);  // Query object for executing SQL commands
-    QString _queryString = SELECT_ALL_QUERY.arg(tableName);  // Complete SELECT query string
-
-    if (!_query.exec(_queryString)) {
-        qDebug() << "Error: Failed to execute query:" << _queryString;
-        qDebug() << "SQL error:" << _query.lastError().text();
-        return false;
+    // Choose the leading visible columns for the projection; tables without row ids fetch
+    // every column since missing ones could not be fetched later
+    QSet<QString> _hiddenSet(hiddenColumns.begin(), hiddenColumns.end());  // Hidden column names for fast lookup
+    QVector<bool> _loadedColumns(_columnNames.size(), !_schema.HasRowId);  // Column index -> part of the projection
+    int _projectedCount = 0;  // Number of visible columns chosen so far
+    for (int _col = 0; _schema.HasRowId && _col < _columnNames.size(); ++_col) {  // Current column index (0-based)
+        if (maxLoadedColumns >= 0 && _projectedCount >= maxLoadedColumns) {
+            break;  // Remaining columns are fetched when scrolled into view
+        }
+        if (!_hiddenSet.contains(_columnNames[_col])) {
+            _loadedColumns[_col] = true;
+            _projectedCount++;
+        }
     }
 
-    // Configure table widget dimensions
+    // Configure table widget dimensions; header labels come from the schema cache
+    tableWidget->setUpdatesEnabled(false);
     tableWidget->clear();
+    tableWidget->setRowCount(0);
     tableWidget->setColumnCount(_columnNames.size());
     tableWidget->setHorizontalHeaderLabels(_columnNames);
 
-    // Load data into table widget
-    int _rowIndex = 0;  // Current row index being processed (0-based)
+    // Mark which columns hold fetched values and hide the ones the user hid
+    for (int _col = 0; _col < _columnNames.size(); ++_col) {  // Current column index (0-based)
+        tableWidget->horizontalHeaderItem(_col)->setData(COLUMN_LOADED_ROLE, _loadedColumns[_col]);
+        tableWidget->setColumnHidden(_col, _hiddenSet.contains(_columnNames[_col]));
+    }
+
+    // Start the keyset scan for this table (from the first row unless jumping to a key)
+    ViewStates[tableName] = _schema.HasRowId ? startState : TableViewState();
+
+    int _rowCount = -1;  // Rows loaded into the widget (-1 on error)
+    if (_schema.HasRowId) {
+        // Row ids drive paging and how changes are written back
+        LoadedRowIds[tableName] = QSet<qint64>();
+        _rowCount = AppendRowsPage(tableName, tableWidget);
+    } else {
+        // Without row ids the whole table is loaded and replaced on save
+        LoadedRowIds.remove(tableName);
+        _rowCount = AppendAllRowsWithoutRowId(tableName, tableWidget);
+    }
+
+    tableWidget->setUpdatesEnabled(true);
+
+    if (_rowCount < 0) {
+        return false;
+    }
+
+    qDebug() << "Loaded table" << tableName << "with" << _rowCount << "rows and"
+             << _loadedColumns.count(true) << "of" << _columnNames.size() << "columns"
+             << (ViewStates[tableName].HasMoreRows ? "(more rows available)" : "");
+    return true;
+}
+
+/**
+ * @brief Append the next page of rows to a table loaded by LoadTableData
+ * @param tableName Name of the table displayed in the widget
+ * @param tableWidget Pointer to QTableWidget previously filled by LoadTableData
+ * @return Number of rows appended, or -1 on error
+ */
+int SQLWorker::FetchNextPage(const QString &tableName, QTableWidget *tableWidget)
+{
+    if (!FileLoaded || tableName.isEmpty() || !tableWidget || !HasMoreRows(tableName)) {
+        return 0;
+    }
+
+    tableWidget->setUpdatesEnabled(false);
+    int _rowCount = AppendRowsPage(tableName, tableWidget);  // Rows appended by this page
+    tableWidget->setUpdatesEnabled(true);
+
+    return _rowCount;
+}
+
+/**
+ * @brief Check if the keyset scan of a table has rows left to fetch
+ */
+bool SQLWorker::HasMoreRows(const QString &tableName) const
+{
+    return ViewStates.value(tableName).HasMoreRows;
+}
+
+/**
+ * @brief Replace the filter conditions of a table
+ * @param tableName Name of the table to filter
+ * @param expressions Column name -> filter expression (empty map removes the filter)
+ * @param errorMessage Output description of the first invalid expression
+ * @return true if all expressions were valid, false otherwise (previous filter is kept)
+ */
+bool SQLWorker::SetTableFilter(const QString &tableName, const QMap<QString, QString> &expressions, QString &errorMessage)
+{
+    TableFilter _filter;  // New filter built from the expressions
+
+    for (auto _it = expressions.constBegin(); _it != expressions.constEnd(); ++_it) {  // Each filtered column
+        if (!_filter.SetColumnExpression(_it.key(), _it.value(), errorMessage)) {
+            return false;
+        }
+    }
+
+    if (_filter.IsEmpty()) {
+        TableFilters.remove(tableName);
+    } else {
+        TableFilters.insert(tableName, _filter);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check if a filter is active for a table
+ */
+bool SQLWorker::IsTableFiltered(const QString &tableName) const
+{
+    return TableFilters.contains(tableName);
+}
+
+/**
+ * @brief Get the active filter of a table
+ */
+TableFilter SQLWorker::GetTableFilter(const QString &tableName) const
+{
+    return TableFilters.value(tableName);
+}
+
+/**
+ * @brief Replace the sort keys of a table (applied on the next LoadTableData)
+ * @param tableName Name of the table to sort
+ * @param sortKeys Sort columns in priority order (empty list restores rowid order)
+ * @return true if all sort columns exist, false otherwise (previous sort is kept)
+ */
+bool SQLWorker::SetTableSort(const QString &tableName, const QList<SortKey> &sortKeys)
+{
+    QStringList _columnNames = GetTableColumns(tableName);  // Valid column names of the table
+    for (const SortKey &_key : sortKeys) {
+        if (!_columnNames.contains(_key.ColumnName)) {
+            qDebug() << "Error: Cannot sort table" << tableName << "by unknown column" << _key.ColumnName;
+            return false;
+        }
+    }
+
+    if (sortKeys.isEmpty()) {
+        TableSorts.remove(tableName);
+    } else {
+        TableSorts.insert(tableName, sortKeys);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get the sort keys of a table
+ */
+QList<SQLWorker::SortKey> SQLWorker::GetTableSort(const QString &tableName) const
+{
+    return TableSorts.value(tableName);
+}
+
+/**
+ * @brief Restrict a table to the rows matching a full-text search
+ * @param tableName Name of a table with a search index
+ * @param searchText Terms to search for (empty text removes the search)
+ * @return true if the search was set, false if the table has no search index
+ */
+bool SQLWorker::SetTableSearch(const QString &tableName, const QString &searchText)
+{
+    QStringList _terms = searchText.split(' ', Qt::SkipEmptyParts);  // Whitespace separated search terms
+    if (_terms.isEmpty()) {
+        TableSearches.remove(tableName);
+        return true;
+    }
+
+    if (!SearchIndexColumns.contains(tableName)) {
+        qDebug() << "Error: Table" << tableName << "has no search index";
+        return false;
+    }
+
+    // Quote every term so operators and punctuation in IDs or error strings are matched literally
+    QStringList _phrases;  // FTS5 phrases, implicitly combined with AND
+    for (QString _term : _terms) {
+        bool _prefix = _term.endsWith('*');  // Trailing * requests a prefix match
+        if (_prefix) {
+            _term.chop(1);
+        }
+        if (_term.isEmpty()) {
+            continue;
+        }
+        _term.replace('"', "\"\"");
+        _phrases.append('"' + _term + '"' + (_prefix ? "*" : ""));
+    }
+
+    if (_phrases.isEmpty()) {
+        TableSearches.remove(tableName);
+    } else {
+        TableSearches.insert(tableName, _phrases.join(' '));
+    }
+    return true;
+}
+
+/**
+ * @brief Check if a full-text search is active for a table
+ */
+bool SQLWorker::IsTableSearched(const QString &tableName) const
+{
+    return TableSearches.contains(tableName);
+}
+
+/**
+ * @brief Get the columns covered by the search index of a table
+ */
+QStringList SQLWorker::GetSearchIndexColumns(const QString &tableName) const
+{
+    return SearchIndexColumns.value(tableName);
+}
+
+/**
+ * @brief Attach the search index file (if any) and re-read which tables it covers
+ */
+void SQLWorker::ReloadSearchIndexes()
+{
+    SearchIndexColumns.clear();
+    if (!FileLoaded || !AttachSearchIndex()) {
+        TableSearches.clear();
+        return;
+    }
+
+    QSqlQuery _query(SqlDatabase);  // Query object for reading the index list
+    QString _queryString = QString("SELECT table_name, column_names FROM %1.%2")
+                               .arg(SEARCH_INDEX_SCHEMA, QuoteIdentifier(SEARCH_INDEX_META_TABLE));  // Complete SELECT query string
+    if (!_query.exec(_queryString)) {
+        // A file without the list has no finished index yet
+        TableSearches.clear();
+        return;
+    }
+
+    while (_query.next()) {  // One row per finished index
+        QStringList _columns;  // Indexed source columns in FTS5 column order
+        for (const QJsonValue &_column : QJsonDocument::fromJson(_query.value(1).toString().toUtf8()).array()) {
+            _columns.append(_column.toString());
+        }
+        if (!_columns.isEmpty()) {
+            SearchIndexColumns.insert(_query.value(0).toString(), _columns);
+        }
+    }
+
+    // Searches on tables whose index disappeared cannot be applied any more
+    for (const QString &_tableName : TableSearches.keys()) {
+        if (!SearchIndexColumns.contains(_tableName)) {
+            TableSearches.remove(_tableName);
+        }
+    }
+
+    qDebug() << "Search index covers tables:" << SearchIndexColumns.keys();
+}
+
+/**
+ * @brief Get the columns of a table with text affinity
+ */
+QStringList SQLWorker::GetTextColumns(const QString &tableName)
+{
+    TableSchema _schema = GetTableSchema(tableName);  // Column names and declared types
+    QStringList _textColumns;  // Columns with text affinity
+
+    for (int _col = 0; _col < _schema.ColumnNames.size(); ++_col) {  // Current column index (0-based)
+        QString _type = _schema.ColumnTypes.value(_col).toUpper();  // Declared type in upper case
+        if (_type.isEmpty() || _type.contains("CHAR") || _type.contains("CLOB") || _type.contains("TEXT")) {
+            _textColumns.append(_schema.ColumnNames[_col]);
+        }
+    }
+
+    return _textColumns;
+}
+
+/**
+ * @brief Get the declared types of the columns of a table
+ */
+QStringList SQLWorker::GetTableColumnTypes(const QString &tableName)
+{
+    return GetTableSchema(tableName).ColumnTypes;
+}
+
+/**
+ * @brief Get the side database holding the full-text indexes of a database file
+ */
+QString SQLWorker::GetSearchIndexFilePath(const QString &filePath)
+{
+    return filePath + ".search";
+}
+
+/**
+ * @brief Get the FTS5 table indexing a table in the search index file
+ */
+QString SQLWorker::GetSearchIndexTableName(const QString &tableName)
+{
+    return "fts_" + tableName;
+}
+
+/**
+ * @brief Get the FTS5 column names used for the indexed columns
+ */
+QStringList SQLWorker::GetSearchIndexColumnNames(int columnCount)
+{
+    QStringList _names;  // c0, c1, ... in index column order
+    for (int _i = 0; _i < columnCount; ++_i) {
+        _names.append(QString("c%1").arg(_i));
+    }
+    return _names;
+}
+
+/**
+ * @brief Build the ORDER BY terms for a sort, ending with the rowid tiebreaker
+ * The tiebreaker follows the direction of the primary key so single-direction sorts stay index friendly
+ */
+QString SQLWorker::BuildOrderByClause(const QList<SortKey> &sortKeys)
+{
+    QStringList _terms;  // "column ASC|DESC" per sort key
+    for (const SortKey &_key : sortKeys) {
+        _terms.append(QuoteIdentifier(_key.ColumnName) + (_key.Order == Qt::AscendingOrder ? " ASC" : " DESC"));
+    }
+
+    bool _descendingRowId = !sortKeys.isEmpty() && sortKeys.first().Order == Qt::DescendingOrder;  // Tiebreaker direction
+    _terms.append(_descendingRowId ? "rowid DESC" : "rowid ASC");
+    return _terms.join(", ");
+}
+
+/**
+ * @brief Build the condition selecting rows after a (sort key, rowid) keyset position
+ * SQLite sorts NULL before any value, so NULL keys need explicit IS / IS NOT NULL terms
+ */
+QString SQLWorker::BuildKeysetCondition(const QList<SortKey> &sortKeys, const QVariantList &lastValues,
+                                        qint64 lastRowId, QVariantList &bindValues)
+{
+    bool _descendingRowId = !sortKeys.isEmpty() && sortKeys.first().Order == Qt::DescendingOrder;  // Tiebreaker direction
+
+    // Fast path: ascending keys with non-NULL values allow a row value comparison the index can seek on
+    // (descending keys are excluded because NULL rows follow them and compare as unknown)
+    bool _rowValueComparable = true;  // Position can be expressed as (keys..., rowid) > (values..., id)
+    for (int _i = 0; _i < sortKeys.size(); ++_i) {
+        if (sortKeys[_i].Order == Qt::DescendingOrder || lastValues.value(_i).isNull()) {
+            _rowValueComparable = false;
+        }
+    }
+    if (_rowValueComparable) {
+        QStringList _columns;       // Quoted sort columns followed by rowid
+        QStringList _placeholders;  // One placeholder per column
+        for (int _i = 0; _i < sortKeys.size(); ++_i) {
+            _columns.append(QuoteIdentifier(sortKeys[_i].ColumnName));
+            _placeholders.append("?");
+            bindValues.append(lastValues.value(_i));
+        }
+        _columns.append("rowid");
+        _placeholders.append("?");
+        bindValues.append(lastRowId);
+
+        if (_columns.size() == 1) {
+            return "rowid > ?";
+        }
+        return QString("(%1) > (%2)").arg(_columns.join(", "), _placeholders.join(", "));
+    }
+
+    // General case: key i is past its value while all earlier keys are equal
+    QStringList _alternatives;  // One OR branch per sort key plus the rowid branch
+    QStringList _equalPrefix;   // "key IS ?" terms of the earlier keys
+    QVariantList _equalValues;  // Values bound by the equal prefix
+
+    for (int _i = 0; _i < sortKeys.size(); ++_i) {  // Current sort key (0-based)
+        QString _column = QuoteIdentifier(sortKeys[_i].ColumnName);  // Quoted sort column
+        QVariant _value = lastValues.value(_i);                       // Sort key value of the last row
+        bool _descending = sortKeys[_i].Order == Qt::DescendingOrder;  // Direction of this key
+
+        QString _after;           // Condition for rows strictly after the value in this direction
+        QVariantList _afterValues;  // Values bound by _after
+        if (_value.isNull()) {
+            _after = _descending ? QString() : _column + " IS NOT NULL";  // Nothing follows NULL in descending order
+        } else if (_descending) {
+            _after = QString("(%1 < ? OR %1 IS NULL)").arg(_column);
+            _afterValues.append(_value);
+        } else {
+            _after = _column + " > ?";
+            _afterValues.append(_value);
+        }
+
+        if (!_after.isEmpty()) {
+            QStringList _branch = _equalPrefix;  // Earlier keys equal, this key after
+            _branch.append(_after);
+            _alternatives.append("(" + _branch.join(" AND ") + ")");
+            bindValues.append(_equalValues);
+            bindValues.append(_afterValues);
+        }
+
+        _equalPrefix.append(_column + " IS ?");
+        _equalValues.append(_value);
+    }
+
+    // All keys equal: continue by rowid
+    QStringList _branch = _equalPrefix;  // Every key equal, rowid after
+    _branch.append(_descendingRowId ? "rowid < ?" : "rowid > ?");
+    _alternatives.append("(" + _branch.join(" AND ") + ")");
+    bindValues.append(_equalValues);
+    bindValues.append(lastRowId);
+
+    return _alternatives.join(" OR ");
+}
+
+/**
+ * @brief Append one keyset page of rows matching the table filter
+ */
+int SQLWorker::AppendRowsPage(const QString &tableName, QTableWidget *tableWidget)
+{
+    TableViewState &_state = ViewStates[tableName];  // Keyset position of the table scan
+
+    // Project the columns that are currently loaded in the widget
+    QStringList _projection;       // Quoted column names included in the SELECT list
+    QList<int> _projectedIndexes;  // Widget column index of each projected column
+    for (int _col = 0; _col < tableWidget->columnCount(); ++_col) {  // Current column index (0-based)
+        if (IsColumnLoaded(tableWidget, _col) && tableWidget->horizontalHeaderItem(_col)) {
+            _projection.append(QuoteIdentifier(tableWidget->horizontalHeaderItem(_col)->text()));
+            _projectedIndexes.append(_col);
+        }
+    }
+
+    // Combine the user filter with the keyset continuation so each page starts where the last one ended
+    QStringList _conditions;   // WHERE clause parts joined with AND
+    QVariantList _bindValues;  // Values for the placeholders in order
+    AppendViewConditions(tableName, _conditions, _bindValues);
+    const QList<SortKey> _sortKeys = TableSorts.value(tableName);  // Active sort (empty means rowid order)
+    if (_state.HasLastRow) {
+        _conditions.append("(" + BuildKeysetCondition(_sortKeys, _state.LastSortValues, _state.LastRowId, _bindValues) + ")");
+    }
+
+    // Sort key values are selected after the projection so the next page can continue from them
+    QStringList _selectList = _projection;  // Projection followed by the sort key columns
+    if (_selectList.isEmpty()) {
+        _selectList.append("NULL");
+    }
+    int _sortValueOffset = 1 + _selectList.size();  // Result index of the first sort key value
+    for (const SortKey &_key : _sortKeys) {
+        _selectList.append(QuoteIdentifier(_key.ColumnName));
+    }
+
+    QString _queryString = SELECT_PROJECTION_QUERY.arg(_selectList.join(", "), QuoteIdentifier(tableName));  // Complete SELECT query string
+    if (!_conditions.isEmpty()) {
+        _queryString += " WHERE " + _conditions.join(" AND ");
+    }
+    _queryString += QString(" ORDER BY %1 LIMIT %2").arg(BuildOrderByClause(_sortKeys)).arg(PAGE_SIZE);
+
+    QSqlQuery _query(SqlDatabase);  // Query object for the page
+    _query.setForwardOnly(true);
+    if (!_query.prepare(_queryString)) {
+        qDebug() << "Error: Failed to prepare page query:" << _queryString;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return -1;
+    }
+    for (int _i = 0; _i < _bindValues.size(); ++_i) {
+        _query.bindValue(_i, _bindValues[_i]);
+    }
+    if (!_query.exec()) {
+        qDebug() << "Error: Failed to execute page query:" << _queryString;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return -1;
+    }
+
+    QSet<qint64> &_loadedRowIds = LoadedRowIds[tableName];  // Row ids displayed in the widget
+    int _rowIndex = tableWidget->rowCount();  // Next widget row to fill
+    int _firstRow = _rowIndex;                // Widget row of the first row of this page
 
     while (_query.next()) {  // Iterate through all rows returned by query
-        tableWidget->insertRow(_rowIndex);  // Add new row to table widget
+        // Grow the widget in blocks; inserting rows one by one re-lays out every column each time
+        if (_rowIndex >= tableWidget->rowCount()) {
+            tableWidget->setRowCount(_rowIndex + ROW_ALLOCATION_BLOCK);
+        }
 
-        // Process each column in current row
-        for (int _col = 0; _col < _columnNames.size(); ++_col) {  // Current column index (0-based)
-            QVariant _cellValue = _query.value(_col);  // Raw cell value from database
-            QString _cellText = _cellValue.toString();  // Convert to string for display
+        qint64 _rowId = _query.value(0).toLongLong();  // Row id identifying this row in the database
+        QTableWidgetItem *_headerItem = new QTableWidgetItem(QString::number(_state.FirstRowPosition + _rowIndex + 1));  // Row header carrying the row id
+        _headerItem->setData(ROW_ID_ROLE, _rowId);
+        tableWidget->setVerticalHeaderItem(_rowIndex, _headerItem);
+        _loadedRowIds.insert(_rowId);
 
-            QTableWidgetItem *_item = new QTableWidgetItem(_cellText);  // Table cell item containing database cell data
-            tableWidget->setItem(_rowIndex, _col, _item);
+        // Process each projected column in current row
+        for (int _i = 0; _i < _projectedIndexes.size(); ++_i) {  // Current projected column (0-based)
+            QTableWidgetItem *_item = new QTableWidgetItem(_query.value(_i + 1).toString());  // Table cell item containing database cell data
+            tableWidget->setItem(_rowIndex, _projectedIndexes[_i], _item);
         }
 
+        _state.LastRowId = _rowId;
+        _state.LastSortValues.clear();
+        for (int _i = 0; _i < _sortKeys.size(); ++_i) {  // Remember the sort key of the last row for the next page
+            _state.LastSortValues.append(_query.value(_sortValueOffset + _i));
+        }
+        _state.HasLastRow = true;
         _rowIndex++;  // Move to next row
     }
 
-    tableWidget->setRowCount(_rowIndex);
-
-    qDebug() << "Loaded table" << tableName << "with" << _rowIndex << "rows";
-    return true;
+    tableWidget->setRowCount(_rowIndex);
+
+    int _fetchedRows = _rowIndex - _firstRow;  // Rows appended by this page
+    _state.HasMoreRows = (_fetchedRows == PAGE_SIZE);
+    return _fetchedRows;
+}
+
+/**
+ * @brief Append the filter and search conditions of a table
+ */
+void SQLWorker::AppendViewConditions(const QString &tableName, QStringList &conditions, QVariantList &bindValues) const
+{
+    const TableFilter _filter = TableFilters.value(tableName);  // Active filter (empty if none)
+    if (!_filter.IsEmpty()) {
+        conditions.append("(" + _filter.BuildWhereClause() + ")");
+        bindValues.append(_filter.GetBindValues());
+    }
+    if (TableSearches.contains(tableName)) {
+        // The FTS5 lookup yields the matching row ids, which the rowid IN list seeks directly
+        QString _indexTable = GetSearchIndexTableName(tableName);  // FTS5 table of this table
+        conditions.append(QString("rowid IN (SELECT rowid FROM %1.%2 WHERE %2 MATCH ?)")
+                              .arg(SEARCH_INDEX_SCHEMA, QuoteIdentifier(_indexTable)));
+        bindValues.append(TableSearches.value(tableName));
+    }
+}
+
+/**
+ * @brief Load the page of a table around one row under the current sort, filter and search
+ * Rows before the target in the view order are the rows after it in the reversed order, so
+ * the keyset condition of the reversed sort both counts them and finds where the page starts
+ */
+bool SQLWorker::LoadTableAroundKey(const QString &tableName, QTableWidget *tableWidget, const QString &key, bool keyIsRowId,
+                                   const QStringList &hiddenColumns, int maxLoadedColumns, int &targetRow, QString &errorMessage)
+{
+    if (!FileLoaded || tableName.isEmpty() || !tableWidget || key.trimmed().isEmpty()) {
+        errorMessage = "No key entered";
+        return false;
+    }
+
+    TableSchema _schema = GetTableSchema(tableName);  // Cached column names and key information
+    if (!_schema.HasRowId) {
+        errorMessage = QString("Table %1 has no row ids").arg(tableName);
+        return false;
+    }
+
+    qint64 _rowId = 0;  // Row id of the requested row
+    if (!FindRowIdByKey(tableName, _schema, key.trimmed(), keyIsRowId, _rowId)) {
+        errorMessage = QString("No row with key %1").arg(key.trimmed());
+        return false;
+    }
+
+    QStringList _conditions;   // Filter and search conditions of the view
+    QVariantList _bindValues;  // Values for the placeholders in order
+    AppendViewConditions(tableName, _conditions, _bindValues);
+    const QList<SortKey> _sortKeys = TableSorts.value(tableName);  // Active sort (empty means rowid order)
+
+    // Read the sort key of the target, which also checks that the view includes it
+    QStringList _sortColumns;  // Quoted sort columns
+    for (const SortKey &_key : _sortKeys) {
+        _sortColumns.append(QuoteIdentifier(_key.ColumnName));
+    }
+    QSqlQuery _query(SqlDatabase);  // Query object for the lookups
+    _query.setForwardOnly(true);
+    QString _queryString = QString("SELECT %1 FROM %2 WHERE %3")
+                               .arg(_sortColumns.isEmpty() ? QString("NULL") : _sortColumns.join(", "), QuoteIdentifier(tableName),
+                                    (_conditions + QStringList("rowid = ?")).join(" AND "));  // Target lookup query string
+    _query.prepare(_queryString);
+    for (int _i = 0; _i < _bindValues.size(); ++_i) {
+        _query.bindValue(_i, _bindValues[_i]);
+    }
+    _query.bindValue(_bindValues.size(), _rowId);
+    if (!_query.exec()) {
+        qDebug() << "Error: Failed to look up row" << _rowId << "of table" << tableName;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        errorMessage = "Failed to look up the row";
+        return false;
+    }
+    if (!_query.next()) {
+        errorMessage = QString("Row with key %1 is hidden by the current filter or search").arg(key.trimmed());
+        return false;
+    }
+    QVariantList _targetValues;  // Sort key values of the target
+    for (int _i = 0; _i < _sortKeys.size(); ++_i) {
+        _targetValues.append(_query.value(_i));
+    }
+    _query.finish();
+
+    // Reversed sort; without sort keys the view is in rowid order, which BuildOrderByClause cannot reverse
+    QList<SortKey> _reversedKeys;  // Sort keys with flipped directions
+    for (const SortKey &_key : _sortKeys) {
+        _reversedKeys.append({_key.ColumnName, _key.Order == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder});
+    }
+    QStringList _beforeConditions = _conditions;  // View conditions plus "before the target"
+    QVariantList _beforeValues = _bindValues;     // Values of _beforeConditions
+    QString _reversedOrder;  // ORDER BY terms walking backwards from the target
+    if (_sortKeys.isEmpty()) {
+        _beforeConditions.append("rowid < ?");
+        _beforeValues.append(_rowId);
+        _reversedOrder = "rowid DESC";
+    } else {
+        _beforeConditions.append("(" + BuildKeysetCondition(_reversedKeys, _targetValues, _rowId, _beforeValues) + ")");
+        _reversedOrder = BuildOrderByClause(_reversedKeys);
+    }
+
+    // Position of the target within the view
+    _queryString = QString("SELECT COUNT(*) FROM %1 WHERE %2").arg(QuoteIdentifier(tableName), _beforeConditions.join(" AND "));
+    _query.prepare(_queryString);
+    for (int _i = 0; _i < _beforeValues.size(); ++_i) {
+        _query.bindValue(_i, _beforeValues[_i]);
+    }
+    if (!_query.exec() || !_query.next()) {
+        qDebug() << "Error: Failed to count rows before row" << _rowId << "of table" << tableName;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        errorMessage = "Failed to locate the row";
+        return false;
+    }
+    qint64 _position = _query.value(0).toLongLong();  // Rows before the target
+    _query.finish();
+
+    // The page starts a few rows before the target; the keyset continues after the row preceding it
+    TableViewState _startState;  // Scan position the page is loaded from
+    _startState.FirstRowPosition = qMax<qint64>(0, _position - JUMP_CONTEXT_ROWS);
+    if (_position > JUMP_CONTEXT_ROWS) {
+        _queryString = QString("SELECT rowid%1 FROM %2 WHERE %3 ORDER BY %4 LIMIT 1 OFFSET %5")
+                           .arg(_sortColumns.isEmpty() ? QString() : ", " + _sortColumns.join(", "), QuoteIdentifier(tableName),
+                                _beforeConditions.join(" AND "), _reversedOrder)
+                           .arg(JUMP_CONTEXT_ROWS);
+        _query.prepare(_queryString);
+        for (int _i = 0; _i < _beforeValues.size(); ++_i) {
+            _query.bindValue(_i, _beforeValues[_i]);
+        }
+        if (!_query.exec() || !_query.next()) {
+            qDebug() << "Error: Failed to find the page start before row" << _rowId << "of table" << tableName;
+            qDebug() << "SQL error:" << _query.lastError().text();
+            errorMessage = "Failed to locate the row";
+            return false;
+        }
+        _startState.LastRowId = _query.value(0).toLongLong();
+        for (int _i = 0; _i < _sortKeys.size(); ++_i) {
+            _startState.LastSortValues.append(_query.value(1 + _i));
+        }
+        _startState.HasLastRow = true;
+        _query.finish();
+    }
+
+    if (!LoadTableWindow(tableName, tableWidget, hiddenColumns, maxLoadedColumns, _startState)) {
+        errorMessage = "Failed to load table data";
+        return false;
+    }
+
+    targetRow = static_cast<int>(_position - _startState.FirstRowPosition);
+    if (targetRow >= tableWidget->rowCount()) {
+        errorMessage = "The row changed while the page was loaded";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the position of the first loaded row within the sorted and filtered table
+ */
+qint64 SQLWorker::GetFirstRowPosition(const QString &tableName) const
+{
+    return ViewStates.value(tableName).FirstRowPosition;
+}
+
+/**
+ * @brief Build the query returning every row and column of a table in view order
+ */
+void SQLWorker::BuildTableQuery(const QString &tableName, QString &queryString, QVariantList &bindValues)
+{
+    queryString = SELECT_ALL_QUERY.arg(QuoteIdentifier(tableName));
+    bindValues.clear();
+
+    QStringList _conditions;  // Filter and search conditions of the view
+    AppendViewConditions(tableName, _conditions, bindValues);
+    if (!_conditions.isEmpty()) {
+        queryString += " WHERE " + _conditions.join(" AND ");
+    }
+
+    // Same order as the keyset pages; tables without row ids have no rowid tiebreak
+    const QList<SortKey> _sortKeys = TableSorts.value(tableName);  // Active sort (empty means rowid order)
+    if (GetTableSchema(tableName).HasRowId) {
+        queryString += " ORDER BY " + BuildOrderByClause(_sortKeys);
+    } else if (!_sortKeys.isEmpty()) {
+        QStringList _orderTerms;  // "column ASC|DESC" per sort key
+        for (const SortKey &_key : _sortKeys) {
+            _orderTerms.append(QuoteIdentifier(_key.ColumnName) + (_key.Order == Qt::AscendingOrder ? " ASC" : " DESC"));
+        }
+        queryString += " ORDER BY " + _orderTerms.join(", ");
+    }
+}
+
+/**
+ * @brief Build the query returning the rows of a table within a rowid range in view order
+ */
+bool SQLWorker::BuildTableRangeQuery(const QString &tableName, QString &queryString, QVariantList &bindValues)
+{
+    // The search index is attached to the editor connection only, so searched views stay on it
+    if (!GetTableSchema(tableName).HasRowId || !TableSorts.value(tableName).isEmpty() || TableSearches.contains(tableName)) {
+        return false;
+    }
+
+    bindValues.clear();
+    QStringList _conditions;  // Filter conditions of the view and the rowid range
+    AppendViewConditions(tableName, _conditions, bindValues);
+    _conditions.append("rowid BETWEEN ? AND ?");
+
+    queryString = SELECT_ALL_QUERY.arg(QuoteIdentifier(tableName))
+                  + " WHERE " + _conditions.join(" AND ") + " ORDER BY rowid ASC";
+    return true;
+}
+
+/**
+ * @brief Open a forward-only cursor over every row and column of a table in view order
+ */
+bool SQLWorker::OpenTableCursor(const QString &tableName, QSqlQuery &cursor)
+{
+    if (!FileLoaded || tableName.isEmpty()) {
+        qDebug() << "Error: No table to open a cursor on";
+        return false;
+    }
+
+    QString _queryString;      // Complete SELECT query string
+    QVariantList _bindValues;  // Values for the placeholders in order
+    BuildTableQuery(tableName, _queryString, _bindValues);
+
+    // Forward-only keeps QSqlQuery from caching the rows it has stepped over
+    cursor = QSqlQuery(SqlDatabase);
+    cursor.setForwardOnly(true);
+    if (!cursor.prepare(_queryString)) {
+        qDebug() << "Error: Failed to prepare query:" << _queryString;
+        qDebug() << "SQL error:" << cursor.lastError().text();
+        return false;
+    }
+    for (int _i = 0; _i < _bindValues.size(); ++_i) {
+        cursor.bindValue(_i, _bindValues[_i]);
+    }
+
+    if (!cursor.exec()) {
+        qDebug() << "Error: Failed to execute query:" << _queryString;
+        qDebug() << "SQL error:" << cursor.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Prepare a native SQLite statement on a connection and bind its values
+ */
+bool SQLWorker::PrepareNativeStatement(const QSqlDatabase &database, const QString &queryString, const QVariantList &bindValues,
+                                       sqlite3_stmt *&statement)
+{
+    statement = nullptr;
+    sqlite3 *_handle = GetNativeHandle(database);  // Connection the statement runs on
+    if (!_handle) {
+        qDebug() << "Error: No native handle for the database connection";
+        return false;
+    }
+    QByteArray _query = queryString.toUtf8();  // Query in UTF-8
+    if (sqlite3_prepare_v2(_handle, _query.constData(), _query.size(), &statement, nullptr) != SQLITE_OK) {
+        qDebug() << "Error: Failed to prepare query:" << queryString;
+        qDebug() << "SQL error:" << sqlite3_errmsg(_handle);
+        sqlite3_finalize(statement);
+        statement = nullptr;
+        return false;
+    }
+
+    for (int _i = 0; _i < bindValues.size(); ++_i) {
+        const QVariant &_value = bindValues[_i];  // Value of placeholder _i + 1
+        int _result = SQLITE_OK;                   // Result of the bind call
+        switch (_value.isNull() ? QMetaType::UnknownType : _value.userType()) {
+        case QMetaType::UnknownType:
+            _result = sqlite3_bind_null(statement, _i + 1);
+            break;
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Bool:
+            _result = sqlite3_bind_int64(statement, _i + 1, _value.toLongLong());
+            break;
+        case QMetaType::Double:
+            _result = sqlite3_bind_double(statement, _i + 1, _value.toDouble());
+            break;
+        case QMetaType::QByteArray: {
+            QByteArray _bytes = _value.toByteArray();  // Blob value
+            _result = sqlite3_bind_blob(statement, _i + 1, _bytes.constData(), _bytes.size(), SQLITE_TRANSIENT);
+            break;
+        }
+        default: {
+            QByteArray _text = _value.toString().toUtf8();  // Text value
+            _result = sqlite3_bind_text(statement, _i + 1, _text.constData(), _text.size(), SQLITE_TRANSIENT);
+            break;
+        }
+        }
+        if (_result != SQLITE_OK) {
+            qDebug() << "Error: Failed to bind value" << _i << "of query:" << queryString;
+            qDebug() << "SQL error:" << sqlite3_errmsg(_handle);
+            sqlite3_finalize(statement);
+            statement = nullptr;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Find the rowid of a row by single-column primary key, falling back to the rowid itself
+ */
+bool SQLWorker::FindRowIdByKey(const QString &tableName, const TableSchema &schema, const QString &key, bool keyIsRowId, qint64 &rowId)
+{
+    QSqlQuery _query(SqlDatabase);  // Query object for the key lookup
+    _query.setForwardOnly(true);
+
+    // Column affinity converts the typed text for INTEGER and other typed keys
+    if (!keyIsRowId && schema.PrimaryKeyColumns.size() == 1) {
+        _query.prepare(QString("SELECT rowid FROM %1 WHERE %2 = ? LIMIT 1")
+                           .arg(QuoteIdentifier(tableName), QuoteIdentifier(schema.PrimaryKeyColumns.first())));
+        _query.addBindValue(key);
+        if (_query.exec() && _query.next()) {
+            rowId = _query.value(0).toLongLong();
+            return true;
+        }
+        _query.finish();
+    }
+
+    bool _isNumber = false;  // Key can be a rowid
+    qint64 _candidate = key.toLongLong(&_isNumber);  // Key read as a rowid
+    if (!_isNumber) {
+        return false;
+    }
+
+    _query.prepare(QString("SELECT rowid FROM %1 WHERE rowid = ?").arg(QuoteIdentifier(tableName)));
+    _query.addBindValue(_candidate);
+    if (_query.exec() && _query.next()) {
+        rowId = _query.value(0).toLongLong();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Load every row of a table without row ids, applying the table filter
+ */
+int SQLWorker::AppendAllRowsWithoutRowId(const QString &tableName, QTableWidget *tableWidget)
+{
+    QString _queryString = SELECT_ALL_QUERY.arg(QuoteIdentifier(tableName));  // Complete SELECT query string
+    const TableFilter _filter = TableFilters.value(tableName);  // Active filter (empty if none)
+    if (!_filter.IsEmpty()) {
+        _queryString += " WHERE " + _filter.BuildWhereClause();
+    }
+
+    // All rows are loaded at once, so the sort only needs an ORDER BY without keyset continuation
+    const QList<SortKey> _sortKeys = TableSorts.value(tableName);  // Active sort (empty if unsorted)
+    if (!_sortKeys.isEmpty()) {
+        QStringList _orderTerms;  // "column ASC|DESC" per sort key
+        for (const SortKey &_key : _sortKeys) {
+            _orderTerms.append(QuoteIdentifier(_key.ColumnName) + (_key.Order == Qt::AscendingOrder ? " ASC" : " DESC"));
+        }
+        _queryString += " ORDER BY " + _orderTerms.join(", ");
+    }
+
+    QSqlQuery _query(SqlDatabase);  // Query object for executing SQL commands
+    _query.setForwardOnly(true);
+    if (!_query.prepare(_queryString)) {
+        qDebug() << "Error: Failed to prepare query:" << _queryString;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return -1;
+    }
+
+    QVariantList _bindValues = _filter.GetBindValues();  // Filter values in placeholder order
+    for (int _i = 0; _i < _bindValues.size(); ++_i) {
+        _query.bindValue(_i, _bindValues[_i]);
+    }
+
+    if (!_query.exec()) {
+        qDebug() << "Error: Failed to execute query:" << _queryString;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return -1;
+    }
+
+    int _rowIndex = 0;  // Current row index being processed (0-based)
+    int _columnCount = tableWidget->columnCount();  // Number of columns returned by SELECT *
+
+    while (_query.next()) {  // Iterate through all rows returned by query
+        if (_rowIndex >= tableWidget->rowCount()) {
+            tableWidget->setRowCount(_rowIndex + ROW_ALLOCATION_BLOCK);
+        }
+
+        for (int _col = 0; _col < _columnCount; ++_col) {  // Current column index (0-based)
+            tableWidget->setItem(_rowIndex, _col, new QTableWidgetItem(_query.value(_col).toString()));
+        }
+
+        _rowIndex++;  // Move to next row
+    }
+
+    tableWidget->setRowCount(_rowIndex);
+    return _rowIndex;
+}
+
+/**
+ * @brief Fetch columns that were not loaded when the table was loaded
+ * @param tableName Name of the table displayed in the widget
+ * @param tableWidget Pointer to QTableWidget previously filled by LoadTableData
+ * @param columnNames Names of the columns to fetch
+ * @return true if all requested columns are loaded, false on error
+ */
+bool SQLWorker::LoadTableColumns(const QString &tableName, QTableWidget *tableWidget, const QStringList &columnNames)
+{
+    if (!FileLoaded || tableName.isEmpty() || !tableWidget) {
+        qDebug() << "Error: Invalid parameters for loading table columns";
+        return false;
+    }
+
+    // Find widget columns that still have to be fetched
+    QSet<QString> _requestedColumns(columnNames.begin(), columnNames.end());  // Requested names for fast lookup
+    QStringList _projection;      // Quoted column names included in the SELECT list
+    QList<int> _columnIndexes;    // Widget column index of each fetched column
+    for (int _col = 0; _col < tableWidget->columnCount(); ++_col) {  // Current column index (0-based)
+        QTableWidgetItem *_headerItem = tableWidget->horizontalHeaderItem(_col);  // Header item with column name and load state
+        if (_headerItem && _requestedColumns.contains(_headerItem->text()) && !IsColumnLoaded(tableWidget, _col)) {
+            _projection.append(QuoteIdentifier(_headerItem->text()));
+            _columnIndexes.append(_col);
+        }
+    }
+
+    if (_projection.isEmpty()) {
+        return true;
+    }
+
+    // Map row ids to widget rows so fetched values land in the right place
+    QHash<qint64, int> _rowsById;  // Row id -> widget row index
+    QList<qint64> _rowIds;         // Row ids of all rows shown in the widget
+    for (int _row = 0; _row < tableWidget->rowCount(); ++_row) {  // Current row index (0-based)
+        QTableWidgetItem *_headerItem = tableWidget->verticalHeaderItem(_row);  // Row header carrying the row id
+        if (_headerItem && _headerItem->data(ROW_ID_ROLE).isValid()) {
+            qint64 _rowId = _headerItem->data(ROW_ID_ROLE).toLongLong();  // Row id of this widget row
+            _rowsById.insert(_rowId, _row);
+            _rowIds.append(_rowId);
+        }
+    }
+
+    // Only the rows in the widget are fetched, in batches of row ids
+    QSqlQuery _query(SqlDatabase);  // Query object for fetching the columns
+    _query.setForwardOnly(true);
+    tableWidget->setUpdatesEnabled(false);
+
+    for (int _start = 0; _start < _rowIds.size(); _start += ROW_ID_BATCH_SIZE) {  // First row id of the current batch
+        int _batchSize = qMin(ROW_ID_BATCH_SIZE, _rowIds.size() - _start);  // Row ids in this batch
+        QStringList _placeholders;  // One placeholder per row id
+        for (int _i = 0; _i < _batchSize; ++_i) {
+            _placeholders.append("?");
+        }
+
+        QString _queryString = SELECT_PROJECTION_QUERY.arg(_projection.join(", "), QuoteIdentifier(tableName))
+                               + QString(" WHERE rowid IN (%1)").arg(_placeholders.join(", "));  // Complete SELECT query string
+        if (!_query.prepare(_queryString)) {
+            qDebug() << "Error: Failed to prepare query:" << _queryString;
+            qDebug() << "SQL error:" << _query.lastError().text();
+            tableWidget->setUpdatesEnabled(true);
+            return false;
+        }
+        for (int _i = 0; _i < _batchSize; ++_i) {
+            _query.bindValue(_i, _rowIds[_start + _i]);
+        }
+        if (!_query.exec()) {
+            qDebug() << "Error: Failed to fetch columns of table" << tableName;
+            qDebug() << "SQL error:" << _query.lastError().text();
+            tableWidget->setUpdatesEnabled(true);
+            return false;
+        }
+
+        while (_query.next()) {  // Iterate through all rows returned by query
+            int _row = _rowsById.value(_query.value(0).toLongLong());  // Widget row of this database row
+            for (int _i = 0; _i < _columnIndexes.size(); ++_i) {  // Current fetched column (0-based)
+                tableWidget->setItem(_row, _columnIndexes[_i], new QTableWidgetItem(_query.value(_i + 1).toString()));
+            }
+        }
+    }
+
+    tableWidget->setUpdatesEnabled(true);
+
+    for (int _col : _columnIndexes) {  // Mark fetched columns as loaded
+        tableWidget->horizontalHeaderItem(_col)->setData(COLUMN_LOADED_ROLE, true);
+    }
+
+    qDebug() << "Loaded" << _columnIndexes.size() << "column(s) of table" << tableName << "for" << _rowIds.size() << "rows";
+    return true;
+}
+
+/**
+ * @brief Check if a widget column holds values fetched from the database
+ */
+bool SQLWorker::IsColumnLoaded(QTableWidget *tableWidget, int column)
+{
+    QTableWidgetItem *_headerItem = tableWidget->horizontalHeaderItem(column);  // Header item with load state
+    return !_headerItem || !_headerItem->data(COLUMN_LOADED_ROLE).isValid() || _headerItem->data(COLUMN_LOADED_ROLE).toBool();
+}
+
+/**
+ * @brief Add new row to specified table in database
+ */
+bool SQLWorker::AddRowToTable(const QString &tableName, const QStringList &rowData)
+{
+    if (!FileLoaded || tableName.isEmpty()) {
+        qDebug() << "Error: Invalid parameters for adding row";
+        return false;
+    }
+
+    // Get column information for the table
+    QStringList _columnNames = GetTableColumns(tableName);  // List of column names for INSERT statement
+    if (_columnNames.isEmpty()) {
+        qDebug() << "Error: Could not retrieve column information for table" << tableName;
+        return false;
+    }
+
+    // Prepare column names and values for INSERT statement
+    QString _columns = _columnNames.join(", ");  // Comma-separated column names
+    QStringList _placeholders;  // List of placeholder values for prepared statement
+
+    for (int _i = 0; _i < _columnNames.size(); ++_i) {  // Generate placeholder for each column
+        _placeholders.append("?");  // Use parameter placeholder for safe SQL execution
+    }
+
+    QString _values = _placeholders.join(", ");  // Comma-separated placeholder values
+
+    // Create and execute INSERT query
+    QSqlQuery _query(SqlDatabase);  // Query object for INSERT operation
+    QString _queryString = INSERT_QUERY_TEMPLATE.arg(tableName, _columns, _values);  // Complete INSERT query string
+
+    if (!_query.prepare(_queryString)) {
+        qDebug() << "Error: Failed to prepare INSERT query:" << _queryString;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return false;
+    }
+
+    // Bind values to query parameters
+    for (int _i = 0; _i < _columnNames.size(); ++_i) {  // Bind each column value
+        QString _value = (_i < rowData.size()) ? rowData[_i] : "";  // Use provided value or empty string
+        _query.addBindValue(_value);
+    }
+
+    // Execute the INSERT query
+    if (!_query.exec()) {
+        qDebug() << "Error: Failed to execute INSERT query";
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return false;
+    }
+
+    ChangedTables.insert(tableName);
+    LocalCommitCount++;
+    qDebug() << "Added new row to table" << tableName;
+    return true;
+}
+
+/**
+ * @brief Delete specific row from table by index
+ */
+bool SQLWorker::DeleteRowFromTable(const QString &tableName, int rowIndex)
+{
+    if (!FileLoaded || tableName.isEmpty() || rowIndex < 0) {
+        qDebug() << "Error: Invalid parameters for deleting row";
+        return false;
+    }
+
+    // For SQL databases, we need to identify the row to delete
+    // Since SQLite doesn't have built-in row numbers, we'll use ROWID
+    QSqlQuery _query(SqlDatabase);  // Query object for DELETE operation
+    QString _queryString = QString("DELETE FROM %1 WHERE ROWID = (SELECT ROWID FROM %1 LIMIT 1 OFFSET %2)")
+                               .arg(tableName).arg(rowIndex);  // DELETE query using ROWID and OFFSET
+
+    if (!_query.exec(_queryString)) {
+        qDebug() << "Error: Failed to execute DELETE query:" << _queryString;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return false;
+    }
+
+    ChangedTables.insert(tableName);
+    LocalCommitCount++;
+    qDebug() << "Deleted row" << rowIndex << "from table" << tableName;
+    return true;
+}
+
+/**
+ * @brief Write table contents from QTableWidget back to the database
+ * @param tableName Name of the table to update (must exist in database)
+ * @param tableWidget Pointer to QTableWidget containing the new data
+ * @return true if table updated successfully, false on error
+ */
+bool SQLWorker::UpdateCompleteTable(const QString &tableName, QTableWidget *tableWidget)
+{
+    // Validate input parameters
+    if (!FileLoaded || tableName.isEmpty() || !tableWidget) {
+        qDebug() << "Error: Invalid parameters for updating table data";
+        return false;
+    }
+
+    // Check if database connection is still valid
+    if (!SqlDatabase.isOpen()) {
+        qDebug() << "Error: Database connection is not open";
+        return false;
+    }
+
+    // Start a transaction for atomic updates
+    if (!SqlDatabase.transaction()) {
+        qDebug() << "Error: Failed to start transaction";
+        return false;
+    }
+
+    // Replacing the whole table from a filtered view would delete every row outside the filter
+    if (!LoadedRowIds.contains(tableName) && IsTableFiltered(tableName)) {
+        qDebug() << "Error: Cannot save a filtered view of table" << tableName << "without row ids";
+        SqlDatabase.rollback();
+        return false;
+    }
+
+    // Tables loaded with row ids are written back row by row, leaving unfetched columns untouched
+    bool _written = LoadedRowIds.contains(tableName) ? ApplyTableChanges(tableName, tableWidget)
+                                                     : ReplaceTableContents(tableName, tableWidget);  // Result of writing the widget contents
+    if (!_written) {
+        SqlDatabase.rollback();  // Rollback transaction on error
+        return false;
+    }
+
+    // Commit the transaction
+    if (!SqlDatabase.commit()) {
+        qDebug() << "Error: Failed to commit transaction";
+        SqlDatabase.rollback();
+        return false;
+    }
+
+    ChangedTables.insert(tableName);
+    LocalCommitCount++;
+    qDebug() << "Updated table" << tableName << "with" << tableWidget->rowCount() << "rows";
+    return true;
+}
+
+/**
+ * @brief Insert the objects of a JSON Lines stream as rows of a table
+ */
+bool SQLWorker::ImportJsonLines(const QString &tableName, QIODevice *device, const ImportProgressCallback &progress,
+                                qint64 &importedRows, QStringList &unknownKeys, QString &errorMessage)
+{
+    importedRows = 0;
+    unknownKeys.clear();
+    errorMessage.clear();
+    if (!FileLoaded || tableName.isEmpty() || !device) {
+        qDebug() << "Error: Invalid parameters for importing rows";
+        errorMessage = "No table to import into";
+        return false;
+    }
+
+    QStringList _columnNames = GetTableColumns(tableName);  // Columns keys are matched against
+    if (_columnNames.isEmpty()) {
+        qDebug() << "Error: Could not retrieve column information for table" << tableName;
+        errorMessage = QString("Could not read the columns of table %1").arg(tableName);
+        return false;
+    }
+
+    JsonLinesReader _reader(device, _columnNames, GetTableColumnTypes(tableName));  // Line by line decoder
+    QVariantList _values;    // Values of the current line per column
+    QVector<bool> _present;  // Columns with a key in the current line
+    if (!_reader.ReadRow(_values, _present)) {
+        errorMessage = _reader.GetErrorString();
+        return !_reader.HasError();  // An empty file imports nothing
+    }
+
+    // The first line chooses the columns of the prepared INSERT
+    QList<int> _columnIndexes;  // Table column of each placeholder
+    QStringList _quotedColumns; // Quoted names of the inserted columns
+    QStringList _placeholders;  // "?" placeholders for INSERT
+    for (int _col = 0; _col < _columnNames.size(); ++_col) {
+        if (_present[_col]) {
+            _columnIndexes.append(_col);
+            _quotedColumns.append(QuoteIdentifier(_columnNames[_col]));
+            _placeholders.append("?");
+        }
+    }
+    if (_columnIndexes.isEmpty()) {
+        errorMessage = QString("No key of the first line matches a column of table %1").arg(tableName);
+        qDebug() << "Error:" << errorMessage;
+        return false;
+    }
+
+    QSqlQuery _insertQuery(SqlDatabase);  // Prepared INSERT reused for every line
+    QString _queryString = INSERT_QUERY_TEMPLATE.arg(QuoteIdentifier(tableName), _quotedColumns.join(", "), _placeholders.join(", "));  // Complete INSERT query string
+    if (!_insertQuery.prepare(_queryString)) {
+        qDebug() << "Error: Failed to prepare INSERT query:" << _queryString;
+        qDebug() << "SQL error:" << _insertQuery.lastError().text();
+        errorMessage = _insertQuery.lastError().text();
+        return false;
+    }
+
+    // Imported rows are added to the search index like rows saved from the editor
+    bool _syncIndex = !SearchIndexColumns.value(tableName).isEmpty();  // Search index must follow the inserted rows
+    QSqlQuery _indexAddQuery(SqlDatabase);  // Prepared FTS5 insert of a row's values
+    if (_syncIndex && !_indexAddQuery.prepare(BuildSearchIndexSyncQuery(tableName, false))) {
+        qDebug() << "Error: Failed to prepare search index statements for table" << tableName;
+        qDebug() << "SQL error:" << _indexAddQuery.lastError().text();
+        errorMessage = _indexAddQuery.lastError().text();
+        return false;
+    }
+
+    // Batches keep the journal small; a failure loses at most the current batch
+    if (!SqlDatabase.transaction()) {
+        qDebug() << "Error: Failed to start transaction";
+        errorMessage = "Failed to start transaction: " + SqlDatabase.lastError().text();
+        return false;
+    }
+    bool _inTransaction = true;  // A batch transaction is open
+    qint64 _batchRows = 0;       // Rows inserted in the open transaction
+    do {
+        for (int _i = 0; _i < _columnIndexes.size(); ++_i) {
+            _insertQuery.bindValue(_i, _values[_columnIndexes[_i]]);
+        }
+        if (!_insertQuery.exec()) {
+            qDebug() << "Error: Failed to insert line" << _reader.GetLineNumber();
+            qDebug() << "SQL error:" << _insertQuery.lastError().text();
+            errorMessage = QString("Line %1: %2").arg(_reader.GetLineNumber()).arg(_insertQuery.lastError().text());
+            break;
+        }
+        if (_syncIndex && !ExecSearchIndexSync(_indexAddQuery, _insertQuery.lastInsertId().toLongLong())) {
+            errorMessage = QString("Line %1: %2").arg(_reader.GetLineNumber()).arg(_indexAddQuery.lastError().text());
+            break;
+        }
+
+        if (++_batchRows < IMPORT_BATCH_ROWS) {
+            continue;
+        }
+        _inTransaction = false;
+        if (!SqlDatabase.commit()) {
+            qDebug() << "Error: Failed to commit transaction";
+            errorMessage = "Failed to commit transaction: " + SqlDatabase.lastError().text();
+            SqlDatabase.rollback();
+            break;
+        }
+        importedRows += _batchRows;
+        _batchRows = 0;
+        if (progress && !progress(importedRows)) {
+            qDebug() << "Import into" << tableName << "cancelled";
+            errorMessage = "Import cancelled";
+            break;
+        }
+        if (!SqlDatabase.transaction()) {
+            qDebug() << "Error: Failed to start transaction";
+            errorMessage = "Failed to start transaction: " + SqlDatabase.lastError().text();
+            break;
+        }
+        _inTransaction = true;
+    } while (_reader.ReadRow(_values, _present));
+
+    if (errorMessage.isEmpty() && _reader.HasError()) {
+        errorMessage = _reader.GetErrorString();
+    }
+    if (_inTransaction) {
+        if (errorMessage.isEmpty() && SqlDatabase.commit()) {
+            importedRows += _batchRows;
+        } else {
+            if (errorMessage.isEmpty()) {
+                qDebug() << "Error: Failed to commit transaction";
+                errorMessage = "Failed to commit transaction: " + SqlDatabase.lastError().text();
+            }
+            SqlDatabase.rollback();
+        }
+    }
+
+    unknownKeys = _reader.GetUnknownKeys();
+    if (importedRows > 0) {
+        ChangedTables.insert(tableName);
+        LocalCommitCount++;
+    }
+    qDebug() << "Imported" << importedRows << "rows into table" << tableName;
+    return errorMessage.isEmpty();
 }
 
 /**
- * @brief Add new row to specified table in database
+ * @brief Apply widget rows to the database by row id
+ * Rows with a row id are updated, rows without one are inserted and loaded
+ * row ids missing from the widget are deleted; only fetched columns are written
  */
-bool SQLWorker::AddRowToTable(const QString &tableName, const QStringList &rowData)
+bool SQLWorker::ApplyTableChanges(const QString &tableName, QTableWidget *tableWidget)
 {
-    if (!FileLoaded || tableName.isEmpty()) {
-        qDebug() << "Error: Invalid parameters for adding row";
-        return false;
+    // Collect the fetched columns that will be written
+    QStringList _columnNames;     // Quoted names of loaded columns
+    QList<int> _columnIndexes;    // Widget column index of each loaded column
+    for (int _col = 0; _col < tableWidget->columnCount(); ++_col) {  // Current column index (0-based)
+        QTableWidgetItem *_headerItem = tableWidget->horizontalHeaderItem(_col);  // Header item with column name
+        if (_headerItem && IsColumnLoaded(tableWidget, _col)) {
+            _columnNames.append(QuoteIdentifier(_headerItem->text()));
+            _columnIndexes.append(_col);
+        }
     }
 
-    // Get column information for the table
-    QStringList _columnNames = GetTableColumns(tableName);  // List of column names for INSERT statement
-    if (_columnNames.isEmpty()) {
-        qDebug() << "Error: Could not retrieve column information for table" << tableName;
-        return false;
+    QString _quotedTable = QuoteIdentifier(tableName);  // Quoted table name for generated statements
+    QStringList _assignments;   // "column = ?" fragments for UPDATE
+    QStringList _placeholders;  // "?" placeholders for INSERT
+    for (const QString &_columnName : _columnNames) {
+        _assignments.append(_columnName + " = ?");
+        _placeholders.append("?");
     }
 
-    // Prepare column names and values for INSERT statement
-    QString _columns = _columnNames.join(", ");  // Comma-separated column names
-    QStringList _placeholders;  // List of placeholder values for prepared statement
+    QSqlQuery _updateQuery(SqlDatabase);  // Prepared UPDATE for rows with a row id
+    QSqlQuery _insertQuery(SqlDatabase);  // Prepared INSERT for new rows
+    QSqlQuery _deleteQuery(SqlDatabase);  // Prepared DELETE for removed rows
 
-    for (int _i = 0; _i < _columnNames.size(); ++_i) {  // Generate placeholder for each column
-        _placeholders.append("?");  // Use parameter placeholder for safe SQL execution
+    bool _prepared = _deleteQuery.prepare(QString("DELETE FROM %1 WHERE rowid = ?").arg(_quotedTable));  // All statements prepared successfully
+    if (!_columnNames.isEmpty()) {
+        _prepared = _prepared
+                    && _updateQuery.prepare(QString("UPDATE %1 SET %2 WHERE rowid = ?").arg(_quotedTable, _assignments.join(", ")))
+                    && _insertQuery.prepare(INSERT_QUERY_TEMPLATE.arg(_quotedTable, _columnNames.join(", "), _placeholders.join(", ")));
     }
-
-    QString _values = _placeholders.join(", ");  // Comma-separated placeholder values
-
-    // Create and execute INSERT query
-    QSqlQuery _query(SqlDatabase);  // Query object for INSERT operation
-    QString _queryString = INSERT_QUERY_TEMPLATE.arg(tableName, _columns, _values);  // Complete INSERT query string
-
-    if (!_query.prepare(_queryString)) {
-        qDebug() << "Error: Failed to prepare INSERT query:" << _queryString;
-        qDebug() << "SQL error:" << _query.lastError().text();
+    if (!_prepared) {
+        qDebug() << "Error: Failed to prepare write statements for table" << tableName;
         return false;
     }
 
-    // Bind values to query parameters
-    for (int _i = 0; _i < _columnNames.size(); ++_i) {  // Bind each column value
-        QString _value = (_i < rowData.size()) ? rowData[_i] : "";  // Use provided value or empty string
-        _query.addBindValue(_value);
+    // Rows are removed from the search index with their old values and re-added with the new ones
+    QStringList _indexedColumns = SearchIndexColumns.value(tableName);  // Columns of the search index (empty if none)
+    bool _syncIndex = !_indexedColumns.isEmpty();  // Search index must follow the written rows
+    bool _updatesIndexedColumns = false;           // At least one written column is indexed
+    for (int _col : _columnIndexes) {
+        _updatesIndexedColumns = _updatesIndexedColumns || _indexedColumns.contains(tableWidget->horizontalHeaderItem(_col)->text());
     }
-
-    // Execute the INSERT query
-    if (!_query.exec()) {
-        qDebug() << "Error: Failed to execute INSERT query";
-        qDebug() << "SQL error:" << _query.lastError().text();
+    QSqlQuery _indexRemoveQuery(SqlDatabase);  // Prepared FTS5 'delete' of a row's old values
+    QSqlQuery _indexAddQuery(SqlDatabase);     // Prepared FTS5 insert of a row's current values
+    if (_syncIndex && (!_indexRemoveQuery.prepare(BuildSearchIndexSyncQuery(tableName, true))
+                       || !_indexAddQuery.prepare(BuildSearchIndexSyncQuery(tableName, false)))) {
+        qDebug() << "Error: Failed to prepare search index statements for table" << tableName;
+        qDebug() << "SQL error:" << _indexAddQuery.lastError().text();
         return false;
     }
 
-    qDebug() << "Added new row to table" << tableName;
-    return true;
-}
+    QSet<qint64> _remainingRowIds = LoadedRowIds.value(tableName);  // Loaded rows not found in the widget yet
 
-/**
- * @brief Delete specific row from table by index
- */
-bool SQLWorker::DeleteRowFromTable(const QString &tableName, int rowIndex)
-{
-    if (!FileLoaded || tableName.isEmpty() || rowIndex < 0) {
-        qDebug() << "Error: Invalid parameters for deleting row";
-        return false;
+    for (int _row = 0; _row < tableWidget->rowCount(); ++_row) {  // Current row index (0-based)
+        QTableWidgetItem *_rowHeader = tableWidget->verticalHeaderItem(_row);  // Row header carrying the row id
+        bool _hasRowId = _rowHeader && _rowHeader->data(ROW_ID_ROLE).isValid();  // Row exists in the database
+        if (_columnNames.isEmpty()) {
+            if (_hasRowId) {
+                _remainingRowIds.remove(_rowHeader->data(ROW_ID_ROLE).toLongLong());
+            }
+            continue;
+        }
+
+        QSqlQuery &_query = _hasRowId ? _updateQuery : _insertQuery;  // Statement used for this row
+
+        // Bind data from each loaded cell in the row
+        for (int _i = 0; _i < _columnIndexes.size(); ++_i) {  // Current loaded column (0-based)
+            QTableWidgetItem *_cellItem = tableWidget->item(_row, _columnIndexes[_i]);  // Cell item at current position
+            _query.bindValue(_i, _cellItem ? _cellItem->text() : "");  // Use empty string if cell is null
+        }
+
+        qint64 _rowId = 0;  // Row id of the written row (assigned by SQLite for new rows)
+        if (_hasRowId) {
+            _rowId = _rowHeader->data(ROW_ID_ROLE).toLongLong();
+            _query.bindValue(_columnIndexes.size(), _rowId);
+            _remainingRowIds.remove(_rowId);
+        }
+
+        bool _reindexRow = _syncIndex && (!_hasRowId || _updatesIndexedColumns);  // Indexed values of this row change
+        if (_reindexRow && _hasRowId && !ExecSearchIndexSync(_indexRemoveQuery, _rowId)) {
+            return false;
+        }
+
+        if (!_query.exec()) {
+            qDebug() << "Error: Failed to write row" << _row;
+            qDebug() << "SQL error:" << _query.lastError().text();
+            return false;
+        }
+
+        if (!_hasRowId) {
+            _rowId = _query.lastInsertId().toLongLong();
+        }
+        if (_reindexRow && !ExecSearchIndexSync(_indexAddQuery, _rowId)) {
+            return false;
+        }
     }
 
-    // For SQL databases, we need to identify the row to delete
-    // Since SQLite doesn't have built-in row numbers, we'll use ROWID
-    QSqlQuery _query(SqlDatabase);  // Query object for DELETE operation
-    QString _queryString = QString("DELETE FROM %1 WHERE ROWID = (SELECT ROWID FROM %1 LIMIT 1 OFFSET %2)")
-                               .arg(tableName).arg(rowIndex);  // DELETE query using ROWID and OFFSET
+    // Rows that were loaded but are no longer in the widget have been deleted by the user
+    for (qint64 _rowId : _remainingRowIds) {
+        if (_syncIndex && !ExecSearchIndexSync(_indexRemoveQuery, _rowId)) {
+            return false;
+        }
 
-    if (!_query.exec(_queryString)) {
-        qDebug() << "Error: Failed to execute DELETE query:" << _queryString;
-        qDebug() << "SQL error:" << _query.lastError().text();
-        return false;
+        _deleteQuery.bindValue(0, _rowId);
+        if (!_deleteQuery.exec()) {
+            qDebug() << "Error: Failed to delete row id" << _rowId;
+            qDebug() << "SQL error:" << _deleteQuery.lastError().text();
+            return false;
+        }
     }
 
-    qDebug() << "Deleted row" << rowIndex << "from table" << tableName;
     return true;
 }
 
 /**
- * @brief Replace entire table with data from QTableWidget
- * @param tableName Name of the table to update (must exist in database)
- * @param tableWidget Pointer to QTableWidget containing the new data
- * @return true if table updated successfully, false on error
+ * @brief Replace all rows of a table without row ids (WITHOUT ROWID tables)
  */
-bool SQLWorker::UpdateCompleteTable(const QString &tableName, QTableWidget *tableWidget)
+bool SQLWorker::ReplaceTableContents(const QString &tableName, QTableWidget *tableWidget)
 {
-    // Validate input parameters
-    if (!FileLoaded || tableName.isEmpty() || !tableWidget) {
-        qDebug() << "Error: Invalid parameters for updating table data";
-        return false;
-    }
-
-    // Check if database connection is still valid
-    if (!SqlDatabase.isOpen()) {
-        qDebug() << "Error: Database connection is not open";
-        return false;
-    }
-
-    // Start a transaction for atomic updates
-    if (!SqlDatabase.transaction()) {
-        qDebug() << "Error: Failed to start transaction";
-        return false;
-    }
-
     // Delete all existing rows from the table
     QSqlQuery _deleteQuery(SqlDatabase);  // Query object for DELETE operation
     QString _deleteQueryString = DELETE_ALL_QUERY.arg(tableName);  // Complete DELETE query string
@@ -278,7 +1575,6 @@ bool SQLWorker::UpdateCompleteTable(const QString &tableName, QTableWidget *tabl
     if (!_deleteQuery.exec(_deleteQueryString)) {
         qDebug() << "Error: Failed to delete existing data:" << _deleteQueryString;
         qDebug() << "SQL error:" << _deleteQuery.lastError().text();
-        SqlDatabase.rollback();  // Rollback transaction on error
         return false;
     }
 
@@ -313,7 +1609,6 @@ bool SQLWorker::UpdateCompleteTable(const QString &tableName, QTableWidget *tabl
     if (!_insertQuery.prepare(_insertQueryString)) {
         qDebug() << "Error: Failed to prepare INSERT query:" << _insertQueryString;
         qDebug() << "SQL error:" << _insertQuery.lastError().text();
-        SqlDatabase.rollback();  // Rollback transaction on error
         return false;
     }
 
@@ -323,7 +1618,6 @@ bool SQLWorker::UpdateCompleteTable(const QString &tableName, QTableWidget *tabl
         _insertQuery.finish();
         if (!_insertQuery.prepare(_insertQueryString)) {
             qDebug() << "Error: Failed to re-prepare INSERT query for row" << _row;
-            SqlDatabase.rollback();
             return false;
         }
 
@@ -338,19 +1632,10 @@ bool SQLWorker::UpdateCompleteTable(const QString &tableName, QTableWidget *tabl
         if (!_insertQuery.exec()) {
             qDebug() << "Error: Failed to insert row" << _row;
             qDebug() << "SQL error:" << _insertQuery.lastError().text();
-            SqlDatabase.rollback();  // Rollback transaction on error
             return false;
         }
     }
 
-    // Commit the transaction
-    if (!SqlDatabase.commit()) {
-        qDebug() << "Error: Failed to commit transaction";
-        SqlDatabase.rollback();
-        return false;
-    }
-
-    qDebug() << "Updated table" << tableName << "with" << tableWidget->rowCount() << "rows";
     return true;
 }
 
@@ -386,6 +1671,203 @@ bool SQLWorker::IsFileLoaded() const
     return FileLoaded && SqlDatabase.isOpen();
 }
 
+/**
+ * @brief Get tables modified through this worker since the last maintenance run
+ */
+QStringList SQLWorker::GetChangedTables() const
+{
+    return QStringList(ChangedTables.begin(), ChangedTables.end());
+}
+
+/**
+ * @brief Forget changed tables once maintenance has processed them
+ */
+void SQLWorker::ClearChangedTables(const QStringList &tableNames)
+{
+    for (const QString &_tableName : tableNames) {  // Each table processed by maintenance
+        ChangedTables.remove(_tableName);
+    }
+}
+
+/**
+ * @brief Open a new SQLite connection with the settings used by all workers
+ * @param filePath Path to the SQL database file to open
+ * @param connectionName Unique connection name registered with QSqlDatabase
+ * @return Open QSqlDatabase, or a closed one if opening failed
+ */
+QSqlDatabase SQLWorker::OpenDatabaseConnection(const QString &filePath, const QString &connectionName)
+{
+    QSqlDatabase _database = QSqlDatabase::addDatabase("QSQLITE", connectionName);  // New connection registered under the given name
+    _database.setDatabaseName(filePath);
+
+    // Background connections share the file, so wait for locks instead of failing immediately
+    _database.setConnectOptions(QString("QSQLITE_BUSY_TIMEOUT=%1").arg(BUSY_TIMEOUT_MS));
+
+    if (!_database.open()) {
+        qDebug() << "Error: Cannot open database file" << filePath;
+        qDebug() << "Database error:" << _database.lastError().text();
+        return _database;
+    }
+
+    // Application functions are available to the editor and every background task
+    if (!SQLiteFunctions::Register(GetNativeHandle(_database))) {
+        qDebug() << "Error: Failed to register SQL functions on connection" << connectionName;
+    }
+
+    return _database;
+}
+
+/**
+ * @brief Quote an identifier for safe use in generated SQL
+ */
+QString SQLWorker::QuoteIdentifier(const QString &identifier)
+{
+    QString _escaped = identifier;  // Identifier with embedded quotes doubled
+    _escaped.replace('"', "\"\"");
+    return '"' + _escaped + '"';
+}
+
+/**
+ * @brief Get a version number of the file contents
+ * PRAGMA data_version only moves when another connection commits, so commits made
+ * through this worker are added from a local counter
+ */
+qint64 SQLWorker::GetDataVersion()
+{
+    if (!FileLoaded || !SqlDatabase.isOpen()) {
+        return -1;
+    }
+
+    QSqlQuery _query(SqlDatabase);  // Query object for the pragma
+    if (!_query.exec("PRAGMA data_version") || !_query.next()) {
+        qDebug() << "Error: Failed to read data version";
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return -1;
+    }
+
+    return _query.value(0).toLongLong() + LocalCommitCount;
+}
+
+/**
+ * @brief Get the native SQLite handle behind a QSQLITE connection
+ */
+sqlite3 *SQLWorker::GetNativeHandle(const QSqlDatabase &database)
+{
+    if (!database.isOpen() || !database.driver()) {
+        return nullptr;
+    }
+
+    QVariant _handle = database.driver()->handle();  // Driver handle wrapped in a QVariant
+    if (!_handle.isValid() || qstrcmp(_handle.typeName(), "sqlite3*") != 0) {
+        qDebug() << "Error: Connection does not expose a native SQLite handle";
+        return nullptr;
+    }
+
+    return *static_cast<sqlite3 **>(_handle.data());
+}
+
+/**
+ * @brief Switch the loaded file to WAL mode for the rest of the session
+ * A parallel export keeps read transactions open on several connections for as long as it
+ * runs; in WAL mode they never block a save, which a rollback journal's shared locks would.
+ * The previous mode is restored when the file is closed, so the file is not left in WAL mode
+ * (which needs shared memory that network file systems and older readers do not provide)
+ */
+bool SQLWorker::EnableWriteAheadLog()
+{
+    if (!FileLoaded) {
+        return false;
+    }
+
+    QSqlQuery _query(SqlDatabase);  // Query object for the journal mode switch
+    if (!_query.exec("PRAGMA journal_mode") || !_query.next()) {
+        qDebug() << "Error: Cannot read the journal mode of" << CurrentFilePath;
+        return false;
+    }
+    QString _currentMode = _query.value(0).toString().toLower();  // Mode before the switch
+    _query.finish();
+    if (_currentMode == "wal") {
+        return true;  // Already WAL, either from an earlier export or by the file's own setting
+    }
+
+    if (!_query.exec("PRAGMA journal_mode=WAL") || !_query.next() || _query.value(0).toString().toLower() != "wal") {
+        qDebug() << "Error: Cannot switch" << CurrentFilePath << "to WAL mode, the export may delay saving";
+        return false;
+    }
+    _query.finish();
+
+    OriginalJournalMode = _currentMode;
+    qDebug() << "Switched" << CurrentFilePath << "from" << _currentMode << "to WAL mode until it is closed";
+    return true;
+}
+
+/**
+ * @brief Put back the journal mode the file had before EnableWriteAheadLog
+ */
+void SQLWorker::RestoreJournalMode()
+{
+    if (OriginalJournalMode.isEmpty()) {
+        return;
+    }
+
+    // Leaving WAL checkpoints the log and needs every other connection to the file closed
+    QSqlQuery _query(SqlDatabase);  // Query object for the journal mode switch
+    if (!_query.exec(QString("PRAGMA journal_mode=%1").arg(OriginalJournalMode)) || !_query.next()
+        || _query.value(0).toString().toLower() != OriginalJournalMode) {
+        qDebug() << "Error: Cannot restore journal mode" << OriginalJournalMode << "of" << CurrentFilePath;
+    }
+    _query.finish();
+    OriginalJournalMode.clear();
+}
+
+/**
+ * @brief Atomically replace the loaded database file and reopen it
+ * @param replacementFilePath Path to a verified database file in the same directory
+ * @return true if the file was replaced and reopened, false otherwise
+ */
+bool SQLWorker::ReplaceDatabaseFile(const QString &replacementFilePath)
+{
+    if (!FileLoaded || replacementFilePath.isEmpty() || !QFile::exists(replacementFilePath)) {
+        qDebug() << "Error: Invalid parameters for replacing database file";
+        return false;
+    }
+
+    QString _filePath = CurrentFilePath;  // Path of the file being replaced
+
+    // The editor connection must be closed so it does not keep writing to the old inode;
+    // closing the last connection also checkpoints and removes any WAL file
+    RestoreJournalMode();
+    SqlDatabase.close();
+    SqlDatabase = QSqlDatabase();
+    QSqlDatabase::removeDatabase(ConnectionName);
+    FileLoaded = false;
+
+    // Rename over the original so readers see either the old or the new file, never a partial one
+#ifdef Q_OS_WIN
+    bool _renamed = MoveFileExW(reinterpret_cast<LPCWSTR>(replacementFilePath.utf16()),
+                                reinterpret_cast<LPCWSTR>(_filePath.utf16()),
+                                MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;  // Result of the atomic replace
+#else
+    bool _renamed = std::rename(QFile::encodeName(replacementFilePath).constData(),
+                                QFile::encodeName(_filePath).constData()) == 0;  // Result of the atomic replace
+#endif
+
+    if (!_renamed) {
+        qDebug() << "Error: Failed to replace" << _filePath << "with" << replacementFilePath;
+    } else if (QFile::exists(GetSearchIndexFilePath(_filePath))) {
+        // VACUUM may renumber rows of tables without INTEGER PRIMARY KEY, so the index no longer matches
+        QFile::remove(GetSearchIndexFilePath(_filePath));
+        qDebug() << "Removed search index of" << _filePath << "- rebuild it after compaction";
+    }
+
+    // Reopen whichever file is now in place
+    if (!LoadSQLFile(_filePath)) {
+        return false;
+    }
+
+    return _renamed;
+}
+
 /**
  * @brief Parse loaded SQL database and extract table structure information
  */
@@ -415,28 +1897,134 @@ void SQLWorker::ParseSQLStructure()
 
 /**
  * @brief Get column information for specified table
+ * Results come from the schema cache; PRAGMA table_info runs once per table and file
  */
 QStringList SQLWorker::GetTableColumns(const QString &tableName)
 {
-    QStringList _columns;  // List to store column names
+    return GetTableSchema(tableName).ColumnNames;
+}
+
+/**
+ * @brief Get cached schema of the specified table, reading it on first use
+ */
+SQLWorker::TableSchema SQLWorker::GetTableSchema(const QString &tableName)
+{
+    auto _cached = SchemaCache.constFind(tableName);  // Cached schema entry (end if not read yet)
+    if (_cached != SchemaCache.constEnd()) {
+        return _cached.value();
+    }
+
+    TableSchema _schema;  // Column names and declared types of the table
 
     // Use PRAGMA table_info to get column information
     QSqlQuery _query(SqlDatabase);  // Query object for schema information
-    QString _queryString = GET_COLUMNS_QUERY.arg(tableName);  // Complete PRAGMA query string
+    QString _queryString = GET_COLUMNS_QUERY.arg(QuoteIdentifier(tableName));  // Complete PRAGMA query string
 
     if (!_query.exec(_queryString)) {
         qDebug() << "Error: Failed to get column information for table" << tableName;
         qDebug() << "SQL error:" << _query.lastError().text();
-        return _columns;
+        return _schema;
     }
 
-    // Extract column names from PRAGMA results
+    // Extract column names, declared types and primary key positions from PRAGMA results
+    QMap<int, QString> _primaryKey;  // Position in the primary key (1-based) -> column name
     while (_query.next()) {  // Iterate through all column information rows
-        QString _columnName = _query.value(1).toString();  // Column name is in second field (index 1)
-        _columns.append(_columnName);
+        _schema.ColumnNames.append(_query.value(1).toString());  // Column name is in second field (index 1)
+        _schema.ColumnTypes.append(_query.value(2).toString());  // Declared type is in third field (index 2)
+        if (_query.value(5).toInt() > 0) {
+            _primaryKey.insert(_query.value(5).toInt(), _query.value(1).toString());  // Key position is in sixth field (index 5)
+        }
+    }
+    _schema.PrimaryKeyColumns = _primaryKey.values();
+
+    // WITHOUT ROWID tables reject the rowid column at prepare time
+    QSqlQuery _rowIdQuery(SqlDatabase);  // Query object used only to probe for a rowid
+    _schema.HasRowId = _rowIdQuery.prepare(QString("SELECT rowid FROM %1 LIMIT 0").arg(QuoteIdentifier(tableName)));
+
+    // Only successful lookups are cached so a missing table is retried later
+    if (!_schema.ColumnNames.isEmpty()) {
+        SchemaCache.insert(tableName, _schema);
+    }
+
+    return _schema;
+}
+
+/**
+ * @brief Attach the search index file as SEARCH_INDEX_SCHEMA if it exists
+ */
+bool SQLWorker::AttachSearchIndex()
+{
+    if (SearchIndexAttached) {
+        return true;
+    }
+
+    // ATTACH would create an empty file, so indexes stay strictly opt-in
+    if (!QFile::exists(GetSearchIndexFilePath(CurrentFilePath))) {
+        return false;
     }
+    if (!AttachSearchIndexFile(SqlDatabase, CurrentFilePath)) {
+        return false;
+    }
+
+    SearchIndexAttached = true;
+    return true;
+}
+
+/**
+ * @brief Attach the search index file of a database file to a connection if the index exists
+ */
+bool SQLWorker::AttachSearchIndexFile(QSqlDatabase &database, const QString &filePath)
+{
+    QString _indexFilePath = GetSearchIndexFilePath(filePath);  // Side database next to the database file
+    if (!QFile::exists(_indexFilePath)) {
+        return true;
+    }
+
+    QSqlQuery _query(database);  // Query object for ATTACH
+    _query.prepare(QString("ATTACH DATABASE ? AS %1").arg(SEARCH_INDEX_SCHEMA));
+    _query.addBindValue(_indexFilePath);
+    if (!_query.exec()) {
+        qDebug() << "Error: Failed to attach search index" << _indexFilePath;
+        qDebug() << "SQL error:" << _query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Build the statement adding (or removing) one row of a table to its search index
+ */
+QString SQLWorker::BuildSearchIndexSyncQuery(const QString &tableName, bool remove) const
+{
+    QStringList _sourceColumns;  // Quoted indexed columns of the table
+    for (const QString &_column : SearchIndexColumns.value(tableName)) {
+        _sourceColumns.append(QuoteIdentifier(_column));
+    }
+
+    QString _indexTable = QuoteIdentifier(GetSearchIndexTableName(tableName));  // Quoted FTS5 table name
+    QString _indexColumns = GetSearchIndexColumnNames(_sourceColumns.size()).join(", ");  // FTS5 column list
+
+    // The FTS5 'delete' command is an insert into the hidden column named like the table
+    if (remove) {
+        return QString("INSERT INTO %1.%2(%2, rowid, %3) SELECT 'delete', rowid, %4 FROM main.%5 WHERE rowid = ?")
+            .arg(SEARCH_INDEX_SCHEMA, _indexTable, _indexColumns, _sourceColumns.join(", "), QuoteIdentifier(tableName));
+    }
+    return QString("INSERT INTO %1.%2(rowid, %3) SELECT rowid, %4 FROM main.%5 WHERE rowid = ?")
+        .arg(SEARCH_INDEX_SCHEMA, _indexTable, _indexColumns, _sourceColumns.join(", "), QuoteIdentifier(tableName));
+}
 
-    return _columns;
+/**
+ * @brief Run a prepared search index sync statement for one row
+ */
+bool SQLWorker::ExecSearchIndexSync(QSqlQuery &query, qint64 rowId)
+{
+    query.bindValue(0, rowId);
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to update search index for row id" << rowId;
+        qDebug() << "SQL error:" << query.lastError().text();
+        return false;
+    }
+    return true;
 }
 
 /**
@@ -11,8 +11,17 @@
 #include <QTableWidget>
 #include <QTableWidgetItem>
 #include <QMap>
+#include <QSet>
+#include <QHash>
+#include <QVector>
 #include <QDebug>
 #include <QVariant>
+#include <QIODevice>
+#include <functional>
+#include "tablefilter.h"
+
+struct sqlite3;
+struct sqlite3_stmt;
 
 /**
  * @brief Worker class for SQL database file operations
@@ -46,11 +55,230 @@ public:
 
     /**
      * @brief Load specific table data into QTableWidget
+     * Hidden columns and visible columns beyond maxLoadedColumns are not fetched and can be
+     * loaded later with LoadTableColumns; each row header stores its row id under ROW_ID_ROLE
      * @param tableName Name of the table to load
      * @param tableWidget Target QTableWidget to populate
+     * @param hiddenColumns Names of columns to hide and leave out of the SELECT projection
+     * @param maxLoadedColumns Maximum number of visible columns fetched now (-1 for all)
      * @return true if table loaded successfully, false otherwise
      */
-    bool LoadTableData(const QString &tableName, QTableWidget *tableWidget);
+    bool LoadTableData(const QString &tableName, QTableWidget *tableWidget,
+                       const QStringList &hiddenColumns = QStringList(), int maxLoadedColumns = -1);
+
+    /**
+     * @brief Append the next keyset page of rows to a table loaded by LoadTableData
+     * @param tableName Name of the table displayed in the widget
+     * @param tableWidget QTableWidget previously filled by LoadTableData
+     * @return Number of rows appended (0 if no rows are left), or -1 on error
+     */
+    int FetchNextPage(const QString &tableName, QTableWidget *tableWidget);
+
+    /**
+     * @brief Load the page of a table around one row under the current sort, filter and search
+     * The row is found by its single-column primary key, or by rowid; its position is counted
+     * in SQL and only rows from a few before it onwards are fetched
+     * @param tableName Name of the table (must have row ids)
+     * @param tableWidget Pointer to QTableWidget that will display the data
+     * @param key Primary key value or rowid of the row
+     * @param keyIsRowId true to read the key only as rowid, false to try the primary key first
+     * @param hiddenColumns Columns that are hidden and therefore not fetched
+     * @param maxLoadedColumns Maximum number of visible columns fetched now (-1 for all)
+     * @param targetRow Output widget row of the requested row
+     * @param errorMessage Output description if the row cannot be shown
+     * @return true if the page was loaded, false otherwise
+     */
+    bool LoadTableAroundKey(const QString &tableName, QTableWidget *tableWidget, const QString &key, bool keyIsRowId,
+                            const QStringList &hiddenColumns, int maxLoadedColumns, int &targetRow, QString &errorMessage);
+
+    /**
+     * @brief Get the position of the first loaded row within the sorted and filtered table
+     * @param tableName Name of the table
+     * @return 0-based position (0 unless loaded by LoadTableAroundKey)
+     */
+    qint64 GetFirstRowPosition(const QString &tableName) const;
+
+    /**
+     * @brief Build the query returning every row and column of a table in view order
+     * The filter, search and sort of the view apply; what the widget has loaded does not matter
+     * @param tableName Name of the table
+     * @param queryString Output SELECT statement
+     * @param bindValues Output values for its placeholders in order
+     */
+    void BuildTableQuery(const QString &tableName, QString &queryString, QVariantList &bindValues);
+
+    /**
+     * @brief Build the query returning the rows of a table within a rowid range in view order
+     * Only possible while the view is in rowid order, so consecutive ranges concatenate to
+     * the whole view; the last two placeholders take the first and last rowid of the range
+     * @param tableName Name of the table
+     * @param queryString Output SELECT statement
+     * @param bindValues Output values for the view placeholders (the range follows them)
+     * @return true if the query was built, false if the view is sorted, searched or has no row ids
+     */
+    bool BuildTableRangeQuery(const QString &tableName, QString &queryString, QVariantList &bindValues);
+
+    /**
+     * @brief Open a forward-only cursor over every row and column of a table in view order
+     * Rows are stepped one at a time from SQLite, so reading a table of any size needs
+     * constant memory and nothing is loaded into the widget
+     * @param tableName Name of the table
+     * @param cursor Output query on the editor connection, positioned before the first row
+     * @return true if the cursor is open, false otherwise
+     */
+    bool OpenTableCursor(const QString &tableName, QSqlQuery &cursor);
+
+    /**
+     * @brief Prepare a native SQLite statement on a connection and bind its values
+     * For exporters that read column values with the sqlite3_column functions instead of
+     * converting every value to a QVariant (e.g. a query from BuildTableQuery on a task connection)
+     * @param database Open connection created by OpenDatabaseConnection
+     * @param queryString Statement to prepare
+     * @param bindValues Values for the placeholders in order
+     * @param statement Output statement with its values bound (finalized by the caller)
+     * @return true if the statement is ready to step, false otherwise
+     */
+    static bool PrepareNativeStatement(const QSqlDatabase &database, const QString &queryString, const QVariantList &bindValues,
+                                       sqlite3_stmt *&statement);
+
+    /**
+     * @brief Check if the keyset scan of a table has rows left to fetch
+     * @param tableName Name of the table
+     * @return true if FetchNextPage can return more rows, false otherwise
+     */
+    bool HasMoreRows(const QString &tableName) const;
+
+    /**
+     * @brief Replace the filter conditions of a table (applied on the next LoadTableData)
+     * @param tableName Name of the table to filter
+     * @param expressions Column name -> filter expression (see TableFilter), empty map clears the filter
+     * @param errorMessage Output description of the first invalid expression
+     * @return true if all expressions were valid, false otherwise (previous filter is kept)
+     */
+    bool SetTableFilter(const QString &tableName, const QMap<QString, QString> &expressions, QString &errorMessage);
+
+    /**
+     * @brief Column and direction of one ORDER BY term
+     */
+    struct SortKey {
+        QString ColumnName;              // Name of the sorted column
+        Qt::SortOrder Order;             // Sort direction
+    };
+
+    /**
+     * @brief Replace the sort keys of a table (applied on the next LoadTableData)
+     * Sorting runs in SQL with rowid as tiebreaker, pages continue from the last (sort key, rowid)
+     * @param tableName Name of the table to sort
+     * @param sortKeys Sort columns in priority order (empty list restores rowid order)
+     * @return true if all sort columns exist, false otherwise (previous sort is kept)
+     */
+    bool SetTableSort(const QString &tableName, const QList<SortKey> &sortKeys);
+
+    /**
+     * @brief Get the sort keys of a table
+     * @param tableName Name of the table
+     * @return QList of sort keys in priority order (empty if unsorted)
+     */
+    QList<SortKey> GetTableSort(const QString &tableName) const;
+
+    /**
+     * @brief Restrict a table to the rows matching a full-text search (applied on the next LoadTableData)
+     * Each whitespace separated term must occur in one of the indexed columns; a trailing * matches a prefix
+     * @param tableName Name of a table with a search index
+     * @param searchText Terms to search for, empty text removes the search
+     * @return true if the search was set, false if the table has no search index
+     */
+    bool SetTableSearch(const QString &tableName, const QString &searchText);
+
+    /**
+     * @brief Check if a full-text search is active for a table
+     * @param tableName Name of the table
+     * @return true if rows are restricted to search results, false otherwise
+     */
+    bool IsTableSearched(const QString &tableName) const;
+
+    /**
+     * @brief Get the columns covered by the search index of a table
+     * @param tableName Name of the table
+     * @return QStringList containing indexed column names (empty if the table has no search index)
+     */
+    QStringList GetSearchIndexColumns(const QString &tableName) const;
+
+    /**
+     * @brief Attach the search index file (if any) and re-read which tables it covers
+     * Call after a SearchIndexTask has finished building an index
+     */
+    void ReloadSearchIndexes();
+
+    /**
+     * @brief Get the columns of a table with text affinity (declared type containing CHAR, CLOB or TEXT, or none)
+     * @param tableName Name of the table
+     * @return QStringList containing text column names
+     */
+    QStringList GetTextColumns(const QString &tableName);
+
+    /**
+     * @brief Get the declared types of the columns of a table
+     * @param tableName Name of the table
+     * @return QStringList containing declared types in column order (empty string if none declared)
+     */
+    QStringList GetTableColumnTypes(const QString &tableName);
+
+    /**
+     * @brief Get the side database holding the full-text indexes of a database file
+     * @param filePath Path to the SQL database file
+     * @return Path to the search index file next to the database file
+     */
+    static QString GetSearchIndexFilePath(const QString &filePath);
+
+    /**
+     * @brief Get the FTS5 table indexing a table in the search index file
+     * @param tableName Name of the indexed table
+     * @return Unquoted FTS5 table name
+     */
+    static QString GetSearchIndexTableName(const QString &tableName);
+
+    /**
+     * @brief Get the FTS5 column names used for the indexed columns
+     * Source column names are not reused since FTS5 reserves names such as rank and rowid
+     * @param columnCount Number of indexed columns
+     * @return QStringList containing c0, c1, ...
+     */
+    static QStringList GetSearchIndexColumnNames(int columnCount);
+
+    static const QString SEARCH_INDEX_SCHEMA;      // Schema name the search index file is attached as
+    static const QString SEARCH_INDEX_META_TABLE;  // Table in the search index file listing the indexed tables
+
+    /**
+     * @brief Check if a filter is active for a table
+     * @param tableName Name of the table
+     * @return true if rows are filtered, false otherwise
+     */
+    bool IsTableFiltered(const QString &tableName) const;
+
+    /**
+     * @brief Get the active filter of a table
+     * @param tableName Name of the table
+     * @return Copy of the filter (empty if the table is unfiltered)
+     */
+    TableFilter GetTableFilter(const QString &tableName) const;
+
+    /**
+     * @brief Fetch columns that were not loaded when the table was loaded
+     * @param tableName Name of the table displayed in the widget
+     * @param tableWidget QTableWidget previously filled by LoadTableData
+     * @param columnNames Names of the columns to fetch for the rows in the widget (already loaded ones are skipped)
+     * @return true if all requested columns are loaded, false otherwise
+     */
+    bool LoadTableColumns(const QString &tableName, QTableWidget *tableWidget, const QStringList &columnNames);
+
+    /**
+     * @brief Check if a widget column holds values fetched from the database
+     * @param tableWidget QTableWidget filled by LoadTableData
+     * @param column Column index (0-based)
+     * @return true if the column values are loaded, false if it was left out of the projection
+     */
+    static bool IsColumnLoaded(QTableWidget *tableWidget, int column);
 
     /**
      * @brief Add new row to specified table
@@ -69,13 +297,38 @@ public:
     bool DeleteRowFromTable(const QString &tableName, int rowIndex);
 
     /**
-     * @brief Update entire table with new data
-     * @param tableName Name of the table to replace
+     * @brief Write table widget contents back to the database
+     * Loaded rows are updated by row id, new rows inserted and removed rows deleted;
+     * columns that were never fetched are left unchanged
+     * @param tableName Name of the table to update
      * @param tableWidget Source QTableWidget containing new data
      * @return true if table updated successfully, false otherwise
      */
     bool UpdateCompleteTable(const QString &tableName, QTableWidget *tableWidget);
 
+    /**
+     * @brief Callback reporting rows imported so far
+     * @return true to continue, false to stop the import
+     */
+    using ImportProgressCallback = std::function<bool(qint64 rowCount)>;
+
+    /**
+     * @brief Insert the objects of a JSON Lines stream as rows of a table
+     * Lines are parsed one at a time and inserted with one prepared statement, committed
+     * every IMPORT_BATCH_ROWS rows. The keys of the first line choose the inserted columns,
+     * so columns it leaves out keep their defaults; later lines missing a key insert NULL.
+     * On an error or cancellation the current batch is rolled back and earlier batches stay
+     * @param tableName Name of the table to insert into
+     * @param device Open input device positioned at the first line
+     * @param progress Called after each committed batch (may be empty)
+     * @param importedRows Output number of rows committed
+     * @param unknownKeys Output keys that matched no column and were ignored
+     * @param errorMessage Output description of the failure (empty on success)
+     * @return true if every line was imported, false otherwise
+     */
+    bool ImportJsonLines(const QString &tableName, QIODevice *device, const ImportProgressCallback &progress,
+                         qint64 &importedRows, QStringList &unknownKeys, QString &errorMessage);
+
     /**
      * @brief Save all changes back to the SQL database file (no-op for SQL as changes are immediate)
      * @return true always (SQL changes are committed immediately)
@@ -94,7 +347,80 @@ public:
      */
     bool IsFileLoaded() const;
 
+    /**
+     * @brief Get tables modified through this worker since the last maintenance run
+     * @return QStringList containing names of changed tables
+     */
+    QStringList GetChangedTables() const;
+
+    /**
+     * @brief Forget changed tables once maintenance has processed them
+     * @param tableNames Names of tables to remove from the changed set
+     */
+    void ClearChangedTables(const QStringList &tableNames);
+
+    /**
+     * @brief Open a new SQLite connection with the settings used by all workers
+     * @param filePath Path to the SQL database file to open
+     * @param connectionName Unique connection name (must be used from the calling thread only)
+     * @return Open QSqlDatabase, or a closed one if opening failed
+     */
+    static QSqlDatabase OpenDatabaseConnection(const QString &filePath, const QString &connectionName);
+
+    /**
+     * @brief Attach the search index file of a database file to a connection if the index exists
+     * Views restricted by a search look up their row ids in the index, so every connection
+     * running a view statement needs it attached as SEARCH_INDEX_SCHEMA
+     * @param database Open connection created by OpenDatabaseConnection
+     * @param filePath Path to the SQL database file the connection reads
+     * @return true if the index is attached or there is none, false if ATTACH failed
+     */
+    static bool AttachSearchIndexFile(QSqlDatabase &database, const QString &filePath);
+
+    /**
+     * @brief Quote an identifier for safe use in generated SQL
+     * @param identifier Table or column name
+     * @return Identifier wrapped in double quotes with embedded quotes doubled
+     */
+    static QString QuoteIdentifier(const QString &identifier);
+
+    static const int ROW_ID_ROLE;          // Item data role of row headers holding the database row id
+    static const int COLUMN_LOADED_ROLE;   // Item data role of column headers marking fetched columns
+
+    /**
+     * @brief Get a version number of the file contents, changing whenever any connection commits
+     * @return Data version, or -1 if no file is loaded
+     */
+    qint64 GetDataVersion();
+
+    /**
+     * @brief Get the native SQLite handle behind a QSQLITE connection
+     * @param database Open connection created by OpenDatabaseConnection
+     * @return sqlite3 handle, or nullptr if the connection is not an open SQLite connection
+     */
+    static sqlite3 *GetNativeHandle(const QSqlDatabase &database);
+
+    /**
+     * @brief Switch the loaded file to WAL mode until it is closed
+     * Used before long background reads on several connections, which would otherwise make
+     * a save wait for their shared locks; the previous journal mode is restored on close
+     * @return true if the file is in WAL mode, false otherwise
+     */
+    bool EnableWriteAheadLog();
+
+    /**
+     * @brief Atomically replace the loaded database file and reopen it
+     * @param replacementFilePath Path to a verified database file on the same file system
+     * @return true if the file was replaced and reopened, false otherwise
+     */
+    bool ReplaceDatabaseFile(const QString &replacementFilePath);
+
 private:
+    /**
+     * @brief Put back the journal mode the file had before EnableWriteAheadLog (no-op if unchanged)
+     */
+    void RestoreJournalMode();
+
     /**
      * @brief Parse SQL database and extract table structure
      */
@@ -107,6 +433,120 @@ private:
      */
     QStringList GetTableColumns(const QString &tableName);
 
+    /**
+     * @brief Column names and declared types of a table
+     */
+    struct TableSchema {
+        QStringList ColumnNames;         // Column names in declaration order
+        QStringList ColumnTypes;         // Declared column types (empty string if none declared)
+        bool HasRowId = false;           // Flag indicating rows have a rowid (false for WITHOUT ROWID tables)
+        QStringList PrimaryKeyColumns;   // Primary key columns in key order (empty if none declared)
+    };
+
+    /**
+     * @brief Keyset scan position of the table shown in the widget
+     */
+    struct TableViewState {
+        qint64 LastRowId = 0;            // Row id of the last fetched row
+        QVariantList LastSortValues;     // Sort key values of the last fetched row (empty if unsorted)
+        bool HasLastRow = false;         // Flag indicating at least one row was fetched (true) or none (false)
+        bool HasMoreRows = false;        // Flag indicating the last page was full (true) or the scan ended (false)
+        qint64 FirstRowPosition = 0;     // Position of the first widget row within the sorted and filtered table
+    };
+
+    /**
+     * @brief Load a table into the widget, starting the keyset scan at a given position
+     * @param startState Scan position before the first row to load (default state starts at the first row)
+     * @return true if data loaded successfully, false on error
+     */
+    bool LoadTableWindow(const QString &tableName, QTableWidget *tableWidget, const QStringList &hiddenColumns,
+                         int maxLoadedColumns, const TableViewState &startState);
+
+    /**
+     * @brief Append the filter and search conditions of a table
+     * @param conditions Output list of WHERE clause parts (joined with AND)
+     * @param bindValues Output list the placeholder values are appended to
+     */
+    void AppendViewConditions(const QString &tableName, QStringList &conditions, QVariantList &bindValues) const;
+
+    /**
+     * @brief Find the rowid of a row by single-column primary key, falling back to the rowid itself
+     * @param keyIsRowId true to skip the primary key lookup
+     * @param rowId Output row id
+     * @return true if the row exists, false otherwise
+     */
+    bool FindRowIdByKey(const QString &tableName, const TableSchema &schema, const QString &key, bool keyIsRowId, qint64 &rowId);
+
+    /**
+     * @brief Build the ORDER BY terms for a sort, ending with the rowid tiebreaker
+     * @return ORDER BY terms without the ORDER BY keywords
+     */
+    static QString BuildOrderByClause(const QList<SortKey> &sortKeys);
+
+    /**
+     * @brief Build the condition selecting rows after a (sort key, rowid) keyset position
+     * @param sortKeys Active sort keys
+     * @param lastValues Sort key values of the last fetched row
+     * @param lastRowId Row id of the last fetched row
+     * @param bindValues Output list the placeholder values are appended to
+     * @return Condition without the WHERE keyword
+     */
+    static QString BuildKeysetCondition(const QList<SortKey> &sortKeys, const QVariantList &lastValues,
+                                        qint64 lastRowId, QVariantList &bindValues);
+
+    /**
+     * @brief Append one keyset page of rows matching the table filter
+     * @return Number of rows appended, or -1 on error
+     */
+    int AppendRowsPage(const QString &tableName, QTableWidget *tableWidget);
+
+    /**
+     * @brief Load every row of a table without row ids, applying the table filter
+     * @return Number of rows loaded, or -1 on error
+     */
+    int AppendAllRowsWithoutRowId(const QString &tableName, QTableWidget *tableWidget);
+
+    /**
+     * @brief Get cached schema of the specified table, reading it on first use
+     * @param tableName Name of the table
+     * @return TableSchema with empty lists if the table could not be read
+     */
+    TableSchema GetTableSchema(const QString &tableName);
+
+    /**
+     * @brief Apply widget rows to the database by row id (inside an open transaction)
+     * @return true if all rows were written, false otherwise
+     */
+    bool ApplyTableChanges(const QString &tableName, QTableWidget *tableWidget);
+
+    /**
+     * @brief Delete all rows and insert the widget rows (inside an open transaction)
+     * Used for tables without row ids, where rows cannot be matched individually
+     * @return true if all rows were written, false otherwise
+     */
+    bool ReplaceTableContents(const QString &tableName, QTableWidget *tableWidget);
+
+    /**
+     * @brief Attach the search index file as SEARCH_INDEX_SCHEMA if it exists
+     * @return true if the index file is attached, false otherwise
+     */
+    bool AttachSearchIndex();
+
+    /**
+     * @brief Build the statement adding (or removing) one row of a table to its search index
+     * Contentless FTS5 tables need the indexed values to remove a row, so both read them from the table
+     * @param tableName Name of the indexed table
+     * @param remove true for the FTS5 'delete' command, false for a plain insert
+     * @return Statement with one placeholder for the row id
+     */
+    QString BuildSearchIndexSyncQuery(const QString &tableName, bool remove) const;
+
+    /**
+     * @brief Run a prepared search index sync statement for one row
+     * @return true if the statement succeeded, false otherwise
+     */
+    static bool ExecSearchIndexSync(QSqlQuery &query, qint64 rowId);
+
     /**
      * @brief Check if database connection is valid
      * @return true if connection is valid, false otherwise
@@ -139,13 +579,31 @@ private:
     bool FileLoaded;                     // Flag indicating if database file is loaded (true) or not loaded (false)
     QString ConnectionName;              // Unique connection name for this worker instance
     QMap<QString, QStringList> TableBackups;  // Backup storage for table data (table name -> serialized data)
+    QSet<QString> ChangedTables;         // Tables written since the last maintenance run (empty if none)
+    QMap<QString, QSet<qint64>> LoadedRowIds;  // Row ids shown in the widget per table (missing for tables without row ids)
+    QHash<QString, TableSchema> SchemaCache;   // Schema per table name, filled on first use (cleared on file load)
+    QHash<QString, TableViewState> ViewStates; // Keyset scan position per table (reset by LoadTableData)
+    QHash<QString, TableFilter> TableFilters;  // Active filter per table (missing if unfiltered)
+    QHash<QString, QList<SortKey>> TableSorts; // Active sort keys per table (missing if in rowid order)
+    QHash<QString, QStringList> SearchIndexColumns;  // Indexed source columns per table (missing if not indexed)
+    QHash<QString, QString> TableSearches;     // Active FTS5 match expression per table (missing if not searched)
+    bool SearchIndexAttached;            // Flag indicating the search index file is attached (true) or not (false)
+    qint64 LocalCommitCount;             // Commits made through this worker (not seen by PRAGMA data_version)
+    QString OriginalJournalMode;         // Journal mode to restore on close (empty if EnableWriteAheadLog changed nothing)
 
     // SQL query constants
     static const QString GET_TABLES_QUERY;        // Query to get all table names
     static const QString GET_COLUMNS_QUERY;       // Query template to get column information
     static const QString SELECT_ALL_QUERY;        // Query template to select all data from table
+    static const QString SELECT_PROJECTION_QUERY; // Query template to select row id and listed columns
     static const QString DELETE_ALL_QUERY;        // Query template to delete all data from table
     static const QString INSERT_QUERY_TEMPLATE;   // Query template for inserting rows
+    static const int BUSY_TIMEOUT_MS;             // Time a connection waits for locks held by other connections
+    static const int ROW_ALLOCATION_BLOCK;        // Rows added to the widget at once while loading
+    static const int PAGE_SIZE;                   // Rows fetched per keyset page
+    static const int JUMP_CONTEXT_ROWS;           // Rows loaded before the row a jump targets
+    static const int ROW_ID_BATCH_SIZE;           // Row ids bound per IN list when fetching columns
+    static const int IMPORT_BATCH_ROWS;           // Rows inserted per transaction by imports
 };
 
 #endif // SQLWORKER_H
@@ -0,0 +1,202 @@
+#include "tablefilter.h"
+#include "sqlworker.h"
+#include <QRegularExpression>
+
+/**
+ * @brief Constructor initializes an empty filter
+ */
+TableFilter::TableFilter()
+    : Conditions()                     // Active column conditions
+{
+}
+
+/**
+ * @brief Set or replace the expression of one column
+ */
+bool TableFilter::SetColumnExpression(const QString &columnName, const QString &expression, QString &errorMessage)
+{
+    // Drop any previous condition of the column first
+    for (int _i = 0; _i < Conditions.size(); ++_i) {  // Current condition index (0-based)
+        if (Conditions[_i].ColumnName == columnName) {
+            Conditions.removeAt(_i);
+            break;
+        }
+    }
+
+    if (expression.trimmed().isEmpty()) {
+        return true;
+    }
+
+    ColumnCondition _condition;  // Condition parsed from the expression
+    _condition.ColumnName = columnName;
+    _condition.Expression = expression;
+
+    if (!ParseExpression(expression.trimmed(), _condition, errorMessage)) {
+        errorMessage = QString("Column %1: %2").arg(columnName, errorMessage);
+        return false;
+    }
+
+    Conditions.append(_condition);
+    return true;
+}
+
+/**
+ * @brief Remove all column conditions
+ */
+void TableFilter::Clear()
+{
+    Conditions.clear();
+}
+
+/**
+ * @brief Check if any condition is active
+ */
+bool TableFilter::IsEmpty() const
+{
+    return Conditions.isEmpty();
+}
+
+/**
+ * @brief Build the SQL condition combining all columns with AND
+ */
+QString TableFilter::BuildWhereClause() const
+{
+    QStringList _parts;  // One SQL fragment per column condition
+
+    for (const ColumnCondition &_condition : Conditions) {
+        QString _column = SQLWorker::QuoteIdentifier(_condition.ColumnName);  // Quoted column name
+
+        switch (_condition.Operator) {
+        case Equals:         _parts.append(_column + " = ?"); break;
+        case Range:          _parts.append(_column + " BETWEEN ? AND ?"); break;
+        case GreaterThan:    _parts.append(_column + " > ?"); break;
+        case GreaterOrEqual: _parts.append(_column + " >= ?"); break;
+        case LessThan:       _parts.append(_column + " < ?"); break;
+        case LessOrEqual:    _parts.append(_column + " <= ?"); break;
+        case Like:           _parts.append(_column + " LIKE ?"); break;
+        case IsNull:         _parts.append(_column + " IS NULL"); break;
+        case IsNotNull:      _parts.append(_column + " IS NOT NULL"); break;
+        case Regexp:         _parts.append(_column + " REGEXP ?"); break;
+        case InList: {
+            QStringList _placeholders;  // One placeholder per list value
+            for (int _i = 0; _i < _condition.Values.size(); ++_i) {
+                _placeholders.append("?");
+            }
+            _parts.append(QString("%1 IN (%2)").arg(_column, _placeholders.join(", ")));
+            break;
+        }
+        }
+    }
+
+    return _parts.join(" AND ");
+}
+
+/**
+ * @brief Get values for the placeholders of BuildWhereClause in order
+ */
+QVariantList TableFilter::GetBindValues() const
+{
+    QVariantList _values;  // Bind values of all conditions in clause order
+    for (const ColumnCondition &_condition : Conditions) {
+        _values.append(_condition.Values);
+    }
+    return _values;
+}
+
+/**
+ * @brief Get the expressions currently set, keyed by column name
+ */
+QMap<QString, QString> TableFilter::GetExpressions() const
+{
+    QMap<QString, QString> _expressions;  // Column name -> expression text
+    for (const ColumnCondition &_condition : Conditions) {
+        _expressions.insert(_condition.ColumnName, _condition.Expression);
+    }
+    return _expressions;
+}
+
+/**
+ * @brief Parse a filter expression into a condition
+ */
+bool TableFilter::ParseExpression(const QString &expression, ColumnCondition &condition, QString &errorMessage)
+{
+    // NULL checks take no values
+    if (expression.compare("NULL", Qt::CaseInsensitive) == 0) {
+        condition.Operator = IsNull;
+        return true;
+    }
+    if (expression.compare("!NULL", Qt::CaseInsensitive) == 0) {
+        condition.Operator = IsNotNull;
+        return true;
+    }
+
+    // Regular expression; checked before ranges and lists since patterns may contain ".." or ";"
+    if (expression.startsWith('~')) {
+        QString _pattern = expression.mid(1);  // Pattern after the operator
+        QRegularExpression _expression(_pattern);  // Compiled once here only to report syntax errors early
+        if (_pattern.isEmpty() || !_expression.isValid()) {
+            errorMessage = _pattern.isEmpty() ? "missing pattern after '~'" : "invalid regular expression: " + _expression.errorString();
+            return false;
+        }
+        condition.Operator = Regexp;
+        condition.Values.append(_pattern);
+        return true;
+    }
+
+    // Comparison prefixes; two-character operators are checked first
+    static const QList<QPair<QString, ConditionOperator>> PREFIX_OPERATORS = {
+        {">=", GreaterOrEqual}, {"<=", LessOrEqual}, {">", GreaterThan}, {"<", LessThan}, {"=", Equals}
+    };
+    for (const auto &_prefix : PREFIX_OPERATORS) {
+        if (expression.startsWith(_prefix.first)) {
+            QString _value = expression.mid(_prefix.first.size()).trimmed();  // Operand after the operator
+            if (_value.isEmpty()) {
+                errorMessage = QString("missing value after '%1'").arg(_prefix.first);
+                return false;
+            }
+            condition.Operator = _prefix.second;
+            condition.Values.append(_value);
+            return true;
+        }
+    }
+
+    // Inclusive range "a..b"
+    int _rangeIndex = expression.indexOf("..");  // Position of the range separator (-1 if none)
+    if (_rangeIndex >= 0) {
+        QString _low = expression.left(_rangeIndex).trimmed();    // Lower bound
+        QString _high = expression.mid(_rangeIndex + 2).trimmed();  // Upper bound
+        if (_low.isEmpty() || _high.isEmpty()) {
+            errorMessage = "range needs both bounds (a..b)";
+            return false;
+        }
+        condition.Operator = Range;
+        condition.Values = {_low, _high};
+        return true;
+    }
+
+    // IN list "a;b;c"
+    if (expression.contains(';')) {
+        condition.Operator = InList;
+        for (const QString &_item : expression.split(';')) {
+            if (!_item.trimmed().isEmpty()) {
+                condition.Values.append(_item.trimmed());
+            }
+        }
+        if (condition.Values.isEmpty()) {
+            errorMessage = "empty value list";
+            return false;
+        }
+        return true;
+    }
+
+    // LIKE pattern when a % wildcard is present ('_' alone is too common in plain values)
+    if (expression.contains('%')) {
+        condition.Operator = Like;
+        condition.Values.append(expression);
+        return true;
+    }
+
+    condition.Operator = Equals;
+    condition.Values.append(expression);
+    return true;
+}
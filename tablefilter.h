@@ -0,0 +1,105 @@
+#ifndef TABLEFILTER_H
+#define TABLEFILTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVariantList>
+#include <QList>
+#include <QMap>
+#include <QPair>
+
+/**
+ * @brief Per-column filter conditions compiled into a parameterized WHERE clause
+ * Each column accepts a short expression typed into the filter bar:
+ *   value        equals            a..b         range (inclusive)
+ *   >x  >=x      lower bound       <x  <=x      upper bound
+ *   %abc%        LIKE pattern      a;b;c        IN list
+ *   NULL         IS NULL           !NULL        IS NOT NULL
+ *   ~regex       REGEXP (evaluated by SQLite, see SQLiteFunctions)
+ * Values are always bound as parameters, so column affinity and indexes apply
+ */
+class TableFilter
+{
+public:
+    /**
+     * @brief Constructor for TableFilter
+     */
+    TableFilter();
+
+    /**
+     * @brief Set or replace the expression of one column
+     * @param columnName Name of the filtered column
+     * @param expression Filter expression (empty removes the column condition)
+     * @param errorMessage Output description of a syntax error
+     * @return true if expression was accepted, false on syntax error
+     */
+    bool SetColumnExpression(const QString &columnName, const QString &expression, QString &errorMessage);
+
+    /**
+     * @brief Remove all column conditions
+     */
+    void Clear();
+
+    /**
+     * @brief Check if any condition is active
+     * @return true if no condition is set, false otherwise
+     */
+    bool IsEmpty() const;
+
+    /**
+     * @brief Build the SQL condition combining all columns with AND
+     * @return Condition without the WHERE keyword (empty if no condition is set)
+     */
+    QString BuildWhereClause() const;
+
+    /**
+     * @brief Get values for the placeholders of BuildWhereClause in order
+     * @return QVariantList containing bind values
+     */
+    QVariantList GetBindValues() const;
+
+    /**
+     * @brief Get the expressions currently set, keyed by column name
+     * @return QMap containing column name -> expression text
+     */
+    QMap<QString, QString> GetExpressions() const;
+
+private:
+    /**
+     * @brief Comparison performed by a single condition
+     */
+    enum ConditionOperator {
+        Equals,                          // column = ?
+        Range,                           // column BETWEEN ? AND ?
+        GreaterThan,                     // column > ?
+        GreaterOrEqual,                  // column >= ?
+        LessThan,                        // column < ?
+        LessOrEqual,                     // column <= ?
+        Like,                            // column LIKE ?
+        InList,                          // column IN (?, ...)
+        IsNull,                          // column IS NULL
+        IsNotNull,                       // column IS NOT NULL
+        Regexp                           // column REGEXP ?
+    };
+
+    /**
+     * @brief Parsed condition for one column
+     */
+    struct ColumnCondition {
+        QString ColumnName;              // Name of the filtered column
+        QString Expression;              // Expression text as typed by the user
+        ConditionOperator Operator;      // Comparison to perform
+        QVariantList Values;             // Bind values used by the comparison (empty for NULL checks)
+    };
+
+    /**
+     * @brief Parse a filter expression into a condition
+     * @return true if expression is valid, false otherwise
+     */
+    static bool ParseExpression(const QString &expression, ColumnCondition &condition, QString &errorMessage);
+
+    QList<ColumnCondition> Conditions;   // Active conditions in the order columns were filtered
+};
+
+#endif // TABLEFILTER_H
@@ -0,0 +1,259 @@
+#include "tablefindscanner.h"
+#include <QElapsedTimer>
+#include <QtAlgorithms>
+#include <algorithm>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Define scanning constants
+const int TableFindScanner::ROWS_PER_BLOCK = 4096;
+const int TableFindScanner::SCAN_TICK_BUDGET_MS = 15;
+
+/**
+ * @brief Constructor initializes the scanner and watches the table for changes
+ */
+TableFindScanner::TableFindScanner(QTableWidget *tableWidget, QObject *parent)
+    : QObject(parent)
+    , TableWidget(tableWidget)         // Searched table
+    , Blocks()                         // Cached column buffers
+    , Needle("")                       // Current search text
+    , Hits()                           // Hits of the current search
+    , NextBlock(-1)                    // No scan running
+    , ScanTimer(new QTimer(this))      // Incremental scan driver
+{
+    ScanTimer->setInterval(0);
+    connect(ScanTimer, &QTimer::timeout, this, &TableFindScanner::ScanNextBlocks);
+
+    // Any change to the cells makes the cached buffers stale
+    QAbstractItemModel *_model = tableWidget->model();  // Model behind the table widget
+    connect(_model, &QAbstractItemModel::dataChanged, this, &TableFindScanner::Invalidate);
+    connect(_model, &QAbstractItemModel::rowsInserted, this, &TableFindScanner::Invalidate);
+    connect(_model, &QAbstractItemModel::rowsRemoved, this, &TableFindScanner::Invalidate);
+    connect(_model, &QAbstractItemModel::columnsInserted, this, &TableFindScanner::Invalidate);
+    connect(_model, &QAbstractItemModel::columnsRemoved, this, &TableFindScanner::Invalidate);
+    connect(_model, &QAbstractItemModel::modelReset, this, &TableFindScanner::Invalidate);
+}
+
+/**
+ * @brief Start a case-insensitive search, replacing the previous one
+ */
+void TableFindScanner::StartFind(const QString &text)
+{
+    ScanTimer->stop();
+    Hits.clear();
+    Needle = text.toCaseFolded();
+
+    if (Needle.isEmpty() || Needle.contains(QChar(0))) {
+        NextBlock = -1;
+        emit HitsFound(0, true);
+        return;
+    }
+
+    NextBlock = 0;
+    ScanTimer->start();
+}
+
+/**
+ * @brief Stop a running search, keeping the hits found so far
+ */
+void TableFindScanner::Cancel()
+{
+    ScanTimer->stop();
+    NextBlock = -1;
+}
+
+/**
+ * @brief Check if a search is still scanning rows
+ */
+bool TableFindScanner::IsScanning() const
+{
+    return NextBlock >= 0;
+}
+
+/**
+ * @brief Get the hits found so far in row-major order
+ */
+const QVector<TableFindScanner::FindHit> &TableFindScanner::GetHits() const
+{
+    return Hits;
+}
+
+/**
+ * @brief Drop the cached buffers after the table contents changed
+ * A running scan is stopped since its remaining blocks no longer match the hits collected so far
+ */
+void TableFindScanner::Invalidate()
+{
+    Blocks.clear();
+    if (IsScanning()) {
+        Cancel();
+        emit HitsFound(Hits.size(), true);
+    }
+}
+
+/**
+ * @brief Scan row blocks until the per-tick time budget is used up
+ */
+void TableFindScanner::ScanNextBlocks()
+{
+    int _blockCount = (TableWidget->rowCount() + ROWS_PER_BLOCK - 1) / ROWS_PER_BLOCK;  // Blocks covering the loaded rows
+    int _hitsBefore = Hits.size();  // Hits known before this tick
+
+    QElapsedTimer _timer;  // Measures time spent in this tick
+    _timer.start();
+    while (NextBlock >= 0 && NextBlock < _blockCount && _timer.elapsed() < SCAN_TICK_BUDGET_MS) {
+        ScanBlock(NextBlock);
+        NextBlock++;
+    }
+
+    bool _finished = NextBlock < 0 || NextBlock >= _blockCount;  // Every loaded row has been scanned
+    if (_finished) {
+        ScanTimer->stop();
+        NextBlock = -1;
+    }
+
+    if (_finished || Hits.size() != _hitsBefore) {
+        emit HitsFound(Hits.size(), _finished);
+    }
+}
+
+/**
+ * @brief Copy the cells of a block of rows into per-column buffers
+ */
+void TableFindScanner::BuildBlock(int blockIndex)
+{
+    if (Blocks.size() <= blockIndex) {
+        Blocks.resize(blockIndex + 1);
+    }
+
+    int _firstRow = blockIndex * ROWS_PER_BLOCK;  // First widget row of the block
+    int _lastRow = qMin(_firstRow + ROWS_PER_BLOCK, TableWidget->rowCount());  // One past the last row of the block
+    QVector<ColumnBuffer> &_columns = Blocks[blockIndex];  // Buffers of this block
+    _columns.resize(TableWidget->columnCount());
+
+    for (int _col = 0; _col < _columns.size(); ++_col) {  // Current column index (0-based)
+        ColumnBuffer &_buffer = _columns[_col];  // Buffer receiving this column's cells
+        _buffer.CellEnds.reserve(_lastRow - _firstRow);
+        for (int _row = _firstRow; _row < _lastRow; ++_row) {  // Current row index (0-based)
+            QTableWidgetItem *_item = TableWidget->item(_row, _col);  // Cell item (nullptr if empty)
+            if (_item) {
+                _buffer.Text += _item->text().toCaseFolded();
+            }
+            _buffer.CellEnds.append(_buffer.Text.size());
+            _buffer.Text += QChar(0);  // Separator keeps matches inside one cell
+        }
+    }
+}
+
+/**
+ * @brief Collect the hits of one block in row-major order
+ */
+void TableFindScanner::ScanBlock(int blockIndex)
+{
+    if (blockIndex >= Blocks.size() || Blocks[blockIndex].isEmpty()) {
+        BuildBlock(blockIndex);
+    }
+
+    int _firstRow = blockIndex * ROWS_PER_BLOCK;  // First widget row of the block
+    const char16_t *_needle = reinterpret_cast<const char16_t *>(Needle.utf16());  // Case-folded search text
+    QVector<FindHit> _blockHits;  // Hits of this block in column-major order
+
+    const QVector<ColumnBuffer> &_columns = Blocks[blockIndex];  // Buffers of this block
+    for (int _col = 0; _col < _columns.size(); ++_col) {  // Current column index (0-based)
+        if (TableWidget->isColumnHidden(_col)) {
+            continue;
+        }
+
+        const ColumnBuffer &_buffer = _columns[_col];  // Cells of this column
+        const char16_t *_text = reinterpret_cast<const char16_t *>(_buffer.Text.utf16());  // Contiguous cell texts
+        int _offset = 0;  // Scan position within the buffer
+
+        while (true) {
+            int _match = FindInBuffer(_text, _buffer.Text.size(), _needle, Needle.size(), _offset);  // Next occurrence (-1 if none)
+            if (_match < 0) {
+                break;
+            }
+
+            // A cell is reported once, so continue after the end of the matching cell
+            int _cell = static_cast<int>(std::upper_bound(_buffer.CellEnds.begin(), _buffer.CellEnds.end(), _match)
+                                         - _buffer.CellEnds.begin());  // Row within the block
+            _blockHits.append({_firstRow + _cell, _col});
+            _offset = _buffer.CellEnds[_cell] + 1;
+        }
+    }
+
+    std::sort(_blockHits.begin(), _blockHits.end(), [](const FindHit &_a, const FindHit &_b) {
+        return _a.Row != _b.Row ? _a.Row < _b.Row : _a.Column < _b.Column;
+    });
+    Hits += _blockHits;
+}
+
+/**
+ * @brief Find the code units of a needle in a UTF-16 buffer
+ * Candidate positions must match both the first and the last needle code unit, which
+ * the vector loops test for 16 (AVX2) or 8 (SSE2) positions at once before comparing the rest
+ */
+int TableFindScanner::FindInBuffer(const char16_t *haystack, int haystackLength,
+                                   const char16_t *needle, int needleLength, int from)
+{
+    if (needleLength <= 0 || haystackLength - from < needleLength) {
+        return -1;
+    }
+
+    const int _lastStart = haystackLength - needleLength;  // Last offset a match can start at
+    const char16_t _first = needle[0];                     // First code unit of the needle
+    const char16_t _last = needle[needleLength - 1];       // Last code unit of the needle
+    const int _middleLength = qMax(0, needleLength - 2);   // Code units between first and last
+    int _pos = from;  // Current candidate offset
+
+#if defined(__AVX2__)
+    const __m256i _firstVector = _mm256_set1_epi16(static_cast<short>(_first));  // First code unit in every lane
+    const __m256i _lastVector = _mm256_set1_epi16(static_cast<short>(_last));    // Last code unit in every lane
+    for (; _pos + 16 <= _lastStart + 1; _pos += 16) {
+        __m256i _blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + _pos));
+        __m256i _blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + _pos + needleLength - 1));
+        __m256i _equal = _mm256_and_si256(_mm256_cmpeq_epi16(_blockFirst, _firstVector),
+                                          _mm256_cmpeq_epi16(_blockLast, _lastVector));  // Lanes matching both ends
+        quint32 _mask = static_cast<quint32>(_mm256_movemask_epi8(_equal));  // Two bits per matching lane
+
+        while (_mask != 0) {
+            int _lane = qCountTrailingZeroBits(_mask) / 2;  // Candidate lane (0-15)
+            if (std::equal(needle + 1, needle + 1 + _middleLength, haystack + _pos + _lane + 1)) {
+                return _pos + _lane;
+            }
+            _mask &= ~(3u << (_lane * 2));
+        }
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i _firstVector = _mm_set1_epi16(static_cast<short>(_first));  // First code unit in every lane
+    const __m128i _lastVector = _mm_set1_epi16(static_cast<short>(_last));    // Last code unit in every lane
+    for (; _pos + 8 <= _lastStart + 1; _pos += 8) {
+        __m128i _blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + _pos));
+        __m128i _blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + _pos + needleLength - 1));
+        __m128i _equal = _mm_and_si128(_mm_cmpeq_epi16(_blockFirst, _firstVector),
+                                       _mm_cmpeq_epi16(_blockLast, _lastVector));  // Lanes matching both ends
+        quint32 _mask = static_cast<quint32>(_mm_movemask_epi8(_equal));  // Two bits per matching lane
+
+        while (_mask != 0) {
+            int _lane = qCountTrailingZeroBits(_mask) / 2;  // Candidate lane (0-7)
+            if (std::equal(needle + 1, needle + 1 + _middleLength, haystack + _pos + _lane + 1)) {
+                return _pos + _lane;
+            }
+            _mask &= ~(3u << (_lane * 2));
+        }
+    }
+#endif
+
+    // Scalar fallback and tail of the vector loops
+    for (; _pos <= _lastStart; ++_pos) {
+        if (haystack[_pos] == _first && haystack[_pos + needleLength - 1] == _last
+            && std::equal(needle + 1, needle + 1 + _middleLength, haystack + _pos + 1)) {
+            return _pos;
+        }
+    }
+
+    return -1;
+}
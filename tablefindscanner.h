@@ -0,0 +1,125 @@
+#ifndef TABLEFINDSCANNER_H
+#define TABLEFINDSCANNER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QTimer>
+#include <QTableWidget>
+
+/**
+ * @brief Incremental find-in-table over the rows loaded into a QTableWidget
+ * Cell texts are copied once into contiguous case-folded UTF-16 buffers per
+ * column and block of rows; searches then scan those buffers with a vectorized
+ * kernel instead of calling QTableWidgetItem::text() for every cell
+ */
+class TableFindScanner : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Cell containing the search text
+     */
+    struct FindHit {
+        int Row;                         // Widget row index (0-based)
+        int Column;                      // Widget column index (0-based)
+    };
+
+    /**
+     * @brief Constructor for TableFindScanner
+     * @param tableWidget Table whose loaded cells are searched (must outlive the scanner)
+     * @param parent Parent object pointer
+     */
+    explicit TableFindScanner(QTableWidget *tableWidget, QObject *parent = nullptr);
+
+    /**
+     * @brief Start a case-insensitive search, replacing the previous one
+     * Hits are collected block by block from the event loop and reported with HitsFound
+     * @param text Text to find (empty text clears the hits)
+     */
+    void StartFind(const QString &text);
+
+    /**
+     * @brief Stop a running search, keeping the hits found so far
+     */
+    void Cancel();
+
+    /**
+     * @brief Check if a search is still scanning rows
+     * @return true if more hits may be reported, false otherwise
+     */
+    bool IsScanning() const;
+
+    /**
+     * @brief Get the hits found so far in row-major order
+     * @return QVector of hits (empty if nothing found)
+     */
+    const QVector<FindHit> &GetHits() const;
+
+    /**
+     * @brief Find the code units of a needle in a UTF-16 buffer
+     * Uses AVX2 or SSE2 when the build targets them, otherwise a scalar loop
+     * @param haystack Buffer to search
+     * @param haystackLength Number of code units in the buffer
+     * @param needle Code units to find
+     * @param needleLength Number of code units in the needle (at least 1)
+     * @param from Offset the search starts at
+     * @return Offset of the first occurrence at or after from, or -1 if there is none
+     */
+    static int FindInBuffer(const char16_t *haystack, int haystackLength,
+                            const char16_t *needle, int needleLength, int from);
+
+signals:
+    /**
+     * @brief Emitted whenever a scanned block added hits, and once when the scan ends
+     * @param hitCount Number of hits found so far
+     * @param finished true if every loaded row has been scanned, false otherwise
+     */
+    void HitsFound(int hitCount, bool finished);
+
+public slots:
+    /**
+     * @brief Drop the cached buffers after the table contents changed
+     */
+    void Invalidate();
+
+private slots:
+    /**
+     * @brief Scan row blocks until the per-tick time budget is used up
+     */
+    void ScanNextBlocks();
+
+private:
+    /**
+     * @brief Case-folded texts of one column within a block of rows
+     */
+    struct ColumnBuffer {
+        QString Text;                    // Cell texts separated by a NUL code unit
+        QVector<int> CellEnds;           // Offset of the separator after each row's cell
+    };
+
+    /**
+     * @brief Copy the cells of a block of rows into per-column buffers
+     * @param blockIndex Block number (rows blockIndex * ROWS_PER_BLOCK onwards)
+     */
+    void BuildBlock(int blockIndex);
+
+    /**
+     * @brief Collect the hits of one block in row-major order
+     * @param blockIndex Block number to scan
+     */
+    void ScanBlock(int blockIndex);
+
+    QTableWidget *TableWidget;           // Table whose cells are searched
+    QVector<QVector<ColumnBuffer>> Blocks;  // Buffers per row block and column (empty vector if not built yet)
+    QString Needle;                      // Case-folded search text (empty if no search)
+    QVector<FindHit> Hits;               // Hits found so far in row-major order
+    int NextBlock;                       // Next block to scan (-1 if no scan is running)
+    QTimer *ScanTimer;                   // Zero-interval timer driving the incremental scan
+
+    static const int ROWS_PER_BLOCK;     // Rows copied into one set of column buffers
+    static const int SCAN_TICK_BUDGET_MS;  // Time spent scanning before returning to the event loop
+};
+
+#endif // TABLEFINDSCANNER_H
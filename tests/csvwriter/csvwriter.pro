@@ -0,0 +1,22 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 testcase console
+CONFIG -= app_bundle
+
+TARGET = tst_csvwriter
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+
+# Source files
+SOURCES += \
+    tst_csvwriter.cpp \
+    ../../csvwriter.cpp
+
+# Header files
+HEADERS += \
+    ../../csvwriter.h
+
+# Compiler flags for professional development
+QMAKE_CXXFLAGS += -Wall -Wextra -pedantic
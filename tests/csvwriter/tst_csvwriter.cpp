@@ -0,0 +1,402 @@
+#include "csvwriter.h"
+#include <QtTest>
+#include <QBuffer>
+#include <QRandomGenerator>
+
+/**
+ * @brief Tests of the CSV field quoting kernel against a byte-by-byte reference
+ * The corpus targets the block structure of the vector loops: the first special byte at
+ * every offset of 16 and 32 byte blocks, quote runs crossing block edges and fields made
+ * of line breaks only. The benchmarks compare the kernel with the scalar encoder it replaced
+ */
+class TestCsvWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Hand-written fields with their exact expected encoding
+     */
+    void KnownFields_data();
+    void KnownFields();
+
+    /**
+     * @brief Fields without a special byte are copied unchanged at every length
+     */
+    void PlainFields();
+
+    /**
+     * @brief One special byte at every offset of fields spanning several vector blocks
+     */
+    void FirstSpecialAtEveryOffset_data();
+    void FirstSpecialAtEveryOffset();
+
+    /**
+     * @brief Runs of quotes starting at every offset and crossing block edges
+     */
+    void QuoteRunsAcrossBlockEdges();
+
+    /**
+     * @brief Fields consisting of carriage returns and line feeds only
+     */
+    void LineBreakOnlyFields_data();
+    void LineBreakOnlyFields();
+
+    /**
+     * @brief Random fields with special bytes and UTF-8 sequences of every density
+     */
+    void RandomCorpus();
+
+    /**
+     * @brief Encoding time of the kernel and of the scalar encoder on the same fields
+     */
+    void BenchmarkQuoting_data();
+    void BenchmarkQuoting();
+
+private:
+    /**
+     * @brief Encode one field as a single-column row through CsvWriter
+     * @param field Raw bytes of the field
+     * @return Encoded field without the row terminator
+     */
+    static QByteArray EncodeRow(const QByteArray &field);
+
+    /**
+     * @brief Quote a field one byte at a time (reference and scalar benchmark baseline)
+     * Scans for a special byte first and doubles quotes while copying, as the encoder did
+     * before the vector kernel
+     * @param data Bytes of the field
+     * @param length Number of bytes
+     * @param output Buffer receiving the encoded field
+     */
+    static void AppendFieldScalar(const char *data, int length, QByteArray &output);
+
+    /**
+     * @brief Build a field of filler bytes with bytes replaced at given offsets
+     */
+    static QByteArray MakeField(int length, const QVector<int> &offsets, char special);
+
+    /**
+     * @brief Generate benchmark fields
+     * @param fieldCount Number of fields
+     * @param minLength Shortest field in bytes
+     * @param maxLength Longest field in bytes
+     * @param specialRate One byte in specialRate is a separator or quote (0 for none)
+     */
+    static QVector<QByteArray> MakeBenchmarkFields(int fieldCount, int minLength, int maxLength, int specialRate);
+
+    /**
+     * @brief Compare the kernel with the reference on one field, naming the field on failure
+     * The kernel is checked both through the writer and appended after existing buffer bytes
+     */
+    static bool MatchesReference(const QByteArray &field);
+};
+
+/**
+ * @brief Encode one field as a single-column row through CsvWriter
+ */
+QByteArray TestCsvWriter::EncodeRow(const QByteArray &field)
+{
+    QBuffer _device;  // In-memory output
+    _device.open(QIODevice::WriteOnly);
+    {
+        CsvWriter _writer(&_device);  // Encoder under test
+        _writer.WriteValue(field);  // BLOB values go through the quoting kernel as raw bytes
+        _writer.EndRow();
+        _writer.Flush();
+    }
+    QByteArray _encoded = _device.data();  // Row as written
+    _encoded.chop(1);  // Row terminator
+    return _encoded;
+}
+
+/**
+ * @brief Quote a field one byte at a time
+ */
+void TestCsvWriter::AppendFieldScalar(const char *data, int length, QByteArray &output)
+{
+    bool _needsQuotes = false;  // Field contains a separator, quote or line break
+    for (int _i = 0; _i < length; ++_i) {
+        char _c = data[_i];  // Current byte
+        if (_c == ',' || _c == '"' || _c == '\n' || _c == '\r') {
+            _needsQuotes = true;
+            break;
+        }
+    }
+    if (!_needsQuotes) {
+        output.append(data, length);
+        return;
+    }
+
+    output.append('"');
+    for (int _i = 0; _i < length; ++_i) {
+        if (data[_i] == '"') {
+            output.append('"');
+        }
+        output.append(data[_i]);
+    }
+    output.append('"');
+}
+
+/**
+ * @brief Build a field of filler bytes with bytes replaced at given offsets
+ */
+QByteArray TestCsvWriter::MakeField(int length, const QVector<int> &offsets, char special)
+{
+    QByteArray _field(length, 'a');  // Filler without special bytes
+    for (int _offset : offsets) {
+        _field[_offset] = special;
+    }
+    return _field;
+}
+
+/**
+ * @brief Generate benchmark fields
+ */
+QVector<QByteArray> TestCsvWriter::MakeBenchmarkFields(int fieldCount, int minLength, int maxLength, int specialRate)
+{
+    QRandomGenerator _random(42);  // Fixed seed keeps runs comparable
+    QVector<QByteArray> _fields;  // Generated fields
+    _fields.reserve(fieldCount);
+    for (int _i = 0; _i < fieldCount; ++_i) {
+        int _length = _random.bounded(minLength, maxLength + 1);  // Bytes of this field
+        QByteArray _field(_length, Qt::Uninitialized);  // Field being generated
+        for (int _j = 0; _j < _length; ++_j) {
+            if (specialRate > 0 && _random.bounded(specialRate) == 0) {
+                _field[_j] = _random.bounded(2) == 0 ? ',' : '"';
+            } else {
+                _field[_j] = static_cast<char>('a' + _random.bounded(26));
+            }
+        }
+        _fields.append(_field);
+    }
+    return _fields;
+}
+
+/**
+ * @brief Compare the kernel with the reference on one field
+ */
+bool TestCsvWriter::MatchesReference(const QByteArray &field)
+{
+    QByteArray _expected;  // Reference encoding
+    AppendFieldScalar(field.constData(), field.size(), _expected);
+    QByteArray _actual = EncodeRow(field);  // Kernel encoding through the writer
+    QByteArray _appended("prefix");  // Buffer that already holds bytes before the field
+    CsvWriter::EncodeField(field.constData(), field.size(), _appended);
+    if (_actual != _expected || _appended != "prefix" + _expected) {
+        qWarning() << "Field" << field.toPercentEncoding() << "encoded as" << _actual.toPercentEncoding()
+                   << "expected" << _expected.toPercentEncoding();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Hand-written fields with their exact expected encoding
+ */
+void TestCsvWriter::KnownFields_data()
+{
+    QTest::addColumn<QByteArray>("field");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("empty") << QByteArray("") << QByteArray("");
+    QTest::newRow("plain") << QByteArray("abc") << QByteArray("abc");
+    QTest::newRow("separator") << QByteArray("a,b") << QByteArray("\"a,b\"");
+    QTest::newRow("quote only") << QByteArray("\"") << QByteArray("\"\"\"\"");
+    QTest::newRow("quoted word") << QByteArray("say \"hi\"") << QByteArray("\"say \"\"hi\"\"\"");
+    QTest::newRow("line feed") << QByteArray("a\nb") << QByteArray("\"a\nb\"");
+    QTest::newRow("carriage return") << QByteArray("a\rb") << QByteArray("\"a\rb\"");
+    QTest::newRow("utf-8") << QByteArray("caf\xC3\xA9, cr\xC3\xA8me") << QByteArray("\"caf\xC3\xA9, cr\xC3\xA8me\"");
+    QTest::newRow("quote after block") << QByteArray(40, 'x') + "\"" << "\"" + QByteArray(40, 'x') + "\"\"\"";
+}
+
+/**
+ * @brief Hand-written fields with their exact expected encoding
+ */
+void TestCsvWriter::KnownFields()
+{
+    QFETCH(QByteArray, field);
+    QFETCH(QByteArray, expected);
+
+    QCOMPARE(EncodeRow(field), expected);
+}
+
+/**
+ * @brief Fields without a special byte are copied unchanged at every length
+ */
+void TestCsvWriter::PlainFields()
+{
+    for (int _length = 0; _length <= 130; ++_length) {  // Covers several 16 and 32 byte blocks and every tail length
+        QByteArray _field(_length, Qt::Uninitialized);  // Letters and UTF-8 continuation bytes
+        for (int _i = 0; _i < _length; ++_i) {
+            _field[_i] = static_cast<char>(_i % 3 == 2 ? 0xA9 : 'a' + _i % 26);
+        }
+        QCOMPARE(EncodeRow(_field), _field);
+    }
+}
+
+/**
+ * @brief One special byte at every offset of fields spanning several vector blocks
+ */
+void TestCsvWriter::FirstSpecialAtEveryOffset_data()
+{
+    QTest::addColumn<char>("special");
+
+    QTest::newRow("separator") << ',';
+    QTest::newRow("quote") << '"';
+    QTest::newRow("line feed") << '\n';
+    QTest::newRow("carriage return") << '\r';
+}
+
+/**
+ * @brief One special byte at every offset of fields spanning several vector blocks
+ */
+void TestCsvWriter::FirstSpecialAtEveryOffset()
+{
+    QFETCH(char, special);
+
+    const int _lengths[] = {1, 15, 16, 17, 31, 32, 33, 47, 48, 63, 64, 65, 100};  // Block multiples and their neighbours
+    for (int _length : _lengths) {
+        for (int _offset = 0; _offset < _length; ++_offset) {
+            QVERIFY(MatchesReference(MakeField(_length, {_offset}, special)));
+
+            // A second special byte later in the field must not change the first decision
+            if (_offset + 17 < _length) {
+                QVERIFY(MatchesReference(MakeField(_length, {_offset, _offset + 17}, special)));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs of quotes starting at every offset and crossing block edges
+ */
+void TestCsvWriter::QuoteRunsAcrossBlockEdges()
+{
+    const int _length = 100;  // Field spanning three 32 byte blocks plus a tail
+    for (int _start = 0; _start < _length; ++_start) {
+        for (int _runLength = 1; _start + _runLength <= _length && _runLength <= 40; ++_runLength) {
+            QVector<int> _offsets;  // Positions of the quote run
+            for (int _i = _start; _i < _start + _runLength; ++_i) {
+                _offsets.append(_i);
+            }
+            QVERIFY(MatchesReference(MakeField(_length, _offsets, '"')));
+        }
+    }
+
+    // A run that follows a separator, so the field is already quoted when the run begins
+    for (int _start = 1; _start < 70; ++_start) {
+        QByteArray _field = MakeField(96, {0}, ',');  // Separator opens the quotes
+        _field.replace(_start, 26, QByteArray(26, '"'));
+        QVERIFY(MatchesReference(_field));
+    }
+
+    // Only quotes, so every byte doubles
+    for (int _length = 1; _length <= 70; ++_length) {
+        QVERIFY(MatchesReference(QByteArray(_length, '"')));
+    }
+}
+
+/**
+ * @brief Fields consisting of carriage returns and line feeds only
+ */
+void TestCsvWriter::LineBreakOnlyFields_data()
+{
+    QTest::addColumn<QByteArray>("field");
+
+    QTest::newRow("lf") << QByteArray("\n");
+    QTest::newRow("cr") << QByteArray("\r");
+    QTest::newRow("crlf") << QByteArray("\r\n");
+    QTest::newRow("lf run") << QByteArray(33, '\n');
+    QTest::newRow("cr run") << QByteArray(64, '\r');
+    QTest::newRow("crlf run") << QByteArray("\r\n").repeated(40);
+}
+
+/**
+ * @brief Fields consisting of carriage returns and line feeds only
+ */
+void TestCsvWriter::LineBreakOnlyFields()
+{
+    QFETCH(QByteArray, field);
+
+    QCOMPARE(EncodeRow(field), "\"" + field + "\"");
+}
+
+/**
+ * @brief Random fields with special bytes and UTF-8 sequences of every density
+ */
+void TestCsvWriter::RandomCorpus()
+{
+    const char _alphabet[] = "ab,\"\n\rxyz0123456789 \xC3\xA9";  // Specials, filler and a UTF-8 sequence
+    const int _alphabetSize = static_cast<int>(sizeof(_alphabet)) - 1;  // Bytes without the terminator
+    QRandomGenerator _random(1);  // Fixed seed keeps failures reproducible
+
+    for (int _i = 0; _i < 20000; ++_i) {
+        int _length = _random.bounded(200);  // Bytes of this field
+        int _density = _random.bounded(4);  // 0: letters only, otherwise the full alphabet
+        QByteArray _field(_length, Qt::Uninitialized);  // Field being generated
+        for (int _j = 0; _j < _length; ++_j) {
+            _field[_j] = _density == 0 ? static_cast<char>('a' + _random.bounded(26)) : _alphabet[_random.bounded(_alphabetSize)];
+        }
+        QVERIFY(MatchesReference(_field));
+    }
+}
+
+/**
+ * @brief Encoding time of the kernel and of the scalar encoder on the same fields
+ */
+void TestCsvWriter::BenchmarkQuoting_data()
+{
+    QTest::addColumn<bool>("vector");
+    QTest::addColumn<int>("minLength");
+    QTest::addColumn<int>("maxLength");
+    QTest::addColumn<int>("specialRate");
+
+    QTest::newRow("short plain, scalar") << false << 4 << 16 << 0;
+    QTest::newRow("short plain, vector") << true << 4 << 16 << 0;
+    QTest::newRow("medium plain, scalar") << false << 32 << 128 << 0;
+    QTest::newRow("medium plain, vector") << true << 32 << 128 << 0;
+    QTest::newRow("long plain, scalar") << false << 1000 << 4000 << 0;
+    QTest::newRow("long plain, vector") << true << 1000 << 4000 << 0;
+    QTest::newRow("medium 2% special, scalar") << false << 32 << 128 << 50;
+    QTest::newRow("medium 2% special, vector") << true << 32 << 128 << 50;
+    QTest::newRow("long 1% special, scalar") << false << 1000 << 4000 << 100;
+    QTest::newRow("long 1% special, vector") << true << 1000 << 4000 << 100;
+}
+
+/**
+ * @brief Encoding time of the kernel and of the scalar encoder on the same fields
+ * Both append about 8 MiB of fields to a buffer that is emptied whenever it reaches the
+ * writer's block size, as CsvWriter does before handing a block to the device
+ */
+void TestCsvWriter::BenchmarkQuoting()
+{
+    QFETCH(bool, vector);
+    QFETCH(int, minLength);
+    QFETCH(int, maxLength);
+    QFETCH(int, specialRate);
+
+    const int _fieldCount = (8 << 20) / ((minLength + maxLength) / 2);  // Fields of about 8 MiB in total
+    const QVector<QByteArray> _fields = MakeBenchmarkFields(_fieldCount, minLength, maxLength, specialRate);  // Encoded fields
+    QByteArray _buffer;  // Encoded bytes of the current block
+    _buffer.reserve(CsvWriter::BUFFER_SIZE + 16384);
+
+    QBENCHMARK {
+        for (const QByteArray &_field : _fields) {
+            if (vector) {
+                CsvWriter::EncodeField(_field.constData(), _field.size(), _buffer);
+            } else {
+                AppendFieldScalar(_field.constData(), _field.size(), _buffer);
+            }
+            _buffer.append('\n');
+            if (_buffer.size() >= CsvWriter::BUFFER_SIZE) {
+                _buffer.resize(0);
+            }
+        }
+        _buffer.resize(0);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestCsvWriter)
+
+#include "tst_csvwriter.moc"
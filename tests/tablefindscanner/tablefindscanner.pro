@@ -0,0 +1,21 @@
+QT += core widgets testlib
+
+CONFIG += c++17 testcase
+CONFIG -= app_bundle
+
+TARGET = tst_tablefindscanner
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+
+# Source files
+SOURCES += \
+    tst_tablefindscanner.cpp \
+    ../../tablefindscanner.cpp
+
+# Header files
+HEADERS += \
+    ../../tablefindscanner.h
+
+# Compiler flags for professional development
+QMAKE_CXXFLAGS += -Wall -Wextra -pedantic
@@ -0,0 +1,321 @@
+#include "tablefindscanner.h"
+#include <QtTest>
+#include <QApplication>
+#include <QTableWidget>
+#include <QRandomGenerator>
+#include <algorithm>
+
+/**
+ * @brief Tests and benchmarks of the find-in-table scan
+ * FindInBuffer is checked against a scalar search with the needle at every offset of the
+ * 8 and 16 code unit blocks, and timed against that scalar search. The whole find is timed
+ * against the naive scan calling QTableWidgetItem::text() on every cell
+ */
+class TestTableFindScanner : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Needles of several lengths placed at every offset of a buffer
+     */
+    void NeedleAtEveryOffset();
+
+    /**
+     * @brief Random buffers over a small alphabet, where partial matches are frequent
+     */
+    void RandomBuffers();
+
+    /**
+     * @brief The scanner reports the same cells as the naive per-cell scan
+     */
+    void ScannerMatchesNaiveScan();
+
+    /**
+     * @brief Time of FindInBuffer and of the scalar search over one large buffer
+     */
+    void BenchmarkFindInBuffer_data();
+    void BenchmarkFindInBuffer();
+
+    /**
+     * @brief Time of a full find: naive per-cell scan, scanner building its buffers, scanner reusing them
+     */
+    void BenchmarkTableFind_data();
+    void BenchmarkTableFind();
+
+private:
+    /**
+     * @brief Find a needle one position at a time (reference and scalar benchmark baseline)
+     * @return Offset of the first occurrence at or after from, or -1 if there is none
+     */
+    static int FindScalar(const QString &haystack, const QString &needle, int from);
+
+    /**
+     * @brief Find a needle with the kernel under test
+     * @return Offset of the first occurrence at or after from, or -1 if there is none
+     */
+    static int FindVector(const QString &haystack, const QString &needle, int from);
+
+    /**
+     * @brief Fill a table with generated words, a few of which contain the needle in some letter case
+     * @param table Table receiving the cells
+     * @param rowCount Number of rows
+     * @param columnCount Number of columns
+     */
+    static void FillTable(QTableWidget &table, int rowCount, int columnCount);
+
+    /**
+     * @brief Count the cells containing a needle by reading every item's text
+     */
+    static int CountNaive(QTableWidget &table, const QString &needle);
+
+    /**
+     * @brief Run a scanner search to the end and count its hits
+     */
+    static int CountScanner(TableFindScanner &scanner, const QString &needle);
+
+    static const QString TABLE_NEEDLE;   // Text searched in the generated tables
+};
+
+// Define test constants
+const QString TestTableFindScanner::TABLE_NEEDLE = "needle";
+
+/**
+ * @brief Find a needle one position at a time
+ */
+int TestTableFindScanner::FindScalar(const QString &haystack, const QString &needle, int from)
+{
+    for (int _pos = from; _pos + needle.size() <= haystack.size(); ++_pos) {
+        if (std::equal(needle.begin(), needle.end(), haystack.begin() + _pos)) {
+            return _pos;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Find a needle with the kernel under test
+ */
+int TestTableFindScanner::FindVector(const QString &haystack, const QString &needle, int from)
+{
+    return TableFindScanner::FindInBuffer(reinterpret_cast<const char16_t *>(haystack.utf16()), haystack.size(),
+                                          reinterpret_cast<const char16_t *>(needle.utf16()), needle.size(), from);
+}
+
+/**
+ * @brief Fill a table with generated words
+ */
+void TestTableFindScanner::FillTable(QTableWidget &table, int rowCount, int columnCount)
+{
+    QRandomGenerator _random(7);  // Fixed seed keeps runs comparable
+    table.setRowCount(rowCount);
+    table.setColumnCount(columnCount);
+    for (int _row = 0; _row < rowCount; ++_row) {
+        for (int _col = 0; _col < columnCount; ++_col) {
+            QString _text;  // Cell text of 8 to 40 letters
+            int _length = _random.bounded(8, 41);  // Letters in the cell
+            for (int _i = 0; _i < _length; ++_i) {
+                _text += QChar('a' + _random.bounded(26));
+            }
+            if (_random.bounded(200) == 0) {
+                _text.insert(_random.bounded(_text.size() + 1), _random.bounded(2) == 0 ? "Needle" : "NEEDLE");
+            }
+            table.setItem(_row, _col, new QTableWidgetItem(_text));
+        }
+    }
+}
+
+/**
+ * @brief Count the cells containing a needle by reading every item's text
+ */
+int TestTableFindScanner::CountNaive(QTableWidget &table, const QString &needle)
+{
+    int _count = 0;  // Matching cells
+    for (int _row = 0; _row < table.rowCount(); ++_row) {
+        for (int _col = 0; _col < table.columnCount(); ++_col) {
+            QTableWidgetItem *_item = table.item(_row, _col);  // Cell item (nullptr if empty)
+            if (_item && _item->text().contains(needle, Qt::CaseInsensitive)) {
+                _count++;
+            }
+        }
+    }
+    return _count;
+}
+
+/**
+ * @brief Run a scanner search to the end and count its hits
+ */
+int TestTableFindScanner::CountScanner(TableFindScanner &scanner, const QString &needle)
+{
+    scanner.StartFind(needle);
+    while (scanner.IsScanning()) {
+        QCoreApplication::processEvents();
+    }
+    return scanner.GetHits().size();
+}
+
+/**
+ * @brief Needles of several lengths placed at every offset of a buffer
+ */
+void TestTableFindScanner::NeedleAtEveryOffset()
+{
+    const int _needleLengths[] = {1, 2, 3, 8, 9, 17};  // Single unit, short needles, SSE2 block size and longer than a block
+    for (int _needleLength : _needleLengths) {
+        QString _needle;  // Consecutive letters that never occur in the filler
+        for (int _i = 0; _i < _needleLength; ++_i) {
+            _needle += QChar('k' + _i % 10);
+        }
+
+        for (int _length = _needleLength; _length <= 70; _length += 7) {
+            for (int _offset = 0; _offset + _needleLength <= _length; ++_offset) {
+                QString _haystack(_length, QChar('a'));  // Filler without needle units
+                _haystack.replace(_offset, _needleLength, _needle);
+                QCOMPARE(FindVector(_haystack, _needle, 0), _offset);
+                QCOMPARE(FindVector(_haystack, _needle, _offset), _offset);
+                QCOMPARE(FindVector(_haystack, _needle, _offset + 1), FindScalar(_haystack, _needle, _offset + 1));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Random buffers over a small alphabet, where partial matches are frequent
+ */
+void TestTableFindScanner::RandomBuffers()
+{
+    QRandomGenerator _random(3);  // Fixed seed keeps failures reproducible
+    for (int _i = 0; _i < 5000; ++_i) {
+        QString _haystack;  // Buffer of a, b and a NUL separator
+        int _length = _random.bounded(120);  // Code units in the buffer
+        for (int _j = 0; _j < _length; ++_j) {
+            int _unit = _random.bounded(5);  // Mostly a and b
+            _haystack += _unit == 4 ? QChar(0) : QChar(_unit % 2 == 0 ? 'a' : 'b');
+        }
+        QString _needle;  // Needle of one to five units
+        int _needleLength = _random.bounded(1, 6);  // Units in the needle
+        for (int _j = 0; _j < _needleLength; ++_j) {
+            _needle += QChar(_random.bounded(2) == 0 ? 'a' : 'b');
+        }
+
+        int _from = _length > 0 ? _random.bounded(_length) : 0;  // Start of the search
+        QCOMPARE(FindVector(_haystack, _needle, _from), FindScalar(_haystack, _needle, _from));
+    }
+}
+
+/**
+ * @brief The scanner reports the same cells as the naive per-cell scan
+ */
+void TestTableFindScanner::ScannerMatchesNaiveScan()
+{
+    QTableWidget _table;  // Table that is never shown
+    FillTable(_table, 10000, 6);
+    TableFindScanner _scanner(&_table);  // Scanner under test
+
+    int _expected = CountNaive(_table, TABLE_NEEDLE);  // Cells found by reading every item
+    QVERIFY(_expected > 0);
+    QCOMPARE(CountScanner(_scanner, TABLE_NEEDLE), _expected);
+
+    // Hidden columns are skipped
+    _table.setColumnHidden(0, true);
+    int _hiddenHits = 0;  // Naive hits in the hidden column
+    for (int _row = 0; _row < _table.rowCount(); ++_row) {
+        if (_table.item(_row, 0)->text().contains(TABLE_NEEDLE, Qt::CaseInsensitive)) {
+            _hiddenHits++;
+        }
+    }
+    QCOMPARE(CountScanner(_scanner, TABLE_NEEDLE), _expected - _hiddenHits);
+}
+
+/**
+ * @brief Time of FindInBuffer and of the scalar search over one large buffer
+ */
+void TestTableFindScanner::BenchmarkFindInBuffer_data()
+{
+    QTest::addColumn<bool>("vector");
+    QTest::addColumn<QString>("needle");
+
+    QTest::newRow("rare needle, scalar") << false << QString("needle");
+    QTest::newRow("rare needle, vector") << true << QString("needle");
+    QTest::newRow("one unit, scalar") << false << QString("#");
+    QTest::newRow("one unit, vector") << true << QString("#");
+}
+
+/**
+ * @brief Time of FindInBuffer and of the scalar search over one large buffer
+ * The buffer holds 4 Mi code units of letters with the needle only at the very end
+ */
+void TestTableFindScanner::BenchmarkFindInBuffer()
+{
+    QFETCH(bool, vector);
+    QFETCH(QString, needle);
+
+    QRandomGenerator _random(11);  // Fixed seed keeps runs comparable
+    QString _haystack(4 << 20, QChar('a'));  // Letters without the needle
+    for (int _i = 0; _i < _haystack.size(); ++_i) {
+        _haystack[_i] = QChar('a' + _random.bounded(26));
+    }
+    _haystack.replace(QString("needle"), QString("needla"));
+    _haystack += needle;
+    const int _expected = _haystack.size() - needle.size();  // Offset of the only occurrence
+
+    int _found = -1;  // Offset found by the timed search
+    QBENCHMARK {
+        _found = vector ? FindVector(_haystack, needle, 0) : FindScalar(_haystack, needle, 0);
+    }
+    QCOMPARE(_found, _expected);
+}
+
+/**
+ * @brief Time of a full find: naive per-cell scan, scanner building its buffers, scanner reusing them
+ */
+void TestTableFindScanner::BenchmarkTableFind_data()
+{
+    QTest::addColumn<int>("mode");  // 0: naive scan, 1: scanner with cold buffers, 2: scanner with cached buffers
+
+    QTest::newRow("naive per-cell scan") << 0;
+    QTest::newRow("scanner, building buffers") << 1;
+    QTest::newRow("scanner, cached buffers") << 2;
+}
+
+/**
+ * @brief Time of a full find over 50,000 rows of 8 columns
+ */
+void TestTableFindScanner::BenchmarkTableFind()
+{
+    QFETCH(int, mode);
+
+    QTableWidget _table;  // Table that is never shown
+    FillTable(_table, 50000, 8);
+    TableFindScanner _scanner(&_table);  // Scanner under test
+    const int _expected = CountNaive(_table, TABLE_NEEDLE);  // Cells containing the needle
+    CountScanner(_scanner, TABLE_NEEDLE);  // Builds the buffers for the cached case
+
+    int _count = 0;  // Hits of the timed search
+    QBENCHMARK {
+        if (mode == 0) {
+            _count = CountNaive(_table, TABLE_NEEDLE);
+        } else {
+            if (mode == 1) {
+                _scanner.Invalidate();
+            }
+            _count = CountScanner(_scanner, TABLE_NEEDLE);
+        }
+    }
+    QCOMPARE(_count, _expected);
+}
+
+/**
+ * @brief Run the tests with a QApplication on the offscreen platform unless another one is set
+ */
+int main(int argc, char *argv[])
+{
+    // The tables are never shown, so no display is needed
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication _application(argc, argv);  // Widgets need an application object
+    TestTableFindScanner _test;  // Test object
+    return QTest::qExec(&_test, argc, argv);
+}
+
+#include "tst_tablefindscanner.moc"
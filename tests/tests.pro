@@ -0,0 +1,8 @@
+TEMPLATE = subdirs
+
+# Unit tests and benchmarks of the encoding and search kernels
+# Build from this directory with qmake && make check; each test binary also
+# runs its QBENCHMARK functions (pass -iterations or -callgrind for stable numbers)
+SUBDIRS += \
+    csvwriter \
+    tablefindscanner
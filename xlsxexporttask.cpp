@@ -0,0 +1,107 @@
+#include "xlsxexporttask.h"
+#include "xlsxwriter.h"
+#include "sqlworker.h"
+#include <QSqlRecord>
+#include <QFile>
+
+// Define Excel export constants
+const int XlsxExportTask::PROGRESS_INTERVAL_ROWS = 100000;
+
+/**
+ * @brief Constructor initializes XlsxExportTask with the query and the output file
+ */
+XlsxExportTask::XlsxExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                               const QString &sheetName, const QString &outputPath)
+    : DatabaseTask(filePath)
+    , QueryString(queryString)         // Exported rows
+    , BindValues(bindValues)           // Placeholder values
+    , SheetName(sheetName)             // First worksheet name
+    , OutputPath(outputPath)           // Workbook file
+    , RowCount(0)                      // No row written
+{
+}
+
+/**
+ * @brief Get the number of rows written so far
+ */
+qint64 XlsxExportTask::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Run the query and write its rows
+ */
+bool XlsxExportTask::Run(QSqlDatabase &database, QString &message)
+{
+    // A searched view reads its row ids from the index file, which this connection must attach itself
+    if (!SQLWorker::AttachSearchIndexFile(database, FilePath)) {
+        message = "Cannot open search index file of " + FilePath;
+        return false;
+    }
+
+    QSqlQuery _query(database);  // Forward-only cursor over the exported rows
+    _query.setForwardOnly(true);
+    if (!_query.prepare(QueryString)) {
+        message = "Cannot prepare export query: " + _query.lastError().text();
+        return false;
+    }
+    for (int _i = 0; _i < BindValues.size(); ++_i) {
+        _query.bindValue(_i, BindValues[_i]);
+    }
+    if (!_query.exec()) {
+        message = "Export query failed: " + _query.lastError().text();
+        return false;
+    }
+
+    QSqlRecord _record = _query.record();  // Result columns of the cursor
+    const int _columnCount = _record.count();  // Values per row
+    QStringList _names;  // Header cells in column order
+    for (int _col = 0; _col < _columnCount; ++_col) {
+        _names.append(_record.fieldName(_col));
+    }
+
+    // The writer deflates large blocks itself, so QFile's small buffer is bypassed
+    QFile _file(OutputPath);  // Output file
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+        message = QString("Cannot open %1: %2").arg(OutputPath, _file.errorString());
+        return false;
+    }
+
+    // Only the current row is held; each value goes from SQLite into the worksheet buffer
+    XlsxWriter _writer(&_file, SheetName, _names);  // Encoder writing rows straight into the zip container
+    while (!_writer.HasError() && !IsCancelled() && _query.next()) {
+        for (int _col = 0; _col < _columnCount; ++_col) {
+            _writer.WriteValue(_query.value(_col));
+        }
+        _writer.EndRow();
+
+        if (++RowCount % PROGRESS_INTERVAL_ROWS == 0) {
+            emit ProgressChanged(-1, QString("%1 rows written to Excel").arg(RowCount.load()));
+        }
+    }
+
+    if (IsCancelled()) {
+        message = "Export cancelled";
+    } else if (!_writer.HasError() && _query.lastError().isValid()) {
+        message = "Export query failed: " + _query.lastError().text();
+    } else if (_writer.HasError() || !_writer.Finish()) {
+        message = QString("Cannot write %1: %2").arg(OutputPath, _file.errorString());
+    }
+
+    // A workbook without its zip directory cannot be opened, so partial exports are removed
+    if (!message.isEmpty()) {
+        _file.remove();
+        return false;
+    }
+    _file.close();
+
+    message = QString("%1 rows written to %2").arg(RowCount.load()).arg(OutputPath);
+    if (_writer.GetSheetCount() > 1) {
+        message += QString(" (split across %1 worksheets at Excel's row limit)").arg(_writer.GetSheetCount());
+    }
+    if (_writer.GetTruncatedCount() > 0) {
+        message += QString(" (%1 text values truncated to Excel's cell length limit)").arg(_writer.GetTruncatedCount());
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef XLSXEXPORTTASK_H
+#define XLSXEXPORTTASK_H
+
+#include <QStringList>
+#include <QVariantList>
+#include <atomic>
+#include "databasetask.h"
+
+/**
+ * @brief Background export of the rows of one query to an Excel workbook
+ * Rows are stepped on the task's own connection and go straight into the deflated
+ * worksheet XML; tables beyond Excel's row limit continue on further worksheets
+ */
+class XlsxExportTask : public DatabaseTask
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor for XlsxExportTask
+     * @param filePath Path to the SQL database file to read
+     * @param queryString SELECT statement returning the exported rows
+     * @param bindValues Values for the placeholders of the statement in order
+     * @param sheetName Name of the first worksheet
+     * @param outputPath Path of the workbook to write
+     */
+    XlsxExportTask(const QString &filePath, const QString &queryString, const QVariantList &bindValues,
+                   const QString &sheetName, const QString &outputPath);
+
+    /**
+     * @brief Get the number of rows written so far (safe to call while running)
+     * @return Rows written
+     */
+    qint64 GetRowCount() const;
+
+protected:
+    /**
+     * @brief Run the query and write its rows
+     * @param database Open connection owned by the task thread
+     * @param message Output summary or error description
+     * @return true if the complete workbook was written, false otherwise
+     */
+    bool Run(QSqlDatabase &database, QString &message) override;
+
+private:
+    QString QueryString;                 // SELECT statement of the exported rows
+    QVariantList BindValues;             // Placeholder values of the statement
+    QString SheetName;                   // Name of the first worksheet
+    QString OutputPath;                  // Workbook written by the task
+    std::atomic<qint64> RowCount;        // Rows written so far
+
+    static const int PROGRESS_INTERVAL_ROWS;  // Rows between progress reports
+};
+
+#endif // XLSXEXPORTTASK_H
@@ -0,0 +1,423 @@
+#include "xlsxwriter.h"
+#include <QLocale>
+#include <QDebug>
+#include <cmath>
+#include <cctype>
+
+// Define XLSX writer constants
+const int XlsxWriter::MAX_SHEET_ROWS = 1048576;
+const int XlsxWriter::MAX_CELL_CHARS = 32767;
+const qint64 XlsxWriter::MAX_EXACT_INTEGER = 999999999999999LL;
+const int XlsxWriter::BUFFER_SIZE = 1 << 20;
+
+/**
+ * @brief Constructor initializes XlsxWriter and precomputes the column letters
+ */
+XlsxWriter::XlsxWriter(QIODevice *device, const QString &sheetName, const QStringList &columnNames)
+    : Zip(device)                      // Zip container
+    , SheetName(SanitizeSheetName(sheetName))  // First worksheet name
+    , ColumnNames(columnNames)         // Header cells
+    , ColumnLetters()                  // Filled below
+    , SheetNames()                     // No worksheet started
+    , Buffer()                         // Sheet XML
+    , RowNumber()                      // Set per row
+    , CurrentColumn(0)                 // First value of the first row
+    , SheetRow(0)                      // No worksheet started
+    , RowCount(0)                      // No rows written
+    , TruncatedCount(0)                // No cell truncated
+{
+    for (int _col = 0; _col < columnNames.size(); ++_col) {
+        ColumnLetters.append(GetColumnLetters(_col));
+    }
+    Buffer.reserve(BUFFER_SIZE + 4096);  // Room for the cell that crosses the flush threshold
+}
+
+/**
+ * @brief Append the next value of the current row
+ */
+void XlsxWriter::WriteValue(const QVariant &value)
+{
+    if (CurrentColumn >= ColumnLetters.size()) {
+        return;
+    }
+    if (CurrentColumn == 0) {
+        BeginRow();
+    }
+
+    // NULL is an absent cell; the references of the following cells keep their columns
+    if (value.isNull()) {
+        CurrentColumn++;
+        return;
+    }
+
+    switch (value.userType()) {
+    case QMetaType::LongLong:
+    case QMetaType::Int: {
+        // Excel keeps 15 significant digits, so longer integers are written as text to keep them exact
+        qint64 _integer = value.toLongLong();  // Value to format
+        if (_integer >= -MAX_EXACT_INTEGER && _integer <= MAX_EXACT_INTEGER) {
+            BeginCell(nullptr, 0);
+            Buffer.append("<v>");
+            Buffer.append(QByteArray::number(_integer));
+            Buffer.append("</v></c>");
+        } else {
+            AppendTextCell(QString::number(_integer), 0);
+        }
+        break;
+    }
+    case QMetaType::Double: {
+        double _real = value.toDouble();  // Value to format
+        if (std::isfinite(_real)) {
+            BeginCell(nullptr, 0);
+            Buffer.append("<v>");
+            Buffer.append(QByteArray::number(_real, 'g', QLocale::FloatingPointShortest));
+            Buffer.append("</v></c>");
+        } else {
+            AppendTextCell(QString::number(_real), 0);
+        }
+        break;
+    }
+    case QMetaType::QByteArray:
+        AppendTextCell(QString::fromLatin1(value.toByteArray().toBase64()), 0);
+        break;
+    default:
+        AppendTextCell(value.toString(), 0);
+        break;
+    }
+    CurrentColumn++;
+    FlushIfFull();
+}
+
+/**
+ * @brief Close the current row, starting a new worksheet at the row limit
+ */
+void XlsxWriter::EndRow()
+{
+    if (CurrentColumn == 0) {
+        BeginRow();
+    }
+    Buffer.append("</row>");
+    CurrentColumn = 0;
+    RowCount++;
+    FlushIfFull();
+}
+
+/**
+ * @brief Close the last worksheet and write the workbook parts and the zip directory
+ */
+bool XlsxWriter::Finish()
+{
+    // An empty table still gets a worksheet with its header row
+    if (SheetNames.isEmpty()) {
+        BeginSheet();
+    }
+    EndSheet();
+
+    QByteArray _contentTypes(  // Content types of the parts
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+        "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+        "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+        "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+        "<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml\"/>");
+    QByteArray _workbook(  // Workbook listing the worksheets
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<workbook xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" "
+        "xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\"><sheets>");
+    QByteArray _workbookRels(  // Relationships from the workbook to its parts
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">");
+    for (int _sheet = 1; _sheet <= SheetNames.size(); ++_sheet) {
+        QByteArray _number = QByteArray::number(_sheet);  // Worksheet number
+        QByteArray _name = SheetNames[_sheet - 1].toUtf8();  // Worksheet name as UTF-8
+        _contentTypes.append("<Override PartName=\"/xl/worksheets/sheet" + _number + ".xml\" "
+                             "ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>");
+        _workbook.append("<sheet name=\"");
+        AppendEscaped(_name.constData(), _name.size(), _workbook);
+        _workbook.append("\" sheetId=\"" + _number + "\" r:id=\"rId" + _number + "\"/>");
+        _workbookRels.append("<Relationship Id=\"rId" + _number + "\" "
+                             "Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\" "
+                             "Target=\"worksheets/sheet" + _number + ".xml\"/>");
+    }
+    _contentTypes.append("</Types>");
+    _workbook.append("</sheets></workbook>");
+    _workbookRels.append("<Relationship Id=\"rId" + QByteArray::number(SheetNames.size() + 1) + "\" "
+                         "Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles\" "
+                         "Target=\"styles.xml\"/></Relationships>");
+
+    // Style 0 is the default, style 1 the bold header
+    QByteArray _styles(  // Fonts and cell formats
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<styleSheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<fonts count=\"2\"><font><sz val=\"11\"/><name val=\"Calibri\"/></font>"
+        "<font><b/><sz val=\"11\"/><name val=\"Calibri\"/></font></fonts>"
+        "<fills count=\"2\"><fill><patternFill patternType=\"none\"/></fill><fill><patternFill patternType=\"gray125\"/></fill></fills>"
+        "<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+        "<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+        "<cellXfs count=\"2\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/>"
+        "<xf numFmtId=\"0\" fontId=\"1\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/></cellXfs>"
+        "<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles>"
+        "</styleSheet>");
+    QByteArray _packageRels(  // Relationship from the package to the workbook
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+        "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" "
+        "Target=\"xl/workbook.xml\"/></Relationships>");
+
+    // Readers locate the parts through the zip directory, so they may follow the worksheets
+    WritePart("[Content_Types].xml", _contentTypes);
+    WritePart("_rels/.rels", _packageRels);
+    WritePart("xl/workbook.xml", _workbook);
+    WritePart("xl/_rels/workbook.xml.rels", _workbookRels);
+    WritePart("xl/styles.xml", _styles);
+    return Zip.Finish();
+}
+
+/**
+ * @brief Check if a write to the device failed
+ */
+bool XlsxWriter::HasError() const
+{
+    return Zip.HasError();
+}
+
+/**
+ * @brief Get the number of data rows written so far
+ */
+qint64 XlsxWriter::GetRowCount() const
+{
+    return RowCount;
+}
+
+/**
+ * @brief Get the number of worksheets started so far
+ */
+int XlsxWriter::GetSheetCount() const
+{
+    return SheetNames.size();
+}
+
+/**
+ * @brief Get the number of text values cut to Excel's cell length limit
+ */
+qint64 XlsxWriter::GetTruncatedCount() const
+{
+    return TruncatedCount;
+}
+
+/**
+ * @brief Open the next row, moving to a new worksheet when the current one is full
+ */
+void XlsxWriter::BeginRow()
+{
+    if (SheetNames.isEmpty() || SheetRow >= MAX_SHEET_ROWS) {
+        if (!SheetNames.isEmpty()) {
+            EndSheet();
+        }
+        BeginSheet();
+    }
+
+    SheetRow++;
+    RowNumber = QByteArray::number(SheetRow);
+    Buffer.append("<row r=\"");
+    Buffer.append(RowNumber);
+    Buffer.append("\">");
+}
+
+/**
+ * @brief Start a worksheet entry and write its header row
+ */
+void XlsxWriter::BeginSheet()
+{
+    // Later sheets are named "<name> (2)", "<name> (3)", ... within the 31 character limit
+    QString _name = SheetName;  // Name of the new worksheet
+    if (!SheetNames.isEmpty()) {
+        QString _suffix = QString(" (%1)").arg(SheetNames.size() + 1);  // Sheet number suffix
+        _name = SheetName.left(31 - _suffix.size()) + _suffix;
+    }
+    SheetNames.append(_name);
+    Zip.BeginEntry(QString("xl/worksheets/sheet%1.xml").arg(SheetNames.size()));
+
+    // The header row stays frozen above the scrolled rows
+    Buffer.append("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                  "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+                  "<sheetViews><sheetView workbookViewId=\"0\">"
+                  "<pane ySplit=\"1\" topLeftCell=\"A2\" activePane=\"bottomLeft\" state=\"frozen\"/>"
+                  "</sheetView></sheetViews><sheetData>");
+
+    SheetRow = 1;
+    RowNumber = "1";
+    Buffer.append("<row r=\"1\">");
+    for (int _col = 0; _col < ColumnNames.size(); ++_col) {
+        CurrentColumn = _col;
+        AppendTextCell(ColumnNames[_col], 1);
+    }
+    Buffer.append("</row>");
+    CurrentColumn = 0;
+}
+
+/**
+ * @brief Close the sheet data of the current worksheet
+ */
+void XlsxWriter::EndSheet()
+{
+    Buffer.append("</sheetData></worksheet>");
+    Flush();
+    Zip.EndEntry();
+}
+
+/**
+ * @brief Append the opening tag of a cell with its reference
+ */
+void XlsxWriter::BeginCell(const char *type, int style)
+{
+    Buffer.append("<c r=\"");
+    Buffer.append(ColumnLetters[CurrentColumn]);
+    Buffer.append(RowNumber);
+    if (type) {
+        Buffer.append("\" t=\"");
+        Buffer.append(type);
+    }
+    if (style != 0) {
+        Buffer.append("\" s=\"");
+        Buffer.append(QByteArray::number(style));
+    }
+    Buffer.append("\">");
+}
+
+/**
+ * @brief Append an inline string cell
+ */
+void XlsxWriter::AppendTextCell(const QString &text, int style)
+{
+    // Longer text would make Excel repair the workbook; a surrogate pair is never split
+    QByteArray _utf8;  // Cell text as UTF-8
+    if (text.size() > MAX_CELL_CHARS) {
+        int _length = text.at(MAX_CELL_CHARS - 1).isHighSurrogate() ? MAX_CELL_CHARS - 1 : MAX_CELL_CHARS;  // Kept UTF-16 units
+        _utf8 = text.left(_length).toUtf8();
+        TruncatedCount++;
+    } else {
+        _utf8 = text.toUtf8();
+    }
+
+    BeginCell("inlineStr", style);
+    // XML readers drop leading and trailing whitespace unless it is marked as significant
+    const bool _preserve = !_utf8.isEmpty() && (QChar::isSpace(static_cast<uchar>(_utf8.front()))
+                                                || QChar::isSpace(static_cast<uchar>(_utf8.back())));  // Whitespace at an end
+    Buffer.append(_preserve ? "<is><t xml:space=\"preserve\">" : "<is><t>");
+    AppendEscaped(_utf8.constData(), _utf8.size(), Buffer);
+    Buffer.append("</t></is></c>");
+}
+
+/**
+ * @brief Write a complete zip entry from one block of XML
+ */
+void XlsxWriter::WritePart(const QString &name, const QByteArray &xml)
+{
+    Zip.BeginEntry(name);
+    Zip.WriteEntryData(xml.constData(), xml.size());
+    Zip.EndEntry();
+}
+
+/**
+ * @brief Compress the buffer into the current worksheet once it is full
+ */
+void XlsxWriter::FlushIfFull()
+{
+    if (Buffer.size() >= BUFFER_SIZE) {
+        Flush();
+    }
+}
+
+/**
+ * @brief Compress all buffered bytes into the current worksheet
+ */
+void XlsxWriter::Flush()
+{
+    if (!Buffer.isEmpty() && !Zip.HasError()) {
+        Zip.WriteEntryData(Buffer.constData(), Buffer.size());
+    }
+    Buffer.resize(0);  // Keeps the reserved capacity for the next block
+}
+
+/**
+ * @brief Append text as XML character data
+ * Bytes that need no escaping are copied in runs up to the next special byte
+ */
+void XlsxWriter::AppendEscaped(const char *data, int length, QByteArray &output)
+{
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";  // Digits of _xHHHH_ escapes
+    const char *_start = data;  // First byte not copied yet
+    const char *_end = data + length;  // End of the input
+    for (const char *_p = data; _p < _end; ++_p) {
+        const unsigned char _c = static_cast<unsigned char>(*_p);  // Current byte
+        const char *_escape = nullptr;  // Replacement of the byte (nullptr if copied)
+        int _skip = 1;  // Input bytes replaced
+        char _code[8] = {'_', 'x', '0', '0', '0', '0', '_', '\0'};  // _xHHHH_ escape being built
+
+        if (_c == '&') {
+            _escape = "&amp;";
+        } else if (_c == '<') {
+            _escape = "&lt;";
+        } else if (_c == '>') {
+            _escape = "&gt;";
+        } else if (_c < 0x20 && _c != '\t' && _c != '\n') {
+            // Control characters are not allowed in XML; a carriage return would be read back as a line feed
+            _code[4] = HEX_DIGITS[_c >> 4];
+            _code[5] = HEX_DIGITS[_c & 0xF];
+            _escape = _code;
+        } else if (_c == '_' && _end - _p >= 7 && _p[1] == 'x' && _p[6] == '_' && isxdigit(static_cast<unsigned char>(_p[2]))
+                   && isxdigit(static_cast<unsigned char>(_p[3])) && isxdigit(static_cast<unsigned char>(_p[4]))
+                   && isxdigit(static_cast<unsigned char>(_p[5]))) {
+            // Literal text that looks like an escape keeps its underscore escaped
+            _escape = "_x005F_";
+        } else if (_c == 0xEF && _end - _p >= 3 && static_cast<unsigned char>(_p[1]) == 0xBF
+                   && (static_cast<unsigned char>(_p[2]) == 0xBE || static_cast<unsigned char>(_p[2]) == 0xBF)) {
+            // U+FFFE and U+FFFF are not XML characters either
+            _escape = static_cast<unsigned char>(_p[2]) == 0xBE ? "_xFFFE_" : "_xFFFF_";
+            _skip = 3;
+        } else {
+            continue;
+        }
+
+        output.append(_start, static_cast<int>(_p - _start));
+        output.append(_escape);
+        _p += _skip - 1;
+        _start = _p + 1;
+    }
+    output.append(_start, static_cast<int>(_end - _start));
+}
+
+/**
+ * @brief Get the column letters of a zero-based column index
+ */
+QByteArray XlsxWriter::GetColumnLetters(int column)
+{
+    QByteArray _letters;  // Letters from the last to the first
+    for (int _value = column + 1; _value > 0; _value = (_value - 1) / 26) {
+        _letters.prepend(static_cast<char>('A' + (_value - 1) % 26));
+    }
+    return _letters;
+}
+
+/**
+ * @brief Make a valid worksheet name
+ */
+QString XlsxWriter::SanitizeSheetName(const QString &name)
+{
+    QString _name = name;  // Name being cleaned
+    for (QChar &_char : _name) {
+        if (QString("[]:*?/\\").contains(_char)) {
+            _char = '_';
+        }
+    }
+    // Apostrophes may not start or end a name
+    while (_name.startsWith('\'')) {
+        _name.remove(0, 1);
+    }
+    _name = _name.left(31);
+    while (_name.endsWith('\'')) {
+        _name.chop(1);
+    }
+    return _name.isEmpty() ? QString("Sheet") : _name;
+}
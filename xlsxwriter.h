@@ -0,0 +1,154 @@
+#ifndef XLSXWRITER_H
+#define XLSXWRITER_H
+
+#include "zipstreamwriter.h"
+#include <QIODevice>
+#include <QByteArray>
+#include <QVariant>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief Streaming Excel workbook (.xlsx) encoder writing rows straight into the zip container
+ * Each worksheet is one zip entry whose XML rows are encoded into a buffer and deflated in
+ * large blocks, so only the current block is held no matter how many rows are written.
+ * Strings are written inline rather than into a shared-string table, which would have to
+ * collect every distinct string until the end. A new worksheet, again starting with the
+ * header row, begins whenever a sheet reaches Excel's row limit
+ */
+class XlsxWriter
+{
+public:
+    /**
+     * @brief Constructor for XlsxWriter
+     * @param device Open output device (not owned, must outlive the writer)
+     * @param sheetName Name of the first worksheet; further sheets get a number appended
+     * @param columnNames Header cells in value order
+     */
+    XlsxWriter(QIODevice *device, const QString &sheetName, const QStringList &columnNames);
+
+    /**
+     * @brief Append the next value of the current row
+     * Integers of up to 15 digits and finite reals become number cells, NULL an empty cell,
+     * BLOBs base64 text and everything else text, so leading zeros are kept
+     * @param value Value as returned by QSqlQuery::value
+     */
+    void WriteValue(const QVariant &value);
+
+    /**
+     * @brief Close the current row, starting a new worksheet at the row limit
+     */
+    void EndRow();
+
+    /**
+     * @brief Close the last worksheet and write the workbook parts and the zip directory
+     * @return true if the whole workbook reached the device, false otherwise
+     */
+    bool Finish();
+
+    /**
+     * @brief Check if a write to the device failed
+     * @return true if output was lost, false otherwise
+     */
+    bool HasError() const;
+
+    /**
+     * @brief Get the number of data rows written so far
+     * @return Rows ended with EndRow
+     */
+    qint64 GetRowCount() const;
+
+    /**
+     * @brief Get the number of worksheets started so far
+     * @return Worksheets in the workbook
+     */
+    int GetSheetCount() const;
+
+    /**
+     * @brief Get the number of text values cut to Excel's cell length limit
+     * @return Truncated cells
+     */
+    qint64 GetTruncatedCount() const;
+
+    static const int MAX_SHEET_ROWS;     // Rows per worksheet, including the header row (Excel limit)
+    static const int MAX_CELL_CHARS;     // UTF-16 units per text cell (Excel limit)
+    static const qint64 MAX_EXACT_INTEGER;  // Largest integer magnitude Excel shows with all digits
+    static const int BUFFER_SIZE;        // Bytes of sheet XML collected before they are compressed
+
+private:
+    /**
+     * @brief Open the next row, moving to a new worksheet when the current one is full
+     */
+    void BeginRow();
+
+    /**
+     * @brief Start a worksheet entry and write its header row
+     */
+    void BeginSheet();
+
+    /**
+     * @brief Close the sheet data of the current worksheet
+     */
+    void EndSheet();
+
+    /**
+     * @brief Append the opening tag of a cell with its reference
+     * @param type Cell type attribute (nullptr for numbers)
+     * @param style Cell style index (0 for the default style)
+     */
+    void BeginCell(const char *type, int style);
+
+    /**
+     * @brief Append an inline string cell
+     */
+    void AppendTextCell(const QString &text, int style);
+
+    /**
+     * @brief Write a complete zip entry from one block of XML
+     */
+    void WritePart(const QString &name, const QByteArray &xml);
+
+    /**
+     * @brief Compress the buffer into the current worksheet once it is full
+     */
+    void FlushIfFull();
+
+    /**
+     * @brief Compress all buffered bytes into the current worksheet
+     */
+    void Flush();
+
+    /**
+     * @brief Append text as XML character data
+     * Markup characters become entities, and characters XML cannot carry become _xHHHH_
+     * escapes, which Excel decodes back
+     * @param data UTF-8 bytes
+     * @param length Number of bytes
+     * @param output Buffer receiving the escaped bytes
+     */
+    static void AppendEscaped(const char *data, int length, QByteArray &output);
+
+    /**
+     * @brief Get the column letters of a zero-based column index (A, B, ..., Z, AA, ...)
+     */
+    static QByteArray GetColumnLetters(int column);
+
+    /**
+     * @brief Make a valid worksheet name: at most 31 characters and none of []:*?/\
+     */
+    static QString SanitizeSheetName(const QString &name);
+
+    ZipStreamWriter Zip;                 // Zip container of the workbook parts
+    QString SheetName;                   // Sanitized name of the first worksheet
+    QStringList ColumnNames;             // Header cells
+    QVector<QByteArray> ColumnLetters;   // Column part of the cell references per column
+    QStringList SheetNames;              // Names of the worksheets started so far
+    QByteArray Buffer;                   // Sheet XML not yet compressed (capacity BUFFER_SIZE)
+    QByteArray RowNumber;                // Row part of the cell references of the current row
+    int CurrentColumn;                   // Column of the next value in the current row
+    int SheetRow;                        // One-based row of the current row in its worksheet
+    qint64 RowCount;                     // Data rows written so far
+    qint64 TruncatedCount;               // Text cells cut to MAX_CELL_CHARS
+};
+
+#endif // XLSXWRITER_H
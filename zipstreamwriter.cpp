@@ -0,0 +1,291 @@
+#include "zipstreamwriter.h"
+#include <QDateTime>
+#include <QDebug>
+#include <cstring>
+#include <zlib.h>
+
+// Define zip stream writer constants
+const int ZipStreamWriter::DEFLATE_LEVEL = 1;
+const int ZipStreamWriter::OUTPUT_SIZE = 1 << 20;
+const quint32 ZipStreamWriter::LOCAL_HEADER_SIGNATURE = 0x04034b50;
+const quint32 ZipStreamWriter::DATA_DESCRIPTOR_SIGNATURE = 0x08074b50;
+const quint32 ZipStreamWriter::CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+const quint32 ZipStreamWriter::ZIP64_END_SIGNATURE = 0x06064b50;
+const quint32 ZipStreamWriter::ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+const quint32 ZipStreamWriter::END_SIGNATURE = 0x06054b50;
+const quint16 ZipStreamWriter::VERSION_DEFLATE = 20;
+const quint16 ZipStreamWriter::VERSION_ZIP64 = 45;
+const quint16 ZipStreamWriter::FLAGS_DESCRIPTOR_UTF8 = 0x0808;
+const quint16 ZipStreamWriter::METHOD_DEFLATE = 8;
+const quint32 ZipStreamWriter::MAX_32 = 0xFFFFFFFF;
+const quint16 ZipStreamWriter::MAX_16 = 0xFFFF;
+
+/**
+ * @brief Constructor initializes ZipStreamWriter with the current time for every entry
+ */
+ZipStreamWriter::ZipStreamWriter(QIODevice *device)
+    : Device(device)                   // Output device
+    , Entries()                        // No entries written
+    , Stream(nullptr)                  // Created by the first entry
+    , Output()                         // Compressed bytes
+    , Offset(0)                        // Nothing written
+    , DosTime(0)                       // Set below
+    , DosDate(0)                       // Set below
+    , EntryOpen(false)                 // No entry started
+    , Failed(false)                    // No write failed
+{
+    // MS-DOS timestamps count years from 1980 and seconds in steps of two
+    QDateTime _now = QDateTime::currentDateTime();  // Modification time of the entries
+    DosTime = static_cast<quint16>((_now.time().hour() << 11) | (_now.time().minute() << 5) | (_now.time().second() / 2));
+    DosDate = static_cast<quint16>((qMax(0, _now.date().year() - 1980) << 9) | (_now.date().month() << 5) | _now.date().day());
+}
+
+/**
+ * @brief Destructor releases the deflate stream
+ */
+ZipStreamWriter::~ZipStreamWriter()
+{
+    if (Stream) {
+        deflateEnd(Stream);
+        delete Stream;
+    }
+}
+
+/**
+ * @brief Start a new entry, ending the previous one
+ */
+bool ZipStreamWriter::BeginEntry(const QString &name)
+{
+    if (EntryOpen && !EndEntry()) {
+        return false;
+    }
+    if (Failed) {
+        return false;
+    }
+
+    // One raw deflate stream (no zlib header) is reset for every entry
+    if (!Stream) {
+        Stream = new z_stream;
+        std::memset(Stream, 0, sizeof(z_stream));
+        if (deflateInit2(Stream, DEFLATE_LEVEL, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            delete Stream;
+            Stream = nullptr;
+            qDebug() << "Error: Cannot initialize zip compression";
+            Failed = true;
+            return false;
+        }
+    } else {
+        deflateReset(Stream);
+    }
+
+    Entry _entry;  // Central directory record, completed by EndEntry
+    _entry.Name = name.toUtf8();
+    _entry.Crc = static_cast<quint32>(crc32(0, Z_NULL, 0));
+    _entry.CompressedSize = 0;
+    _entry.UncompressedSize = 0;
+    _entry.Offset = Offset;
+    Entries.append(_entry);
+
+    // CRC and sizes are unknown yet; flag bit 3 moves them into the data descriptor
+    QByteArray _header;  // Local file header
+    AppendLittleEndian<quint32>(LOCAL_HEADER_SIGNATURE, _header);
+    AppendLittleEndian<quint16>(VERSION_DEFLATE, _header);
+    AppendLittleEndian<quint16>(FLAGS_DESCRIPTOR_UTF8, _header);
+    AppendLittleEndian<quint16>(METHOD_DEFLATE, _header);
+    AppendLittleEndian<quint16>(DosTime, _header);
+    AppendLittleEndian<quint16>(DosDate, _header);
+    AppendLittleEndian<quint32>(0, _header);
+    AppendLittleEndian<quint32>(0, _header);
+    AppendLittleEndian<quint32>(0, _header);
+    AppendLittleEndian<quint16>(static_cast<quint16>(_entry.Name.size()), _header);
+    AppendLittleEndian<quint16>(0, _header);
+    _header.append(_entry.Name);
+
+    EntryOpen = WriteBytes(_header.constData(), _header.size());
+    return EntryOpen;
+}
+
+/**
+ * @brief Compress bytes into the current entry
+ */
+bool ZipStreamWriter::WriteEntryData(const char *data, int length)
+{
+    if (!EntryOpen || Failed) {
+        return false;
+    }
+    if (length <= 0) {
+        return true;
+    }
+
+    Entry &_entry = Entries.last();  // Record of the open entry
+    _entry.Crc = static_cast<quint32>(crc32(_entry.Crc, reinterpret_cast<const Bytef *>(data), static_cast<uInt>(length)));
+    _entry.UncompressedSize += static_cast<quint64>(length);
+    return Deflate(data, length, Z_NO_FLUSH);
+}
+
+/**
+ * @brief Flush the compressor and write the data descriptor of the current entry
+ */
+bool ZipStreamWriter::EndEntry()
+{
+    if (!EntryOpen) {
+        return !Failed;
+    }
+    EntryOpen = false;
+    if (!Deflate(nullptr, 0, Z_FINISH)) {
+        return false;
+    }
+
+    // Sizes beyond 32 bits are written as 64-bit values (Zip64 data descriptor)
+    const Entry &_entry = Entries.last();  // Record of the finished entry
+    const bool _zip64 = _entry.CompressedSize >= MAX_32 || _entry.UncompressedSize >= MAX_32;  // Sizes need 64 bits
+    QByteArray _descriptor;  // Data descriptor following the entry data
+    AppendLittleEndian<quint32>(DATA_DESCRIPTOR_SIGNATURE, _descriptor);
+    AppendLittleEndian<quint32>(_entry.Crc, _descriptor);
+    if (_zip64) {
+        AppendLittleEndian<quint64>(_entry.CompressedSize, _descriptor);
+        AppendLittleEndian<quint64>(_entry.UncompressedSize, _descriptor);
+    } else {
+        AppendLittleEndian<quint32>(static_cast<quint32>(_entry.CompressedSize), _descriptor);
+        AppendLittleEndian<quint32>(static_cast<quint32>(_entry.UncompressedSize), _descriptor);
+    }
+    return WriteBytes(_descriptor.constData(), _descriptor.size());
+}
+
+/**
+ * @brief End the last entry and write the central directory
+ */
+bool ZipStreamWriter::Finish()
+{
+    if (!EndEntry()) {
+        return false;
+    }
+
+    const quint64 _directoryOffset = Offset;  // Position of the central directory
+    QByteArray _directory;  // Central directory records
+    for (const Entry &_entry : Entries) {
+        // Values that do not fit 32 bits are replaced by 0xFFFFFFFF and stored in the Zip64 extra field
+        QByteArray _extra;  // Zip64 extended information
+        if (_entry.UncompressedSize >= MAX_32) {
+            AppendLittleEndian<quint64>(_entry.UncompressedSize, _extra);
+        }
+        if (_entry.CompressedSize >= MAX_32) {
+            AppendLittleEndian<quint64>(_entry.CompressedSize, _extra);
+        }
+        if (_entry.Offset >= MAX_32) {
+            AppendLittleEndian<quint64>(_entry.Offset, _extra);
+        }
+        if (!_extra.isEmpty()) {
+            QByteArray _field;  // Extra field header followed by the values
+            AppendLittleEndian<quint16>(0x0001, _field);
+            AppendLittleEndian<quint16>(static_cast<quint16>(_extra.size()), _field);
+            _extra.prepend(_field);
+        }
+
+        AppendLittleEndian<quint32>(CENTRAL_HEADER_SIGNATURE, _directory);
+        AppendLittleEndian<quint16>(VERSION_ZIP64, _directory);
+        AppendLittleEndian<quint16>(_extra.isEmpty() ? VERSION_DEFLATE : VERSION_ZIP64, _directory);
+        AppendLittleEndian<quint16>(FLAGS_DESCRIPTOR_UTF8, _directory);
+        AppendLittleEndian<quint16>(METHOD_DEFLATE, _directory);
+        AppendLittleEndian<quint16>(DosTime, _directory);
+        AppendLittleEndian<quint16>(DosDate, _directory);
+        AppendLittleEndian<quint32>(_entry.Crc, _directory);
+        AppendLittleEndian<quint32>(static_cast<quint32>(qMin<quint64>(_entry.CompressedSize, MAX_32)), _directory);
+        AppendLittleEndian<quint32>(static_cast<quint32>(qMin<quint64>(_entry.UncompressedSize, MAX_32)), _directory);
+        AppendLittleEndian<quint16>(static_cast<quint16>(_entry.Name.size()), _directory);
+        AppendLittleEndian<quint16>(static_cast<quint16>(_extra.size()), _directory);
+        AppendLittleEndian<quint16>(0, _directory);
+        AppendLittleEndian<quint16>(0, _directory);
+        AppendLittleEndian<quint16>(0, _directory);
+        AppendLittleEndian<quint32>(0, _directory);
+        AppendLittleEndian<quint32>(static_cast<quint32>(qMin<quint64>(_entry.Offset, MAX_32)), _directory);
+        _directory.append(_entry.Name);
+        _directory.append(_extra);
+    }
+    const quint64 _directorySize = static_cast<quint64>(_directory.size());  // Bytes of the central directory
+    const quint64 _entryCount = static_cast<quint64>(Entries.size());  // Records in the central directory
+
+    // The Zip64 end record and its locator precede the classic end record when a field overflows
+    QByteArray _end;  // End of central directory records
+    if (_entryCount >= MAX_16 || _directorySize >= MAX_32 || _directoryOffset >= MAX_32) {
+        const quint64 _zip64EndOffset = _directoryOffset + _directorySize;  // Position of the Zip64 end record
+        AppendLittleEndian<quint32>(ZIP64_END_SIGNATURE, _end);
+        AppendLittleEndian<quint64>(44, _end);
+        AppendLittleEndian<quint16>(VERSION_ZIP64, _end);
+        AppendLittleEndian<quint16>(VERSION_ZIP64, _end);
+        AppendLittleEndian<quint32>(0, _end);
+        AppendLittleEndian<quint32>(0, _end);
+        AppendLittleEndian<quint64>(_entryCount, _end);
+        AppendLittleEndian<quint64>(_entryCount, _end);
+        AppendLittleEndian<quint64>(_directorySize, _end);
+        AppendLittleEndian<quint64>(_directoryOffset, _end);
+        AppendLittleEndian<quint32>(ZIP64_LOCATOR_SIGNATURE, _end);
+        AppendLittleEndian<quint32>(0, _end);
+        AppendLittleEndian<quint64>(_zip64EndOffset, _end);
+        AppendLittleEndian<quint32>(1, _end);
+    }
+    AppendLittleEndian<quint32>(END_SIGNATURE, _end);
+    AppendLittleEndian<quint16>(0, _end);
+    AppendLittleEndian<quint16>(0, _end);
+    AppendLittleEndian<quint16>(static_cast<quint16>(qMin<quint64>(_entryCount, MAX_16)), _end);
+    AppendLittleEndian<quint16>(static_cast<quint16>(qMin<quint64>(_entryCount, MAX_16)), _end);
+    AppendLittleEndian<quint32>(static_cast<quint32>(qMin<quint64>(_directorySize, MAX_32)), _end);
+    AppendLittleEndian<quint32>(static_cast<quint32>(qMin<quint64>(_directoryOffset, MAX_32)), _end);
+    AppendLittleEndian<quint16>(0, _end);
+
+    _directory.append(_end);
+    return WriteBytes(_directory.constData(), _directory.size());
+}
+
+/**
+ * @brief Check if a write to the device failed
+ */
+bool ZipStreamWriter::HasError() const
+{
+    return Failed;
+}
+
+/**
+ * @brief Run the compressor over input and write its output
+ */
+bool ZipStreamWriter::Deflate(const char *data, int length, int flush)
+{
+    Stream->next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    Stream->avail_in = static_cast<uInt>(length);
+    int _result = Z_OK;  // Result of the last deflate call
+    do {
+        Output.resize(OUTPUT_SIZE);
+        Stream->next_out = reinterpret_cast<Bytef *>(Output.data());
+        Stream->avail_out = static_cast<uInt>(Output.size());
+        _result = deflate(Stream, flush);
+        if (_result == Z_STREAM_ERROR) {
+            qDebug() << "Error: Zip compression failed";
+            Failed = true;
+            return false;
+        }
+
+        const int _produced = Output.size() - static_cast<int>(Stream->avail_out);  // Compressed bytes of this call
+        Entries.last().CompressedSize += static_cast<quint64>(_produced);
+        if (_produced > 0 && !WriteBytes(Output.constData(), _produced)) {
+            return false;
+        }
+    } while (Stream->avail_out == 0 || (flush == Z_FINISH && _result != Z_STREAM_END));
+    return true;
+}
+
+/**
+ * @brief Write bytes to the device and advance the archive offset
+ */
+bool ZipStreamWriter::WriteBytes(const char *data, int length)
+{
+    if (Failed) {
+        return false;
+    }
+    if (Device->write(data, length) != length) {
+        qDebug() << "Error: Failed to write zip output:" << Device->errorString();
+        Failed = true;
+        return false;
+    }
+    Offset += static_cast<quint64>(length);
+    return true;
+}
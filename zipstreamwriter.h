@@ -0,0 +1,127 @@
+#ifndef ZIPSTREAMWRITER_H
+#define ZIPSTREAMWRITER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QtEndian>
+
+struct z_stream_s;
+
+/**
+ * @brief Zip archive encoder streaming deflated entries into an output device
+ * Entries are written one after another without knowing their sizes up front: the
+ * local header announces a data descriptor, which follows the entry data with its
+ * CRC-32 and sizes. Only the central directory (one small record per entry) is kept
+ * until Finish. Sizes and offsets beyond 4 GiB switch to Zip64 records
+ */
+class ZipStreamWriter
+{
+public:
+    /**
+     * @brief Constructor for ZipStreamWriter
+     * @param device Open output device (not owned, must outlive the writer)
+     */
+    explicit ZipStreamWriter(QIODevice *device);
+
+    /**
+     * @brief Destructor releases the deflate stream
+     */
+    ~ZipStreamWriter();
+
+    /**
+     * @brief Start a new entry, ending the previous one
+     * @param name Path of the entry inside the archive
+     * @return true if the local header was written, false otherwise
+     */
+    bool BeginEntry(const QString &name);
+
+    /**
+     * @brief Compress bytes into the current entry
+     * @param data Uncompressed bytes
+     * @param length Number of bytes
+     * @return true if written, false otherwise
+     */
+    bool WriteEntryData(const char *data, int length);
+
+    /**
+     * @brief Flush the compressor and write the data descriptor of the current entry
+     * @return true if the entry is complete, false otherwise
+     */
+    bool EndEntry();
+
+    /**
+     * @brief End the last entry and write the central directory
+     * @return true if the archive is complete, false otherwise
+     */
+    bool Finish();
+
+    /**
+     * @brief Check if a write to the device failed
+     * @return true if output was lost, false otherwise
+     */
+    bool HasError() const;
+
+    static const int DEFLATE_LEVEL;      // zlib compression level of the entries
+    static const int OUTPUT_SIZE;        // Bytes of compressed output collected per device write
+
+private:
+    /**
+     * @brief Central directory record of a written entry
+     */
+    struct Entry
+    {
+        QByteArray Name;                 // Entry path as UTF-8
+        quint32 Crc;                     // CRC-32 of the uncompressed bytes
+        quint64 CompressedSize;          // Bytes of deflated data
+        quint64 UncompressedSize;        // Bytes written into the entry
+        quint64 Offset;                  // Position of the local header in the archive
+    };
+
+    /**
+     * @brief Run the compressor over input and write its output
+     * @param flush Z_NO_FLUSH while streaming, Z_FINISH at the end of the entry
+     */
+    bool Deflate(const char *data, int length, int flush);
+
+    /**
+     * @brief Write bytes to the device and advance the archive offset
+     */
+    bool WriteBytes(const char *data, int length);
+
+    /**
+     * @brief Append a value in little-endian byte order
+     */
+    template <typename T>
+    static void AppendLittleEndian(T value, QByteArray &output)
+    {
+        T _value = qToLittleEndian<T>(value);  // Value in file byte order
+        output.append(reinterpret_cast<const char *>(&_value), sizeof(T));
+    }
+
+    static const quint32 LOCAL_HEADER_SIGNATURE;    // Signature of a local file header
+    static const quint32 DATA_DESCRIPTOR_SIGNATURE; // Signature of a data descriptor
+    static const quint32 CENTRAL_HEADER_SIGNATURE;  // Signature of a central directory record
+    static const quint32 ZIP64_END_SIGNATURE;       // Signature of the Zip64 end record
+    static const quint32 ZIP64_LOCATOR_SIGNATURE;   // Signature of the Zip64 end locator
+    static const quint32 END_SIGNATURE;             // Signature of the end of central directory record
+    static const quint16 VERSION_DEFLATE;           // Version needed to extract deflated entries (2.0)
+    static const quint16 VERSION_ZIP64;             // Version needed to extract Zip64 records (4.5)
+    static const quint16 FLAGS_DESCRIPTOR_UTF8;     // General purpose flags: data descriptor and UTF-8 names
+    static const quint16 METHOD_DEFLATE;            // Compression method deflate
+    static const quint32 MAX_32;                    // Largest 32-bit field value, marking a value stored in Zip64 records
+    static const quint16 MAX_16;                    // Largest 16-bit field value, marking a count stored in Zip64 records
+
+    QIODevice *Device;                   // Output device (not owned)
+    QVector<Entry> Entries;              // Entries written so far, the last one possibly open
+    z_stream_s *Stream;                  // Raw deflate stream of the open entry
+    QByteArray Output;                   // Compressed bytes of one deflate call
+    quint64 Offset;                      // Bytes written to the device
+    quint16 DosTime;                     // Modification time of every entry (MS-DOS format)
+    quint16 DosDate;                     // Modification date of every entry (MS-DOS format)
+    bool EntryOpen;                      // Flag indicating an entry is being written (true) or not (false)
+    bool Failed;                         // Flag indicating a write failed (true) or all succeeded (false)
+};
+
+#endif // ZIPSTREAMWRITER_H